@@ -1,8 +1,12 @@
 #!/bin/bash
 
 # this is a simple benchmarking script for Hantenna 
+# usage: ./Bench.sh [max threads], each transform is run from 1 to max threads, default 12.
+# Timings are appended to timings.csv, which may be plotted with plottimings.py
 
-for i in {1..12}
+NMAX=${1:-12}
+
+for (( i=1; i<=NMAX; i++ ))
 do
    echo "Welcome $i times"
    export OMP_NUM_THREADS=$i
@@ -10,7 +14,7 @@ do
 done
 
 sed -i -- 's/FHTKEY51/FHTKEY101/g' inp/config.inp 
-for i in {1..12}
+for (( i=1; i<=NMAX; i++ ))
 do
    echo "Welcome $i times"
    export OMP_NUM_THREADS=$i
@@ -18,7 +22,7 @@ do
 done
 
 sed -i -- 's/FHTKEY101/FHTKEY201/g' inp/config.inp 
-for i in {1..12}
+for (( i=1; i<=NMAX; i++ ))
 do
    echo "Welcome $i times"
    export OMP_NUM_THREADS=$i
@@ -26,7 +30,7 @@ do
 done
 
 sed -i -- 's/FHTKEY201/ANDERSON801/g' inp/config.inp 
-for i in {1..12}
+for (( i=1; i<=NMAX; i++ ))
 do
    echo "Welcome $i times"
    export OMP_NUM_THREADS=$i
@@ -34,7 +38,7 @@ do
 done
 
 sed -i -- 's/ANDERSON801/QWEKEY/g' inp/config.inp 
-for i in {1..12}
+for (( i=1; i<=NMAX; i++ ))
 do
    echo "Welcome $i times"
    export OMP_NUM_THREADS=$i
@@ -42,7 +46,7 @@ do
 done
 
 sed -i -- 's/QWEKEY/CHAVE/g' inp/config.inp 
-for i in {1..12}
+for (( i=1; i<=NMAX; i++ ))
 do
    echo "Welcome $i times"
    export OMP_NUM_THREADS=$i
@@ -22,6 +22,7 @@
 
 #include "LemmaObject.h"
 #include "DipoleSource.h"
+#include "LayeredEarthEM.h"
 
 namespace Lemma {
 
@@ -29,7 +30,11 @@ namespace Lemma {
   \ingroup FDEM1D
   \brief   Contains pertinant information about an AEM survey
   \details All important details about an AEM survey are stored here, but
-           nothing about the underlying earth model.
+           nothing about the underlying earth model. The survey is stored by
+           columns. The sources of a sounding (frequency, type, offset and moment)
+           are stored once, and every sounding location only adds its position and
+           polarisation. The sources of a sounding are placed relative to its
+           location, and the fields are computed at the location.
  */
 class AEMSurvey : public LemmaObject {
 
@@ -61,11 +66,40 @@ class AEMSurvey : public LemmaObject {
 
     // ====================  OPERATIONS    =======================
 
+    /** Computes the fields set by SetFieldsToCalculate of every source at every
+     *  sounding location, using the same earth model everywhere.
+     *  @param[in] model is the earth model
+     *  @return the fields, see ForwardModel(const std::vector< std::shared_ptr<LayeredEarthEM> >&)
+     */
+    MatrixXcr ForwardModel( std::shared_ptr<LayeredEarthEM> model );
+
+    /** Computes the fields set by SetFieldsToCalculate of every source at every
+     *  sounding location. Sources of a sounding sharing type, moment, height and
+     *  horizontal separation need the same kernels, and are computed together for
+     *  all of their frequencies and offsets. Soundings are computed in parallel, the
+     *  first exception thrown by any of them is rethrown once all have been computed.
+     *  @param[in] models are the earth models, one per sounding location
+     *  @return the fields, column iloc holds sounding iloc and rows 3*isrc to
+     *          3*isrc+2 the x, y and z components due to source isrc. When both
+     *          fields are calculated, H is followed by E in rows 3*nsrc+3*isrc on.
+     */
+    MatrixXcr ForwardModel( const std::vector< std::shared_ptr<LayeredEarthEM> >& models );
+
     // ====================  ACCESS        =======================
 
+    /** Sets the Hankel transform used by ForwardModel, defaults to ANDERSON801
+     */
+    void SetHankelTransformMethod( const HANKELTRANSFORMTYPE& type );
+
+    /** Sets the fields computed by ForwardModel, defaults to H
+     */
+    void SetFieldsToCalculate( const FIELDCALCULATIONS& calc );
+
     /** Returns a particular EM source. For now only dipole sources are supported,
-     *  general loops int the new future.
-     *  @param[in] isource is the source fiducial to return
+     *  general loops int the new future. The source is constructed on demand,
+     *  changing it does not change the survey.
+     *  @param[in] isource is the source fiducial to return, sources are
+     *             ordered by location and then by source within the sounding
      */
     std::shared_ptr<DipoleSource> GetSource(const int& isource);
 
@@ -73,6 +107,26 @@ class AEMSurvey : public LemmaObject {
      */
     int GetNumberOfSources();
 
+    /** @return the number of sources of each sounding
+     */
+    int GetNumberOfSourcesPerLocation();
+
+    /** @return the number of sounding locations
+     */
+    int GetNumberOfLocations();
+
+    /** @return the sounding locations
+     */
+    Vector3Xr GetLocations();
+
+    /** @return the source polarisation of each sounding location
+     */
+    Vector3Xr GetPolarisations();
+
+    /** @return the frequency of each source of a sounding
+     */
+    VectorXr GetSourceFrequencies();
+
     /** Returns vector of all frequencies used in the survey
      *  @return a vector of the unique frequencies
      */
@@ -93,10 +147,31 @@ class AEMSurvey : public LemmaObject {
 
     // ====================  DATA MEMBERS  =========================
 
-    std::vector< std::shared_ptr<DipoleSource> >  Sources;
+    /** Frequency of each source of a sounding, in Hz */
+    VectorXr SourceFrequencies;
+
+    /** Type of each source of a sounding */
+    std::vector<DIPOLESOURCETYPE> SourceTypes;
+
+    /** Position of each source relative to the sounding location */
+    Vector3Xr SourceOffsets;
+
+    /** Moment of each source of a sounding */
+    VectorXr SourceMoments;
+
+    /** Sounding locations */
+    Vector3Xr Locations;
+
+    /** Source polarisation at each sounding location */
+    Vector3Xr Polarisations;
 
     VectorXr Freqs;
 
+    HANKELTRANSFORMTYPE HankelType;
+
+    /** Fields computed by ForwardModel */
+    FIELDCALCULATIONS FieldsToCalculate;
+
     static constexpr auto CName = "AEMSurvey";
 
 }; // -----  end of class  AEMSurvey  -----
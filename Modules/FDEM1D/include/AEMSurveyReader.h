@@ -29,7 +29,9 @@ namespace Lemma {
     /**
       \ingroup FDEM1D
       \brief   Reads an ASCII description of an AEM survey
-      \details The file format is described as follows.
+      \details The file format is described as follows. The header describing the
+               sources of a sounding is read once, the flight plan can then be
+               read all at once or streamed in blocks of locations.
      */
     class AEMSurveyReader : public LemmaObject {
 
@@ -99,6 +101,19 @@ MD        // Source 5 type
          */
         void ReadASCIIAEMFile( const std::string& name );
 
+        /** Opens an AEM survey file and reads the sources and number of locations,
+         *  the locations are then read with ReadLocations.
+         *  @param[in] name is the file name, in the format of ReadASCIIAEMFile
+         */
+        void OpenASCIIAEMFile( const std::string& name );
+
+        /** Reads the next block of locations of the opened file into a new survey,
+         *  available through GetSurvey. The sources are shared by every block.
+         *  @param[in] nmax is the largest number of locations to read
+         *  @return the number of locations read, zero at the end of the file
+         */
+        int ReadLocations( const int& nmax );
+
         // ====================  ACCESS        =======================
 
         /**
@@ -106,6 +121,11 @@ MD        // Source 5 type
          */
         std::shared_ptr<AEMSurvey> GetSurvey();
 
+        /**
+         * @return the number of locations in the opened file
+         */
+        int GetNumberOfLocations();
+
         // ====================  INQUIRY       =======================
         /** Returns the name of the underlying class, similiar to Python's type */
         virtual std::string GetName() const {
@@ -122,6 +142,15 @@ MD        // Source 5 type
 
         std::shared_ptr<AEMSurvey>  Survey;
 
+        /** Parser of the opened file, positioned at the next location */
+        std::shared_ptr<ASCIIParser> Parser;
+
+        /** Number of locations in the opened file */
+        int                         nLocations;
+
+        /** Number of locations read so far */
+        int                         nRead;
+
         static constexpr auto CName = "AEMSurveyReader";
 
     }; // -----  end of class  AEMSurveyReader  -----
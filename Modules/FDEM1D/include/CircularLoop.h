@@ -22,14 +22,21 @@
 
 #pragma once
 #include "CompactSupportEMSource.h"
+#include "DipoleSource.h"
 
 namespace Lemma {
 
     /**
      * \ingroup FDEM1D
      * \brief   Analytic solution of a circular loop.
-     * \details This specialized class provides the EM response of a circular loop on the surface of the earth.
-     *          More general use cases can use PolygonalWireAntenna.
+     * \details This specialized class provides the EM response of a horizontal circular loop
+     *          in the air, or on the surface of the earth. Rather than discretizing the wire into
+     *          dipoles, the loop is treated as a vertical magnetic dipole spread uniformly over
+     *          the disk it encloses. Inside of the loop the transforms are taken over the
+     *          radius, which is exact at the centre. Outside of the loop the point dipole
+     *          response is integrated over the disk. Convergence is slow for receivers close to
+     *          the wire. More general use cases can use PolygonalWireAntenna.
+     *  @see EMEarth1D::CalculateCircularLoopFields
      */
     class CircularLoop : public CompactSupportEMSource {
 
@@ -98,9 +105,89 @@ namespace Lemma {
 
         // ====================  OPERATIONS    =======================
 
+        /**
+         *  Returns a vertical magnetic dipole equivalent to this loop, with moment
+         *  N I pi a^2 spread over the disk of the loop.
+         *  @return a new DipoleSource, which may be passed to EMEarth1D::AttachDipoleSource
+         */
+        std::shared_ptr<DipoleSource> GetDipoleSource();
+
         // ====================  ACCESS        =======================
 
+        /**
+         *  Sets the centre of the loop
+         *  @param[in] posin is the location of the centre
+         */
+        void SetLocation(const Vector3r &posin);
+
+        /**
+         *  Sets the centre of the loop
+         *  @param[in] xp is the x location of the centre
+         *  @param[in] yp is the y location of the centre
+         *  @param[in] zp is the z location of the centre
+         */
+        void SetLocation(const Real &xp, const Real &yp, const Real &zp);
+
+        /**
+         *  Sets the radius of the loop
+         *  @param[in] radius is the radius of the loop, in metres
+         */
+        void SetRadius(const Real& radius);
+
+        /**
+         *  Sets the current in the loop, default is 1. Positive current circulates
+         *  counterclockwise when viewed from above.
+         *  @param[in] amp is the current in the loop, in Amperes
+         */
+        void SetCurrent(const Real &amp);
+
+        /**
+         *  Sets the number of turns in the loop, default is 1
+         */
+        void SetNumberOfTurns(const int &nturns);
+
+        /**
+         *  Sets the number of frequencies.
+         *  @param[in] nfreq is the number of frequencies that will be computed.
+         */
+        void SetNumberOfFrequencies(const int& nfreq);
+
+        /**
+         *  Sets the frequency of the current in the loop
+         *  @param[in] ifreq is the frequency number to set
+         *  @param[in] freq is the frequency (Hz) of the current
+         */
+        void SetFrequency(const int& ifreq, const Real &freq);
+
+        /**
+         *  Sets all of the frequencies of the current in the loop
+         *  @param[in] freqs are the frequencies (Hz) of the current
+         */
+        void SetFrequencies(const VectorXr& freqs);
+
         // ====================  INQUIRY       =======================
+
+        /** @return the centre of the loop */
+        Vector3r GetLocation();
+
+        /** @return the radius of the loop */
+        Real GetRadius();
+
+        /** @return the current in the loop */
+        Real GetCurrent();
+
+        /** @return the number of turns */
+        int GetNumberOfTurns();
+
+        /** @return the number of frequencies */
+        int GetNumberOfFrequencies();
+
+        /** @return the frequency ifreq */
+        Real GetFrequency(const int& ifreq);
+
+        /** @return all of the frequencies */
+        VectorXr GetFrequencies();
+
         /**
          *  Returns the name of the underlying class, similiar to Python's type
          *  @return string of class name
@@ -118,6 +205,21 @@ namespace Lemma {
 
         // ====================  DATA MEMBERS  =========================
 
+        /** Centre of the loop */
+        Vector3r Location = Vector3r::Zero();
+
+        /** Radius of the loop (m) */
+        Real Radius = 1;
+
+        /** Current in the loop (A) */
+        Real Current = 1;
+
+        /** Number of turns */
+        int NumberOfTurns = 1;
+
+        /** Frequencies of the loop */
+        VectorXr Freqs;
+
         private:
 
         /** ASCII string representation of the class name */
@@ -128,7 +128,7 @@ namespace Lemma {
             void Compute(const Real& rho, const int& ntol, const Real& tol);
 
             /** Attaches the integration kernel */
-            void AttachKernel(IntegrationKernel<Scalar> *Kernel);
+            void AttachKernel( std::shared_ptr< IntegrationKernel<Scalar> > Kernel );
 
             /** Detaches the integration kernel */
             void DetachKernel( );
@@ -203,7 +203,7 @@ namespace Lemma {
             int ihi;
 
             /** Kernel Calculator */
-            IntegrationKernel<Scalar> *IntKernel;
+            std::shared_ptr< IntegrationKernel<Scalar> > IntKernel;
 
             /** Holds answer, dimensions are NumConv, and NumberRelated. */
             Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Ans;
@@ -252,7 +252,7 @@ namespace Lemma {
         ABSCISSA(0),
         ABSE(1.10517091807564762),   //   exp(.1)
         ABSER(0.904837418035959573), // 1/exp(.1)
-        ilow(0), ihi(0), IntKernel(NULL) {
+        ilow(0), ihi(0), IntKernel(nullptr) {
     }
 
     template <typename Scalar>
@@ -287,22 +287,14 @@ namespace Lemma {
 
     template <typename Scalar>
     void DigitalFilterIntegratorAnderson<Scalar>::
-            AttachKernel(IntegrationKernel<Scalar> *ck) {
-		if (this->IntKernel == ck) return;
-        if (this->IntKernel != NULL) {
-			this->IntKernel->DetachFrom(this);
-		}
-		ck->AttachTo(this);
+            AttachKernel( std::shared_ptr< IntegrationKernel<Scalar> > ck ) {
 		this->IntKernel = ck;
 	}
 
 
     template <typename Scalar>
 	void DigitalFilterIntegratorAnderson<Scalar>::DetachKernel( ) {
-		if (this->IntKernel != NULL) {
-			this->IntKernel->DetachFrom(this);
-		}
-		this->IntKernel = NULL;
+		this->IntKernel = nullptr;
 	}
 
 //     template < >
@@ -0,0 +1,110 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+  @file
+  @author   Trevor Irons
+  @date     10/18/2026
+ **/
+
+#ifndef  DIPOLESET_INC
+#define  DIPOLESET_INC
+
+#include "LemmaObject.h"
+
+namespace Lemma {
+
+    // ===================================================================
+    //        Class:  DipoleSet
+    /// \ingroup FDEM1D
+    /// \brief   Compact set of ungrounded electric dipoles approximating a wire.
+    /// \details Locations, polarisations and moments are stored in contiguous
+    ///          arrays rather than as individual DipoleSource objects. The set
+    ///          is rebuilt for every receiver, so storage is kept between
+    ///          rebuilds and only grows. This is deliberately not a
+    ///          LemmaObject, it is a plain value held by PolygonalWireAntenna.
+    // ===================================================================
+    class DipoleSet {
+
+        public:
+
+            // ====================  LIFECYCLE     =======================
+
+            /// Default constructor, an empty set.
+            DipoleSet ( );
+
+            /// Default destructor.
+            ~DipoleSet ( );
+
+            // ====================  OPERATIONS    =======================
+
+            /** Empties the set, retaining the allocated storage
+             */
+            void Clear( );
+
+            /** Appends a dipole to the set
+             *  @param[in] loc is the location of the dipole centre
+             *  @param[in] pol is the unit polarisation
+             *  @param[in] moment is the dipole moment
+             */
+            void Push( const Vector3r& loc, const Vector3r& pol, const Real& moment );
+
+            /** Moves and resizes the last dipole of the set
+             *  @param[in] loc is the new location of the dipole centre
+             *  @param[in] moment is the new dipole moment
+             */
+            void CorrectLast( const Vector3r& loc, const Real& moment );
+
+            // ====================  INQUIRY       =======================
+
+            /** @return the number of dipoles in the set
+             */
+            int GetNumberOfDipoles( ) const {
+                return nDipoles;
+            }
+
+            /** @return the location of dipole idip
+             */
+            Vector3r GetLocation( const int& idip ) const {
+                return Locations.col(idip);
+            }
+
+            /** @return the unit polarisation of dipole idip
+             */
+            Vector3r GetPolarisation( const int& idip ) const {
+                return Polarisations.col(idip);
+            }
+
+            /** @return the moment of dipole idip
+             */
+            Real GetMoment( const int& idip ) const {
+                return Moments(idip);
+            }
+
+        private:
+
+            // ====================  DATA MEMBERS  =======================
+
+            /// Number of dipoles in the set, storage may be larger
+            int                nDipoles;
+
+            /// Dipole centres
+            Vector3Xr          Locations;
+
+            /// Unit polarisations
+            Vector3Xr          Polarisations;
+
+            /// Dipole moments
+            VectorXr           Moments;
+
+    }; // -----  end of class  DipoleSet  -----
+
+}       // -----  end of Lemma  name  -----
+
+#endif   // ----- #ifndef DIPOLESET_INC  -----
+
+/* vim: set tabstop=4 expandtab: */
+/* vim: set filetype=cpp: */
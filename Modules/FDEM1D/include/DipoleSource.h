@@ -16,6 +16,7 @@
 #include <memory>
 #include "LemmaObject.h"
 #include "LayeredEarthEM.h"
+#include "KernelEM1DBase.h"
 //#include "PolygonalWireAntenna.h"
 
 #ifdef LEMMAUSEVTK
@@ -53,6 +54,8 @@ namespace Lemma {
 
         friend class EMEarth1D;
         friend class PolygonalWireAntenna;
+        friend class KernelEM1DReflBase;
+        friend class KernelEM1DManager;
 
         public:
 
@@ -147,6 +150,30 @@ namespace Lemma {
             /// Sets the polarity
             void SetPolarity(const DipoleSourcePolarity& pol);
 
+            /** Spreads a vertical magnetic dipole uniformly over a horizontal disk of the
+             *  given radius, centred on the dipole location. The fields are those of a
+             *  circular loop of that radius carrying a current of Moment/(pi radius^2).
+             *  Rather than discretizing the wire, each receiver needs one related Hankel
+             *  transform at the centre of the loop and outside of it, and two elsewhere inside
+             *  of the loop. This is only used by MAGNETICDIPOLE sources with a vertical
+             *  polarisation, in the air. Receivers close to the wire converge slowly, and
+             *  outside of the loop so do receivers close to its plane, where the shorter
+             *  digital filters resolve the radius less well than ANDERSON801.
+             *  @param[in] radius is the loop radius, 0 for a point dipole
+             *  @see CircularLoop
+             */
+            void SetLoopRadius(const Real& radius);
+
+            /** Uses this vertical magnetic dipole as the moment per unit area of a closed,
+             *  horizontal wire loop, whose fields are evaluated as integrals along the wire
+             *  by UpdateLineIntegralFields. Only the kernels used by those integrals are
+             *  loaded. This is only used by MAGNETICDIPOLE sources with a vertical
+             *  polarisation, in the air.
+             *  @param[in] line set to true for line integral evaluation
+             *  @see PolygonalWireAntenna::ApproximateWithLineIntegral
+             */
+            void SetLineIntegral(const bool& line);
+
             /// Sets number of frequencies
             void SetNumberOfFrequencies(const int &nfreq);
 
@@ -189,6 +216,12 @@ namespace Lemma {
             /// Returns the dipole moment
             Real GetMoment();
 
+            /// Returns the loop radius, 0 for a point dipole. @see SetLoopRadius
+            Real GetLoopRadius();
+
+            /// Returns true if the dipole is used for line integral evaluation. @see SetLineIntegral
+            bool GetLineIntegral();
+
             /// Returns the angular frequency of the dipole
             Real GetAngularFrequency(const int &ifreq);
 
@@ -234,11 +267,122 @@ namespace Lemma {
                     std::shared_ptr<FieldPoints> Receivers,
                     const int& irec, std::shared_ptr<LayeredEarthEM> Earth );
 
-            /** Updates the receiver fields */
+            /** Updates the receiver fields, with the updater selected for the source type, fields
+             *  and polarisation by SetKernels or SetupLight
+             */
             virtual void UpdateFields(const int& ifreq, HankelTransform* Hankel, const Real& wavef);
 
+            /** Returns a tag of everything the choice of kernels depends on, used by SetKernels to
+             *  determine if the current kernels can be reused.
+             */
+            int KernelConfiguration();
+
+            /** Computes the transforms and updates the receiver fields of a source spread over
+             *  a loop, used in place of UpdateFields when the loop radius is set.
+             *  Inside of the loop the transforms are taken over the radius, with the offset
+             *  moved into the kernels. Outside of the loop the transform is taken over the
+             *  offset, with the radius moved into the kernels.
+             *  @see SetLoopRadius
+             */
+            void UpdateLoopFields(const int& ifreq, HankelTransform* Hankel, const Real& wavef);
+
+            /** Updates the receiver fields of a closed, horizontal wire loop from integrals along
+             *  the wire. By Green's theorem, the vertical dipoles spread over the area of the loop
+             *  are equivalent to the J1 transform of kernel 12 for Hz, and the J0 transforms of
+             *  kernels 7 and 2 for the horizontal magnetic and electric fields, evaluated along
+             *  the wire. One lagged convolution covers every node when the Hankel transform
+             *  supports it, otherwise each node is transformed separately.
+             *  @param[in] ifreq is the frequency index
+             *  @param[in] Hankel is the Hankel transform to use
+             *  @param[in] wavef is the propagation constant in free space
+             *  @param[in] quad is the quadrature of the wire, as built by
+             *             PolygonalWireAntenna::ApproximateWithLineIntegral
+             *  @see SetLineIntegral
+             */
+            void UpdateLineIntegralFields(const int& ifreq, HankelTransform* Hankel, const Real& wavef,
+                    const Eigen::Matrix<Real, Eigen::Dynamic, 4>& quad);
+
+            /** Returns the weight applied to the kernels of a loop source for the transform in
+             *  progress.
+             *  @param[in] lambda is the current lambda argument
+             *  @see LOOPTRANSFORM
+             */
+            Real LoopWeight( const Real& lambda ) const;
+
+            /** @return 2 J1(x)/x */
+            static Real LoopFormFactor( const Real& x );
+
+            /** @return J0(x) */
+            static Real BesselJ0( const Real& x );
+
         private:
 
+            /** Updates the receiver fields, one is selected for each source type, fields and
+             *  nonzero components of the polarisation, @see SetUpdater
+             */
+            typedef void (DipoleSource::*FieldUpdater)(const int& ifreq, HankelTransform* Hankel,
+                    const Real& wavef);
+
+            /** Updates the receiver fields of a source of type STYPE calculating FIELDS, where POL is
+             *  the mask of nonzero polarisation components, x=1, y=2 and z=4. Only the transforms and
+             *  projections needed are evaluated.
+             */
+            template <DIPOLESOURCETYPE STYPE, FIELDCALCULATIONS FIELDS, int POL>
+            void UpdateFieldsSpec(const int& ifreq, HankelTransform* Hankel, const Real& wavef);
+
+            /** @return the updater of a source of type STYPE
+             *  @param[in] fields are the fields calculated
+             *  @param[in] pol is the mask of nonzero polarisation components
+             */
+            template <DIPOLESOURCETYPE STYPE>
+            static FieldUpdater SelectUpdater( const FIELDCALCULATIONS& fields, const int& pol );
+
+            /** Selects the field updater, if the source type, fields, components of the receiver
+             *  or nonzero components of the polarisation have changed since it was last selected
+             */
+            void SetUpdater( );
+
+            /** @return true if any of the field components in mask are calculated at the
+             *          receiver, for FieldsToCalculate
+             *  @param[in] mask is a combination of FIELDCOMPONENTMASK values
+             */
+            bool IsCalculated( const int& mask ) const;
+
+            /** Appends the electric field to the receiver, components that are not calculated
+             *  there are zeroed
+             */
+            void AppendEfield( const int& ifreq, const Complex& ex, const Complex& ey,
+                    const Complex& ez );
+
+            /** Appends the magnetic field to the receiver, components that are not calculated
+             *  there are zeroed
+             */
+            void AppendHfield( const int& ifreq, const Complex& hx, const Complex& hy,
+                    const Complex& hz );
+
+            /** Adds kernel Ikernel to the KernelManager, for the layers of the source and receiver
+             */
+            template <EMMODE Mode, int Ikernel>
+            void AddKernel( );
+
+            /** The transforms used for loops of radius a, where the receiver offset is rho */
+            enum LOOPTRANSFORM {
+                /// Transform over rho, kernels weighted by 2 J1(lambda a)/(lambda a), the disk
+                /// average of the point dipole, gives every field outside of the loop
+                LOOPOUTSIDE,
+                /// Transform over a, kernels weighted by 2 J0(lambda rho)/a, gives Hz inside of the loop
+                LOOPINSIDEJ0,
+                /// Transform over a, kernels weighted by 2 J1(lambda rho)/(lambda a), gives the
+                /// horizontal fields inside of the loop
+                LOOPINSIDEJ1
+            };
+
+            /** Power series of J0(x) for n=0, or 2 J1(x)/x for n=1, used for x < 12 */
+            static Real LoopBesselSeries( const int& n, const Real& x );
+
+            /** Hankel's asymptotic expansion of Jn(x) for n=0 or 1, used for x >= 12 */
+            static Real LoopBesselAsymptotic( const int& n, const Real& x );
+
             // ====================  DATA MEMBERS  ======================
 
             /// Defines the type of source (magnetic or electric)
@@ -261,6 +405,15 @@ namespace Lemma {
             /// Dipole Moment
             Real                         Moment;
 
+            /// Radius of the loop the dipole is spread over, @see SetLoopRadius
+            Real                         LoopRadius = 0;
+
+            /// Transform in progress for a loop source, @see LoopWeight
+            LOOPTRANSFORM                loopTransform = LOOPOUTSIDE;
+
+            /// Whether the dipole is used for line integral evaluation, @see SetLineIntegral
+            bool                         LineIntegral = false;
+
             Real                         xxp;
             Real                         yyp;
             Real                         rho;
@@ -274,9 +427,20 @@ namespace Lemma {
 
             FIELDCALCULATIONS            FieldsToCalculate = BOTH;
 
-            VectorXcr                    f;
+            /// Field components calculated at the receiver, @see FieldPoints::SetComponents
+            int                          Components = ALLMASK;
+
             VectorXi                     ik;
 
+            /// Updater of the receiver fields, @see SetUpdater
+            FieldUpdater                 Updater = nullptr;
+
+            /// Source type, fields and polarisation the Updater was selected for
+            int                          updaterConfig = -1;
+
+            /// Configuration the current KernelManager was built for, @see KernelConfiguration
+            int                          kernelConfig = -1;
+
             /// Central location of the dipole
             Vector3r                                    Location;
 
@@ -40,6 +40,7 @@ namespace Lemma {
     enum TXRXMODE { TX, RX, TXRX, NOMODE };
 
     class WireAntenna;
+    class CircularLoop;
     class PolygonalWireAntenna;
     class FieldPoints;
     class DipoleSource;
@@ -102,14 +103,150 @@ namespace Lemma {
             /** C++ wrapper for em1dnew.for, serial */
             void MakeCalc3();
 
-            /** Calculates the field(s) due to a wire antennae */
+            /** Calculates the field(s) due to a wire antennae. The work is split into tiles of
+             *  receivers, frequencies and dipoles which are scheduled as OpenMP tasks, so that
+             *  masked receivers or uneven numbers of dipoles do not leave threads idle.
+             *  @param[in] progressbar set to true to display progress
+             */
             void CalculateWireAntennaFields(bool progressbar=false);
 
+            /** Calculates the field(s) due to a circular loop. The loop is
+             *  evaluated analytically as a single transform per receiver rather
+             *  than being discretized into dipoles. The loop must lie in the air,
+             *  and the Gaussian quadrature (CHAVE) transform is not supported.
+             *  @see CircularLoop
+             */
+            void CalculateCircularLoopFields();
+
+            /** Calculates the fields, as MakeCalc3, together with the sensitivities of the
+             *  magnetic field to the conductivity and thickness of each layer. The reflection
+             *  recursion is differentiated analytically, so the cost is that of one forward
+             *  calculation plus a Hankel transform of each derivative kernel, rather than a
+             *  forward calculation per parameter.
+             *  @note Only sources and receivers in the air, point dipole sources, the
+             *        magnetic field and the FHTKEY201, FHTKEY101 and FHTKEY51 transforms are
+             *        supported. With BOTH the electric field is calculated but has no
+             *        sensitivities. Other setups throw UnsupportedSensitivities, or
+             *        UnsupportedLoopSource for loops.
+             *  @return the sensitivities, rows 3*(ifreq*nrec+irec) to 3*(ifreq*nrec+irec)+2
+             *          hold the x, y and z components of H at receiver irec and frequency
+             *          ifreq. Column ilay-1 is the derivative with respect to the conductivity
+             *          of layer ilay, for ilay=1 to nlay-1, and column nlay-2+ilay with
+             *          respect to the thickness of layer ilay, for ilay=1 to nlay-2.
+             */
+            MatrixXcr CalculateSensitivities();
+
+            /** Calculates the fields, as MakeCalc3, but keeps the kernels of each thread
+             *  between calls. With the FHTKEY201, FHTKEY101 and FHTKEY51 transforms the layer
+             *  recursion of every frequency and receiver is kept too, so a later call only
+             *  recomputes the layers at and above the deepest layer of the earth that changed.
+             *  This suits line searches and other updates of a few layers at a time. The
+             *  receiver fields are cleared first. The kept state is rebuilt when a different
+             *  source or transform is attached, or the number of threads changes.
+             *  @see ResetIncrementalCalc
+             */
+            void MakeIncrementalCalc();
+
+            /** Sets the conductivity of layer ilay of the attached earth and recalculates
+             *  the fields with MakeIncrementalCalc
+             *  @param[in] ilay is the layer, from 1 to nlay-1
+             *  @param[in] sigma is the new conductivity
+             */
+            void UpdateLayer( const int& ilay, const Complex& sigma );
+
+            /** Sets the conductivity and thickness of layer ilay of the attached earth and
+             *  recalculates the fields with MakeIncrementalCalc
+             *  @param[in] ilay is the layer, from 1 to nlay-2
+             *  @param[in] sigma is the new conductivity
+             *  @param[in] thickness is the new thickness
+             */
+            void UpdateLayer( const int& ilay, const Complex& sigma, const Real& thickness );
+
+            /** Discards the kernels and recursions kept by MakeIncrementalCalc. Needed after
+             *  the attached source is modified in place.
+             */
+            void ResetIncrementalCalc();
+
+            /** Calculates the fields set by SetFieldsToCalculate of the attached dipole
+             *  source at the attached receivers, for many earth models over that one
+             *  geometry. With the source and receiver in the air the kernels only depend on
+             *  the earth through the reflection coefficient at the surface, and the fields
+             *  are linear in the kernels. So the kernels, the transform and the fields of a
+             *  unit kernel are prepared once per frequency and receiver, and the layer
+             *  recursion runs over blocks of models, with the models as the inner loop.
+             *  The fields of a block then follow from two matrix products. The work is
+             *  shared among threads by frequency, receiver and block of models.
+             *  @note Only point dipole sources, sources and receivers in the air and the
+             *        digital filter transforms FHTKEY201, FHTKEY101 and FHTKEY51 are
+             *        supported. Other setups throw UnsupportedModelBatch, or
+             *        UnsupportedLoopSource for loops. Every model must have the same number
+             *        of layers. The reduced stack of LayeredEarthEM::SetTruncationTolerance
+             *        is not used.
+             *  @param[in] models are the earth models
+             *  @return the models by receivers by frequencies response. Row imod holds model
+             *          imod, and columns 3*(ifreq*nrec+irec) to 3*(ifreq*nrec+irec)+2 the
+             *          x, y and z components of H at receiver irec and frequency ifreq. E is
+             *          laid out the same way, after H when both are calculated. Each column
+             *          is contiguous across models.
+             */
+            MatrixXcr CalculateModels( const std::vector< std::shared_ptr<LayeredEarthEM> >& models );
+
+            /** Calculates the fields of many earth models stored as rows of a matrix, as
+             *  CalculateModels( const std::vector< std::shared_ptr<LayeredEarthEM> >& ).
+             *  @param[in] base supplies the number of layers and all other properties
+             *  @param[in] conductivity is nmodels by nlayers, including the air layer
+             *  @param[in] thickness is nmodels by nlayers-2
+             *  @return the fields, row imod holds model imod
+             */
+            MatrixXcr CalculateModels( std::shared_ptr<LayeredEarthEM> base,
+                    const MatrixXcr& conductivity, const MatrixXr& thickness );
+
+            /** Calculates the fields set by SetFieldsToCalculate of many independent
+             *  soundings, in parallel across soundings. Sounding i is the dipole sources[i]
+             *  over models[i], observed at receivers[i]. A single source or receiver set is
+             *  used by every sounding, CalculateModels is faster for many models over one
+             *  geometry in the air. Every sounding must have the same number of frequencies
+             *  and receivers.
+             *  The Hankel transform of this object is used, the attached
+             *  earth, source and receivers are neither used nor modified. Each thread
+             *  keeps its copy of a source, with its kernels, while the source does not
+             *  change between soundings.
+             *  @param[in] models are the earth models, one per sounding
+             *  @param[in] sources are the dipole sources, one per sounding or one for all
+             *  @param[in] receivers are the receiver points, one per sounding or one for all
+             *  @return column i holds sounding i, rows 3*(ifreq*nrec+irec) to
+             *          3*(ifreq*nrec+irec)+2 the x, y and z components of H at receiver
+             *          irec and frequency ifreq. E is laid out the same way, after H when
+             *          both are calculated.
+             */
+            MatrixXcr CalculateSoundings( const std::vector< std::shared_ptr<LayeredEarthEM> >& models,
+                    const std::vector< std::shared_ptr<DipoleSource> >& sources,
+                    const std::vector< std::shared_ptr<FieldPoints> >& receivers );
+
+            /** Calculates the magnetic fields of many independent soundings, whose models
+             *  are stored as rows of a matrix. Each thread copies the base model once and
+             *  only replaces its conductivities and thicknesses between soundings.
+             *  @param[in] base supplies the number of layers and all other properties
+             *  @param[in] conductivity is nsoundings by nlayers, including the air layer
+             *  @param[in] thickness is nsoundings by nlayers-2
+             *  @param[in] sources are the dipole sources, one per sounding or one for all
+             *  @param[in] receivers are the receiver points, one per sounding or one for all
+             *  @return the fields, as CalculateSoundings( const std::vector< std::shared_ptr<LayeredEarthEM> >&,
+             *          const std::vector< std::shared_ptr<DipoleSource> >&, const std::vector< std::shared_ptr<FieldPoints> >& )
+             */
+            MatrixXcr CalculateSoundings( std::shared_ptr<LayeredEarthEM> base,
+                    const MatrixXcr& conductivity, const MatrixXr& thickness,
+                    const std::vector< std::shared_ptr<DipoleSource> >& sources,
+                    const std::vector< std::shared_ptr<FieldPoints> >& receivers );
+
             // ====================  ACCESS        ===========================
 
             /** Attaches an antennae */
             void AttachWireAntenna( std::shared_ptr<WireAntenna> antennae );
 
+            /** Attaches a circular loop */
+            void AttachCircularLoop( std::shared_ptr<CircularLoop> loop );
+
             /** Attaches a dipole for calculation */
             void AttachDipoleSource( std::shared_ptr<DipoleSource> dipole );
 
@@ -126,6 +263,46 @@ namespace Lemma {
              */
             void SetHankelTransformMethod( const HANKELTRANSFORMTYPE &type );
 
+            /** Sets the relative tolerance of the related kernels used by FHTAUTO to choose
+             *  a filter, defaults to 1e-6. The choices made so far are cleared.
+             *  @see FHTAuto::SetTolerance
+             */
+            void SetHankelTransformTolerance( const Real& tol );
+
+            /**
+             *  When enabled, horizontally planar PolygonalWireAntenna calculations group the
+             *  receivers by height and compute a single lagged convolution per
+             *  height and frequency, covering the horizontal offset of every
+             *  receiver--dipole pair in that group. The kernels only depend on frequency,
+             *  source and receiver height, so this is exact up to the interpolation of the
+             *  lagged arguments. Only used with the digital filter Hankel transforms.
+             *  Default is false.
+             *  @param[in] share set to true to share lagged convolutions across receivers
+             */
+            void SetShareLaggedConvolution( const bool& share );
+
+            /**
+             *  When enabled, closed and horizontally planar PolygonalWireAntenna calculations
+             *  in the air evaluate the fields of the loop as integrals along the wire, rather than
+             *  approximating the wire with dipoles. This needs a few quadrature nodes per segment
+             *  and a single lagged convolution per receiver and frequency, instead of a chain of
+             *  dipoles that grows as receivers approach the wire. Other antennae use the dipole
+             *  approximation. Default is false.
+             *  @param[in] line set to true to evaluate closed loops as line integrals
+             *  @see PolygonalWireAntenna::ApproximateWithLineIntegral
+             */
+            void SetLineIntegralEvaluation( const bool& line );
+
+            /**
+             *  Sets the number of threads used by the calculations of this object. Set it to 1
+             *  when the object is itself used by one thread of a parallel region, for instance
+             *  one calculator per sounding, so that it neither opens nested teams nor keeps
+             *  per-thread copies it does not need. Has no effect without OpenMP.
+             *  @param[in] nthreads is the number of threads, 0 (the default) uses
+             *             omp_get_max_threads()
+             */
+            void SetNumberOfThreads( const int& nthreads );
+
             /**
              *   Accesor for field points
              */
@@ -155,10 +332,46 @@ namespace Lemma {
                 return Mode;
             }
 
+            /**
+             *  @return the FHTAUTO transform shared by the threads of every calculation, which
+             *          keeps the filter chosen for each regime and the statistics of the
+             *          choices. This is nullptr unless FHTAUTO has been set.
+             */
+            inline std::shared_ptr<FHTAuto> GetAutoHankelTransform() const {
+                return AutoHankel;
+            }
+
+            /**
+             *  @return true if lagged convolutions are shared across receivers of
+             *          the same height
+             *  @see SetShareLaggedConvolution
+             */
+            inline bool GetShareLaggedConvolution() const {
+                return ShareLaggedConvolution;
+            }
+
+            /**
+             *  @return true if closed loops are evaluated as line integrals
+             *  @see SetLineIntegralEvaluation
+             */
+            inline bool GetLineIntegralEvaluation() const {
+                return LineIntegralEvaluation;
+            }
+
+            /**
+             *  @return the number of threads the calculations use
+             *  @see SetNumberOfThreads
+             */
+            int GetNumberOfThreads() const;
+
         protected:
 
             // ====================  OPERATIONS    ===========================
 
+            /** @return a new transform of HankelType, FHTAUTO transforms share AutoHankel
+             */
+            std::shared_ptr<HankelTransform> NewHankelTransform();
+
             /** Used internally, this is the innermost loop of the MakeCalc3,
              *  and CalculateWireAntennaField routines.
              */
@@ -172,6 +385,22 @@ namespace Lemma {
 //                     const Real &wavef, const int &ifreq,
 //                     std::shared_ptr<DipoleSource> tDipole);
 
+            /** Used internally, solves one tile of CalculateWireAntennaFields. The antenna is
+             *  approximated for receiver irec, and the fields of dipoles idip0 to idip1-1 are
+             *  computed for frequencies ifreq0 to ifreq1-1.
+             *  @param[in] Rx are the receivers the fields are appended to
+             *  @param[in] irec is the receiver index in Rx
+             *  @param[in] ifreq0 is the first frequency index
+             *  @param[in] ifreq1 is one past the last frequency index
+             *  @param[in] idip0 is the first dipole index
+             *  @param[in] idip1 is one past the last dipole index
+             *  @param[in] Hankel is the worker's Hankel transform
+             *  @param[in] antenna is the worker's copy of the antenna
+             */
+            void SolveWireAntennaTile(const std::shared_ptr<FieldPoints>& Rx, const int &irec,
+                    const int& ifreq0, const int& ifreq1, const int& idip0, const int& idip1,
+                    HankelTransform* Hankel, PolygonalWireAntenna* antenna);
+
             /** Used internally, this is the innermost loop of the MakeCalc3,
              *  and CalculateWireAntennaField routines.
              */
@@ -179,6 +408,76 @@ namespace Lemma {
                     const Real &wavef, const int &ifreq,
                     PolygonalWireAntenna* antenna);
 
+            /** Used internally, evaluates the fields of a closed loop at receiver irec as
+             *  integrals along the wire.
+             *  @see SetLineIntegralEvaluation
+             */
+            void SolveLineIntegralTxRxPair(const int &irec, HankelTransform* Hankel,
+                    const int &ifreq, PolygonalWireAntenna* antenna);
+
+            /** Used internally, computes a lagged convolution shared by all receivers at the
+             *  height of receiver irec, valid for horizontal offsets between rhomin and rhomax.
+             *  @param[in] irec is a representative receiver of the group
+             *  @param[in] rhomin is the smallest offset in the group
+             *  @param[in] rhomax is the largest offset in the group
+             *  @param[in] Hankel is the Hankel transform which stores the result, it is
+             *             copied to other transforms with HankelTransform::CopyLaggedRelated
+             *  @param[in] ifreq is the frequency index
+             *  @param[in] antenna is a thread local copy of the antenna
+             */
+            void ComputeSharedLaggedPlane(const int &irec,
+                    const Real& rhomin, const Real& rhomax,
+                    HankelTransform* Hankel, const int &ifreq,
+                    PolygonalWireAntenna* antenna);
+
+            /** Used internally, sets up the kernels of the antenna's dipole set source for
+             *  a lagged convolution shared by the receivers at the height of receiver irec.
+             *  @param[in] irec is a representative receiver of the group
+             *  @param[in] ifreq is the frequency index
+             *  @param[in] antenna is a thread local copy of the antenna
+             *  @return the dipole, which is passed to SolveSharedLaggedTxRxPair
+             */
+            std::shared_ptr<DipoleSource> PrepareSharedLaggedSource(const int &irec,
+                    const int &ifreq, PolygonalWireAntenna* antenna);
+
+            /** Used internally, evaluates the fields at receiver irec from a lagged convolution
+             *  computed by ComputeSharedLaggedPlane and copied into Hankel.
+             */
+            void SolveSharedLaggedTxRxPair(const int &irec, HankelTransform* Hankel,
+                    const Real &wavef, const int &ifreq,
+                    PolygonalWireAntenna* antenna, DipoleSource* tDipole);
+
+            /** Used internally, throws UnsupportedLoopSource if src is a loop source that
+             *  cannot be computed in earth with the current Hankel transform.
+             */
+            void CheckLoopSource( DipoleSource* src, LayeredEarthEM* earth ) const;
+
+            /** Used internally, checks the sources and receivers of nsnd soundings and
+             *  computes them. SetEarth(isnd, Model, Earth) makes Earth, the thread's copy of
+             *  the model, hold the model of sounding isnd. Model is the thread's last input
+             *  model, which lets the copy be kept while the input does not change.
+             */
+            template <typename EarthSetter>
+            MatrixXcr SolveSoundings( const int& nsnd, EarthSetter SetEarth,
+                    const std::vector< std::shared_ptr<DipoleSource> >& sources,
+                    const std::vector< std::shared_ptr<FieldPoints> >& receivers );
+
+            /** Used internally, computes CalculateModels from the models evaluated at each
+             *  frequency of the attached source.
+             *  @param[in] Reference is one of the models, which sets up the kernels
+             *  @param[in] Models are the models evaluated at each frequency
+             */
+            MatrixXcr SolveModels( std::shared_ptr<LayeredEarthEM> Reference,
+                    const std::vector<EvaluatedModelsEM>& Models );
+
+            /** Bounds the horizontal distance between a receiver and any dipole
+             *  that approximates the antenna.
+             *  @param[in] irec is the receiver index
+             *  @param[out] rhomin is the smallest possible offset
+             *  @param[out] rhomax is the largest possible offset
+             */
+            void LaggedOffsetBounds(const int& irec, Real& rhomin, Real& rhomax);
+
             // ====================  DATA MEMBERS  ===========================
 
             /** Computes field due to dipole */
@@ -193,6 +492,9 @@ namespace Lemma {
             /** Wire antennae tx */
             std::shared_ptr<WireAntenna>         Antenna;
 
+            /** Circular loop tx */
+            std::shared_ptr<CircularLoop>        Loop;
+
             /** What fields are wanted */
             FIELDCALCULATIONS    FieldsToCalculate;
 
@@ -201,6 +503,11 @@ namespace Lemma {
              */
             HANKELTRANSFORMTYPE  HankelType;
 
+            /** Transform whose choices and statistics are shared by the FHTAUTO
+             *  transforms of every calculation
+             */
+            std::shared_ptr<FHTAuto> AutoHankel = nullptr;
+
             /** Counter for number of caclulations made
              */
             int icalcinner;
@@ -215,6 +522,38 @@ namespace Lemma {
              */
             TXRXMODE       Mode = NOMODE;
 
+            /** Whether lagged convolutions are shared across receivers of the same height
+             */
+            bool           ShareLaggedConvolution = false;
+
+            /** Whether closed loops are evaluated as line integrals
+             */
+            bool           LineIntegralEvaluation = false;
+
+            /** Number of threads of the calculations, 0 uses omp_get_max_threads()
+             */
+            int            NumberOfThreads = 0;
+
+            /** Per thread copies of the source, with their kernels, kept by MakeIncrementalCalc
+             */
+            std::vector< std::shared_ptr<DipoleSource> >     IncrementalDipoles;
+
+            /** Per thread transforms kept by MakeIncrementalCalc
+             */
+            std::vector< std::shared_ptr<HankelTransform> >  IncrementalHankels;
+
+            /** Source the kept copies were made from
+             */
+            std::shared_ptr<DipoleSource>                    IncrementalSource = nullptr;
+
+            /** Transform type of the kept transforms
+             */
+            HANKELTRANSFORMTYPE                              IncrementalHankelType = ANDERSON801;
+
+            /** Number of models whose layer recursion runs together in CalculateModels
+             */
+            static constexpr int ModelBlock = 256;
+
             /** ASCII string representation of the class name */
             static constexpr auto CName = "EMEarth1D";
 
@@ -248,6 +587,44 @@ namespace Lemma {
             public: NullInstrument(LemmaObject* ptr);
     };
 
+    /** If a CircularLoop is NULL valued, throw this error.
+     */
+    class NullCircularLoop : public std::runtime_error {
+            /** Thrown when a circular loop pointer is NULL
+             */
+            public: NullCircularLoop();
+    };
+
+    /** If a loop source is buried, or used with a Hankel transform that
+     *  cannot apply the loop kernel, throw this.
+     */
+    class UnsupportedLoopSource : public std::runtime_error {
+            /** Thrown when a loop source cannot be evaluated
+             *  @param[in] reason describes the unsupported configuration
+             */
+            public: UnsupportedLoopSource(const std::string& reason);
+    };
+
+    /** If sensitivities are requested of a configuration that
+     *  EMEarth1D::CalculateSensitivities does not differentiate, throw this.
+     */
+    class UnsupportedSensitivities : public std::runtime_error {
+            /** Thrown when the sensitivities cannot be calculated
+             *  @param[in] reason describes the unsupported configuration
+             */
+            public: UnsupportedSensitivities(const std::string& reason);
+    };
+
+    /** If EMEarth1D::CalculateModels is called with a configuration it cannot
+     *  batch, throw this.
+     */
+    class UnsupportedModelBatch : public std::runtime_error {
+            /** Thrown when the models cannot be calculated together
+             *  @param[in] reason describes the unsupported configuration
+             */
+            public: UnsupportedModelBatch(const std::string& reason);
+    };
+
     /** If a dipole source is specified, but a method calling a wire antenna is
      * called, throw this.
      */
@@ -21,10 +21,69 @@
 
 #pragma once
 #include "HankelTransform.h"
-#include "CubicSplineInterpolator.h"
 
 namespace Lemma {
 
+    /**
+     *  @return the number of coefficients of the digital filter of Type, or Eigen::Dynamic if
+     *          Type is not a filter of FHT
+     */
+    constexpr int FHTFilterLength( const HANKELTRANSFORMTYPE Type ) {
+        switch (Type) {
+            case FHTKEY51:
+                return 51;
+            case FHTKONG61:
+                return 61;
+            case FHTKEY101:
+                return 101;
+            case FHTKONG121:
+                return 121;
+            case FHTKEY201:
+                return 201;
+            case FHTKONG241:
+                return 241;
+            case IRONS:
+                return 961;
+            default:
+                return Eigen::Dynamic;
+        }
+    }
+
+    /**
+     *  @return the J0 and J1 weights of a digital filter, each repeated for the real and
+     *          imaginary part of a kernel value, @see FilterConvolve
+     *  @param[in] WT are the abscissa, J0 and J1 weights of the filter
+     */
+    template < int N >
+    Eigen::Matrix<Real, 2*N, 2> InterleaveFilterWeights( const Eigen::Matrix<Real, N, 3>& WT ) {
+        Eigen::Matrix<Real, 2*N, 2> WTRI;
+        for (int i=0; i<N; ++i) {
+            WTRI.row(2*i)   = WT.row(i).template tail<2>();
+            WTRI.row(2*i+1) = WT.row(i).template tail<2>();
+        }
+        return WTRI;
+    }
+
+    /**
+     *  @return the convolution of the N weights of a digital filter with N kernel values
+     *  @param[in] Z are the kernel values
+     *  @param[in] WTRI is a column of InterleaveFilterWeights
+     */
+    template < int N >
+    inline Complex FilterConvolve( const Complex* Z, const Real* WTRI ) {
+        // The kernel values are read as reals, four to a column of eight, so that the products
+        // are vectorised and summed in eight independent partial sums
+        constexpr int N4 = N/4;
+        const Eigen::Map< const Eigen::Matrix<Real, 8, N4> > Z4( reinterpret_cast<const Real*>(Z) );
+        const Eigen::Map< const Eigen::Matrix<Real, 8, N4> > W4( WTRI );
+        const Eigen::Matrix<Real, 8, 1> part = Z4.cwiseProduct(W4).rowwise().sum();
+        Complex conv( (part(0)+part(2)) + (part(4)+part(6)), (part(1)+part(3)) + (part(5)+part(7)) );
+        for (int i=4*N4; i<N; ++i) {
+            conv += Z[i]*WTRI[2*i];
+        }
+        return conv;
+    }
+
     /**
       \ingroup FDEM1D
       \brief   Impliments lagged and related fast Hankel transform through
@@ -35,6 +94,9 @@ namespace Lemma {
                This approach performs a complete sweep of the
                coefficients , for a variant that uses a longer filter which may
                be truncated, see FHTAnderson801.
+               The length of each filter is known at compile time, the weights and
+               the kernel values of a related evaluation are stored with fixed rows so
+               that the convolutions are unrolled and vectorised.
                @see FHTAnderson801
                @see GQChave
                @see QWEKey
@@ -115,18 +177,37 @@ namespace Lemma {
 
         void ComputeLaggedRelated(const Real& rho, const int& nlag, std::shared_ptr<KernelEM1DManager> KernelManager);
 
+        bool PrepareModelRelated(const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager);
+
+        void ComputeModelRelated(std::shared_ptr<KernelEM1DManager> KernelManager,
+                const EvaluatedModelsEM& Models, const int& imod, const int& nmod,
+                Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& Z);
+
         // ====================  ACCESS        =======================
 
         /**
-         *  @param[in] rho is the argument for lagged convolution evaluation from the
-         *             spline after calculation.
+         *  @param[in] rho is the argument for lagged convolution evaluation, all related
+         *             kernels are interpolated from the lagged table in one pass.
          */
         void SetLaggedArg(const Real& rho) {
-            for (int i=0; i<Zans.cols(); ++ i) {
-                Zans(0, i) = Complex( splineVecReal[i]->Interpolate(rho),
-                                      splineVecImag[i]->Interpolate(rho) );
+            InterpolateLagged(rho, Zans);
+        }
+
+        /**
+         *  @param[in] Source is an FHT of the same type holding lagged convolutions
+         */
+        void CopyLaggedRelated(const HankelTransform& Source) {
+            CopyLaggedTable(Source);
+            if (Zans.rows() < 1 || Zans.cols() != LaggedTable.cols()) {
+                Zans.setZero(1, LaggedTable.cols());
             }
-            return ;
+        }
+
+        /**
+         *  @param[in] Z are the related kernels returned by Zgauss
+         */
+        void SetRelated(const VectorXcr& Z) {
+            Zans = Z.transpose();
         }
 
         // ====================  INQUIRY       =======================
@@ -152,18 +233,47 @@ namespace Lemma {
 
         private:
 
-        // Filter Weights, these are specialized for each template type
-		static const Eigen::Matrix<Real, Eigen::Dynamic, 3>  WT;
+        /// Number of filter coefficients
+        static constexpr int NWT = FHTFilterLength(Type);
 
-        /// Spines for lagged convolutions (real part)
-        std::vector <std::shared_ptr<CubicSplineInterpolator> > splineVecReal;
+        /// Filter weights, abscissa, J0 and J1 columns
+        typedef Eigen::Matrix<Real, NWT, 3> FilterWeights;
+
+        // ====================  OPERATIONS    =======================
 
-        /// Spines for lagged convolutions (imaginary part)
-        std::vector < std::shared_ptr<CubicSplineInterpolator> > splineVecImag;
+        /// @return the interleaved filter weights, @see InterleaveFilterWeights
+        static const Eigen::Matrix<Real, 2*NWT, 2>& GetWTRI() {
+            static const Eigen::Matrix<Real, 2*NWT, 2> WTRI = InterleaveFilterWeights<NWT>( WT );
+            return WTRI;
+        }
+
+        // ====================  DATA MEMBERS  =========================
+
+        // Filter Weights, these are specialized for each template type
+		static const FilterWeights  WT;
 
         /// Holds answer, dimensions are NumConv, and NumberRelated.
         Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic> Zans;
 
+        /// Kernel evaluations of a related evaluation, dimensions are filter length, and NumberRelated.
+        Eigen::Matrix<Complex, NWT, Eigen::Dynamic> Zwork;
+
+        /// Kernel evaluations of a lagged evaluation, dimensions are filter length + NumConv, and NumberRelated.
+        Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic> ZworkLagged;
+
+        /// Filter weights times the coefficient of relCon of each kernel, over rho, for the
+        /// related kernels of many models, dimensions are filter length, and NumberRelated.
+        Eigen::Matrix<Complex, NWT, Eigen::Dynamic> ModelWeights;
+
+        /// Related kernels of any model with relCon set to zero, @see PrepareModelRelated
+        VectorXcr ModelOffset;
+
+        /// Kernel arguments of the last evaluation
+        VectorXr lambda;
+
+        /// Lagged arguments of the last evaluation
+        VectorXr Arg;
+
         /** ASCII string representation of the class name */
         //static constexpr auto CName = "FHT";
 
@@ -172,22 +282,22 @@ namespace Lemma {
     // Clang wants forward declarations, MSVC doesn't
 #if defined( __clang__) || defined(__GNUC__) || defined(__GNUG__) || defined(__ICC) || defined(__INTEL_COMPILER)
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKEY201>::WT;
+    const Eigen::Matrix<Real, 201, 3>  FHT<FHTKEY201>::WT;
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKEY101>::WT;
+    const Eigen::Matrix<Real, 101, 3>  FHT<FHTKEY101>::WT;
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKEY51>::WT;
+    const Eigen::Matrix<Real, 51, 3>  FHT<FHTKEY51>::WT;
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKONG61>::WT;
+    const Eigen::Matrix<Real, 61, 3>  FHT<FHTKONG61>::WT;
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKONG121>::WT;
+    const Eigen::Matrix<Real, 121, 3>  FHT<FHTKONG121>::WT;
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKONG241>::WT;
+    const Eigen::Matrix<Real, 241, 3>  FHT<FHTKONG241>::WT;
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<IRONS>::WT;
+    const Eigen::Matrix<Real, 961, 3>  FHT<IRONS>::WT;
     // Clang wants generic declaration
     template < HANKELTRANSFORMTYPE Type >
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT< Type >::WT;
+    const typename FHT< Type >::FilterWeights  FHT< Type >::WT;
 #endif
 
     template < HANKELTRANSFORMTYPE Type >
@@ -230,26 +340,28 @@ namespace Lemma {
     void FHT<Type>::ComputeRelated ( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager ) {
 
         int nrel = (int)(KernelManager->GetSTLVector().size());
-        Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic > Zwork;
-        Zans= Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>::Zero(1, nrel);
-        Zwork.resize(WT.rows(), nrel);
-        VectorXr lambda = WT.col(0).array()/rho;
+        // work arrays are members, these are no-ops once sized
+        Zans.setZero(1, nrel);
+        Zwork.resize(NWT, nrel);
+        lambda = WT.col(0)/rho;
         int NumFun = 0;
-        int idx = 0;
 
         // Get Kernel values
-        for (int ir=0; ir<lambda.size(); ++ir) {
-            // irelated loop
-            ++NumFun;
-            KernelManager->ComputeReflectionCoeffs(lambda(ir), idx, rho);
-            for (int ir2=0; ir2<nrel; ++ir2) {
-                // Zwork* needed due to sign convention of filter weights
- 			    Zwork(ir, ir2) = std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir)));
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeRelatedKernels(Zwork)) {
+            for (int ir=0; ir<NWT; ++ir) {
+                // irelated loop
+                ++NumFun;
+                KernelManager->SelectLambda(ir);
+                for (int ir2=0; ir2<nrel; ++ir2) {
+                    Zwork(ir, ir2) = KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir));
+                }
             }
         }
 
         for (int ir2=0; ir2<nrel; ++ir2) {
-            Zans(0, ir2) = Zwork.col(ir2).dot(WT.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder() + 1))/rho;
+            Zans(0, ir2) = FilterConvolve<NWT>( Zwork.col(ir2).data(),
+                    GetWTRI().col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()).data() )/rho;
         }
         return ;
     }		// -----  end of method FHT::ComputeRelated  -----
@@ -264,60 +376,102 @@ namespace Lemma {
 
         int nrel = (int)(KernelManager->GetSTLVector().size());
 
-        Eigen::Matrix< Complex, Eigen::Dynamic, Eigen::Dynamic > Zwork;
-        Zans= Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>::Zero(nlag, nrel);
-        Zwork.resize(WT.rows()+nlag, nrel);  // Zwork needs to be expanded to filter length + nlag
+        Zans.setZero(nlag, nrel);
+        ZworkLagged.resize(NWT+nlag, nrel);  // ZworkLagged needs to be expanded to filter length + nlag
 
         // lambda needs to be expanded to include lagged results
-        VectorXr lambda = (VectorXr(WT.rows()+nlag) << WT.col(0).array()/rho, VectorXr::Zero(nlag)).finished();
-        for (Index ilam = WT.rows(); ilam< nlag+WT.rows(); ++ilam) {
+        lambda.resize(NWT+nlag);
+        lambda.head<NWT>() = WT.col(0)/rho;
+        for (Index ilam = NWT; ilam< nlag+NWT; ++ilam) {
             lambda(ilam) = lambda(ilam-1)/GetABSER();
         }
 
         int NumFun = 0;
-        int idx = 0;
 
-        VectorXr Arg(nlag);
+        Arg.resize(nlag);
         Arg(nlag-1) = rho;
         for (int ilag=nlag-2; ilag>=0; --ilag) {
             Arg(ilag) = Arg(ilag+1) * GetABSER();
         }
 
         // Get Kernel values
-        for (int ir=0; ir<lambda.size(); ++ir) {
-            // irelated loop
-            ++NumFun;
-            KernelManager->ComputeReflectionCoeffs(lambda(ir), idx, rho);
-            for (int ir2=0; ir2<nrel; ++ir2) {
- 			    Zwork(ir, ir2) = std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir)));
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeRelatedKernels(ZworkLagged)) {
+            for (int ir=0; ir<lambda.size(); ++ir) {
+                // irelated loop
+                ++NumFun;
+                KernelManager->SelectLambda(ir);
+                for (int ir2=0; ir2<nrel; ++ir2) {
+                    ZworkLagged(ir, ir2) = KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir));
+                }
             }
         }
 
         // Inner product and scale
-        int ilagr = nlag-1; // Zwork is in opposite order from Arg
-        for (int ilag=0; ilag<nlag; ++ilag) {
-            for (int ir2=0; ir2<nrel; ++ir2) {
-                Zans(ilagr, ir2) = Zwork.col(ir2).segment(ilag,WT.rows()).dot( WT.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()+1) ) / Arg(ilagr);
+        for (int ir2=0; ir2<nrel; ++ir2) {
+            const Real* WTRI = GetWTRI().col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()).data();
+            int ilagr = nlag-1; // ZworkLagged is in opposite order from Arg
+            for (int ilag=0; ilag<nlag; ++ilag) {
+                Zans(ilagr, ir2) = FilterConvolve<NWT>( ZworkLagged.col(ir2).data()+ilag, WTRI ) / Arg(ilagr);
+                ilagr -= 1;
             }
-            ilagr -= 1;
         }
 
-        // make sure vectors are empty
-        splineVecReal.clear();
-        splineVecImag.clear();
+        // Arg is an exact geometric grid, so no spline is needed
+        SetLaggedTable( Arg, Zans );
+        return ;
+    }		// -----  end of method FHT::ComputeLaggedRelated  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHT
+    //      Method:  PrepareModelRelated
+    //--------------------------------------------------------------------------------------
+    template < HANKELTRANSFORMTYPE Type >
+    bool FHT<Type>::PrepareModelRelated ( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager ) {
+
+        int nrel = (int)(KernelManager->GetSTLVector().size());
+        // work arrays are members, these are no-ops once sized
+        Zans.setZero(1, nrel);
+        Zwork.resize(NWT, nrel);
+        ModelWeights.resize(NWT, nrel);
+        ModelOffset.resize(nrel);
+        lambda = WT.col(0)/rho;
+
+        // Each kernel is its coefficient of relCon times relCon, which is all that depends on
+        // the model, plus the rest, so the convolution of the rest is shared by every model
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeAffineKernels(ModelWeights, Zwork)) {
+            return false;
+        }
+
+        for (int ir2=0; ir2<nrel; ++ir2) {
+            const int order = KernelManager->GetSTLVector()[ir2]->GetBesselOrder();
+            ModelOffset(ir2) = FilterConvolve<NWT>( Zwork.col(ir2).data(), GetWTRI().col(order).data() )/rho;
+            ModelWeights.col(ir2).array() *= WT.col(1+order).array()/rho;
+        }
+        return true;
+    }		// -----  end of method FHT::PrepareModelRelated  -----
 
-        // Now do cubic spline
-        for (int ii=0; ii<Zans.cols(); ++ii) {
-            auto SplineR = CubicSplineInterpolator::NewSP();
-            SplineR->SetKnots( Arg, Zans.col(ii).real() );
-            splineVecReal.push_back(SplineR);
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHT
+    //      Method:  ComputeModelRelated
+    //--------------------------------------------------------------------------------------
+    template < HANKELTRANSFORMTYPE Type >
+    void FHT<Type>::ComputeModelRelated ( std::shared_ptr<KernelEM1DManager> KernelManager,
+            const EvaluatedModelsEM& Models, const int& imod, const int& nmod,
+            Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& Z ) {
 
-            auto SplineI = CubicSplineInterpolator::NewSP();
-            SplineI->SetKnots( Arg, Zans.col(ii).imag() );
-            splineVecImag.push_back(SplineI);
+        int nrel = (int)(KernelManager->GetSTLVector().size());
+        KernelManager->ComputeModelReflectionCoeffs(lambda, Models, imod, nmod);
+
+        // The convolutions of all models are one matrix product per kernel
+        Z.resize(nmod, nrel);
+        for (int ir2=0; ir2<nrel; ++ir2) {
+            Z.col(ir2).noalias() = KernelManager->GetModelRelCon(ir2) * ModelWeights.col(ir2);
+            Z.col(ir2).array() += ModelOffset(ir2);
         }
         return ;
-    }		// -----  end of method FHT::ComputeLaggedRelated  -----
+    }		// -----  end of method FHT::ComputeModelRelated  -----
 
 }  // -----  end of namespace Lemma ----
 
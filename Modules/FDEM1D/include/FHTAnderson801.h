@@ -16,7 +16,6 @@
 
 #include "KernelEM1DBase.h"
 #include "KernelEM1DSpec.h"
-#include "CubicSplineInterpolator.h"
 #include "HankelTransform.h"
 
 namespace Lemma {
@@ -133,6 +132,9 @@ class FHTAnderson801 : public HankelTransform {
         /// Sets the lagged kernel index so that the proper value is returned
         void SetLaggedArg(const Real& rho);
 
+        /// Copies the lagged convolutions of another FHTAnderson801
+        void CopyLaggedRelated(const HankelTransform& Source);
+
         // ====================  INQUIRY       ==============================
 
         /// Calculates Hankel Transform using filtering.
@@ -178,10 +180,6 @@ class FHTAnderson801 : public HankelTransform {
 		    return;
 	    }
 
-        // ====================  OPERATIONS    ==============================
-
-        void DeleteSplines();
-
         // ====================  DATA MEMBERS  ==============================
 
         /// The hankel transform wavenumber embedded in the integral
@@ -228,12 +226,6 @@ class FHTAnderson801 : public HankelTransform {
         /// Kernel Calculator
         std::vector < std::shared_ptr<KernelEM1DBase> > kernelVec;
 
-        /// Spines for lagged convolutions (real part)
-        std::vector <std::shared_ptr<CubicSplineInterpolator> > splineVecReal;
-
-        /// Spines for lagged convolutions (imaginary part)
-        std::vector < std::shared_ptr<CubicSplineInterpolator> > splineVecImag;
-
         /// Key used internally
         Eigen::Matrix<int, 801, 1> Key;
         //int  Key[801];
@@ -256,6 +248,10 @@ class FHTAnderson801 : public HankelTransform {
         /// Holds the arguments for lagged convolutions
         VectorXr Arg;
 
+        /// Lambda values of filter weights 298 to 338, which are always evaluated by the first
+        /// convolution and are therefore computed as a single batch
+        VectorXr WindowLambda;
+
         /** ASCII string representation of the class name */
         static constexpr auto CName = "FHTAnderson801";
 
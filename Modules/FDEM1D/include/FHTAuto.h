@@ -0,0 +1,225 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026 10:12:31 AM
+ * @author    Trevor Irons (ti)
+ * @email     Trevor.Irons@lemmasoftware.org
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#ifndef  FHTAUTO_INC
+#define  FHTAUTO_INC
+
+#pragma once
+#include <array>
+#include <map>
+#include <vector>
+#include "HankelTransform.h"
+
+namespace Lemma {
+
+    /**
+      \ingroup FDEM1D
+      \brief   Fast Hankel transform choosing the cheapest digital filter that meets a tolerance.
+      \details The filters are tried in order FHTKEY51, FHTKEY101, FHTKEY201 and ANDERSON801.
+               The error of a filter is estimated by the relative difference of every related
+               kernel from the next filter in the chain. The first time a regime is seen the
+               chain is walked until the estimate falls below the tolerance, and the filter found
+               is used for every evaluation in that regime. A regime is the kernel configuration,
+               frequency, heights of source and receiver, number of layers, offset and skin depth
+               of the top layer of the earth. The offset and skin depth are binned on a
+               logarithmic scale, eight bins per decade, so that nearby offsets and slightly
+               different models share a choice. The sample is taken at the centre of the offset
+               bin, with the model of the first evaluation in the regime. At most MaxChoices
+               regimes are kept, the choices are forgotten when the limit is reached. Transforms
+               made by Share use the same choices and statistics, which are safe to update from
+               several threads.
+               Lagged convolutions use the finer of the choices at either end of the lagged
+               arguments.
+               @see FHT
+               @see FHTAnderson801
+     */
+    class FHTAuto : public HankelTransform {
+
+        friend std::ostream &operator<<(std::ostream &stream, const FHTAuto &ob);
+
+        public:
+
+        // ====================  LIFECYCLE     =======================
+
+        /** Default locked constructor, use NewSP */
+        explicit FHTAuto ( const ctor_key& );
+
+        /** DeSerializing locked constructor, use DeSerialize */
+        FHTAuto ( const YAML::Node& node, const ctor_key& );
+
+        /** Default destructor */
+        ~FHTAuto ();
+
+        /**
+         *  Factory method for generating objects.
+         *  @return std::shared_ptr<FHTAuto>
+         */
+        static std::shared_ptr<FHTAuto> NewSP();
+
+        /**
+         *  Returns a new transform sharing the tolerance, choices and statistics of this
+         *  one, so that each thread of a calculation can have its own.
+         *  @return std::shared_ptr<FHTAuto>
+         */
+        std::shared_ptr<FHTAuto> Share();
+
+        /** YAML Serializing method, the statistics are included
+         */
+        YAML::Node Serialize() const;
+
+        /**
+         *   Constructs an object from a YAML::Node.
+         */
+        static std::shared_ptr< FHTAuto > DeSerialize(const YAML::Node& node);
+
+        // ====================  OPERATORS     =======================
+
+        // ====================  OPERATIONS    =======================
+
+        Complex Zgauss(const int &ikk, const EMMODE &imode,
+                            const int &itype, const Real &rho,
+                            const Real &wavef, KernelEM1DBase* Kernel);
+
+        using HankelTransform::ComputeRelated;
+
+        /** Computes the related kernels with the filter chosen for the regime of rho and
+         *  the kernels of KernelManager, sampling the regime if it has not been seen.
+         */
+        void ComputeRelated(const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager);
+
+        /** Computes the lagged convolutions with the finer of the filters chosen at rhomax and
+         *  at the smallest argument, nlag is counted with the spacing of GetABSER and is
+         *  converted to the spacing of the chosen filter.
+         */
+        void ComputeLaggedRelated(const Real& rhomax, const int& nlag,
+                std::shared_ptr<KernelEM1DManager> KernelManager);
+
+        /** Forgets the choice of every regime and zeros the statistics */
+        void ClearChoices();
+
+        /** Zeros the statistics, the choices are kept */
+        void ResetStatistics();
+
+        // ====================  ACCESS        =======================
+
+        /** Sets the relative tolerance of the related kernels, defaults to 1e-6. As the
+         *  choices depend on it they are cleared.
+         */
+        void SetTolerance( const Real& tol );
+
+        void SetLaggedArg( const Real& rho );
+
+        /** Copies the lagged convolutions of an FHTAuto, with the filter it chose */
+        void CopyLaggedRelated( const HankelTransform& Source );
+
+        // ====================  INQUIRY       =======================
+
+        /** @return the relative tolerance */
+        Real GetTolerance() const;
+
+        /** @return the number of regimes that were sampled */
+        int GetNumberOfSamples() const;
+
+        /** @return the number of evaluations computed with the filter type, which is one of
+         *          FHTKEY51, FHTKEY101, FHTKEY201 or ANDERSON801
+         */
+        int GetNumberOfEvaluations( const HANKELTRANSFORMTYPE& type ) const;
+
+        /** @return the number of regimes kept that chose the filter type */
+        int GetNumberOfChoices( const HANKELTRANSFORMTYPE& type ) const;
+
+        /** @return the spacing of FHTKEY201, used to count the lagged arguments */
+        Real GetABSER();
+
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual inline std::string GetName() const {
+            return CName;
+        }
+
+        protected:
+
+        // ====================  DATA MEMBERS  =========================
+
+        /** Number of filters in the chain */
+        static constexpr int NFILT = 4;
+
+        /** Number of regimes kept before the choices are forgotten */
+        static constexpr int MaxChoices = 4096;
+
+        /** Regime of an evaluation, its parameters with the offset and skin depth binned
+         *  logarithmically
+         */
+        typedef std::vector<Real> Regime;
+
+        /** State shared by the transforms made with Share */
+        struct Selection {
+            Real                          Tolerance = 1e-6;
+            std::map<Regime, int>         Choices;
+            int                           Samples = 0;
+            std::array<int, NFILT>        Evaluations = {{0, 0, 0, 0}};
+        };
+
+        private:
+
+        // ====================  OPERATIONS    =======================
+
+        /** @return the regime of an evaluation at rho with the kernels of KernelManager */
+        Regime GetRegime( const Real& rho, KernelEM1DManager* KernelManager ) const;
+
+        /** Looks up the filter chosen for the regime of rho, sampling the regime if it has
+         *  not been seen
+         *  @return the index of the chosen filter
+         */
+        int Choose( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager );
+
+        /** Walks the filter chain at rho until the error estimate meets the tolerance
+         *  @return the index of the chosen filter
+         */
+        int Sample( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager );
+
+        /** Copies the related kernels of the last evaluation of filter ifilt into Z */
+        void GetRelated( const int& ifilt, KernelEM1DManager* KernelManager, VectorXcr& Z );
+
+        /** @return the index of type in the filter chain */
+        int FilterIndex( const HANKELTRANSFORMTYPE& type ) const;
+
+        // ====================  DATA MEMBERS  =========================
+
+        /** The filter chain, cheapest first */
+        static const std::array<HANKELTRANSFORMTYPE, NFILT>     Types;
+
+        /** Transforms of the filter chain */
+        std::array<std::shared_ptr<HankelTransform>, NFILT>    Filters;
+
+        /** Transform holding the result of the last evaluation */
+        HankelTransform*                                       Chosen;
+
+        /** Choices and statistics, shared with the transforms made by Share */
+        std::shared_ptr<Selection>                             Shared;
+
+        /** Related kernels of the coarser and finer filters of a sample */
+        VectorXcr                                              Zcoarse;
+        VectorXcr                                              Zfine;
+
+        /** ASCII string representation of the class name */
+        static constexpr auto CName = "FHTAuto";
+
+    }; // -----  end of class  FHTAuto  -----
+
+}		// -----  end of Lemma  name  -----
+
+#endif   // ----- #ifndef FHTAUTO_INC  -----
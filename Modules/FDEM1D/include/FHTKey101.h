@@ -98,9 +98,18 @@ namespace Lemma {
         // Shared Filter Weights
 		static const Eigen::Matrix<Real, 101, 3>  WT101;
 
+        /// Filter weights interleaved for the real and imaginary parts of the kernels
+		static const Eigen::Matrix<Real, 202, 2>  WT101RI;
+
         /// Holds answer, dimensions are NumConv, and NumberRelated.
         Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic> Zans;
 
+        /// Kernel evaluations of the related calculation, kept to avoid reallocation
+        Eigen::Matrix<Complex, 101, Eigen::Dynamic> Zwork;
+
+        /// Kernel arguments of the related calculation
+        VectorXr lambda;
+
         /** ASCII string representation of the class name */
         static constexpr auto CName = "FHTKey101";
 
@@ -108,6 +108,9 @@ namespace Lemma {
         // Shared Filter Weights
 		static const Eigen::Matrix<Real, 201, 3>  WT201;
 
+        /// Filter weights interleaved for the real and imaginary parts of the kernels
+		static const Eigen::Matrix<Real, 402, 2>  WT201RI;
+
         /// Spines for lagged convolutions (real part)
         std::vector <std::shared_ptr<CubicSplineInterpolator> > splineVecReal;
 
@@ -117,6 +120,12 @@ namespace Lemma {
         /// Holds answer, dimensions are NumConv, and NumberRelated.
         Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic> Zans;
 
+        /// Kernel evaluations of the related calculation, kept to avoid reallocation
+        Eigen::Matrix<Complex, 201, Eigen::Dynamic> Zwork;
+
+        /// Kernel arguments of the related calculation
+        VectorXr lambda;
+
         /** ASCII string representation of the class name */
         static constexpr auto CName = "FHTKey201";
 
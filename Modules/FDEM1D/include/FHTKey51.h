@@ -100,9 +100,18 @@ namespace Lemma {
         // Shared Filter Weights
 		static const Eigen::Matrix<Real, 51, 3>  WT51;
 
+        /// Filter weights interleaved for the real and imaginary parts of the kernels
+		static const Eigen::Matrix<Real, 102, 2>  WT51RI;
+
         /// Holds answer, dimensions are NumConv, and NumberRelated.
         Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic> Zans;
 
+        /// Kernel evaluations of the related calculation, kept to avoid reallocation
+        Eigen::Matrix<Complex, 51, Eigen::Dynamic> Zwork;
+
+        /// Kernel arguments of the related calculation
+        VectorXr lambda;
+
         /** ASCII string representation of the class name */
         static constexpr auto CName = "FHTKey51";
 
@@ -124,6 +124,11 @@ namespace Lemma {
             /// Returns the number of receiverpoints.
             int GetNumberOfPoints();
 
+            /**
+             *  @return whether appends are made directly, @see SetThreadPrivate
+             */
+            bool GetThreadPrivate();
+
             /// Returns all of the computed E fields. Every frequency
             std::vector<Vector3Xcr> GetEfield( );
 
@@ -197,7 +202,7 @@ namespace Lemma {
             /// Returns the z component of the location
             Real GetLocationZ(const int& loc);
 
-            /// Resets fields
+            /// Resets fields, and discards any per-thread accumulation buffers
             void ClearFields();
 
             /// Sets the mask variable to true for this point.
@@ -212,6 +217,25 @@ namespace Lemma {
             /// Returns the mask for this point
             int GetMask(const int& i);
 
+            /**
+             *  Selects the field components calculated at a point, for instance HZMASK for an
+             *  instrument recording only the vertical magnetic field. Only the kernels and
+             *  projections these need are evaluated, the other components are left zero.
+             *  Defaults to ALLMASK.
+             *  @param[in] i is the index of the point
+             *  @param[in] mask is a combination of FIELDCOMPONENTMASK values
+             */
+            void SetComponents(const int& i, const int& mask);
+
+            /**
+             *  Selects the field components calculated at every point
+             *  @param[in] mask is a combination of FIELDCOMPONENTMASK values
+             */
+            void SetComponents(const int& mask);
+
+            /// Returns the mask of the field components calculated at this point
+            int GetComponents(const int& i);
+
         protected:
 
             // ====================  OPERATIONS    ===========================
@@ -236,16 +260,44 @@ namespace Lemma {
             void SetHfield(const int &nfreq, const int& loc,
                 const Complex &hx, const Complex &hy, const Complex &hz);
 
-            /// Appends the value of the E field. This method is not
-            /// thread safe.
+            /// Appends the value of the E field. Between calls to
+            /// BeginThreadAccumulation and EndThreadAccumulation this is lock free,
+            /// and values are stored in the calling thread's buffer.
             void AppendEfield(const int&nfreq, const int& loc,
                 const Complex &ex, const Complex &ey, const Complex &ez);
 
-            /// Appends the value of the H field. This method is not
-            /// thread safe.
+            /// Appends the value of the H field. Between calls to
+            /// BeginThreadAccumulation and EndThreadAccumulation this is lock free,
+            /// and values are stored in the calling thread's buffer.
             void AppendHfield(const int &nfreq, const int& loc,
                 const Complex &hx, const Complex &hy, const Complex &hz);
 
+            /**
+             *  Starts accumulating appended fields into per-thread buffers. Buffers are
+             *  allocated by each thread on its first append. Must be called outside of
+             *  the parallel region whose threads append, which may itself be nested in
+             *  another region if these points are used by only one of its threads.
+             *  @param[in] nthreads is the maximum number of threads that will append
+             */
+            void BeginThreadAccumulation(const int& nthreads);
+
+            /**
+             *  Sums the per-thread buffers into the fields, in thread order, and releases
+             *  them. For a fixed thread count and static scheduling the result is
+             *  bitwise reproducible. Must be called outside of the parallel region whose
+             *  threads append, as BeginThreadAccumulation.
+             */
+            void EndThreadAccumulation();
+
+            /**
+             *  Marks the points as private to whichever thread uses them, appends are then
+             *  made directly without locking or buffering. This also holds for points
+             *  shared between threads, so long as each point and bin is only ever appended
+             *  by one of them. Default is false.
+             *  @param[in] priv set to true if no point and bin is appended by two threads
+             */
+            void SetThreadPrivate(const bool& priv);
+
             // ====================  DATA MEMBERS  ===========================
 
         private:
@@ -263,6 +315,9 @@ namespace Lemma {
             /// this point.
             VectorXi                    Mask;
 
+            /// Field components calculated at each point, @see SetComponents
+            VectorXi                    Components;
+
             /// Locations of receivers
             Vector3Xr                   Locations;
 
@@ -273,6 +328,15 @@ namespace Lemma {
             /// H field at receiver locations
             std::vector<Vector3Xcr>     Hfield;
 
+            /// Per-thread E field accumulation buffers, indexed by thread then bin
+            std::vector< std::vector<Vector3Xcr> >  EfieldThread;
+
+            /// Per-thread H field accumulation buffers, indexed by thread then bin
+            std::vector< std::vector<Vector3Xcr> >  HfieldThread;
+
+            /// Whether the points are private to one thread, @see SetThreadPrivate
+            bool                        ThreadPrivate = false;
+
             /** ASCII string representation of the class name */
             static constexpr auto CName = "FieldPoints";
 
@@ -78,6 +78,36 @@ namespace Lemma {
 
                 virtual void SetLaggedArg( const Real& rho ) {}
 
+                /** Copies the lagged convolutions of another transform of the same type, after
+                 *  which SetLaggedArg interpolates them without evaluating any kernels.
+                 *  @param[in] Source is a transform of the same type on which
+                 *             ComputeLaggedRelated has been called
+                 */
+                virtual void CopyLaggedRelated( const HankelTransform& ) {}
+
+                /** Prepares the related kernels at an argument rho of many earth models that
+                 *  share the source, receiver and kernels of a kernel manager, which must be
+                 *  in the air, @see ComputeModelRelated
+                 *  @return false if this transform can not evaluate many models at once
+                 */
+                virtual bool PrepareModelRelated( const Real&, std::shared_ptr<KernelEM1DManager> ) {
+                    return false;
+                }
+
+                /** Computes the related kernels of a block of earth models, at the argument of
+                 *  the last PrepareModelRelated call. The arguments are the kernel manager, the
+                 *  models, the first model of the block and its number of models, and the
+                 *  kernels, which get a row per model and a column per related kernel.
+                 */
+                virtual void ComputeModelRelated( std::shared_ptr<KernelEM1DManager>,
+                        const EvaluatedModelsEM&, const int&, const int&,
+                        Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& ) {}
+
+                /** Sets the related kernels returned by Zgauss, one value per related
+                 *  kernel, as if they had been computed
+                 */
+                virtual void SetRelated( const VectorXcr& ) {}
+
                 // ====================  DATA MEMBERS  =======================
 
             protected:
@@ -93,6 +123,48 @@ namespace Lemma {
                 /// Default protected constructor.
                 virtual ~HankelTransform ( );
 
+                // ====================  OPERATIONS    =======================
+
+                /** Stores lagged convolutions for evaluation by InterpolateLagged. The lagged
+                 *  arguments lie on a geometric grid, so interpolation is carried out in the
+                 *  index of log(rho), on \f$ \rho Z \f$ which varies more slowly than Z.
+                 *  @param[in] Arg are the lagged arguments, ascending with a constant ratio
+                 *  @param[in] Z are the lagged convolutions, one row per argument and one
+                 *             column per related kernel
+                 */
+                void SetLaggedTable( const VectorXr& Arg,
+                        const Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& Z );
+
+                /** Copies the table stored by SetLaggedTable of Source.
+                 *  @param[in] Source is the transform holding the table
+                 */
+                void CopyLaggedTable( const HankelTransform& Source );
+
+                /** Interpolates every related kernel at rho from the table stored by
+                 *  SetLaggedTable, using cubic Lagrange weights over the four nearest
+                 *  arguments. The weights are shared by all related kernels. Throws if no
+                 *  table is stored.
+                 *  @param[in] rho is the argument to interpolate at
+                 *  @param[out] Z receives the interpolated kernels in its first row
+                 */
+                void InterpolateLagged( const Real& rho,
+                        Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& Z );
+
+                // ====================  DATA MEMBERS  =======================
+
+                /// Scaled lagged convolutions, one row per lagged argument. Storage is only
+                /// grown, the first nLagged rows are valid.
+                Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> LaggedTable;
+
+                /// Number of lagged arguments in LaggedTable
+                int nLagged = 0;
+
+                /// Logarithm of the smallest lagged argument
+                Real LaggedLogArg0 = 0;
+
+                /// Inverse of the logarithmic spacing of the lagged arguments
+                Real LaggedInvLogStep = 0;
+
             private:
 
                 /** ASCII string representation of the class name */
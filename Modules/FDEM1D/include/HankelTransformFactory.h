@@ -23,6 +23,7 @@
 
 #include "FHTAnderson801.h"
 #include "FHT.h"
+#include "FHTAuto.h"
 
 #include "FHTKey201.h"
 #include "FHTKey101.h"
@@ -117,6 +118,8 @@ namespace Lemma {
                     return QWEKey::NewSP();
                 case IRONS:
                     return FHT<IRONS>::NewSP();
+                case FHTAUTO:
+                    return FHTAuto::NewSP();
                 default:
                     std::cerr << "HankelTransformFactory only works with defined types\n";
                     return FHTAnderson801::NewSP(); // dummy return 
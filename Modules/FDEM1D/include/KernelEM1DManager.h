@@ -91,6 +91,15 @@ namespace Lemma {
 
             void ResetSource(const int& ifreq);
 
+            /** Points the existing kernels at a new source frequency and receiver height,
+             *  re-evaluating the earth properties held by the reflection bases. The kernels
+             *  themselves are kept, so no memory is allocated once the manager is warm.
+             *  @param[in] Dipole is the source
+             *  @param[in] ifreq is the frequency index
+             *  @param[in] rx_zin is the receiver height
+             */
+            void ReSetDipoleSource( DipoleSource* Dipole, const int& ifreq, const Real& rx_zin);
+
             /** For use in related Kernel calculations. This function calles
              * ComputeReflectionCoeffs on TEReflBase and TMReflBase, if they
              * exist. After this has been called, KernelEM1DBase::RelBesselArg() may be safely
@@ -98,9 +107,82 @@ namespace Lemma {
              */
             void ComputeReflectionCoeffs(const Real& lambda, const int& idx, const Real& rho0);
 
+            /** Batched version of ComputeReflectionCoeffs. Calls the batched ComputeReflectionCoeffs
+             *  on TEReflBase and TMReflBase, if they exist, computing the reflection coefficients and
+             *  potential terms of every lambda in the block at once. Afterwards, call SelectLambda
+             *  before KernelEM1DBase::RelBesselArg() for each lambda in the block.
+             *  @param[in] lambda are the lambda arguments of the block
+             */
+            void ComputeReflectionCoeffs(const VectorXr& lambda);
+
+            /** Loads the results of lambda index ilam of the last batched
+             *  ComputeReflectionCoeffs call, after which KernelEM1DBase::RelBesselArg() may
+             *  be safely called.
+             *  @param[in] ilam is the index into the lambda block
+             */
+            void SelectLambda(const int& ilam);
+
+            /** Evaluates every kernel at every lambda of the last batched
+             *  ComputeReflectionCoeffs call in one pass. Row ilam, column ik of Z is set to
+             *  what SelectLambda(ilam) followed by KernelEM1DBase::RelBesselArg of kernel ik
+             *  gives. With the source and receiver in the air the kernels only differ in their
+             *  potential term and power of lambda, which AddKernel records from compile time
+             *  constants of KernelEM1DSpec, so each column is a few vectorised operations over
+             *  the block, with no call per kernel and lambda.
+             *  @param[out] Z has a row per lambda value and a column per kernel
+             *  @return false if the kernels can not be evaluated this way, then Z is untouched
+             *          and SelectLambda and KernelEM1DBase::RelBesselArg must be used
+             */
+            bool ComputeRelatedKernels( Eigen::Ref<MatrixXcr> Z );
+
+            /** Splits every kernel at every lambda of the last batched ComputeReflectionCoeffs
+             *  call into its coefficient of relCon and the rest. With the source and receiver
+             *  in the air each kernel is Zcon relCon + Zrest, where neither Zcon nor Zrest
+             *  depends on the earth below the air.
+             *  @param[out] Zcon is the coefficient of relCon of each lambda value and kernel
+             *  @param[out] Zrest is the kernel with relCon set to zero
+             *  @return false if the kernels can not be split this way, as for
+             *          ComputeRelatedKernels or loop sources, then Zcon and Zrest are undefined
+             */
+            bool ComputeAffineKernels( Eigen::Ref<MatrixXcr> Zcon, Eigen::Ref<MatrixXcr> Zrest );
+
+            /** Computes relCon of models imod to imod+nmod-1 of Models at every lambda value,
+             *  @see KernelEM1DReflBase::ComputeInAirModelRelCon and GetModelRelCon. The models
+             *  must be evaluated at the frequency of the source.
+             *  @param[in] lambda are the lambda values
+             *  @param[in] Models are the earth models
+             *  @param[in] imod is the first model
+             *  @param[in] nmod is the number of models
+             */
+            void ComputeModelReflectionCoeffs( const VectorXr& lambda, const EvaluatedModelsEM& Models,
+                    const int& imod, const int& nmod );
+
+            /** @return relCon of the mode of kernel ik, one row per model of the last
+             *          ComputeModelReflectionCoeffs call and a column per lambda value
+             *  @param[in] ik is the kernel index
+             */
+            const MatrixXcr& GetModelRelCon( const int& ik ) const;
+
+            /** Enables the computation of layer sensitivities with the batched reflection
+             *  coefficients, @see KernelEM1DReflBase::SetComputeSensitivities
+             */
+            void SetComputeSensitivities(const bool& compute);
+
+            /** Selects the sensitivity loaded by SelectLambda, or -1 for the reflection
+             *  coefficients, @see KernelEM1DReflBase::SelectSensitivity
+             */
+            void SelectSensitivity(const int& iparam);
+
+            /** Keeps the layer recursion of each batch of reflection coefficients between
+             *  calls, keyed by slot, @see KernelEM1DReflBase::SetIncrementalRecursion
+             */
+            void SetIncrementalRecursion(const bool& incremental, const int& slot=0);
+
             /** Clears the vector of kernels */
             void ClearVec() {
                 KernelVec.clear();
+                FusedKernels.clear();
+                Fused = true;
             }
 
             // ====================  ACCESS        =======================
@@ -126,7 +208,21 @@ namespace Lemma {
              */
             DipoleSource*                      GetDipole( );
 
-            inline std::vector< std::shared_ptr<KernelEM1DBase> >  GetSTLVector() {
+            /** Returns the frequency index of the connected dipole the kernels are set up for
+             */
+            int                                GetFrequencyIndex( ) const;
+
+            /** Returns the receiver height the kernels are set up for
+             */
+            Real                               GetReceiverHeight( ) const;
+
+            /** Returns the earth model the kernels are evaluated in
+             */
+            std::shared_ptr<LayeredEarthEM>    GetEarth( ) const;
+
+            /** Returns a reference to the kernels, in the order they were added
+             */
+            inline const std::vector< std::shared_ptr<KernelEM1DBase> >&  GetSTLVector() const {
                 return KernelVec;
             }
 
@@ -144,6 +240,26 @@ namespace Lemma {
             /** List of KernelEm1D instances */
             std::vector< std::shared_ptr<KernelEM1DBase> >  KernelVec;
 
+            /** Terms of a kernel with the source and receiver in the air,
+             *  @see KernelEM1DSpec::InAirPotential */
+            struct FusedKernel {
+                EMMODE  Mode;
+                int     Potential;
+                int     LambdaPower;
+            };
+
+            /** Terms of each kernel, in the order they were added */
+            std::vector<FusedKernel>                   FusedKernels;
+
+            /** True while every kernel can be evaluated by ComputeRelatedKernels */
+            bool                                       Fused = true;
+
+            /** relCon plus and minus relenukadz for TE and TM mode, used by ComputeRelatedKernels */
+            VectorXcr                                  FusedCon[2][2];
+
+            /** Loop weight of each lambda value, used by ComputeRelatedKernels */
+            VectorXr                                   FusedWeight;
+
             /** Reflection base used for TE mode */
             std::shared_ptr<KernelEM1DReflBase>        TEReflBase = nullptr;
 
@@ -195,6 +311,13 @@ namespace Lemma {
                 break;
         }
         KernelVec.push_back( std::move(NewKern) );
+        if (Isource == INAIR && Irecv == INAIR) {
+            FusedKernels.push_back( { Mode,
+                KernelEM1DSpec<Mode, Ikernel, Isource, Irecv>::InAirPotential(),
+                KernelEM1DSpec<Mode, Ikernel, Isource, Irecv>::InAirLambdaPower() } );
+        } else {
+            Fused = false;
+        }
         return static_cast<int>(KernelVec.size()-1);
      }
 
@@ -17,6 +17,8 @@
 #include "DipoleSource.h"
 #include "LayeredEarthEM.h"
 
+#include <map>
+
 namespace Lemma {
 
     enum DIPOLE_LOCATION { INAIR, INGROUND };
@@ -66,34 +68,27 @@ namespace Lemma {
 
                 Earth = EarthIn;
 
+                // Layer geometry is set from the evaluated earth in SetUpSource
                 LayerThickness.resize(nlay);
-                for (int ilay=0; ilay<nlay; ++ilay) {
-                    LayerThickness(ilay) =  Earth->GetLayerThickness(ilay);
-                }
-
                 LayerDepth.resize(nlay);
-                for (int ilay=0; ilay<nlay; ++ilay) {
-                    LayerDepth(ilay) =  Earth->GetLayerDepth(ilay);
-                }
 
             }
 
+            /** Sets up the source. The earth properties are taken from the evaluated earth
+             *  at the source frequency, which is shared with other threads and never modified.
+             *  @see LayeredEarthEM::GetEvaluatedEarth
+             */
             void SetUpSource( DipoleSource* Dipole, const int &ifreq ) {
 
-                zh(0) = Complex(0, Dipole->GetAngularFrequency(ifreq)*MU0);
-                yh(0) = Complex(0, Dipole->GetAngularFrequency(ifreq)*EPSILON0);
-                kk(0) = -zh(0) * yh(0);
-
-                Earth->EvaluateColeColeModel(Dipole->GetAngularFrequency(ifreq));
-
-                for (int ilay=1; ilay<Earth->GetNumberOfLayers(); ++ilay) {
-                    zh(ilay) = zh(0) * Earth->GetLayerSusceptibility(ilay);
-                    yh(ilay) = Earth->GetLayerConductivity(ilay) +
-                            yh(0)*Earth->GetLayerPermitivity(ilay);
-                    kk(ilay)   = -zh(ilay)*yh(ilay);
-                }
+                EvaluatedEarth = Earth->GetEvaluatedEarth( Dipole->GetAngularFrequency(ifreq) );
+                zh = EvaluatedEarth->zh;
+                yh = EvaluatedEarth->yh;
+                kk = EvaluatedEarth->kk;
+                LayerThickness = EvaluatedEarth->LayerThickness;
+                LayerDepth = EvaluatedEarth->LayerDepth;
 
                 tx_z = Dipole->GetLocation(2);
+                LoopSource = (Dipole->GetLoopRadius() > 0) ? Dipole : nullptr;
                 lays = 0;
                 Real Depth(0);
                 for (int ilay=1; ilay<nlay; ++ilay) {
@@ -116,7 +111,93 @@ namespace Lemma {
                 }
             }
 
+            /** Loads the reflection coefficients and potential terms of lambda index ilam of
+             *  the last batched ComputeReflectionCoeffs call. Afterwards the related kernels
+             *  may be evaluated exactly as after the per lambda ComputeReflectionCoeffs and
+             *  PreComputePotentialTerms calls. If the specialisation has no batched
+             *  implementation this falls back to those calls.
+             *  @param[in] ilam is the index into the batched lambda values
+             */
+            inline void SelectLambda( const int& ilam ) {
+                if (!batchTerms) {
+                    ComputeReflectionCoeffs( BatchLambda(ilam) );
+                    PreComputePotentialTerms( );
+                } else {
+                    rams = BatchLambda(ilam)*BatchLambda(ilam);
+                    uk = BatchUk(ilam);
+                    um = BatchUm(ilam);
+                    relCon = BatchRelCon(ilam);
+                    relenukadz = BatchRelenukadz(ilam);
+                    rel_a = BatchRel_a(ilam);
+                    relexp_pbs1 = BatchRelexp_pbs1(ilam);
+                    relexp_pbs2 = BatchRelexp_pbs2(ilam);
+                    rtd(layr) = BatchRtdr(ilam);
+                    if (SensitivityParameter >= 0) {
+                        // kernels are affine in relCon, the source term drops out
+                        relCon = BatchdRelCon(ilam, SensitivityParameter);
+                        relenukadz = 0;
+                    }
+                }
+                ApplyLoopWeight( BatchLambda(ilam) );
+            }
+
+            /** For a source spread over a loop, multiplies the potential terms by the loop
+             *  weight. Every related kernel is linear in these terms, so they all pick up
+             *  the weight. Does nothing for point sources.
+             *  @param[in] lambda is the current lambda argument
+             *  @see DipoleSource::SetLoopRadius
+             */
+            inline void ApplyLoopWeight( const Real& lambda ) {
+                if (LoopSource != nullptr) {
+                    Real w = LoopSource->LoopWeight( lambda );
+                    relCon *= w;
+                    relenukadz *= w;
+                    rel_a *= w;
+                }
+            }
+
             // ====================  ACCESS        =======================
+
+            /** Enables the computation of the sensitivities of relCon to the layer
+             *  conductivities and thicknesses alongside the batched reflection coefficients.
+             *  Only supported with the source and receiver in the air.
+             *  @param[in] compute set to true to compute sensitivities
+             */
+            void SetComputeSensitivities( const bool& compute ) {
+                ComputeSensitivity = compute;
+            }
+
+            /** Selects what SelectLambda loads. With -1 the reflection coefficients are loaded,
+             *  otherwise the sensitivity to parameter iparam, the conductivity of layer
+             *  iparam+1 for iparam < nlay-1 and else the thickness of layer iparam-nlay+2.
+             *  While a sensitivity is selected the batched ComputeReflectionCoeffs reuses
+             *  the last batch, which must have been computed for the same lambda.
+             *  @param[in] iparam is the parameter index, or -1
+             */
+            void SelectSensitivity( const int& iparam ) {
+                SensitivityParameter = iparam;
+            }
+
+            /** Keeps the layer recursion of every batch, keyed by a slot and the order of
+             *  the batch since the slot was set. A later batch with the same key, frequency
+             *  and lambda values only recomputes the layers at and above the deepest layer
+             *  whose properties changed in between, otherwise it replaces the kept one. The
+             *  slot is typically one frequency and receiver pair, so at most one recursion is
+             *  kept per batch of a transform there. Each kept batch holds eight nlambda by
+             *  nlay matrices. Disabling discards the kept batches.
+             *  @param[in] incremental set to true to keep the recursion of each batch
+             *  @param[in] slot identifies the calculation the following batches belong to
+             *  @see EMEarth1D::MakeIncrementalCalc
+             */
+            void SetIncrementalRecursion( const bool& incremental, const int& slot=0 ) {
+                IncrementalRecursion = incremental;
+                RecursionSlot = slot;
+                SlotBatch = 0;
+                if (!incremental) {
+                    RecursionCache.clear();
+                }
+            }
+
             Complex GetYm() {
                 return yh(layr);
             }
@@ -164,6 +245,72 @@ namespace Lemma {
              */
             virtual void PreComputePotentialTerms()=0;
 
+            /** Batched version of ComputeReflectionCoeffs and PreComputePotentialTerms for a
+             *  block of lambda values, followed by calls to SelectLambda. The default
+             *  implementation only stores the lambda values, so that SelectLambda evaluates
+             *  each one with the per lambda reference path.
+             *  @param[in] lambda are the lambda values of the block
+             */
+            virtual void ComputeReflectionCoeffs(const VectorXr& lambda) {
+                nBatch = lambda.size();
+                BatchLambda = lambda;
+                batchTerms = false;
+            }
+
+            /** Computes the batched reflection coefficients and potential terms for a source in
+             *  the air layer, which is the case of all the specialisations. Quantities are stored
+             *  with lambda running fastest and the real and imaginary parts separate, so that the
+             *  complex square roots, exponentials and the layer recursion vectorise across lambda.
+             *  @param[in] lambda are the lambda values of the block
+             *  @param[in] Zh is the layer impedance, yh for TM mode and zh for TE mode
+             *  @param[in] dZhdSigma is the derivative of Zh with respect to conductivity
+             */
+            void ComputeInAirSourceReflectionCoeffs(const VectorXr& lambda, const VectorXcr& Zh,
+                    const Real& dZhdSigma);
+
+            /** Computes the sensitivities of relCon to every layer conductivity and
+             *  thickness, for each lambda of the batch, by differentiating the Zyd recursion
+             *  from the surface downwards. Needs the source and receiver in the air.
+             *  @param[in] Zh is the layer impedance, yh for TM mode and zh for TE mode
+             *  @param[in] dZhdSigma is the derivative of Zh with respect to conductivity
+             */
+            void ComputeInAirSourceSensitivities(const VectorXcr& Zh, const Real& dZhdSigma);
+
+            /** Computes relCon of many earth models at each lambda of a block into
+             *  ModelRelCon. With the source and receiver in the air this is the only term of
+             *  the kernels that depends on the earth below the air. Lambda runs in the outer
+             *  loop and the models in the inner one, so the square roots, exponentials and
+             *  the layer recursion vectorise across models.
+             *  @param[in] lambda are the lambda values of the block
+             *  @param[in] Zh is the layer impedance of each model, yh for TM mode and zh for
+             *             TE mode, one row per model
+             *  @param[in] kkm is the squared wavenumber of each model and layer
+             *  @param[in] thickness is the thickness of each model and layer
+             */
+            void ComputeInAirModelRelCon(const VectorXr& lambda, const Eigen::Ref<const MatrixXcr>& Zh,
+                    const Eigen::Ref<const MatrixXcr>& kkm, const Eigen::Ref<const MatrixXr>& thickness);
+
+            /** Computes the reflection coefficient of a receiver in the air over the reduced
+             *  stack of the evaluated earth, @see LayeredEarthEM::SetTruncationTolerance
+             *  @param[in] lambda is the lambda value
+             *  @param[in] Zh is the layer impedance, yh for TM mode and zh for TE mode
+             */
+            void ComputeReducedReflectionCoeffs(const Real& lambda, const VectorXcr& Zh);
+
+            /** Finds the kept recursion of the current batch, sizing a new one if there is
+             *  none or the kept one is of other lambda values, and swaps its terms in. Flags
+             *  in LayerChanged the layers whose terms must be recomputed.
+             *  @param[in] Zh is the layer impedance, yh for TM mode and zh for TE mode
+             *  @return the deepest layer that changed, or -1 if none did
+             */
+            int SwapInBatchRecursion(const VectorXcr& Zh);
+
+            /** Stores the terms of the current batch in its kept recursion, swapping back
+             *  the storage of the working terms
+             *  @param[in] Zh is the layer impedance, yh for TM mode and zh for TE mode
+             */
+            void SwapOutBatchRecursion(const VectorXcr& Zh);
+
             // ====================  DATA MEMBERS  =========================
 
 			/// Bessel order, only 0 or 1 supported
@@ -190,6 +337,9 @@ namespace Lemma {
 			/// Transmitter z position
 			Real tx_z;
 
+            /// Loop source, nullptr for point dipoles, @see ApplyLoopWeight
+            DipoleSource* LoopSource = nullptr;
+
             /// bessel arg squared
             Real rams;
 
@@ -210,6 +360,9 @@ namespace Lemma {
             /// Pointer to layered earth
             std::shared_ptr<LayeredEarthEM> Earth = nullptr;
 
+            /// Layered earth evaluated at the source frequency, shared read-only between threads
+            std::shared_ptr<const EvaluatedEarthEM> EvaluatedEarth = nullptr;
+
 			Complex       uk;
 			Complex       um;
 			VectorXcr     cf;  // nlay
@@ -232,6 +385,74 @@ namespace Lemma {
 			/// a layered earth model
 			VectorXcr    rtd;
 
+            // ====================  BATCHED DATA  =========================
+
+            /// Number of lambda values in the current batch
+            int nBatch = 0;
+
+            /// True if the Batch* potential terms are valid for the current batch
+            bool batchTerms = false;
+
+            /// Lambda values of the current batch
+            VectorXr     BatchLambda;
+
+            /// Real and imaginary parts of u, Zyi, Zyd, cf and rtd for the current batch. Each
+            /// column is a layer and each row a lambda value.
+            MatrixXr     BuRe, BuIm, BZyiRe, BZyiIm, BZydRe, BZydIm, BcfRe, BcfIm, BrtdRe, BrtdIm;
+
+            /// Potential terms of each lambda value in the batch, @see SelectLambda
+            VectorXcr    BatchUk, BatchUm, BatchRelCon, BatchRelenukadz, BatchRel_a,
+                         BatchRelexp_pbs1, BatchRelexp_pbs2, BatchRtdr;
+
+            /// True if sensitivities are computed with the batch, @see SetComputeSensitivities
+            bool ComputeSensitivity = false;
+
+            /// Sensitivity loaded by SelectLambda, -1 for none, @see SelectSensitivity
+            int SensitivityParameter = -1;
+
+            /// Sensitivity of relCon to each parameter, one row per lambda value in the batch
+            MatrixXcr    BatchdRelCon;
+
+            /// relCon of each model, one row per model and a column per lambda value,
+            /// @see ComputeInAirModelRelCon
+            MatrixXcr    ModelRelCon;
+
+            /// Real and imaginary parts of kk and 1/Zh of each model, and -2 times its layer
+            /// thickness. Each column is a layer and each row a model.
+            MatrixXr     MkkRe, MkkIm, MZinvRe, MZinvIm, Mm2h;
+
+            /// Real and imaginary parts of u, Zyi, Zyd and cf of each model, at the layer the
+            /// recursion is at
+            VectorXr     MuRe, MuIm, MZyiRe, MZyiIm, MZydRe, MZydIm, McfRe, McfIm;
+
+            /// Layer recursion of one batch, kept for incremental updates
+            struct BatchRecursion {
+                Real         omega;
+                VectorXr     Lambda;
+                VectorXcr    Zh;
+                VectorXcr    kk;
+                VectorXr     LayerThickness;
+                MatrixXr     BuRe, BuIm, BZyiRe, BZyiIm, BZydRe, BZydIm, BcfRe, BcfIm;
+            };
+
+            /// True if the recursion of each batch is kept, @see SetIncrementalRecursion
+            bool IncrementalRecursion = false;
+
+            /// Kept recursions, keyed by slot and batch within the slot
+            std::map< std::pair<int, int>, BatchRecursion > RecursionCache;
+
+            /// Slot of the following batches, @see SetIncrementalRecursion
+            int RecursionSlot = 0;
+
+            /// Number of batches kept since the slot was set
+            int SlotBatch = 0;
+
+            /// Kept recursion of the current batch
+            BatchRecursion* KeptRecursion = nullptr;
+
+            /// Layers of the current batch whose terms are recomputed
+            std::vector<bool> LayerChanged;
+
         private:
 
             static constexpr auto CName = "KernelEM1DReflBase";
@@ -83,6 +83,12 @@ namespace Lemma {
              */
             void ComputeReflectionCoeffs(const Real &lambda);
 
+            /** Computes reflection coefficients and potential terms for a block of lambda
+             *  values, @see KernelEM1DReflBase::SelectLambda. The unspecialised version
+             *  defers to the per lambda path.
+             */
+            void ComputeReflectionCoeffs(const VectorXr &lambda);
+
             /* Computes reflection coefficients. Depending on the
              * specialisation, this will either be TM or TE mode. This method
              * stores previous results in a struct. For a given index, and
@@ -128,6 +134,18 @@ namespace Lemma {
     template<>
     void KernelEM1DReflSpec<TE, INAIR, INGROUND>::ComputeReflectionCoeffs(const Real& lambda);
 
+    template<>
+    void KernelEM1DReflSpec<TM, INAIR, INAIR>::ComputeReflectionCoeffs(const VectorXr& lambda);
+
+    template<>
+    void KernelEM1DReflSpec<TE, INAIR, INAIR>::ComputeReflectionCoeffs(const VectorXr& lambda);
+
+    template<>
+    void KernelEM1DReflSpec<TM, INAIR, INGROUND>::ComputeReflectionCoeffs(const VectorXr& lambda);
+
+    template<>
+    void KernelEM1DReflSpec<TE, INAIR, INGROUND>::ComputeReflectionCoeffs(const VectorXr& lambda);
+
     template<>
     void KernelEM1DReflSpec<TM, INAIR, INAIR>::PreComputePotentialTerms( );
 
@@ -263,6 +281,11 @@ namespace Lemma {
         return;
     }
 
+    template<EMMODE Mode, DIPOLE_LOCATION Isource, DIPOLE_LOCATION Irecv>
+    void KernelEM1DReflSpec<Mode, Isource, Irecv>::ComputeReflectionCoeffs(const VectorXr& lambda) {
+        KernelEM1DReflBase::ComputeReflectionCoeffs(lambda);
+    }
+
     template<EMMODE Mode, DIPOLE_LOCATION Isource, DIPOLE_LOCATION Irecv>
     void KernelEM1DReflSpec<Mode, Isource, Irecv>::PreComputePotentialTerms( ) {
         static bool called = false;
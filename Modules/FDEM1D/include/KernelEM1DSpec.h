@@ -24,6 +24,35 @@ namespace Lemma {
 
     //class KernelEM1DReflBase;
 
+    /** Terms of a related kernel with the source and receiver in the air,
+     *  @see KernelEM1DSpec::InAirPotential
+     */
+    struct InAirTerm {
+        int Potential;
+        int LambdaPower;
+    };
+
+    /** Terms of each related kernel with the source and receiver in the air, indexed by
+     *  Ikernel. The comment gives the argument of RelPotentialInSourceLayer in its
+     *  RelBesselArg specialisation, where rams is lambda squared.
+     */
+    constexpr InAirTerm InAirTerms[] = {
+        { 4, 1 },   //  0, lambda
+        { 4, 0 },   //  1, 1
+        { 1, 1 },   //  2, lambda
+        { 1, 0 },   //  3, 1
+        { 3, 2 },   //  4, rams
+        { 3, 1 },   //  5, lambda
+        { 3, 0 },   //  6, 1
+        { 2, 1 },   //  7, lambda
+        { 2, 0 },   //  8, 1
+        { 1, 2 },   //  9, rams
+        { 2, 2 },   // 10, rams
+        { 1, 3 },   // 11, lambda*rams
+        { 1, 2 }    // 12, rams
+    };
+    static_assert( sizeof(InAirTerms)/sizeof(InAirTerm) == 13, "one InAirTerm per related kernel" );
+
     // ===================================================================
     //  Class:  KernelEM1DSpec
     /**
@@ -114,6 +143,23 @@ namespace Lemma {
 
             int GetBesselOrder();
 
+            /** With the source and receiver in the air every related kernel is
+             *  \f$ \lambda^p \, u_0^q \, (relCon \pm relenukadz) \f$. This returns the
+             *  potential term of the kernel, which is JD(Ikernel) and selects the
+             *  sign from SS_SL and \f$ q \f$, known at compile time.
+             *  @see InAirTerms
+             *  @see KernelEM1DManager::ComputeRelatedKernels
+             */
+            static constexpr int InAirPotential() {
+                return InAirTerms[Ikernel].Potential;
+            }
+
+            /** @return the power \f$ p \f$ of lambda of the kernel with the source and
+             *          receiver in the air, @see InAirPotential
+             */
+            static constexpr int InAirLambdaPower() {
+                return InAirTerms[Ikernel].LambdaPower;
+            }
 
             Complex GetZm() {
                 return ReflCalc->GetZm();
@@ -18,6 +18,82 @@
 
 namespace Lemma {
 
+    // =======================================================================
+    //        Class:  EvaluatedEarthEM
+    /// \ingroup FDEM1D
+    /// \brief   Snapshot of a LayeredEarthEM evaluated at a single frequency.
+    /// \details Holds everything the EM kernels need from the earth model, with the
+    ///          Cole-Cole model already evaluated. Instances are never modified after
+    ///          they are built, so a single snapshot may be shared by all threads.
+    ///          @see LayeredEarthEM::GetEvaluatedEarth
+    // =======================================================================
+    struct EvaluatedEarthEM {
+
+        /// Angular frequency the model was evaluated at
+        Real          omega;
+
+        /// Number of layers, including the air layer
+        int           nlay;
+
+        /// Impedivity of each layer, \f$ i \omega \mu \f$
+        VectorXcr     zh;
+
+        /// Admittivity of each layer, \f$ \sigma + i \omega \epsilon \f$
+        VectorXcr     yh;
+
+        /// Squared wavenumber of each layer, \f$ -zh \, yh \f$
+        VectorXcr     kk;
+
+        /// Thickness of each layer, @see LayeredEarth::GetLayerThickness
+        VectorXr      LayerThickness;
+
+        /// Depth of the bottom of each layer, @see LayeredEarth::GetLayerDepth
+        VectorXr      LayerDepth;
+
+        /// True if the layer recursion of receivers in the air uses the reduced stack
+        bool          Reduced;
+
+        /// Layers of the reduced stack from the top, starting at layer 1. Each stands for
+        /// a run of identical layers and the last one is taken as the bottom half space.
+        VectorXi      StackLayers;
+
+        /// Thickness of each layer of the reduced stack, that of its whole run, indexed by layer
+        VectorXr      StackThickness;
+
+        /// Two way attenuation, at zero wavenumber, of reflections from below the reduced
+        /// stack, zero if no layers are dropped. @see LayeredEarthEM::SetTruncationTolerance
+        Real          TruncationBound;
+
+    }; // -----  end of struct  EvaluatedEarthEM  -----
+
+    // =======================================================================
+    //        Class:  EvaluatedModelsEM
+    /// \ingroup FDEM1D
+    /// \brief   Many layered earth models with the same number of layers, evaluated at a
+    ///          single frequency.
+    /// \details Each row is one model, so that a column holds one layer of every model
+    ///          contiguously. Layer 0 is free space in every model.
+    ///          @see EMEarth1D::CalculateModels
+    // =======================================================================
+    struct EvaluatedModelsEM {
+
+        /// Angular frequency the models were evaluated at
+        Real          omega;
+
+        /// Impedivity of each model and layer, \f$ i \omega \mu \f$
+        MatrixXcr     zh;
+
+        /// Admittivity of each model and layer, \f$ \sigma + i \omega \epsilon \f$
+        MatrixXcr     yh;
+
+        /// Squared wavenumber of each model and layer, \f$ -zh \, yh \f$
+        MatrixXcr     kk;
+
+        /// Thickness of each model and layer, @see LayeredEarth::GetLayerThickness
+        MatrixXr      LayerThickness;
+
+    }; // -----  end of struct  EvaluatedModelsEM  -----
+
     // =======================================================================
     //        Class:  LayeredEarthEM
     /// \ingroup FDEM1D
@@ -84,6 +160,23 @@ namespace Lemma {
              */
             void EvaluateColeColeModel(const Real& omega);
 
+            /** Builds and stores the evaluated earth of each angular frequency, so that
+             *  GetEvaluatedEarth returns a shared snapshot instead of building a new one.
+             *  Snapshots already stored for the same frequencies are reused. This is not thread
+             *  safe and should be called before starting a parallel calculation.
+             *  @param[in] omega are the angular frequencies
+             */
+            void EvaluateFrequencies(const VectorXr& omega);
+
+            /** Returns the model evaluated at angular frequency omega. Unlike
+             *  EvaluateColeColeModel this does not modify the model, and so is thread safe
+             *  as long as the model itself is not being changed. If omega was passed to
+             *  EvaluateFrequencies the stored snapshot is returned, otherwise a new one is built.
+             *  @param[in] omega is the angular frequency
+             *  @return the evaluated earth
+             */
+            std::shared_ptr<const EvaluatedEarthEM> GetEvaluatedEarth(const Real& omega);
+
             // ====================  ACCESS        ===========================
 
             /** Sets the number of layers and resizes all model parameters to
@@ -149,8 +242,41 @@ namespace Lemma {
              */
             void SetLayerTauPermitivity(const VectorXr& oerbr);
 
+            /** Sets the tolerance of the truncation of the layer recursion, which applies to
+             *  receivers in the air. At each frequency the recursion stops at the first layer
+             *  where the two way attenuation at zero wavenumber,
+             *  \f$ \exp(-2 \sum_j \Re(\sqrt{-k_j^2}) h_j ) \f$ accumulated from the surface,
+             *  falls below tol. That layer is taken as the bottom half space and the layers
+             *  below it are dropped. Attenuation only grows with wavenumber, so the dropped
+             *  reflections are attenuated by at least this factor at every wavenumber.
+             *  @param[in] tol is the tolerance, 0, the default, disables truncation
+             *  @see GetTruncationBound
+             */
+            void SetTruncationTolerance(const Real& tol);
+
+            /** Merges runs of consecutive layers with identical properties into single layers
+             *  in the layer recursion of receivers in the air. This is exact.
+             *  @param[in] merge set to true to merge identical layers, defaults to false
+             */
+            void SetMergeIdenticalLayers(const bool& merge);
+
             // ====================  INQUIRY       ===========================
 
+            /** Returns the error bound of the truncation at an angular frequency, the two way
+             *  attenuation of reflections from the dropped layers relative to those from the
+             *  surface. This is, to first order, the relative error of the reflection coefficient.
+             *  @param[in] omega is the angular frequency
+             *  @return the bound, zero if no layers are dropped
+             *  @see SetTruncationTolerance
+             */
+            Real GetTruncationBound(const Real& omega);
+
+            /** @param[in] omega is the angular frequency
+             *  @return the deepest layer used by the layer recursion of receivers in the air
+             *  @see SetTruncationTolerance
+             */
+            int GetTruncationLayer(const Real& omega);
+
             /** Returns the thickness of a layer
                 @return a VectorXcr of the layer conductivities.
              */
@@ -257,8 +383,33 @@ namespace Lemma {
 
 
         private:
+
+            // ====================  OPERATIONS    ===========================
+
+            /** @return the Cole-Cole susceptibility of layer ilay at angular frequency omega
+             */
+            Complex ColeColeSusceptibility(const int& ilay, const Real& omega) const;
+
+            /** @return the Cole-Cole permitivity of layer ilay at angular frequency omega
+             */
+            Complex ColeColePermitivity(const int& ilay, const Real& omega) const;
+
+            /** Builds a new evaluated earth at angular frequency omega
+             */
+            std::shared_ptr<const EvaluatedEarthEM> BuildEvaluatedEarth(const Real& omega);
+
             // ====================  DATA MEMBERS  ===========================
 
+            /** Evaluated earths stored by EvaluateFrequencies, cleared whenever the model
+             *  is changed */
+            std::vector< std::shared_ptr<const EvaluatedEarthEM> > EvaluatedEarths;
+
+            /** Truncation tolerance of the layer recursion, @see SetTruncationTolerance */
+            Real              TruncationTolerance = 0;
+
+            /** Whether identical layers are merged, @see SetMergeIdenticalLayers */
+            bool              MergeIdenticalLayers = false;
+
             /** Vector of layer Conductivity */
             VectorXcr         LayerConductivity;
 
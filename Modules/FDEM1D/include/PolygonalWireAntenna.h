@@ -13,6 +13,7 @@
 #define  POLYGONALWIREANTENNA_INC
 
 #include "DipoleSource.h"
+#include "DipoleSet.h"
 #include "WireAntenna.h"
 
 namespace Lemma {
@@ -22,7 +23,9 @@ namespace Lemma {
     /// \ingroup FDEM1D
     /// \brief   Class representing polygonal wire antennae.
     /// \details For EM calculations, dipoles representing this loop are
-    ///    created dynamically, depending on receiver location.
+    ///    created dynamically, depending on receiver location. These are
+    ///    held in a compact DipoleSet, full DipoleSource objects are only
+    ///    built when requested through GetDipoleSource.
     /// @todo enforce minimum dipole moment.
     // ===================================================================
     class PolygonalWireAntenna : public WireAntenna {
@@ -82,6 +85,18 @@ namespace Lemma {
             /// minDipoleRatio is satisfied.
             virtual void ApproximateWithElectricDipoles(const Vector3r &rp);
 
+            /** Builds a quadrature along the wire for receiver rp, in place of the dipole
+             *  approximation. The fields of a closed, horizontally planar loop are those of
+             *  vertical magnetic dipoles spread over its area, which by Green's theorem are
+             *  integrals along the wire. Each segment is split into Gauss-Legendre panels that
+             *  double in length away from the point nearest to the receiver, so that a few
+             *  nodes per segment suffice for distant receivers.
+             *  @param[in] rp is the receiver location
+             *  @see GetLineIntegralQuadrature
+             *  @see DipoleSource::UpdateLineIntegralFields
+             */
+            void ApproximateWithLineIntegral(const Vector3r &rp);
+
             /** Sets the minimum ratio for dipole moments to be used to
              * approximate the loop. A smaller ratio yields a more accurate
              * result, but is more expensive. Default is (1/5).
@@ -100,8 +115,40 @@ namespace Lemma {
 
             // ====================  ACCESS        =======================
 
+            /** @return the dipole that calculations move through the DipoleSet in turn.
+             *  It is an ungrounded electric dipole holding the frequencies of the antenna,
+             *  its location, polarisation, and moment are left as last set.
+             */
+            std::shared_ptr<DipoleSource> GetDipoleSetSource();
+
+            /** @return the vertical magnetic dipole used for line integral evaluation,
+             *  with a moment per unit area of the current times the number of turns
+             */
+            std::shared_ptr<DipoleSource> GetLineIntegralSource();
+
             // ====================  INQUIRY       =======================
 
+            /** @return the dipoles built by ApproximateWithElectricDipoles
+             */
+            const DipoleSet& GetDipoleSet() const;
+
+            /** Returns a dipole of the current approximation. These are built from the
+             *  DipoleSet on first request after each resplit, calculations should prefer
+             *  GetDipoleSet.
+             *  @param[in] dip is the index of the dipole
+             */
+            virtual std::shared_ptr<DipoleSource> GetDipoleSource(const int &dip);
+
+            /** @return the number of dipoles of the current approximation
+             */
+            virtual size_t GetNumberOfDipoles();
+
+            /** @return the quadrature built by ApproximateWithLineIntegral. Each row is a node,
+             *  holding the horizontal offset to the receiver, the weight of the vertical field,
+             *  and the weights of the x and y components of the outward normal.
+             */
+            const Eigen::Matrix<Real, Eigen::Dynamic, 4>& GetLineIntegralQuadrature() const;
+
             /** Returns the name of the underlying class, similiar to Python's type */
             virtual std::string GetName() const ;
 
@@ -126,14 +173,12 @@ namespace Lemma {
 
             /// appends
             void PushXYZDipoles( const Vector3r &step, const Vector3r &cp,
-                            const Vector3r &dir,
-                            std::vector< std::shared_ptr<DipoleSource> > &Dipoles) ;
+                            const Vector3r &dir );
 
             /// corrects for overstep
             void CorrectOverstepXYZDipoles( const Vector3r &step,
                             const Vector3r &cp,
-                            const Vector3r &dir,
-                            std::vector< std::shared_ptr<DipoleSource> > &Dipoles );
+                            const Vector3r &dir );
 
             // ====================  OPERATIONS    =======================
 
@@ -150,13 +195,27 @@ namespace Lemma {
                             const Vector3r &rp);
 
             /// Interpolates dipoles along line segment defined by p0 and p1.
-            void InterpolateLineSegment(const Vector3r &p0, const Vector3r &p1, const Vector3r &rp,
-                            std::vector< std::shared_ptr<DipoleSource> > &Dipoles );
+            void InterpolateLineSegment(const Vector3r &p0, const Vector3r &p1, const Vector3r &rp);
 
         private:
 
             Vector3r                               rRepeat;
 
+            /// Dipoles of the current approximation, @see GetDipoleSet
+            DipoleSet                              XYZDipoles;
+
+            /// Dipole moved through XYZDipoles, @see GetDipoleSetSource
+            std::shared_ptr<DipoleSource>          SetSource;
+
+            /// Receiver location of the current line integral quadrature
+            Vector3r                               lRepeat = Vector3r::Constant(1e10);
+
+            /// Line integral quadrature, @see GetLineIntegralQuadrature
+            Eigen::Matrix<Real, Eigen::Dynamic, 4> LineQuadrature;
+
+            /// Dipole holding the kernels of the line integrals
+            std::shared_ptr<DipoleSource>          LineSource;
+
             static constexpr auto CName = "PolygonalWireAntenna";
 
     }; // -----  end of class  PolygonalWireAntenna  -----
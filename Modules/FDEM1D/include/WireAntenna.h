@@ -167,13 +167,13 @@ namespace Lemma {
 			/**
               * Returns pointer to a dipole source
 			  */
-            std::shared_ptr<DipoleSource> GetDipoleSource(const int &dip);
+            virtual std::shared_ptr<DipoleSource> GetDipoleSource(const int &dip);
 
 			/**
               * returns number of dipoles used to approximate this
               * loop
 			  */
-            size_t GetNumberOfDipoles();
+            virtual size_t GetNumberOfDipoles();
 
 			/**
               * @return the number of frequencies of this wire loop.
@@ -192,6 +192,11 @@ namespace Lemma {
              */
             bool IsHorizontallyPlanar();
 
+            /** Returns true if the last point coincides with the first, so that
+             *  the wire forms a closed loop
+             */
+            bool IsClosed();
+
             /** Returns the name of the underlying class, similiar to Python's type */
             virtual std::string GetName() const;
 
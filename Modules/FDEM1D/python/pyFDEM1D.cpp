@@ -333,11 +333,19 @@ PYBIND11_MODULE(FDEM1D, m) {
         .def("GetHfieldMat", &Lemma::FieldPoints::GetHfieldMat,
             "Returns the H field for the specified frequency.")
         .def("GetMask", &Lemma::FieldPoints::MaskPoint, "Return the mask boolean value for the specified index")
+        .def("GetComponents", &Lemma::FieldPoints::GetComponents,
+            "Returns the mask of field components calculated at the specified index")
 
         // methods
         .def("ClearFields", &Lemma::FieldPoints::ClearFields, "Clears calculated fields")
         .def("MaskPoint", &Lemma::FieldPoints::MaskPoint, "Masks the index resulting in no calculation")
         .def("UnMaskPoint", &Lemma::FieldPoints::UnMaskPoint, "Unmasks the index resulting in a calculation")
+        .def("SetComponents", py::overload_cast< const int&, const int& >
+            (&Lemma::FieldPoints::SetComponents),
+            "Selects the field components calculated at the specified index, from FIELDCOMPONENTMASK")
+        .def("SetComponents", py::overload_cast< const int& >
+            (&Lemma::FieldPoints::SetComponents),
+            "Selects the field components calculated at every index, from FIELDCOMPONENTMASK")
 
         ;
 }
@@ -19,6 +19,10 @@
  */
 
 #include "AEMSurvey.h"
+#include "EMEarth1D.h"
+#include "FieldPoints.h"
+
+#include <algorithm>
 
 namespace Lemma {
 
@@ -36,7 +40,8 @@ std::ostream &operator<<(std::ostream &stream, const AEMSurvey &ob) {
 //      Method:  AEMSurvey
 // Description:  constructor (protected)
 //--------------------------------------------------------------------------------------
-AEMSurvey::AEMSurvey (const ctor_key& key) : LemmaObject(key) {
+AEMSurvey::AEMSurvey (const ctor_key& key) : LemmaObject(key), HankelType(ANDERSON801),
+    FieldsToCalculate(H) {
 
 }  // -----  end of method AEMSurvey::AEMSurvey  (constructor)  -----
 
@@ -64,7 +69,20 @@ AEMSurvey::~AEMSurvey () {
 //      Method:  GetSource
 //--------------------------------------------------------------------------------------
 std::shared_ptr<DipoleSource> AEMSurvey::GetSource ( const int& isource ) {
-    return Sources[isource] ;
+    const int nsrc = GetNumberOfSourcesPerLocation();
+    if (isource < 0 || isource >= GetNumberOfSources()) {
+        throw std::runtime_error("AEMSurvey::GetSource out of range");
+    }
+    const int iloc = isource / nsrc;
+    const int isrc = isource % nsrc;
+    auto Source = DipoleSource::NewSP();
+        Source->SetType( SourceTypes[isrc] );
+        Source->SetNumberOfFrequencies(1);
+        Source->SetFrequency(0, SourceFrequencies(isrc));
+        Source->SetMoment( SourceMoments(isrc) );
+        Source->SetLocation( Vector3r(Locations.col(iloc) + SourceOffsets.col(isrc)) );
+        Source->SetPolarisation( Vector3r(Polarisations.col(iloc)) );
+    return Source;
 }		// -----  end of method AEMSurvey::GetSource  -----
 
 //--------------------------------------------------------------------------------------
@@ -75,14 +93,219 @@ VectorXr AEMSurvey::GetFrequencies (  ) {
     return Freqs;
 }		// -----  end of method AEMSurvey::GetFrequencies  -----
 
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  GetSourceFrequencies
+//--------------------------------------------------------------------------------------
+VectorXr AEMSurvey::GetSourceFrequencies (  ) {
+    return SourceFrequencies;
+}		// -----  end of method AEMSurvey::GetSourceFrequencies  -----
 
 //--------------------------------------------------------------------------------------
 //       Class:  AEMSurvey
 //      Method:  GetNumberOfSources
 //--------------------------------------------------------------------------------------
 int AEMSurvey::GetNumberOfSources (  ) {
-    return  static_cast<int>(Sources.size());
+    return GetNumberOfLocations() * GetNumberOfSourcesPerLocation();
 }		// -----  end of method AEMSurvey::GetNumberOfSources  -----
 
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  GetNumberOfSourcesPerLocation
+//--------------------------------------------------------------------------------------
+int AEMSurvey::GetNumberOfSourcesPerLocation (  ) {
+    return static_cast<int>(SourceFrequencies.size());
+}		// -----  end of method AEMSurvey::GetNumberOfSourcesPerLocation  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  GetNumberOfLocations
+//--------------------------------------------------------------------------------------
+int AEMSurvey::GetNumberOfLocations (  ) {
+    return static_cast<int>(Locations.cols());
+}		// -----  end of method AEMSurvey::GetNumberOfLocations  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  GetLocations
+//--------------------------------------------------------------------------------------
+Vector3Xr AEMSurvey::GetLocations (  ) {
+    return Locations;
+}		// -----  end of method AEMSurvey::GetLocations  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  GetPolarisations
+//--------------------------------------------------------------------------------------
+Vector3Xr AEMSurvey::GetPolarisations (  ) {
+    return Polarisations;
+}		// -----  end of method AEMSurvey::GetPolarisations  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  SetHankelTransformMethod
+//--------------------------------------------------------------------------------------
+void AEMSurvey::SetHankelTransformMethod ( const HANKELTRANSFORMTYPE& type ) {
+    HankelType = type;
+}		// -----  end of method AEMSurvey::SetHankelTransformMethod  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  SetFieldsToCalculate
+//--------------------------------------------------------------------------------------
+void AEMSurvey::SetFieldsToCalculate ( const FIELDCALCULATIONS& calc ) {
+    FieldsToCalculate = calc;
+}		// -----  end of method AEMSurvey::SetFieldsToCalculate  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  ForwardModel
+//--------------------------------------------------------------------------------------
+MatrixXcr AEMSurvey::ForwardModel ( std::shared_ptr<LayeredEarthEM> model ) {
+    return ForwardModel( std::vector< std::shared_ptr<LayeredEarthEM> >(GetNumberOfLocations(), model) );
+}		// -----  end of method AEMSurvey::ForwardModel  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  AEMSurvey
+//      Method:  ForwardModel
+//--------------------------------------------------------------------------------------
+MatrixXcr AEMSurvey::ForwardModel ( const std::vector< std::shared_ptr<LayeredEarthEM> >& models ) {
+
+    const int nloc = GetNumberOfLocations();
+    const int nsrc = GetNumberOfSourcesPerLocation();
+    if (static_cast<int>(models.size()) != nloc) {
+        throw std::runtime_error("AEMSurvey::ForwardModel needs one model per location");
+    }
+    for (const auto& model : models) {
+        if (model == nullptr) throw std::runtime_error("AEMSurvey::ForwardModel nullptr model");
+    }
+
+    // A layered earth is invariant under horizontal translation, so a source offset from the
+    // sounding is computed as a source above the sounding and a receiver offset the other way.
+    // Sources of a sounding sharing type, moment, height and horizontal separation then need
+    // the same kernels, and are computed together as one multi-frequency dipole with one
+    // receiver per horizontal offset. Batch, Frequency and Offset hold, for each source, its
+    // group and its frequency and receiver within that group.
+    struct Group {
+        DIPOLESOURCETYPE Type;
+        Real Moment;
+        Real Height;
+        Real Separation;
+        std::vector<Real> Frequencies;
+        std::vector<Vector3r> Offsets;
+    };
+    std::vector< Group > Groups;
+    std::vector<int> Batch(nsrc), Frequency(nsrc), Offset(nsrc);
+    for (int isrc=0; isrc<nsrc; ++isrc) {
+        const Real height = SourceOffsets(2, isrc);
+        const Real separation = SourceOffsets.col(isrc).head<2>().norm();
+        unsigned int ig = 0;
+        while ( ig < Groups.size() && !(Groups[ig].Type == SourceTypes[isrc] &&
+                Groups[ig].Moment == SourceMoments(isrc) && Groups[ig].Height == height &&
+                Groups[ig].Separation == separation) ) ++ig;
+        if (ig == Groups.size()) {
+            Groups.push_back( Group{ SourceTypes[isrc], SourceMoments(isrc), height, separation, {}, {} } );
+        }
+        Group& group = Groups[ig];
+        Batch[isrc] = static_cast<int>(ig);
+        const Vector3r offset( -SourceOffsets(0, isrc), -SourceOffsets(1, isrc), 0 );
+        Frequency[isrc] = static_cast<int>( std::find(group.Frequencies.begin(), group.Frequencies.end(),
+                SourceFrequencies(isrc)) - group.Frequencies.begin() );
+        if (Frequency[isrc] == static_cast<int>(group.Frequencies.size())) {
+            group.Frequencies.push_back( SourceFrequencies(isrc) );
+        }
+        Offset[isrc] = static_cast<int>( std::find(group.Offsets.begin(), group.Offsets.end(), offset)
+                - group.Offsets.begin() );
+        if (Offset[isrc] == static_cast<int>(group.Offsets.size())) {
+            group.Offsets.push_back( offset );
+        }
+    }
+
+    // H is followed by E when both are calculated
+    const int nH = (FieldsToCalculate != E) ? 3*nsrc : 0;
+    const int nE = (FieldsToCalculate != H) ? 3*nsrc : 0;
+    MatrixXcr Fields = MatrixXcr::Zero(nH+nE, nloc);
+
+    // Exceptions may not leave the parallel region, the first is rethrown after it
+    std::exception_ptr Error = nullptr;
+
+    #ifdef LEMMAUSEOMP
+    #pragma omp parallel
+    #endif
+    { // OpenMP Parallel Block
+
+        // Each thread keeps its own calculator, receivers, dipoles and model copy. Soundings
+        // are the parallel work, the calculator of a thread stays on that thread.
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->SetHankelTransformMethod( HankelType );
+            EmEarth->SetFieldsToCalculate( FieldsToCalculate );
+            EmEarth->SetNumberOfThreads( 1 );
+
+        std::vector< std::shared_ptr<DipoleSource> > Dipoles;
+        std::vector< std::shared_ptr<FieldPoints> > Receivers;
+        for (const auto& group : Groups) {
+            auto Dipole = DipoleSource::NewSP();
+                Dipole->SetType( group.Type );
+                Dipole->SetMoment( group.Moment );
+                Dipole->SetNumberOfFrequencies( static_cast<int>(group.Frequencies.size()) );
+            for (unsigned int ifreq=0; ifreq<group.Frequencies.size(); ++ifreq) {
+                Dipole->SetFrequency( ifreq, group.Frequencies[ifreq] );
+            }
+            Dipoles.push_back( Dipole );
+            auto Receiver = FieldPoints::NewSP();
+                Receiver->SetNumberOfPoints( static_cast<int>(group.Offsets.size()) );
+            Receivers.push_back( Receiver );
+        }
+
+        std::shared_ptr<LayeredEarthEM> Model = nullptr;
+        std::shared_ptr<LayeredEarthEM> Earth = nullptr;
+
+        #ifdef LEMMAUSEOMP
+        #pragma omp for schedule(dynamic, 1)
+        #endif
+        for (int iloc=0; iloc<nloc; ++iloc) {
+            try {
+                // The earth caches its evaluation, copy it only when the model changes
+                if (models[iloc] != Model) {
+                    Earth = models[iloc]->Clone();
+                    EmEarth->AttachLayeredEarthEM( Earth );
+                    Model = models[iloc];
+                }
+                for (unsigned int igroup=0; igroup<Groups.size(); ++igroup) {
+                    auto& Dipole = Dipoles[igroup];
+                    auto& Receiver = Receivers[igroup];
+                    Dipole->SetLocation( Vector3r(Locations.col(iloc) + Vector3r(0, 0, Groups[igroup].Height)) );
+                    Dipole->SetPolarisation( Vector3r(Polarisations.col(iloc)) );
+                    for (unsigned int irec=0; irec<Groups[igroup].Offsets.size(); ++irec) {
+                        Receiver->SetLocation( irec, Vector3r(Locations.col(iloc) + Groups[igroup].Offsets[irec]) );
+                    }
+                    EmEarth->AttachDipoleSource( Dipole );
+                    EmEarth->AttachFieldPoints( Receiver );
+                    Receiver->ClearFields();
+                    EmEarth->MakeCalc3();
+                    for (int is=0; is<nsrc; ++is) {
+                        if (Batch[is] != static_cast<int>(igroup)) continue;
+                        if (nH > 0) {
+                            Fields.block<3,1>(3*is, iloc) = Receiver->GetHfield(Frequency[is], Offset[is]);
+                        }
+                        if (nE > 0) {
+                            Fields.block<3,1>(nH+3*is, iloc) = Receiver->GetEfield(Frequency[is], Offset[is]);
+                        }
+                    }
+                }
+            } catch (...) {
+                #ifdef LEMMAUSEOMP
+                #pragma omp critical (AEMSurveyError)
+                #endif
+                if (Error == nullptr) Error = std::current_exception();
+            }
+        }
+    } // OpenMP Parallel Block
+
+    if (Error != nullptr) {
+        std::rethrow_exception(Error);
+    }
+    return Fields;
+}		// -----  end of method AEMSurvey::ForwardModel  -----
 
 }		// -----  end of Lemma  name  -----
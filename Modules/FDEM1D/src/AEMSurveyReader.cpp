@@ -35,7 +35,8 @@ namespace Lemma {
     //      Method:  AEMSurveyReader
     // Description:  constructor (protected)
     //--------------------------------------------------------------------------------------
-    AEMSurveyReader::AEMSurveyReader (const ctor_key& key) : LemmaObject(key), Survey(nullptr) {
+    AEMSurveyReader::AEMSurveyReader (const ctor_key& key) : LemmaObject(key), Survey(nullptr),
+        Parser(nullptr), nLocations(0), nRead(0) {
 
     }  // -----  end of method AEMSurveyReader::AEMSurveyReader  (constructor)  -----
 
@@ -66,75 +67,106 @@ namespace Lemma {
     }		// -----  end of method AEMSurveyReader::GetSurvey  -----
 
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  AEMSurveyReader
+    //      Method:  GetNumberOfLocations
+    //--------------------------------------------------------------------------------------
+    int AEMSurveyReader::GetNumberOfLocations (  ) {
+        return nLocations;
+    }		// -----  end of method AEMSurveyReader::GetNumberOfLocations  -----
+
+
     //--------------------------------------------------------------------------------------
     //       Class:  AEMSurveyReader
     //      Method:  ReadASCIIAEMFile
     //--------------------------------------------------------------------------------------
     void AEMSurveyReader::ReadASCIIAEMFile (  const std::string& fname ) {
+        OpenASCIIAEMFile( fname );
+        ReadLocations( nLocations );
+        return ;
+    }		// -----  end of method AEMSurveyReader::ReadASCIIAEMFile  -----
+
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  AEMSurveyReader
+    //      Method:  OpenASCIIAEMFile
+    //--------------------------------------------------------------------------------------
+    void AEMSurveyReader::OpenASCIIAEMFile (  const std::string& fname ) {
 
         Survey = AEMSurvey::NewSP();
-        auto Parser = ASCIIParser::NewSP();
+        Parser = ASCIIParser::NewSP();
         Parser->SetCommentString("//");
         Parser->Open(fname);
 
-        // Sanity check
-        std::vector<int> ivals = Parser->ReadInts(1);
+        int nsrc = Parser->ReadInts(1)[0];   // number of sources
+        Survey->SourceFrequencies.resize(nsrc);
+        Survey->SourceOffsets.resize(Eigen::NoChange, nsrc);
+        Survey->SourceMoments.resize(nsrc);
+        Survey->SourceTypes.clear();
+
         std::vector<Real> freqs;
-        for (int isc=0; isc<ivals[0]; ++isc) {
+        for (int isc=0; isc<nsrc; ++isc) {
             Real df = Parser->ReadReals(1)[0]; // frequency Hz
             bool unique = true;
             for (unsigned int ifreq=0; ifreq<freqs.size(); ++ifreq) {
-                if (df - freqs[ifreq] < 1e-2) {
+                if (std::abs(df - freqs[ifreq]) < 1e-2) {
                     unique = false;
                 }
             }
             if (unique) freqs.push_back(df);
             std::string DT = Parser->ReadStrings(1)[0];
-            if (DT == "MD" || DT == "ED") {
+            if (DT == "MD") {
+                Survey->SourceTypes.push_back(MAGNETICDIPOLE);
+            } else if (DT == "ED") {
+                Survey->SourceTypes.push_back(UNGROUNDEDELECTRICDIPOLE);
             } else {
                 std::cerr << "In AEMSurveyReader::ReadASCIIAEMFile. The source type: "
                           << DT << " is not supported.\n";
                 std::exit(EXIT_FAILURE);
             }
-            Parser->ReadReals(4); // position and moment
+            std::vector<Real> irvals = Parser->ReadReals(4); // position and moment
+            Survey->SourceFrequencies(isc) = df;
+            Survey->SourceOffsets.col(isc) << irvals[0], irvals[1], irvals[2];
+            Survey->SourceMoments(isc) = irvals[3];
         }
-
         Survey->Freqs = VectorXr::Map(&freqs[0], freqs.size());
 
-        // OK, now get cracking, those sources at every location
-        int nb = Parser->ReadInts(1)[0];  // number of locations
+        nLocations = Parser->ReadInts(1)[0];  // number of locations
+        nRead = 0;
+        return ;
+    }		// -----  end of method AEMSurveyReader::OpenASCIIAEMFile  -----
+
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  AEMSurveyReader
+    //      Method:  ReadLocations
+    //--------------------------------------------------------------------------------------
+    int AEMSurveyReader::ReadLocations ( const int& nmax ) {
+
+        if (Parser == nullptr) {
+            throw std::runtime_error("AEMSurveyReader::ReadLocations called before OpenASCIIAEMFile");
+        }
+
+        // The sources are kept, only the locations belong to this block
+        auto Block = AEMSurvey::NewSP();
+            Block->SourceFrequencies = Survey->SourceFrequencies;
+            Block->SourceTypes = Survey->SourceTypes;
+            Block->SourceOffsets = Survey->SourceOffsets;
+            Block->SourceMoments = Survey->SourceMoments;
+            Block->Freqs = Survey->Freqs;
+
+        int nb = std::max(0, std::min(nmax, nLocations - nRead));
+        Block->Locations.resize(Eigen::NoChange, nb);
+        Block->Polarisations.resize(Eigen::NoChange, nb);
         for (int ib=0; ib<nb; ++ib) {
-            std::vector<Real> rvals = Parser->ReadReals(6); // position and moment
-	    std::streamoff bp = Parser->GetFileLocation(  );
-            Parser->JumpToLocation( 0 );
-            //std::vector<int> ivals = Parser->ReadInts(1);   // number of frequencies
-            int nf = Parser->ReadInts(1)[0];   // number of frequencies
-            for (int isc=0; isc<nf; ++isc) {
-                Survey->Sources.push_back(DipoleSource::NewSP());
-                size_t cnt = Survey->Sources.size() - 1; //
-                // and now set it
-                Survey->Sources[cnt]->SetNumberOfFrequencies(1);
-                Survey->Sources[cnt]->SetFrequency(0, Parser->ReadReals(1)[0]);
-                std::string DT = Parser->ReadStrings(1)[0];
-                if (DT == "MD") {
-                     Survey->Sources[cnt]->SetType(MAGNETICDIPOLE);
-                } else if (DT == "ED") {
-                     Survey->Sources[cnt]->SetType(UNGROUNDEDELECTRICDIPOLE);
-                } else {
-                    std::cerr << "In AEMSurveyReader::ReadASCIIAEMFile. The source type: "
-                              << DT << " is not supported.\n";
-                    std::exit(EXIT_FAILURE);
-                }
-                std::vector<Real> irvals = Parser->ReadReals(4); // position and moment
-                Survey->Sources[cnt]->SetMoment(irvals[3]);
-                Survey->Sources[cnt]->SetLocation(rvals[0] + irvals[0], rvals[1] + irvals[1],
-                                                     rvals[2] + irvals[2]);
-                Survey->Sources[cnt]->SetPolarisation(rvals[3], rvals[4], rvals[5]);
-            }
-            Parser->JumpToLocation(bp);
+            std::vector<Real> rvals = Parser->ReadReals(6); // position and polarisation
+            Block->Locations.col(ib) << rvals[0], rvals[1], rvals[2];
+            Block->Polarisations.col(ib) << rvals[3], rvals[4], rvals[5];
         }
-        return ;
-    }		// -----  end of method AEMSurveyReader::ReadASCIIAEMFile  -----
+        nRead += nb;
+        Survey = Block;
+        return nb;
+    }		// -----  end of method AEMSurveyReader::ReadLocations  -----
 
 
 }		// -----  end of Lemma  name  -----
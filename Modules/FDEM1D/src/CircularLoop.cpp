@@ -45,6 +45,11 @@ namespace Lemma {
     // Description:  DeSerializing constructor (locked)
     //--------------------------------------------------------------------------------------
     CircularLoop::CircularLoop (const YAML::Node& node, const ctor_key&) : CompactSupportEMSource(node, CompactSupportEMSource::ctor_key()) {
+        Location = node["Location"].as<Vector3r>();
+        Radius = node["Radius"].as<Real>();
+        Current = node["Current"].as<Real>();
+        NumberOfTurns = node["NumberOfTurns"].as<int>();
+        Freqs = node["Freqs"].as<VectorXr>();
 
     }  // -----  end of method CircularLoop::CircularLoop  (constructor)  -----
 
@@ -73,7 +78,11 @@ namespace Lemma {
     YAML::Node  CircularLoop::Serialize (  ) const {
         YAML::Node node = CompactSupportEMSource::Serialize();
         node.SetTag( GetName() );
-        // FILL IN CLASS SPECIFICS HERE
+        node["Location"] = Location;
+        node["Radius"] = Radius;
+        node["Current"] = Current;
+        node["NumberOfTurns"] = NumberOfTurns;
+        node["Freqs"] = Freqs;
         return node;
     }		// -----  end of method CircularLoop::Serialize  -----
 
@@ -88,6 +97,89 @@ namespace Lemma {
         return std::make_shared< CircularLoop > ( node, ctor_key() );
     }		// -----  end of method CircularLoop::DeSerialize  -----
 
+    // ====================  OPERATIONS    =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  CircularLoop
+    //      Method:  GetDipoleSource
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<DipoleSource> CircularLoop::GetDipoleSource (  ) {
+        auto dipole = DipoleSource::NewSP();
+            dipole->SetType(MAGNETICDIPOLE);
+            dipole->SetPolarisation(0, 0, 1);
+            dipole->SetLocation(Location);
+            dipole->SetMoment( (Real)(NumberOfTurns)*Current*PI*Radius*Radius );
+            dipole->SetLoopRadius(Radius);
+            dipole->SetFrequencies(Freqs);
+        return dipole;
+    }		// -----  end of method CircularLoop::GetDipoleSource  -----
+
+    // ====================  ACCESS        =======================
+
+    void CircularLoop::SetLocation(const Vector3r &posin) {
+        Location = posin;
+    }
+
+    void CircularLoop::SetLocation(const Real &xp, const Real &yp, const Real &zp) {
+        Location << xp, yp, zp;
+    }
+
+    void CircularLoop::SetRadius(const Real& radius) {
+        Radius = radius;
+    }
+
+    void CircularLoop::SetCurrent(const Real &amp) {
+        Current = amp;
+    }
+
+    void CircularLoop::SetNumberOfTurns(const int &nturns) {
+        NumberOfTurns = nturns;
+    }
+
+    void CircularLoop::SetNumberOfFrequencies(const int& nfreq) {
+        Freqs.resize(nfreq);
+        Freqs.setZero();
+    }
+
+    void CircularLoop::SetFrequency(const int& ifreq, const Real &freq) {
+        assert(ifreq < Freqs.size());
+        Freqs[ifreq] = freq;
+    }
+
+    void CircularLoop::SetFrequencies(const VectorXr& freqs) {
+        Freqs = freqs;
+    }
+
+    // ====================  INQUIRY       =======================
+
+    Vector3r CircularLoop::GetLocation() {
+        return Location;
+    }
+
+    Real CircularLoop::GetRadius() {
+        return Radius;
+    }
+
+    Real CircularLoop::GetCurrent() {
+        return Current;
+    }
+
+    int CircularLoop::GetNumberOfTurns() {
+        return NumberOfTurns;
+    }
+
+    int CircularLoop::GetNumberOfFrequencies() {
+        return (int)(Freqs.size());
+    }
+
+    Real CircularLoop::GetFrequency(const int& ifreq) {
+        return Freqs[ifreq];
+    }
+
+    VectorXr CircularLoop::GetFrequencies() {
+        return Freqs;
+    }
+
 } // ----  end of namespace Lemma  ----
 
 /* vim: set tabstop=4 expandtab: */
@@ -51,7 +51,7 @@ namespace Lemma {
 			throw std::runtime_error("In DigitalFilterIntegratorAnderson NumConv is less than 1.");
 		}
 
-		if (this->IntKernel == NULL) {
+		if (this->IntKernel == nullptr) {
 			throw std::runtime_error("In DigitalFilterIntegratorAnderson Unset Kernel Calculator");
 		}
 
@@ -154,7 +154,7 @@ namespace Lemma {
 			throw std::runtime_error("In DigitalFilterIntegratorAnderson NumConv is less than 1.");
 		}
 
-		if (this->IntKernel == NULL) {
+		if (this->IntKernel == nullptr) {
 			throw std::runtime_error("In DigitalFilterIntegratorAnderson Unset Kernel Calculator");
 		}
 
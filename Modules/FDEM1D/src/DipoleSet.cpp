@@ -0,0 +1,53 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+  @file
+  @author   Trevor Irons
+  @date     10/18/2026
+ **/
+
+#include "DipoleSet.h"
+
+namespace Lemma {
+
+    // ====================  LIFECYCLE     =======================
+
+    DipoleSet::DipoleSet( ) : nDipoles(0) {
+    }
+
+    DipoleSet::~DipoleSet( ) {
+    }
+
+    // ====================  OPERATIONS    =======================
+
+    void DipoleSet::Clear( ) {
+        nDipoles = 0;
+    }
+
+    void DipoleSet::Push( const Vector3r& loc, const Vector3r& pol, const Real& moment ) {
+        if (nDipoles == Moments.size()) {
+            // grow geometrically, so that steady state rebuilds do not allocate
+            int capacity = std::max(64, 2*nDipoles);
+            Locations.conservativeResize(Eigen::NoChange, capacity);
+            Polarisations.conservativeResize(Eigen::NoChange, capacity);
+            Moments.conservativeResize(capacity);
+        }
+        Locations.col(nDipoles) = loc;
+        Polarisations.col(nDipoles) = pol;
+        Moments(nDipoles) = moment;
+        ++nDipoles;
+    }
+
+    void DipoleSet::CorrectLast( const Vector3r& loc, const Real& moment ) {
+        Locations.col(nDipoles-1) = loc;
+        Moments(nDipoles-1) = moment;
+    }
+
+}		// -----  end of Lemma  name  -----
+
+/* vim: set tabstop=4 expandtab: */
+/* vim: set filetype=cpp: */
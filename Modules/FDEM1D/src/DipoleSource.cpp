@@ -63,6 +63,9 @@ namespace Lemma {
     {
         Type = string2Enum<DIPOLESOURCETYPE>(node["Type"].as<std::string>());
         this->Location = node["Location"].as<Vector3r>();
+        if (node["LoopRadius"]) {
+            LoopRadius = node["LoopRadius"].as<Real>();
+        }
         this->Phat.setZero();
     }
 
@@ -83,6 +86,9 @@ namespace Lemma {
         node["Freqs"] = Freqs;
         node["Phase"] = Phase;
         node["Moment"] = Moment;
+        if (LoopRadius > 0) {
+            node["LoopRadius"] = LoopRadius;
+        }
         return node;
     }
 
@@ -106,6 +112,8 @@ namespace Lemma {
 
         Obj->Phase = Phase;
         Obj->Moment = Moment;
+        Obj->LoopRadius = LoopRadius;
+        Obj->LineIntegral = LineIntegral;
 
         Obj->xxp = xxp;
         Obj->yyp = yyp;
@@ -118,7 +126,7 @@ namespace Lemma {
         Obj->c2p = c2p;
 
         Obj->FieldsToCalculate = FieldsToCalculate;
-        Obj->f = f;
+        Obj->Components = Components;
         Obj->ik = ik;
 
         Obj->Location = Location;
@@ -243,6 +251,14 @@ namespace Lemma {
         this->Moment = moment;
     }
 
+    void DipoleSource::SetLoopRadius(const Real& radius) {
+        this->LoopRadius = radius;
+    }
+
+    void DipoleSource::SetLineIntegral(const bool& line) {
+        this->LineIntegral = line;
+    }
+
     // ====================  OPERATIONS     =====================
 
     void DipoleSource::SetKernels(const int& ifreq, const FIELDCALCULATIONS&  Fields , std::shared_ptr<FieldPoints> ReceiversIn, const int& irecin,
@@ -272,13 +288,25 @@ namespace Lemma {
         cps = cp*cp;
         c2p = cps-sps;
 
-        f = VectorXcr::Zero(13);
-        ik = VectorXi::Zero(13);
-
         lays = Earth->GetLayerAtThisDepth(Location[2]);
         layr = Earth->GetLayerAtThisDepth(Receivers->GetLocation(irec)[2]);
 
-        // TODO, avoid smart pointer here maybe?
+        Components = Receivers->GetComponents(irec);
+        SetUpdater();
+
+        // The kernels only depend on the source type, polarisation, fields and receiver components, and
+        // whether the source and receiver are in the air or the ground. If these are unchanged, the manager
+        // is reused and only the frequency and receiver height are updated, which does not allocate.
+        int config = KernelConfiguration();
+        if (KernelManager != nullptr && config == kernelConfig) {
+            KernelManager->SetEarth(Earth);
+            KernelManager->ReSetDipoleSource( this, ifreq, Receivers->GetLocation(irec)[2] );
+            kernelFreq = Freqs(ifreq);
+            return;
+        }
+        kernelConfig = config;
+
+        ik = VectorXi::Zero(13);
         KernelManager = KernelEM1DManager::NewSP();
 
             KernelManager->SetEarth(Earth);
@@ -294,8 +322,18 @@ namespace Lemma {
         return;
     }
 
+    int DipoleSource::KernelConfiguration( ) {
+        return static_cast<int>(Type) + 8*static_cast<int>(FieldsToCalculate) +
+               32*(std::abs(Phat[2]) > 0) + 64*(std::abs(Phat[0]) > 0 || std::abs(Phat[1]) > 0) +
+               128*(lays > 0) + 256*(layr > 0) + 512*(LoopRadius > 0) +
+               1024*LineIntegral + 2048*IsCalculated(EXMASK | EYMASK) + 4096*IsCalculated(EZMASK) +
+               8192*IsCalculated(HXMASK | HYMASK) + 16384*IsCalculated(HZMASK);
+    }
+
     void DipoleSource::SetupLight(const int& ifreq, const FIELDCALCULATIONS&  Fields, const int& irecin) {
 
+        irec = irecin;
+
         xxp = Receivers->GetLocation(irec)[0] - Location[0];
         yyp = Receivers->GetLocation(irec)[1] - Location[1];
         rho = (Receivers->GetLocation(irec).head<2>() - Location.head<2>()).norm();
@@ -307,646 +345,153 @@ namespace Lemma {
         cps = cp*cp;
         c2p = cps-sps;
 
+        Components = Receivers->GetComponents(irec);
+        SetUpdater();
         return;
     }
 
 
 
-    // TODO we could make the dipoles template specializations avoiding this rats nest of switch statements. Probably
-    //      not the most critical piece though
+    template <EMMODE Mode, int Ikernel>
+    void DipoleSource::AddKernel( ) {
+        if (lays == 0 && layr == 0) {
+            ik[Ikernel] = KernelManager->AddKernel<Mode, Ikernel, INAIR, INAIR>( );
+        } else if (lays == 0 && layr > 0) {
+            ik[Ikernel] = KernelManager->AddKernel<Mode, Ikernel, INAIR, INGROUND>( );
+        } else if (lays > 0 && layr == 0) {
+            ik[Ikernel] = KernelManager->AddKernel<Mode, Ikernel, INGROUND, INAIR>( );
+        } else {
+            ik[Ikernel] = KernelManager->AddKernel<Mode, Ikernel, INGROUND, INGROUND>( );
+        }
+    }
+
     void DipoleSource::ReSetKernels(const int& ifreq, const FIELDCALCULATIONS&  Fields ,
             std::shared_ptr<FieldPoints> Receivers, const int& irec,
             std::shared_ptr<LayeredEarthEM> Earth  ) {
 
-        Vector3r Pol = Phat;
+        const bool PolZ  = std::abs(Phat[2]) > 0;
+        const bool PolXY = std::abs(Phat[0]) > 0 || std::abs(Phat[1]) > 0;
 
+        // Horizontal and vertical components of the fields. Both horizontal components of a
+        // field are found from the same kernels.
+        const bool EH = IsCalculated( EXMASK | EYMASK );
+        const bool EV = IsCalculated( EZMASK );
+        const bool HH = IsCalculated( HXMASK | HYMASK );
+        const bool HV = IsCalculated( HZMASK );
+
+        // Only the kernels read by UpdateFieldsSpec are added. Grounding points neglect the TE
+        // terms of a horizontal dipole, and ungrounded dipoles the TM grounding terms.
         switch (Type) {
 
             case (GROUNDEDELECTRICDIPOLE):
+            case (GROUNDINGPOINT):
+            case (UNGROUNDEDELECTRICDIPOLE):
 
-                if (std::abs(Pol[2]) > 0) { // z dipole
-
-                    switch(FieldsToCalculate) {
-
-                        case E:
-                            if (lays == 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INAIR>( );
-                            } else {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-                            if (lays == 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-
-                        case BOTH:
-                            if ( lays == 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INAIR>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INGROUND>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INAIR>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INGROUND>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INGROUND>( );
-                            }
-                        }
+                if (PolZ) {
+                    if (EH && Type != UNGROUNDEDELECTRICDIPOLE) {
+                        AddKernel<TM, 10>( );
+                    }
+                    if (EV) {
+                        AddKernel<TM, 11>( );
+                    }
+                    if (HH) {
+                        AddKernel<TM, 12>( );
+                    }
                 }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y grounded HED dipole
-
-                    switch(FieldsToCalculate) {
-
-                        case E:
-                            if ( lays == 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INAIR>( );
-                            } else {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-                            if (lays == 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case BOTH:
-                            if (lays == 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INAIR>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INGROUND>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INAIR>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INGROUND>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
+                if (PolXY) {
+                    if (Type != UNGROUNDEDELECTRICDIPOLE) {
+                        if (EH) {
+                            AddKernel<TM, 0>( );
+                            AddKernel<TM, 1>( );
+                        }
+                        if (EV) {
+                            AddKernel<TM, 4>( );
                         }
                     }
-                break;
-
-            case (GROUNDINGPOINT):
-
-                if (std::abs(Pol[2]) > 0) { // z dipole
-
-                    switch(FieldsToCalculate) {
-
-                        case E:
-                            if (lays == 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INAIR>( );
-                            } else {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-                            if (lays == 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-
-                        case BOTH:
-                            if ( lays == 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INAIR>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INAIR, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INGROUND>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INAIR>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[10] = KernelManager->AddKernel<TM, 10, INGROUND, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INGROUND>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INGROUND>( );
-                            }
+                    if (EH && Type != GROUNDINGPOINT) {
+                        AddKernel<TE, 2>( );
+                        AddKernel<TE, 3>( );
+                    }
+                    if (HH && Type != UNGROUNDEDELECTRICDIPOLE) {
+                        AddKernel<TM, 5>( );
+                        AddKernel<TM, 6>( );
+                    }
+                    if (Type != GROUNDINGPOINT) {
+                        if (HH) {
+                            AddKernel<TE, 7>( );
+                            AddKernel<TE, 8>( );
                         }
-                }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y grounded HED dipole
-
-                    switch(FieldsToCalculate) {
-
-                        case E:
-                            if ( lays == 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INAIR>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INGROUND>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INAIR>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INAIR>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INAIR>( );
-                            } else {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INGROUND>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INGROUND>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-                            if (lays == 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INAIR>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INAIR>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INGROUND>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INGROUND>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INAIR>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INAIR>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INAIR>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INGROUND>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INGROUND>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INGROUND>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case BOTH:
-                            if (lays == 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INAIR>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INAIR>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INAIR>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INAIR>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INAIR, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INAIR, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INAIR, INGROUND>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INGROUND>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INGROUND>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INGROUND>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INAIR>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INAIR>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INAIR>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INAIR>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INAIR>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INAIR>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[0] = KernelManager->AddKernel<TM, 0, INGROUND, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TM, 1, INGROUND, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TM, 4, INGROUND, INGROUND>( );
-                                //ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INGROUND>( );
-                                //ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INGROUND>( );
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INGROUND>( );
-                                //ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INGROUND>( );
-                                //ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INGROUND>( );
-                                //ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
+                        if (HV) {
+                            AddKernel<TE, 9>( );
                         }
                     }
+                }
                 break;
 
-            case (UNGROUNDEDELECTRICDIPOLE):
+            case (MAGNETICDIPOLE):
 
-                if (std::abs(Pol[2]) > 0) { // z dipole
-
-                    switch(FieldsToCalculate) {
-
-                        case E:
-                            if (lays == 0 && layr == 0) {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INAIR>( );
-                            } else {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-                            if (lays == 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-
-                        case BOTH:
-                            if ( lays == 0 && layr == 0) {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INAIR>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INAIR, INGROUND>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INAIR>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[11] = KernelManager->AddKernel<TM, 11, INGROUND, INGROUND>( );
-                                ik[12] = KernelManager->AddKernel<TM, 12, INGROUND, INGROUND>( );
-                            }
+                if (LineIntegral) {
+                    // Integrals along a closed loop are found from kernels 2, 7 and 12
+                    if (EH) {
+                        if (layr == 0) {
+                            ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
+                        } else {
+                            ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
                         }
-                }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y grounded HED dipole
-
-                    switch(FieldsToCalculate) {
-
-                        case E:
-                            if ( lays == 0 && layr == 0) {
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INAIR>( );
-                            } else {
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-                            if (lays == 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case BOTH:
-                            if (lays == 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INAIR, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INAIR, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INAIR, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INAIR, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[5] = KernelManager->AddKernel<TM, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TM, 6, INGROUND, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TE, 2, INGROUND, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TE, 3, INGROUND, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TE, 7, INGROUND, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TE, 8, INGROUND, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TE, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
+                    }
+                    if (HH) {
+                        if (layr == 0) {
+                            ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INAIR>( );
+                        } else {
+                            ik[7] = KernelManager->AddKernel<TE, 7, INAIR, INGROUND>( );
                         }
                     }
-
-
-                break;
-
-            case (MAGNETICDIPOLE):
-
-                if (std::abs(Pol[2]) > 0) { // z dipole
-
-                    switch (FieldsToCalculate) {
-
-                        case E:
-
-                            if (lays == 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INGROUND, INAIR>( );
-                            } else {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-
-                            if (lays == 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TE, 10, INAIR, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[10] = KernelManager->AddKernel<TE, 10, INAIR, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[10] = KernelManager->AddKernel<TE, 10, INGROUND, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INGROUND, INAIR>( );
-                            } else {
-                                ik[10] = KernelManager->AddKernel<TE, 10, INGROUND, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-
-                        case BOTH:
-
-                            if (lays == 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INAIR, INAIR>( );
-                                ik[10] = KernelManager->AddKernel<TE, 10, INAIR, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INAIR, INGROUND>( );
-                                ik[10] = KernelManager->AddKernel<TE, 10, INAIR, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INGROUND, INAIR>( );
-                                ik[10] = KernelManager->AddKernel<TE, 10, INGROUND, INAIR>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INGROUND, INAIR>( );
-                            } else {
-                                ik[12] = KernelManager->AddKernel<TE, 12, INGROUND, INGROUND>( );
-                                ik[10] = KernelManager->AddKernel<TE, 10, INGROUND, INGROUND>( );
-                                ik[11] = KernelManager->AddKernel<TE, 11, INGROUND, INGROUND>( );
-                            }
+                    if (HV) {
+                        if (layr == 0) {
+                            ik[12] = KernelManager->AddKernel<TE, 12, INAIR, INAIR>( );
+                        } else {
+                            ik[12] = KernelManager->AddKernel<TE, 12, INAIR, INGROUND>( );
+                        }
                     }
+                    break;
                 }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y grounded HED dipole
-
-                    switch (FieldsToCalculate) {
-
-                        case E:
-                            if ( lays == 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INAIR, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INAIR, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INAIR, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INAIR, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INAIR, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INAIR, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INGROUND, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INGROUND, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INGROUND, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INGROUND, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INGROUND, INAIR>( );
-                            } else {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INGROUND, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INGROUND, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INGROUND, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case H:
-
-                            if ( lays == 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TE, 0, INAIR, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INAIR, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INAIR, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INAIR, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[0] = KernelManager->AddKernel<TE, 0, INAIR, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INAIR, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INAIR, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INAIR, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INAIR, INGROUND>( );
-                            } else if (lays > 0 && layr == 0) {
-                                ik[0] = KernelManager->AddKernel<TE, 0, INGROUND, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INGROUND, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INGROUND, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INGROUND, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INGROUND, INAIR>( );
-                            } else {
-                                ik[0] = KernelManager->AddKernel<TE, 0, INGROUND, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INGROUND, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INGROUND, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INGROUND, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INGROUND, INGROUND>( );
-                            }
-                            break;
-
-                        case BOTH:
-
-                            if ( lays == 0 && layr == 0) {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INAIR, INAIR>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INAIR, INAIR>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INAIR, INAIR>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INAIR, INAIR>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INAIR, INAIR>( );
-                                ik[0] = KernelManager->AddKernel<TE, 0, INAIR, INAIR>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INAIR, INAIR>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INAIR, INAIR>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INAIR, INAIR>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INAIR, INAIR>( );
-                            } else if (lays == 0 && layr > 0) {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INAIR, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INAIR, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INAIR, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INAIR, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INAIR, INGROUND>( );
-                                ik[0] = KernelManager->AddKernel<TE, 0, INAIR, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INAIR, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INAIR, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INAIR, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INAIR, INGROUND>( );
-                            } else {
-                                ik[5] = KernelManager->AddKernel<TE, 5, INGROUND, INGROUND>( );
-                                ik[6] = KernelManager->AddKernel<TE, 6, INGROUND, INGROUND>( );
-                                ik[7] = KernelManager->AddKernel<TM, 7, INGROUND, INGROUND>( );
-                                ik[8] = KernelManager->AddKernel<TM, 8, INGROUND, INGROUND>( );
-                                ik[9] = KernelManager->AddKernel<TM, 9, INGROUND, INGROUND>( );
-                                ik[0] = KernelManager->AddKernel<TE, 0, INGROUND, INGROUND>( );
-                                ik[1] = KernelManager->AddKernel<TE, 1, INGROUND, INGROUND>( );
-                                ik[4] = KernelManager->AddKernel<TE, 4, INGROUND, INGROUND>( );
-                                ik[2] = KernelManager->AddKernel<TM, 2, INGROUND, INGROUND>( );
-                                ik[3] = KernelManager->AddKernel<TM, 3, INGROUND, INGROUND>( );
-                           }
-                           break;
+
+                if (PolZ) {
+                    if (EH) {
+                        AddKernel<TE, 12>( );
+                    }
+                    if (HH) {
+                        AddKernel<TE, 10>( );
+                    }
+                    if (HV) {
+                        AddKernel<TE, 11>( );
+                        // Inside of a loop, Hz is found from kernel 12
+                        if (LoopRadius > 0 && !EH) {
+                            AddKernel<TE, 12>( );
                         }
+                    }
+                }
+                if (PolXY) {
+                    if (EH) {
+                        AddKernel<TE, 5>( );
+                        AddKernel<TE, 6>( );
+                        AddKernel<TM, 7>( );
+                        AddKernel<TM, 8>( );
+                    }
+                    if (EV) {
+                        AddKernel<TM, 9>( );
+                    }
+                    if (HH) {
+                        AddKernel<TE, 0>( );
+                        AddKernel<TE, 1>( );
+                    }
+                    if (HV) {
+                        AddKernel<TE, 4>( );
+                    }
+                    if (HH) {
+                        AddKernel<TM, 2>( );
+                        AddKernel<TM, 3>( );
+                    }
                 }
                 break;
 
@@ -957,505 +502,478 @@ namespace Lemma {
         }
     }
 
+    // ====================  FIELD UPDATES  ======================
+
     void DipoleSource::UpdateFields( const int& ifreq, HankelTransform* Hankel, const Real& wavef) {
+        if (Updater == nullptr) {
+            throw NonValidDipoleType(this);
+        }
+        (this->*Updater)( ifreq, Hankel, wavef );
+    }
 
-        Vector3r Pol = Phat;
+    bool DipoleSource::IsCalculated( const int& mask ) const {
+        const int fields = ((FieldsToCalculate != H) ? EMASK : 0) | ((FieldsToCalculate != E) ? HMASK : 0);
+        return (Components & fields & mask) != 0;
+    }
 
-        switch (Type) {
+    void DipoleSource::AppendEfield( const int& ifreq, const Complex& ex, const Complex& ey,
+            const Complex& ez ) {
+        this->Receivers->AppendEfield(ifreq, irec,
+            (Components & EXMASK) ? ex : Complex(0),
+            (Components & EYMASK) ? ey : Complex(0),
+            (Components & EZMASK) ? ez : Complex(0) );
+    }
+
+    void DipoleSource::AppendHfield( const int& ifreq, const Complex& hx, const Complex& hy,
+            const Complex& hz ) {
+        this->Receivers->AppendHfield(ifreq, irec,
+            (Components & HXMASK) ? hx : Complex(0),
+            (Components & HYMASK) ? hy : Complex(0),
+            (Components & HZMASK) ? hz : Complex(0) );
+    }
 
+    void DipoleSource::SetUpdater( ) {
+
+        // The fields updated are those of FieldsToCalculate with components at the receiver
+        const bool CalcE = IsCalculated( EMASK );
+        const bool CalcH = IsCalculated( HMASK );
+        const FIELDCALCULATIONS fields = CalcE ? (CalcH ? BOTH : E) : H;
+        int pol = (std::abs(Phat[0]) > 0) + 2*(std::abs(Phat[1]) > 0) + 4*(std::abs(Phat[2]) > 0);
+        if (!CalcE && !CalcH) {
+            pol = 0;
+        }
+
+        const int config = static_cast<int>(Type) + 8*static_cast<int>(fields) + 32*pol + 256*Components;
+        if (config == updaterConfig) {
+            return;
+        }
+        updaterConfig = config;
+
+        switch (Type) {
             case (GROUNDEDELECTRICDIPOLE):
+                Updater = SelectUpdater<GROUNDEDELECTRICDIPOLE>( fields, pol );
+                break;
+            case (GROUNDINGPOINT):
+                Updater = SelectUpdater<GROUNDINGPOINT>( fields, pol );
+                break;
+            case (UNGROUNDEDELECTRICDIPOLE):
+                Updater = SelectUpdater<UNGROUNDEDELECTRICDIPOLE>( fields, pol );
+                break;
+            case (MAGNETICDIPOLE):
+                Updater = SelectUpdater<MAGNETICDIPOLE>( fields, pol );
+                break;
+            default:
+                Updater = nullptr;
+        }
+    }
 
-                //Hankel->ComputeRelated(rho, KernelManager);
-
-                if (std::abs(Pol[2]) > 0) { // z dipole
-                    switch(FieldsToCalculate) {
-                        case E:
-                            f(10) = Hankel->Zgauss(10, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[10])) / KernelManager->GetRAWKernel(ik[10])->GetYm();
-                            f(11) = Hankel->Zgauss(11, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11])) / KernelManager->GetRAWKernel(ik[11])->GetYm();
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                -Pol[2]*QPI*cp*f(10)*Moment,
-                                -Pol[2]*QPI*sp*f(10)*Moment,
-                                 Pol[2]*QPI*f(11)*Moment);
-                            break;
-
-                        case H:
-                            f(12) = Hankel->Zgauss(12, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]));
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                -Pol[2]*QPI*sp*f(12)*Moment,
-                                 Pol[2]*QPI*cp*f(12)*Moment,
-                                 0. );
-                            break;
-
-                        case BOTH:
-                            f(10) = Hankel->Zgauss(10, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[10])) / KernelManager->GetRAWKernel(ik[10])->GetYm();
-                            f(11) = Hankel->Zgauss(11, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11])) / KernelManager->GetRAWKernel(ik[11])->GetYm();
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                    -Pol[2]*QPI*cp*f(10)*Moment,
-                                    -Pol[2]*QPI*sp*f(10)*Moment,
-                                     Pol[2]*QPI*f(11)*Moment   );
-
-                            f(12) = Hankel->Zgauss(12, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]));
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                    -Pol[2]*QPI*sp*f(12)*Moment,
-                                     Pol[2]*QPI*cp*f(12)*Moment,
-                                     0. );
-                    } // Fields to calculate Z polarity Electric dipole
-                }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y dipole
-                    switch(FieldsToCalculate) {
-                        case E:
-                            f(2) = Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(ik[2])->GetZs();
-                            f(3) = Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(ik[3])->GetZs();
-                            f(0) = Hankel->Zgauss(0, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0])) / KernelManager->GetRAWKernel(ik[0])->GetYm();
-                            f(1) = Hankel->Zgauss(1, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1])) / KernelManager->GetRAWKernel(ik[1])->GetYm();
-                            f(4) = Hankel->Zgauss(4, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4])) / KernelManager->GetRAWKernel(ik[4])->GetYm();
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[1]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[1]*Moment*QPI*((sps*f(0)+c2p*f(1)/rho)-(cps*f(2)-c2p*f(3)/rho)),
-                                    Pol[1]*Moment*QPI*sp*f(4));
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*((cps*f(0)-c2p*f(1)/rho)-(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-                            }
-                            break;
-                        case H:
-                            f(5) = Hankel->Zgauss(5, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]));
-                            f(6) = Hankel->Zgauss(6, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]));
-                            f(7) = Hankel->Zgauss(7, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetZs()/KernelManager->GetRAWKernel(ik[7])->GetZm();
-                            f(8) = Hankel->Zgauss(8, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetZs()/KernelManager->GetRAWKernel(ik[8])->GetZm();
-                            f(9) = Hankel->Zgauss(9, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetZs()/KernelManager->GetRAWKernel(ik[9])->GetZm();
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                        Pol[1]*QPI*(sps*f(5)+c2p*f(6)/rho-cps*f(7)+c2p*f(8)/rho)*Moment,
-                                        Pol[1]*QPI*scp*(-f(5)+(Real)(2.)*f(6)/rho-f(7)+(Real)(2.)*f(8)/rho)*Moment,
-                                        -Pol[1]*QPI*cp*f(9)*Moment );
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*scp*(f(5)-(Real)(2.)*f(6)/rho+f(7)-(Real)(2.)*f(8)/rho),
-                                    Pol[0]*Moment*QPI*(-cps*f(5)+c2p*f(6)/rho+sps*f(7)+c2p*f(8)/rho),
-                                    Pol[0]*Moment*QPI*sp*f(9) );
-                            }
-                            break;
-
-                        case BOTH:
-                            f(0) = Hankel->Zgauss(0, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0])) / KernelManager->GetRAWKernel(ik[0])->GetYm();
-                            f(1) = Hankel->Zgauss(1, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1])) / KernelManager->GetRAWKernel(ik[1])->GetYm();
-                            f(4) = Hankel->Zgauss(4, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4])) / KernelManager->GetRAWKernel(ik[4])->GetYm();
-                            f(2) = Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(ik[2])->GetZs();
-                            f(3) = Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(ik[3])->GetZs();
-                            f(5) = Hankel->Zgauss(5, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]));
-                            f(6) = Hankel->Zgauss(6, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]));
-                            f(7) = Hankel->Zgauss(7, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetZs()/KernelManager->GetRAWKernel(ik[7])->GetZm();
-                            f(8) = Hankel->Zgauss(8, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetZs()/KernelManager->GetRAWKernel(ik[8])->GetZm();
-                            f(9) = Hankel->Zgauss(9, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetZs()/KernelManager->GetRAWKernel(ik[9])->GetZm();
-
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                        Pol[1]*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho))*Moment ,
-                                        Pol[1]*QPI*((sps*f(0)+c2p*f(1)/rho)-(cps*f(2)-c2p*f(3)/rho))*Moment,
-                                        Pol[1]*QPI*sp*f(4)*Moment);
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                        Pol[1]*QPI*(sps*f(5)+c2p*f(6)/rho-cps*f(7)+c2p*f(8)/rho)*Moment,
-                                        Pol[1]*QPI*scp*(-f(5)+(Real)(2.)*f(6)/rho-f(7)+(Real)(2.)*f(8)/rho)*Moment,
-                                       -Pol[1]*QPI*cp*f(9)*Moment );
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*((cps*f(0)-c2p*f(1)/rho)-(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*scp*(f(5)-(Real)(2.)*f(6)/rho+f(7)-(Real)(2.)*f(8)/rho),
-                                    Pol[0]*Moment*QPI*(-cps*f(5)+c2p*f(6)/rho+sps*f(7)+c2p*f(8)/rho),
-                                    Pol[0]*Moment*QPI*sp*f(9) );
-                            }
-                            break;
+    template <DIPOLESOURCETYPE STYPE>
+    DipoleSource::FieldUpdater DipoleSource::SelectUpdater( const FIELDCALCULATIONS& fields, const int& pol ) {
+        static const FieldUpdater Updaters[3][8] = {
+            { &DipoleSource::UpdateFieldsSpec<STYPE, E, 0>, &DipoleSource::UpdateFieldsSpec<STYPE, E, 1>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, E, 2>, &DipoleSource::UpdateFieldsSpec<STYPE, E, 3>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, E, 4>, &DipoleSource::UpdateFieldsSpec<STYPE, E, 5>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, E, 6>, &DipoleSource::UpdateFieldsSpec<STYPE, E, 7> },
+            { &DipoleSource::UpdateFieldsSpec<STYPE, H, 0>, &DipoleSource::UpdateFieldsSpec<STYPE, H, 1>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, H, 2>, &DipoleSource::UpdateFieldsSpec<STYPE, H, 3>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, H, 4>, &DipoleSource::UpdateFieldsSpec<STYPE, H, 5>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, H, 6>, &DipoleSource::UpdateFieldsSpec<STYPE, H, 7> },
+            { &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 0>, &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 1>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 2>, &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 3>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 4>, &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 5>,
+              &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 6>, &DipoleSource::UpdateFieldsSpec<STYPE, BOTH, 7> }
+        };
+        return Updaters[static_cast<int>(fields)][pol];
+    }
+
+    template <DIPOLESOURCETYPE STYPE, FIELDCALCULATIONS FIELDS, int POL>
+    void DipoleSource::UpdateFieldsSpec( const int& ifreq, HankelTransform* Hankel, const Real& wavef) {
+
+        // The branches on template arguments are resolved by the compiler, those on the
+        // components of the receiver once per call
+        const bool EH = (FIELDS != H) && IsCalculated( EXMASK | EYMASK );
+        const bool EV = (FIELDS != H) && IsCalculated( EZMASK );
+        const bool HH = (FIELDS != E) && IsCalculated( HXMASK | HYMASK );
+        const bool HV = (FIELDS != E) && IsCalculated( HZMASK );
+        const Real QM = QPI*Moment;
+
+        if (STYPE != MAGNETICDIPOLE) {
+
+            if (POL & 4) { // z dipole
+                const Real Pz = Phat[2]*QM;
+                if (EH || EV) {
+                    // ungrounded dipoles have no radial term
+                    Complex f10(0), f11(0);
+                    if (EH && STYPE != UNGROUNDEDELECTRICDIPOLE) {
+                        KernelEM1DBase* K10 = KernelManager->GetRAWKernel(ik[10]);
+                        f10 = Hankel->Zgauss(10, TM, 1, rho, wavef, K10) / K10->GetYm();
+                    }
+                    if (EV) {
+                        KernelEM1DBase* K11 = KernelManager->GetRAWKernel(ik[11]);
+                        f11 = Hankel->Zgauss(11, TM, 0, rho, wavef, K11) / K11->GetYm();
                     }
+                    AppendEfield(ifreq,
+                        -Pz*cp*f10,
+                        -Pz*sp*f10,
+                         Pz*f11 );
+                }
+                if (HH) {
+                    KernelEM1DBase* K12 = KernelManager->GetRAWKernel(ik[12]);
+                    Complex f12 = Hankel->Zgauss(12, TM, 1, rho, wavef, K12);
+                    AppendHfield(ifreq,
+                        -Pz*sp*f12,
+                         Pz*cp*f12,
+                         0. );
+                }
+            }
+
+            if (POL & 3) { // x or y dipole
+                // Grounding points neglect the TE terms, ungrounded dipoles the TM grounding terms
+                Complex f0(0), f1(0), f2(0), f3(0), f4(0), f5(0), f6(0), f7(0), f8(0), f9(0);
+                if (EH && STYPE != UNGROUNDEDELECTRICDIPOLE) {
+                    KernelEM1DBase* K0 = KernelManager->GetRAWKernel(ik[0]);
+                    KernelEM1DBase* K1 = KernelManager->GetRAWKernel(ik[1]);
+                    f0 = Hankel->Zgauss(0, TM, 0, rho, wavef, K0) / K0->GetYm();
+                    f1 = Hankel->Zgauss(1, TM, 1, rho, wavef, K1) / K1->GetYm();
+                }
+                if (EV && STYPE != UNGROUNDEDELECTRICDIPOLE) {
+                    KernelEM1DBase* K4 = KernelManager->GetRAWKernel(ik[4]);
+                    f4 = Hankel->Zgauss(4, TM, 1, rho, wavef, K4) / K4->GetYm();
+                }
+                if (EH && STYPE != GROUNDINGPOINT) {
+                    KernelEM1DBase* K2 = KernelManager->GetRAWKernel(ik[2]);
+                    KernelEM1DBase* K3 = KernelManager->GetRAWKernel(ik[3]);
+                    f2 = Hankel->Zgauss(2, TE, 0, rho, wavef, K2) * K2->GetZs();
+                    f3 = Hankel->Zgauss(3, TE, 1, rho, wavef, K3) * K3->GetZs();
+                }
+                if (HH && STYPE != UNGROUNDEDELECTRICDIPOLE) {
+                    KernelEM1DBase* K5 = KernelManager->GetRAWKernel(ik[5]);
+                    KernelEM1DBase* K6 = KernelManager->GetRAWKernel(ik[6]);
+                    f5 = Hankel->Zgauss(5, TM, 0, rho, wavef, K5);
+                    f6 = Hankel->Zgauss(6, TM, 1, rho, wavef, K6);
+                }
+                if (HH && STYPE != GROUNDINGPOINT) {
+                    KernelEM1DBase* K7 = KernelManager->GetRAWKernel(ik[7]);
+                    KernelEM1DBase* K8 = KernelManager->GetRAWKernel(ik[8]);
+                    f7 = Hankel->Zgauss(7, TE, 0, rho, wavef, K7) * K7->GetZs() / K7->GetZm();
+                    f8 = Hankel->Zgauss(8, TE, 1, rho, wavef, K8) * K8->GetZs() / K8->GetZm();
+                }
+                if (HV && STYPE != GROUNDINGPOINT) {
+                    KernelEM1DBase* K9 = KernelManager->GetRAWKernel(ik[9]);
+                    f9 = Hankel->Zgauss(9, TE, 1, rho, wavef, K9) * K9->GetZs() / K9->GetZm();
                 }
-                break; // GROUNDEDELECTRICDIPOLE
 
-            case (GROUNDINGPOINT):
-                if (std::abs(Pol[2]) > 0) { // z dipole
-                    switch(FieldsToCalculate) {
-                        case E:
-                            f(10) = Hankel->Zgauss(10, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[10])) / KernelManager->GetRAWKernel(ik[10])->GetYm();
-                            f(11) = Hankel->Zgauss(11, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11])) / KernelManager->GetRAWKernel(ik[11])->GetYm();
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                -Pol[2]*QPI*cp*f(10)*Moment,
-                                -Pol[2]*QPI*sp*f(10)*Moment,
-                                 Pol[2]*QPI*f(11)*Moment);
-                            break;
-
-                        case H:
-                            f(12) = Hankel->Zgauss(12, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]));
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                -Pol[2]*QPI*sp*f(12)*Moment,
-                                 Pol[2]*QPI*cp*f(12)*Moment,
-                                 0. );
-                            break;
-
-                        case BOTH:
-                            f(10) = Hankel->Zgauss(10, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[10])) / KernelManager->GetRAWKernel(ik[10])->GetYm();
-                            f(11) = Hankel->Zgauss(11, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11])) / KernelManager->GetRAWKernel(ik[11])->GetYm();
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                    -Pol[2]*QPI*cp*f(10)*Moment,
-                                    -Pol[2]*QPI*sp*f(10)*Moment,
-                                     Pol[2]*QPI*f(11)*Moment   );
-
-                            f(12) = Hankel->Zgauss(12, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]));
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                    -Pol[2]*QPI*sp*f(12)*Moment,
-                                     Pol[2]*QPI*cp*f(12)*Moment,
-                                     0. );
-                    } // Fields to calculate Z polarity Electric dipole
+                if (POL & 2) {
+                    const Real Py = Phat[1]*QM;
+                    // The electric field of a y directed grounding point is only found with the
+                    // magnetic field
+                    if ((EH || EV) && !(STYPE == GROUNDINGPOINT && FieldsToCalculate == E)) {
+                        AppendEfield(ifreq,
+                            Py*scp*((f0-(Real)(2.)*f1/rho)+(f2-(Real)(2.)*f3/rho)),
+                            Py*((sps*f0+c2p*f1/rho)-(cps*f2-c2p*f3/rho)),
+                            Py*sp*f4 );
+                    }
+                    if (HH || HV) {
+                        AppendHfield(ifreq,
+                            Py*(sps*f5+c2p*f6/rho-cps*f7+c2p*f8/rho),
+                            Py*scp*(-f5+(Real)(2.)*f6/rho-f7+(Real)(2.)*f8/rho),
+                           -Py*cp*f9 );
+                    }
                 }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y dipole
-                    switch(FieldsToCalculate) {
-                        case E:
-                            f(2) = 0;//Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(ik[2])->GetZs();
-                            f(3) = 0;//Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(ik[3])->GetZs();
-                            f(0) = Hankel->Zgauss(0, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0])) / KernelManager->GetRAWKernel(ik[0])->GetYm();
-                            f(1) = Hankel->Zgauss(1, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1])) / KernelManager->GetRAWKernel(ik[1])->GetYm();
-                            f(4) = Hankel->Zgauss(4, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4])) / KernelManager->GetRAWKernel(ik[4])->GetYm();
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    0,0,0);
-                                    //Pol[1]*QPI*Moment*scp*(f(0)+f(2)),
-                                    //Pol[1]*QPI*Moment*((sps*f(0)+c2p*f(1)/rho)),
-                                    //Pol[1]*QPI*Moment*(f(0)+f(2)),
-                                    //Pol[1]*QPI*Moment*((f(0)+f(1)/rho)),
-                                    //Pol[1]*QPI*sp*f(4)*Moment);
-                                    // std dipole
-                                    //Pol[1]*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho))*Moment ,
-                                    //Pol[1]*QPI*((sps*f(0)+c2p*f(1)/rho)-(cps*f(2)-c2p*f(3)/rho))*Moment,
-                                    //Pol[1]*QPI*sp*f(4)*Moment);
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*((cps*f(0)-c2p*f(1)/rho)),          //-(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)),   //+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-                            }
-                            break;
-                        case H:
-                            f(5) = Hankel->Zgauss(5, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]));
-                            f(6) = Hankel->Zgauss(6, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]));
-                            f(7) = Hankel->Zgauss(7, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetZs()/KernelManager->GetRAWKernel(ik[7])->GetZm();
-                            f(8) = Hankel->Zgauss(8, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetZs()/KernelManager->GetRAWKernel(ik[8])->GetZm();
-                            f(9) = Hankel->Zgauss(9, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetZs()/KernelManager->GetRAWKernel(ik[9])->GetZm();
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                        Pol[1]*QPI*(sps*f(5)+c2p*f(6)/rho-cps*f(7)+c2p*f(8)/rho)*Moment,
-                                        Pol[1]*QPI*scp*(-f(5)+(Real)(2.)*f(6)/rho-f(7)+(Real)(2.)*f(8)/rho)*Moment,
-                                        -Pol[1]*QPI*cp*f(9)*Moment );
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*scp*(f(5)-(Real)(2.)*f(6)/rho+f(7)-(Real)(2.)*f(8)/rho),
-                                    Pol[0]*Moment*QPI*(-cps*f(5)+c2p*f(6)/rho+sps*f(7)+c2p*f(8)/rho),
-                                    Pol[0]*Moment*QPI*sp*f(9) );
-                            }
-                            break;
-
-                        case BOTH:
-                            f(0) = Hankel->Zgauss(0, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0])) / KernelManager->GetRAWKernel(ik[0])->GetYm();
-                            f(1) = Hankel->Zgauss(1, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1])) / KernelManager->GetRAWKernel(ik[1])->GetYm();
-                            f(4) = Hankel->Zgauss(4, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4])) / KernelManager->GetRAWKernel(ik[4])->GetYm();
-                            f(2) = Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(ik[2])->GetZs();
-                            f(3) = Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(ik[3])->GetZs();
-                            f(5) = Hankel->Zgauss(5, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]));
-                            f(6) = Hankel->Zgauss(6, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]));
-                            f(7) = Hankel->Zgauss(7, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetZs()/KernelManager->GetRAWKernel(ik[7])->GetZm();
-                            f(8) = Hankel->Zgauss(8, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetZs()/KernelManager->GetRAWKernel(ik[8])->GetZm();
-                            f(9) = Hankel->Zgauss(9, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetZs()/KernelManager->GetRAWKernel(ik[9])->GetZm();
-
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                        Pol[1]*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho))*Moment ,
-                                        Pol[1]*QPI*((sps*f(0)+c2p*f(1)/rho)-(cps*f(2)-c2p*f(3)/rho))*Moment,
-                                        Pol[1]*QPI*sp*f(4)*Moment);
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                        Pol[1]*QPI*(sps*f(5)+c2p*f(6)/rho-cps*f(7)+c2p*f(8)/rho)*Moment,
-                                        Pol[1]*QPI*scp*(-f(5)+(Real)(2.)*f(6)/rho-f(7)+(Real)(2.)*f(8)/rho)*Moment,
-                                       -Pol[1]*QPI*cp*f(9)*Moment );
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*((cps*f(0)-c2p*f(1)/rho)-(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*scp*(f(5)-(Real)(2.)*f(6)/rho+f(7)-(Real)(2.)*f(8)/rho),
-                                    Pol[0]*Moment*QPI*(-cps*f(5)+c2p*f(6)/rho+sps*f(7)+c2p*f(8)/rho),
-                                    Pol[0]*Moment*QPI*sp*f(9) );
-                            }
-                            break;
+                if (POL & 1) {
+                    const Real Px = Phat[0]*QM;
+                    if (EH || EV) {
+                        AppendEfield(ifreq,
+                            Px*((cps*f0-c2p*f1/rho)-(sps*f2+c2p*f3/rho)),
+                            Px*scp*((f0-(Real)(2.)*f1/rho)+(f2-(Real)(2.)*f3/rho)),
+                            Px*cp*f4 );
+                    }
+                    if (HH || HV) {
+                        AppendHfield(ifreq,
+                            Px*scp*(f5-(Real)(2.)*f6/rho+f7-(Real)(2.)*f8/rho),
+                            Px*(-cps*f5+c2p*f6/rho+sps*f7+c2p*f8/rho),
+                            Px*sp*f9 );
                     }
                 }
-                break; // GROUNDINGPOINT
-
-
-            case UNGROUNDEDELECTRICDIPOLE:
-
-                if (std::abs(Pol[2]) > 0) { // z dipole
-                    switch(FieldsToCalculate) {
-                        case E:
-                            f(10) = 0;
-                            f(11) = Hankel->Zgauss(11, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11])) / KernelManager->GetRAWKernel(ik[11])->GetYm();
-
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                -Pol[2]*QPI*cp*f(10)*Moment,
-                                -Pol[2]*QPI*sp*f(10)*Moment,
-                                 Pol[2]*QPI*f(11)*Moment);
-                            break;
-
-                        case H:
-                            f(12) = Hankel->Zgauss(12, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]));
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                -Pol[2]*QPI*sp*f(12)*Moment,
-                                 Pol[2]*QPI*cp*f(12)*Moment,
-                                 0. );
-                            break;
-
-                        case BOTH:
-                            f(10) = 0;
-                            f(11) = Hankel->Zgauss(11, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11])) / KernelManager->GetRAWKernel(ik[11])->GetYm();
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                    -Pol[2]*QPI*cp*f(10)*Moment,
-                                    -Pol[2]*QPI*sp*f(10)*Moment,
-                                     Pol[2]*QPI*f(11)*Moment   );
-
-                            f(12) = Hankel->Zgauss(12, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]));
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                    -Pol[2]*QPI*sp*f(12)*Moment,
-                                     Pol[2]*QPI*cp*f(12)*Moment,
-                                     0. );
-                    } // Fields to calculate Z polarity Electric dipole
+            }
+
+        } else {
+
+            if (POL & 4) { // z dipole
+                const Real Pz = Phat[2]*QM;
+                if (EH) {
+                    KernelEM1DBase* K12 = KernelManager->GetRAWKernel(ik[12]);
+                    Complex f12 = Hankel->Zgauss(12, TE, 1, rho, wavef, K12) * K12->GetZs();
+                    AppendEfield(ifreq,
+                         Pz*sp*f12,
+                        -Pz*cp*f12,
+                         0. );
                 }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y dipole
-
-                    switch(FieldsToCalculate) {
-                        case E:
-                            //f(0) = 0;
-                            //f(1) = 0;
-                            //f(2) = Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(ik[2])->GetZs();
-                            //f(3) = Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(ik[3])->GetZs();
-                            //f(4) = 0;
-                            f(2) = Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(ik[2])->GetZs();
-                            f(3) = Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(ik[3])->GetZs();
-                            f(0) = Hankel->Zgauss(0, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0])) / KernelManager->GetRAWKernel(ik[0])->GetYm();
-                            f(1) = Hankel->Zgauss(1, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1])) / KernelManager->GetRAWKernel(ik[1])->GetYm();
-                            f(4) = Hankel->Zgauss(4, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4])) / KernelManager->GetRAWKernel(ik[4])->GetYm();
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[1]*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho))*Moment,
-                                    Pol[1]*QPI*((sps*f(0)+c2p*f(1)/rho)-(cps*f(2)-c2p*f(3)/rho))*Moment,
-                                    Pol[1]*QPI*sp*f(4)*Moment);
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*((cps*f(0)-c2p*f(1)/rho)-(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-                            }
-                            break;
-                        case H:
-                            // TI - Comparisons with Amira show slight better agreement when neglecting these grounding terms
-                            f(5) = 0; //Hankel->Zgauss(5, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]));
-                            f(6) = 0; //Hankel->Zgauss(6, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]));
-                            f(7) = Hankel->Zgauss(7, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetZs()/KernelManager->GetRAWKernel(ik[7])->GetZm();
-                            f(8) = Hankel->Zgauss(8, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetZs()/KernelManager->GetRAWKernel(ik[8])->GetZm();
-                            f(9) = Hankel->Zgauss(9, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetZs()/KernelManager->GetRAWKernel(ik[9])->GetZm();
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                        Pol[1]*QPI*(sps*f(5)+c2p*f(6)/rho-cps*f(7)+c2p*f(8)/rho)*Moment,
-                                        Pol[1]*QPI*scp*(-f(5)+(Real)(2.)*f(6)/rho-f(7)+(Real)(2.)*f(8)/rho)*Moment,
-                                       -Pol[1]*QPI*cp*f(9)*Moment );
-                            }
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*scp*(f(5)-(Real)(2.)*f(6)/rho+f(7)-(Real)(2.)*f(8)/rho),
-                                    Pol[0]*Moment*QPI*(-cps*f(5)+c2p*f(6)/rho+sps*f(7)+c2p*f(8)/rho),
-                                    Pol[0]*Moment*QPI*sp*f(9) );
-                            }
-                            break;
-
-                        case BOTH:
-                            f(0) = 0;
-                            f(1) = 0;
-                            f(4) = 0;
-                            f(2) = Hankel->Zgauss(2, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2])) * KernelManager->GetRAWKernel(0)->GetZs();
-                            f(3) = Hankel->Zgauss(3, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3])) * KernelManager->GetRAWKernel(1)->GetZs();
-                            f(5) = 0;//Hankel->Zgauss(5, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]));
-                            f(6) = 0;//Hankel->Zgauss(6, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]));
-                            f(7) = Hankel->Zgauss(7, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetZs()/KernelManager->GetRAWKernel(ik[7])->GetZm();
-                            f(8) = Hankel->Zgauss(8, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetZs()/KernelManager->GetRAWKernel(ik[8])->GetZm();
-                            f(9) = Hankel->Zgauss(9, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetZs()/KernelManager->GetRAWKernel(ik[9])->GetZm();
-
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                        Pol[1]*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho))*Moment ,
-                                        Pol[1]*QPI*((sps*f(0)+c2p*f(1)/rho)-(cps*f(2)-c2p*f(3)/rho))*Moment,
-                                        Pol[1]*QPI*sp*f(4)*Moment);
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                        Pol[1]*QPI*(sps*f(5)+c2p*f(6)/rho-cps*f(7)+c2p*f(8)/rho)*Moment,
-                                        Pol[1]*QPI*scp*(-f(5)+(Real)(2.)*f(6)/rho-f(7)+(Real)(2.)*f(8)/rho)*Moment,
-                                       -Pol[1]*QPI*cp*f(9)*Moment );
-                            }
-
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*((cps*f(0)-c2p*f(1)/rho)-(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*((f(0)-(Real)(2.)*f(1)/rho)+(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*scp*(f(5)-(Real)(2.)*f(6)/rho+f(7)-(Real)(2.)*f(8)/rho),
-                                    Pol[0]*Moment*QPI*(-cps*f(5)+c2p*f(6)/rho+sps*f(7)+c2p*f(8)/rho),
-                                    Pol[0]*Moment*QPI*sp*f(9) );
-                            }
-                            break;
+                if (HH || HV) {
+                    Complex f10(0), f11(0);
+                    if (HH) {
+                        KernelEM1DBase* K10 = KernelManager->GetRAWKernel(ik[10]);
+                        f10 = Hankel->Zgauss(10, TE, 1, rho, wavef, K10) * K10->GetZs() / K10->GetZm();
+                    }
+                    if (HV) {
+                        KernelEM1DBase* K11 = KernelManager->GetRAWKernel(ik[11]);
+                        f11 = Hankel->Zgauss(11, TE, 0, rho, wavef, K11) * K11->GetZs() / K11->GetZm();
                     }
+                    AppendHfield(ifreq,
+                        -Pz*cp*f10,
+                        -Pz*sp*f10,
+                         Pz*f11 );
+                }
+            }
+
+            if (POL & 3) { // x or y dipole
+                Complex f0(0), f1(0), f2(0), f3(0), f4(0), f5(0), f6(0), f7(0), f8(0), f9(0);
+                if (EH) {
+                    KernelEM1DBase* K5 = KernelManager->GetRAWKernel(ik[5]);
+                    KernelEM1DBase* K6 = KernelManager->GetRAWKernel(ik[6]);
+                    KernelEM1DBase* K7 = KernelManager->GetRAWKernel(ik[7]);
+                    KernelEM1DBase* K8 = KernelManager->GetRAWKernel(ik[8]);
+                    f5 = Hankel->Zgauss(5, TE, 0, rho, wavef, K5) * K5->GetZs();
+                    f6 = Hankel->Zgauss(6, TE, 1, rho, wavef, K6) * K6->GetZs();
+                    f7 = Hankel->Zgauss(7, TM, 0, rho, wavef, K7) * K7->GetKs() / K7->GetYm();
+                    f8 = Hankel->Zgauss(8, TM, 1, rho, wavef, K8) * K8->GetKs() / K8->GetYm();
+                }
+                if (EV) {
+                    KernelEM1DBase* K9 = KernelManager->GetRAWKernel(ik[9]);
+                    f9 = Hankel->Zgauss(9, TM, 1, rho, wavef, K9) * K9->GetKs() / K9->GetYm();
+                }
+                if (HH) {
+                    KernelEM1DBase* K0 = KernelManager->GetRAWKernel(ik[0]);
+                    KernelEM1DBase* K1 = KernelManager->GetRAWKernel(ik[1]);
+                    KernelEM1DBase* K2 = KernelManager->GetRAWKernel(ik[2]);
+                    KernelEM1DBase* K3 = KernelManager->GetRAWKernel(ik[3]);
+                    f0 = Hankel->Zgauss(0, TE, 0, rho, wavef, K0) * K0->GetZs() / K0->GetZm();
+                    f1 = Hankel->Zgauss(1, TE, 1, rho, wavef, K1) * K1->GetZs() / K1->GetZm();
+                    f2 = Hankel->Zgauss(2, TM, 0, rho, wavef, K2) * K2->GetKs();
+                    f3 = Hankel->Zgauss(3, TM, 1, rho, wavef, K3) * K3->GetKs();
+                }
+                if (HV) {
+                    KernelEM1DBase* K4 = KernelManager->GetRAWKernel(ik[4]);
+                    f4 = Hankel->Zgauss(4, TE, 1, rho, wavef, K4) * K4->GetZs() / K4->GetZm();
                 }
 
-                break; // UNGROUNDEDELECTRICDIPOLE
-
-            case MAGNETICDIPOLE:
-                //Hankel->ComputeRelated(rho, KernelManager);
-                if (std::abs(Pol[2]) > 0) { // z dipole
-                    switch(FieldsToCalculate) {
-                        case E:
-                            f(12)=Hankel->Zgauss(12, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]))*KernelManager->GetRAWKernel(ik[12])->GetZs();
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                 Pol[2]*Moment*QPI*sp*f(12),
-                                -Pol[2]*Moment*QPI*cp*f(12),
-                                 0);
-                            break;
-                        case H:
-                            f(10)=Hankel->Zgauss(10, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[10]))*KernelManager->GetRAWKernel(ik[10])->GetZs()/KernelManager->GetRAWKernel(ik[10])->GetZm();
-                            f(11)=Hankel->Zgauss(11, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11]))*KernelManager->GetRAWKernel(ik[11])->GetZs()/KernelManager->GetRAWKernel(ik[11])->GetZm();
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                -Pol[2]*Moment*QPI*cp*f(10),
-                                -Pol[2]*Moment*QPI*sp*f(10),
-                                 Pol[2]*Moment*QPI*f(11) );
-                            break;
-
-                        case BOTH:
-                            f(12)=Hankel->Zgauss(12, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[12]))*KernelManager->GetRAWKernel(ik[12])->GetZs();
-                            f(10)=Hankel->Zgauss(10, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[10]))*KernelManager->GetRAWKernel(ik[10])->GetZs()/KernelManager->GetRAWKernel(ik[10])->GetZm();
-                            f(11)=Hankel->Zgauss(11, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[11]))*KernelManager->GetRAWKernel(ik[11])->GetZs()/KernelManager->GetRAWKernel(ik[11])->GetZm();
-
-                            this->Receivers->AppendEfield(ifreq, irec,
-                                 Pol[2]*Moment*QPI*sp*f(12),
-                                -Pol[2]*Moment*QPI*cp*f(12),
-                                 0);
-
-                            this->Receivers->AppendHfield(ifreq, irec,
-                                -Pol[2]*Moment*QPI*cp*f(10),
-                                -Pol[2]*Moment*QPI*sp*f(10),
-                                 Pol[2]*Moment*QPI*f(11) );
-                            break;
+                if (POL & 1) {
+                    const Real Px = Phat[0]*QM;
+                    if (EH || EV) {
+                        AppendEfield(ifreq,
+                            Px*scp*((-f5+(Real)(2.)*f6/rho)+(f7-(Real)(2.)*f8/rho)),
+                            Px*((cps*f5-c2p*f6/rho)+(sps*f7+c2p*f8/rho)),
+                            Px*sp*f9 );
+                    }
+                    if (HH || HV) {
+                        AppendHfield(ifreq,
+                            Px*(cps*f0-c2p*f1/rho+(sps*f2+c2p*f3/rho)),
+                            Px*scp*(f0-(Real)(2.)*f1/rho-(f2-(Real)(2.)*f3/rho)),
+                            Px*cp*f4 );
                     }
                 }
-                if (std::abs(Pol[1]) > 0 || std::abs(Pol[0]) > 0) { // x or y grounded HED dipole
-
-                    switch (FieldsToCalculate) {
-
-                        case E:
-
-                            f(5) = Hankel->Zgauss(5, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]))*KernelManager->GetRAWKernel(ik[5])->GetZs();
-                            f(6) = Hankel->Zgauss(6, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]))*KernelManager->GetRAWKernel(ik[6])->GetZs();
-                            f(7) = Hankel->Zgauss(7, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetKs()/KernelManager->GetRAWKernel(ik[7])->GetYm();
-                            f(8) = Hankel->Zgauss(8, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetKs()/KernelManager->GetRAWKernel(ik[8])->GetYm();
-                            f(9) = Hankel->Zgauss(9, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetKs()/KernelManager->GetRAWKernel(ik[9])->GetYm();
-
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                Pol[0]*Moment*QPI*scp*((-f(5)+(Real)(2.)*f(6)/rho)+(f(7)-(Real)(2.)*f(8)/rho)),
-                                Pol[0]*Moment*QPI*((cps*f(5)-c2p*f(6)/rho)+(sps*f(7)+c2p*f(8)/rho)),
-                                Pol[0]*Moment*QPI*sp*f(9));
-                            }
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[1]*Moment*QPI*(-(sps*f(5)+c2p*f(6)/rho)-(cps*f(7)-c2p*f(8)/rho)),
-                                    Pol[1]*Moment*QPI*scp*((f(5)-(Real)(2.)*f(6)/rho)-(f(7)-(Real)(2.)*f(8)/rho)),
-                                    -Pol[1]*Moment*QPI*cp*f(9) );
-                            }
-                            break;
-
-                        case H:
-                            f(0) = Hankel->Zgauss(0, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0]))*KernelManager->GetRAWKernel(ik[0])->GetZs()/KernelManager->GetRAWKernel(ik[0])->GetZm();
-                            f(1) = Hankel->Zgauss(1, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1]))*KernelManager->GetRAWKernel(ik[1])->GetZs()/KernelManager->GetRAWKernel(ik[1])->GetZm();
-                            f(4) = Hankel->Zgauss(4, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4]))*KernelManager->GetRAWKernel(ik[4])->GetZs()/KernelManager->GetRAWKernel(ik[4])->GetZm();
-                            f(2) = Hankel->Zgauss(2, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2]))*KernelManager->GetRAWKernel(ik[2])->GetKs();
-                            f(3) = Hankel->Zgauss(3, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3]))*KernelManager->GetRAWKernel(ik[3])->GetKs();
-
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[0]*Moment*QPI*(cps*f(0)-c2p*f(1)/rho+(sps*f(2)+c2p*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*scp*(f(0)-(Real)(2.)*f(1)/rho-(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[0]*Moment*QPI*cp*f(4) );
-                            }
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[1]*Moment*QPI*scp*(f(0)-(Real)(2.)*f(1)/rho-(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[1]*Moment*QPI*(sps*f(0)+c2p*f(1)/rho+(cps*f(2)-c2p*f(3)/rho)),
-                                    Pol[1]*Moment*QPI*sp*f(4));
-                            }
-                            break;
-
-                        case BOTH:
-                            f(5) = Hankel->Zgauss(5, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[5]))*KernelManager->GetRAWKernel(ik[5])->GetZs();
-                            f(6) = Hankel->Zgauss(6, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[6]))*KernelManager->GetRAWKernel(ik[6])->GetZs();
-                            f(7) = Hankel->Zgauss(7, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[7]))*KernelManager->GetRAWKernel(ik[7])->GetKs()/KernelManager->GetRAWKernel(ik[7])->GetYm();
-                            f(8) = Hankel->Zgauss(8, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[8]))*KernelManager->GetRAWKernel(ik[8])->GetKs()/KernelManager->GetRAWKernel(ik[8])->GetYm();
-                            f(9) = Hankel->Zgauss(9, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[9]))*KernelManager->GetRAWKernel(ik[9])->GetKs()/KernelManager->GetRAWKernel(ik[9])->GetYm();
-                            f(0) = Hankel->Zgauss(0, TE, 0, rho, wavef, KernelManager->GetRAWKernel(ik[0]))*KernelManager->GetRAWKernel(ik[0])->GetZs()/KernelManager->GetRAWKernel(ik[0])->GetZm();
-                            f(1) = Hankel->Zgauss(1, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[1]))*KernelManager->GetRAWKernel(ik[1])->GetZs()/KernelManager->GetRAWKernel(ik[1])->GetZm();
-                            f(4) = Hankel->Zgauss(4, TE, 1, rho, wavef, KernelManager->GetRAWKernel(ik[4]))*KernelManager->GetRAWKernel(ik[4])->GetZs()/KernelManager->GetRAWKernel(ik[4])->GetZm();
-                            f(2) = Hankel->Zgauss(2, TM, 0, rho, wavef, KernelManager->GetRAWKernel(ik[2]))*KernelManager->GetRAWKernel(ik[2])->GetKs();
-                            f(3) = Hankel->Zgauss(3, TM, 1, rho, wavef, KernelManager->GetRAWKernel(ik[3]))*KernelManager->GetRAWKernel(ik[3])->GetKs();
-
-                            if (std::abs(Pol[0]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                Pol[0]*Moment*QPI*scp*((-f(5)+(Real)(2.)*f(6)/rho)+(f(7)-(Real)(2.)*f(8)/rho)),
-                                Pol[0]*Moment*QPI*((cps*f(5)-c2p*f(6)/rho)+(sps*f(7)+c2p*f(8)/rho)),
-                                Pol[0]*Moment*QPI*sp*f(9));
-
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                Pol[0]*Moment*QPI*(cps*f(0)-c2p*f(1)/rho+(sps*f(2)+c2p*f(3)/rho)),
-                                Pol[0]*Moment*QPI*scp*(f(0)-(Real)(2.)*f(1)/rho-(f(2)-(Real)(2.)*f(3)/rho)),
-                                Pol[0]*Moment*QPI*cp*f(4) );
-                            }
-                            if (std::abs(Pol[1]) > 0) {
-                                this->Receivers->AppendEfield(ifreq, irec,
-                                    Pol[1]*Moment*QPI*(-(sps*f(5)+c2p*f(6)/rho)-(cps*f(7)-c2p*f(8)/rho)),
-                                    Pol[1]*Moment*QPI*scp*((f(5)-(Real)(2.)*f(6)/rho)-(f(7)-(Real)(2.)*f(8)/rho)),
-                                    -Pol[1]*Moment*QPI*cp*f(9) );
-                                this->Receivers->AppendHfield(ifreq, irec,
-                                    Pol[1]*Moment*QPI*scp*(f(0)-(Real)(2.)*f(1)/rho-(f(2)-(Real)(2.)*f(3)/rho)),
-                                    Pol[1]*Moment*QPI*(sps*f(0)+c2p*f(1)/rho+(cps*f(2)-c2p*f(3)/rho)),
-                                    Pol[1]*Moment*QPI*sp*f(4));
-                            }
-
-                            break;
+                if (POL & 2) {
+                    const Real Py = Phat[1]*QM;
+                    if (EH || EV) {
+                        AppendEfield(ifreq,
+                            Py*(-(sps*f5+c2p*f6/rho)-(cps*f7-c2p*f8/rho)),
+                            Py*scp*((f5-(Real)(2.)*f6/rho)-(f7-(Real)(2.)*f8/rho)),
+                           -Py*cp*f9 );
+                    }
+                    if (HH || HV) {
+                        AppendHfield(ifreq,
+                            Py*scp*(f0-(Real)(2.)*f1/rho-(f2-(Real)(2.)*f3/rho)),
+                            Py*(sps*f0+c2p*f1/rho+(cps*f2-c2p*f3/rho)),
+                            Py*sp*f4 );
                     }
                 }
-                break;
-            case NOSOURCETYPE:
-                throw NonValidDipoleType(this);
+            }
+        }
+    }
+
+    // ====================  LOOP SOURCES  =======================
+
+    void DipoleSource::UpdateLoopFields(const int& ifreq, HankelTransform* Hankel, const Real& wavef) {
+
+        // Disk averages of the point dipole f(10), f(11) and f(12), and the direction of the
+        // horizontal fields
+        Complex f10(0), f11(0), f12(0);
+        Real cpl(cp), spl(sp);
+
+        const bool EH = IsCalculated( EXMASK | EYMASK );
+        const bool HH = IsCalculated( HXMASK | HYMASK );
+        const bool HV = IsCalculated( HZMASK );
+
+        KernelEM1DBase* K10 = HH ? KernelManager->GetRAWKernel(ik[10]) : nullptr;
+        KernelEM1DBase* K11 = (HV && rho >= LoopRadius) ? KernelManager->GetRAWKernel(ik[11]) : nullptr;
+        KernelEM1DBase* K12 = (EH || (HV && rho < LoopRadius)) ? KernelManager->GetRAWKernel(ik[12]) : nullptr;
+
+        if (rho < LoopRadius) {
+            // Hz = 2/a int K12 J0(lambda rho) J1(lambda a), with Hr and Ephi in the same form
+            if (HV) {
+                loopTransform = LOOPINSIDEJ0;
+                Hankel->ComputeRelated(LoopRadius, KernelManager);
+                f11 = Hankel->Zgauss(12, TE, 1, LoopRadius, wavef, K12)*K12->GetZs()/K12->GetZm();
+            }
+            if (rho > 1e-6*LoopRadius && (EH || HH)) {
+                loopTransform = LOOPINSIDEJ1;
+                Hankel->ComputeRelated(LoopRadius, KernelManager);
+                if (EH) {
+                    f12 = Hankel->Zgauss(12, TE, 1, LoopRadius, wavef, K12)*K12->GetZs();
+                }
+                if (K10 != nullptr) {
+                    f10 = Hankel->Zgauss(10, TE, 1, LoopRadius, wavef, K10)*K10->GetZs()/K10->GetZm();
+                }
+            } else {
+                // the horizontal fields vanish at the centre
+                cpl = 0;
+                spl = 0;
+            }
+        } else {
+            // Averaged over the disk, J0(lambda R) and J1(lambda R) are those of the centre,
+            // multiplied by 2 J1(lambda a)/(lambda a), so one transform at rho suffices
+            loopTransform = LOOPOUTSIDE;
+            Hankel->ComputeRelated(rho, KernelManager);
+            if (K10 != nullptr) {
+                f10 = Hankel->Zgauss(10, TE, 1, rho, wavef, K10)*K10->GetZs()/K10->GetZm();
+            }
+            if (K11 != nullptr) {
+                f11 = Hankel->Zgauss(11, TE, 0, rho, wavef, K11)*K11->GetZs()/K11->GetZm();
+            }
+            if (K12 != nullptr) {
+                f12 = Hankel->Zgauss(12, TE, 1, rho, wavef, K12)*K12->GetZs();
+            }
+        }
+
+        if (EH) {
+            AppendEfield(ifreq,
+                 Phat[2]*Moment*QPI*spl*f12,
+                -Phat[2]*Moment*QPI*cpl*f12,
+                 0);
+        }
+        if (HH || HV) {
+            AppendHfield(ifreq,
+                -Phat[2]*Moment*QPI*cpl*f10,
+                -Phat[2]*Moment*QPI*spl*f10,
+                 Phat[2]*Moment*QPI*f11 );
+        }
+    }
+
+    void DipoleSource::UpdateLineIntegralFields(const int& ifreq, HankelTransform* Hankel, const Real& wavef,
+                    const Eigen::Matrix<Real, Eigen::Dynamic, 4>& quad) {
+
+        KernelEM1DBase* K2  = IsCalculated(EXMASK | EYMASK) ? KernelManager->GetRAWKernel(ik[2]) : nullptr;
+        KernelEM1DBase* K7  = IsCalculated(HXMASK | HYMASK) ? KernelManager->GetRAWKernel(ik[7]) : nullptr;
+        KernelEM1DBase* K12 = IsCalculated(HZMASK) ? KernelManager->GetRAWKernel(ik[12]) : nullptr;
+
+        bool lagged = Hankel->GetABSER() > 0;
+        if (lagged) {
+            Real rhomin = quad.col(0).minCoeff();
+            // pad the lagged arguments so the spline ends are well clear of the nodes
+            Real rhomax = quad.col(0).maxCoeff()/std::pow(Hankel->GetABSER(), 3);
+            int nlag = 4;
+            Real lrho ( rhomax );
+            while ( lrho > rhomin ) {
+                nlag += 1;
+                lrho *= Hankel->GetABSER();
+            }
+            Hankel->ComputeLaggedRelated( rhomax, nlag, KernelManager );
+        }
+
+        // Weighted sums of the transforms along the wire
+        Complex hx(0), hy(0), hz(0), ex(0), ey(0);
+        for (int iq=0; iq<quad.rows(); ++iq) {
+            const Real& R = quad(iq, 0);
+            if (lagged) {
+                Hankel->SetLaggedArg( R );
+            } else {
+                Hankel->ComputeRelated( R, KernelManager );
+            }
+            if (K12 != nullptr) {
+                hz += quad(iq, 1) * Hankel->Zgauss(12, TE, 1, R, wavef, K12);
+            }
+            if (K7 != nullptr) {
+                Complex g7 = Hankel->Zgauss(7, TE, 0, R, wavef, K7);
+                hx += quad(iq, 2) * g7;
+                hy += quad(iq, 3) * g7;
+            }
+            if (K2 != nullptr) {
+                Complex g2 = Hankel->Zgauss(2, TE, 0, R, wavef, K2);
+                ex += quad(iq, 3) * g2;
+                ey -= quad(iq, 2) * g2;
+            }
+        }
+
+        if (K2 != nullptr) {
+            Complex cE = Phat[2]*Moment*QPI*K2->GetZs();
+            AppendEfield(ifreq, cE*ex, cE*ey, 0);
+        }
+        if (K7 != nullptr || K12 != nullptr) {
+            // the impedances of TE kernels 7 and 12 are the same
+            KernelEM1DBase* KH = (K12 != nullptr) ? K12 : K7;
+            Complex cH = -Phat[2]*Moment*QPI*KH->GetZs()/KH->GetZm();
+            AppendHfield(ifreq, cH*hx, cH*hy, cH*hz);
+        }
+    }
 
-        } // Source Type Switch
+    Real DipoleSource::LoopWeight( const Real& lambda ) const {
+        switch (loopTransform) {
+            case LOOPINSIDEJ0:
+                return (Real)(2.)/LoopRadius * BesselJ0(lambda*rho);
+            case LOOPINSIDEJ1:
+                return rho/LoopRadius * LoopFormFactor(lambda*rho);
+            case LOOPOUTSIDE:
+                return LoopFormFactor(lambda*LoopRadius);
+            default:
+                return 1;
+        }
+    }
+
+    Real DipoleSource::LoopFormFactor( const Real& x ) {
+        if (x < 12.) {
+            return LoopBesselSeries(1, x);
+        }
+        return 2.*LoopBesselAsymptotic(1, x)/x;
+    }
+
+    Real DipoleSource::BesselJ0( const Real& x ) {
+        if (x < 12.) {
+            return LoopBesselSeries(0, x);
+        }
+        return LoopBesselAsymptotic(0, x);
+    }
+
+    Real DipoleSource::LoopBesselSeries( const int& n, const Real& x ) {
+        Real x4 = x*x/4.;
+        Real term(1);
+        Real sum(1);
+        for (int k=1; k<100; ++k) {
+            term *= -x4/(k*(k+n));
+            sum += term;
+            if (std::abs(term) < 1e-17*std::abs(sum)) break;
+        }
+        return sum;
+    }
+
+    Real DipoleSource::LoopBesselAsymptotic( const int& n, const Real& x ) {
+        Real mu = 4*n*n;
+        Real P(1);
+        Real Q(0);
+        Real term(1);
+        for (int k=1; k<30; ++k) {
+            Real next = term * (mu - (2*k-1)*(2*k-1)) / (k*8.*x);
+            if (std::abs(next) > std::abs(term)) break;
+            term = next;
+            switch (k%4) {
+                case 0: P += term; break;
+                case 1: Q += term; break;
+                case 2: P -= term; break;
+                case 3: Q -= term; break;
+            }
+            if (std::abs(term) < 1e-17) break;
+        }
+        Real chi = x - (2*n+1)*PI/4.;
+        return std::sqrt(2./(PI*x))*(P*std::cos(chi) - Q*std::sin(chi));
     }
 
     // ====================  INQUIRY       ======================
@@ -1600,6 +1118,14 @@ namespace Lemma {
         return this->Moment;
     }
 
+    Real DipoleSource::GetLoopRadius() {
+        return this->LoopRadius;
+    }
+
+    bool DipoleSource::GetLineIntegral() {
+        return this->LineIntegral;
+    }
+
     int DipoleSource::GetNumberOfFrequencies() {
         return (int)(this->Freqs.size());
     }
@@ -14,6 +14,10 @@
 #include "FieldPoints.h"
 #include "WireAntenna.h"
 #include "PolygonalWireAntenna.h"
+#include "CircularLoop.h"
+
+#include <map>
+#include <exception>
 
 #ifdef LEMMAUSEOMP
 #include "omp.h"
@@ -174,12 +178,46 @@ namespace Lemma {
         this->Antenna = antennae;
     }
 
+    void EMEarth1D::AttachCircularLoop(std::shared_ptr<CircularLoop> loop) {
+        this->Loop = loop;
+    }
+
     void EMEarth1D::SetFieldsToCalculate(const FIELDCALCULATIONS &calc) {
         FieldsToCalculate = calc;
     }
 
     void EMEarth1D::SetHankelTransformMethod( const HANKELTRANSFORMTYPE &type) {
         HankelType = type;
+        if (HankelType == FHTAUTO && AutoHankel == nullptr) {
+            AutoHankel = FHTAuto::NewSP();
+        }
+    }
+
+    void EMEarth1D::SetHankelTransformTolerance( const Real& tol ) {
+        if (AutoHankel == nullptr) {
+            AutoHankel = FHTAuto::NewSP();
+        }
+        AutoHankel->SetTolerance( tol );
+    }
+
+    void EMEarth1D::SetShareLaggedConvolution( const bool& share ) {
+        ShareLaggedConvolution = share;
+    }
+
+    void EMEarth1D::SetLineIntegralEvaluation( const bool& line ) {
+        LineIntegralEvaluation = line;
+    }
+
+    void EMEarth1D::SetNumberOfThreads( const int& nthreads ) {
+        NumberOfThreads = std::max(0, nthreads);
+    }
+
+    int EMEarth1D::GetNumberOfThreads() const {
+        #ifdef LEMMAUSEOMP
+        return (NumberOfThreads > 0) ? NumberOfThreads : omp_get_max_threads();
+        #else
+        return 1;
+        #endif
     }
 
     /*
@@ -223,6 +261,13 @@ namespace Lemma {
 
         Receivers->ClearFields();
 
+        // Evaluate the earth once per frequency, shared by all threads
+        VectorXr omega(Antenna->GetNumberOfFrequencies());
+        for (int ifreq=0; ifreq<Antenna->GetNumberOfFrequencies(); ++ifreq) {
+            omega(ifreq) = 2.*PI*Antenna->GetFrequency(ifreq);
+        }
+        Earth->EvaluateFrequencies( omega );
+
         // Check to make sure Receivers are set up for all calculations
         switch(FieldsToCalculate) {
             case E:
@@ -241,157 +286,296 @@ namespace Lemma {
                 break;
         }
 
+        #ifdef LEMMAUSEOMP
+        Receivers->BeginThreadAccumulation( GetNumberOfThreads() );
+        #endif
+
         if (Antenna->GetName() == std::string("PolygonalWireAntenna") || Antenna->GetName() == std::string("TEMTransmitter") ) {
             icalc += 1;
+
             // Check to see if they are all on a plane? If so we can do this fast
-            if ( Antenna->IsHorizontallyPlanar() && ( HankelType == ANDERSON801 || HankelType == FHTKEY201  || HankelType==FHTKEY101 ||
+            bool lagged = Antenna->IsHorizontallyPlanar() && ( HankelType == ANDERSON801 || HankelType == FHTKEY201  || HankelType==FHTKEY101 ||
                                                       HankelType == FHTKEY51    || HankelType == FHTKONG61  || HankelType == FHTKONG121 ||
-                                                      HankelType == FHTKONG241  || HankelType == IRONS )) {
+                                                      HankelType == FHTKONG241  || HankelType == IRONS      || HankelType == FHTAUTO );
+
+            // Closed loops in the air can be evaluated along the wire
+            bool lineintegral = LineIntegralEvaluation && Antenna->IsHorizontallyPlanar() &&
+                                Antenna->IsClosed() &&
+                                Earth->GetLayerAtThisDepth( Antenna->GetPoints()(2, 0) ) == 0;
+
+            const int nfreq = Antenna->GetNumberOfFrequencies();
+            std::vector<int> irecs;
+            for (int irec=0; irec<Receivers->GetNumberOfPoints(); ++irec) {
+                if (!Receivers->GetMask(irec)) {
+                    irecs.push_back(irec);
+                }
+            }
+            const int nrec = static_cast<int>(irecs.size());
+
+            // Work is split into tiles of (receiver, frequency block, dipole block) which are
+            // scheduled as tasks, idle workers pick up whatever tiles are left. Each worker keeps
+            // its own Hankel transform and antenna copy for the whole calculation, as the dipole
+            // approximation depends on the receiver.
+            const int nworkers = GetNumberOfThreads();
+            auto Worker = [] () {
+                #ifdef LEMMAUSEOMP
+                return omp_get_thread_num();
+                #else
+                return 0;
+                #endif
+            };
+            std::vector< std::shared_ptr<HankelTransform> >        Hankels(nworkers);
+            std::vector< std::shared_ptr<PolygonalWireAntenna> >  AntCopies(nworkers);
+            for (int iw=0; iw<nworkers; ++iw) {
+                Hankels[iw] = NewHankelTransform();
+                AntCopies[iw] = static_cast<PolygonalWireAntenna*>(Antenna.get())->ClonePA();
+            }
+
+            // Aim for a few tiles per worker so that uneven tiles even out
+            const int ntiles = 4*nworkers;
+
+            /* Progress display bar for long calculations, in receiver--frequency pairs */
+            std::unique_ptr<ProgressBar> mdisp;
+            if (progressbar) {
+                mdisp = std::make_unique< ProgressBar >( nrec*nfreq );
+            }
+            // The bar is advanced from within tasks, on any worker
+            auto Progress = [&mdisp]( const int& npairs ) {
+                #ifdef LEMMAUSEOMP
+                #pragma omp critical (EMEarth1DProgress)
+                #endif
+                for (int ip=0; ip<npairs; ++ip) ++ *mdisp;
+            };
+
+            if (lineintegral) {
+
+                // Each receiver and frequency needs a single convolution, tiles are
+                // (receiver, frequency)
+                #ifdef LEMMAUSEOMP
+                #pragma omp parallel num_threads(nworkers)
+                #pragma omp single
+                #endif
+                for (int ii=0; ii<nrec; ++ii) {
+                    for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+                        #ifdef LEMMAUSEOMP
+                        #pragma omp task firstprivate(ii, ifreq)
+                        #endif
+                        {
+                            const int iw = Worker();
+                            SolveLineIntegralTxRxPair(irecs[ii], Hankels[iw].get(), ifreq, AntCopies[iw].get());
+                            if (progressbar) {
+                                Progress( 1 );
+                            }
+                        } // task
+                    }
+                }
+
+            } else if (lagged && ShareLaggedConvolution) {
 
-                std::unique_ptr<ProgressBar> mdisp;
-                if (progressbar) {
-                    mdisp = std::make_unique< ProgressBar >( Receivers->GetNumberOfPoints()*Antenna->GetNumberOfFrequencies() );
+                // Kernels only depend on receiver height, group receivers into planes
+                std::map<Real, std::vector<int> > planemap;
+                for (int irec : irecs) {
+                    planemap[ Receivers->GetLocationZ(irec) ].push_back(irec);
+                }
+                std::vector< std::vector<int> > planes;
+                std::vector<Real> rhomins;
+                std::vector<Real> rhomaxs;
+                for (auto& plane : planemap) {
+                    // offset range covering every receiver--dipole pair in plane
+                    Real rhomin = 1e9;
+                    Real rhomax = 1e-9;
+                    for (int irec : plane.second) {
+                        Real rmin, rmax;
+                        LaggedOffsetBounds(irec, rmin, rmax);
+                        rhomin = std::min(rhomin, rmin);
+                        rhomax = std::max(rhomax, rmax);
+                    }
+                    planes.push_back(plane.second);
+                    rhomins.push_back(rhomin);
+                    rhomaxs.push_back(rhomax);
                 }
 
-                for (int ifreq=0; ifreq<Antenna->GetNumberOfFrequencies();++ifreq) {
-                    Real wavef = 2.*PI* Antenna->GetFrequency(ifreq);
-                    #ifdef LEMMAUSEOMP
-                    #pragma omp parallel
-                    {
-                    #endif
-                    auto Hankel = HankelTransformFactory::NewSP( HankelType );
-                    auto AntCopy = static_cast<PolygonalWireAntenna*>(Antenna.get())->ClonePA();
-                    #ifdef LEMMAUSEOMP
-                    #pragma omp for schedule(static, 1)
-                    #endif
-                    for (int irec=0; irec<Receivers->GetNumberOfPoints(); ++irec) {
-                        SolveLaggedTxRxPair(irec, Hankel.get(), wavef, ifreq, AntCopy.get());
-                        if (progressbar) {
-                            ++ *mdisp;
+                // The convolution of each plane and frequency is computed once, into its own
+                // transform, by a task that the tiles of that plane and frequency depend on. Each
+                // tile copies the lagged table into its worker's transform before use.
+                const int nplanes = static_cast<int>(planes.size());
+                std::vector< std::shared_ptr<HankelTransform> > PlaneHankels(nplanes*nfreq);
+                std::vector<char> PlaneReady(nplanes*nfreq);
+                char* ready = PlaneReady.data();
+
+                #ifdef LEMMAUSEOMP
+                #pragma omp parallel num_threads(nworkers)
+                #pragma omp single
+                #endif
+                for (int iplane=0; iplane<nplanes; ++iplane) {
+                    const int nplane = static_cast<int>(planes[iplane].size());
+                    const int block = (nplane + nworkers - 1) / nworkers;
+                    for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+                        const int ipf = iplane*nfreq + ifreq;
+                        #ifdef LEMMAUSEOMP
+                        #pragma omp task firstprivate(iplane, ifreq, ipf) depend(out: ready[ipf])
+                        #endif
+                        {
+                            const int iw = Worker();
+                            PlaneHankels[ipf] = NewHankelTransform();
+                            ComputeSharedLaggedPlane( planes[iplane][0], rhomins[iplane], rhomaxs[iplane],
+                                    PlaneHankels[ipf].get(), ifreq, AntCopies[iw].get() );
+                        } // task
+                        for (int ii0=0; ii0<nplane; ii0+=block) {
+                            #ifdef LEMMAUSEOMP
+                            #pragma omp task firstprivate(iplane, ifreq, ipf, ii0) depend(in: ready[ipf])
+                            #endif
+                            {
+                                const int iw = Worker();
+                                Hankels[iw]->CopyLaggedRelated( *PlaneHankels[ipf] );
+                                auto tDipole = PrepareSharedLaggedSource( planes[iplane][ii0], ifreq,
+                                        AntCopies[iw].get() );
+                                Real wavef = 2.*PI* Antenna->GetFrequency(ifreq);
+                                for (int ii=ii0; ii<std::min(ii0+block, nplane); ++ii) {
+                                    SolveSharedLaggedTxRxPair(planes[iplane][ii], Hankels[iw].get(), wavef, ifreq,
+                                            AntCopies[iw].get(), tDipole.get());
+                                    if (progressbar) {
+                                        Progress( 1 );
+                                    }
+                                }
+                            } // task
                         }
                     }
-                    #ifdef LEMMAUSEOMP
-                    #pragma omp barrier
+                }
+
+            } else if (lagged) {
+
+                // A lagged convolution covers all dipoles, so tiles are (receiver, frequency)
+                #ifdef LEMMAUSEOMP
+                #pragma omp parallel num_threads(nworkers)
+                #pragma omp single
+                #endif
+                for (int ii=0; ii<nrec; ++ii) {
+                    for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+                        #ifdef LEMMAUSEOMP
+                        #pragma omp task firstprivate(ii, ifreq)
+                        #endif
+                        {
+                            const int iw = Worker();
+                            Real wavef = 2.*PI* Antenna->GetFrequency(ifreq);
+                            SolveLaggedTxRxPair(irecs[ii], Hankels[iw].get(), wavef, ifreq, AntCopies[iw].get());
+                            if (progressbar) {
+                                Progress( 1 );
+                            }
+                        } // task
                     }
-                    #endif
                 }
 
-            } else if (Receivers->GetNumberOfPoints() > Antenna->GetNumberOfFrequencies()) {
+            } else {
 
-                /* Progress display bar for long calculations */
-                std::unique_ptr<ProgressBar> mdisp;
-                if (progressbar) {
-                    mdisp = std::make_unique< ProgressBar > ( Receivers->GetNumberOfPoints()*Antenna->GetNumberOfFrequencies() );
+                // Tiles holding a block of dipoles sum into a private single point copy of the
+                // receiver, one per worker
+                std::vector< std::shared_ptr<FieldPoints> > TileReceivers(nworkers);
+                for (int iw=0; iw<nworkers; ++iw) {
+                    TileReceivers[iw] = FieldPoints::NewSP();
+                    TileReceivers[iw]->SetNumberOfPoints(1);
+                    if (FieldsToCalculate != H) TileReceivers[iw]->SetNumberOfBinsE(nfreq);
+                    if (FieldsToCalculate != E) TileReceivers[iw]->SetNumberOfBinsH(nfreq);
+                    TileReceivers[iw]->SetThreadPrivate(true);
                 }
 
-                // parallelise across receivers
                 #ifdef LEMMAUSEOMP
-                #pragma omp parallel
+                #pragma omp parallel num_threads(nworkers)
+                #pragma omp single
                 #endif
-                { // OpenMP Parallel Block
-                    // Since these antennas change we need a local copy for each
-                    // thread.
-                    auto AntCopy = static_cast<PolygonalWireAntenna*>(Antenna.get())->ClonePA();
-                    auto Hankel = HankelTransformFactory::NewSP( HankelType );
-
+                for (int ii=0; ii<nrec; ++ii) {
                     #ifdef LEMMAUSEOMP
-                    #pragma omp for schedule(static, 1) //nowait
+                    #pragma omp task firstprivate(ii)
                     #endif
-                    for (int irec=0; irec<Receivers->GetNumberOfPoints(); ++irec) {
-                        if (!Receivers->GetMask(irec)) {
-                            AntCopy->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
-                            for (int idip=0; idip < static_cast<int>(AntCopy->GetNumberOfDipoles()); ++idip) {
-                                auto tDipole = AntCopy->GetDipoleSource(idip);
-                                //#ifdef LEMMAUSEOMP
-                                //#pragma omp for schedule(static, 1)
-                                //#endif
-                                for (int ifreq=0; ifreq<tDipole->GetNumberOfFrequencies();
-                                        ++ifreq) {
-                                    // Propogation constant in free space
-                                    Real wavef   = tDipole->GetAngularFrequency(ifreq) *
-                                          std::sqrt(MU0*EPSILON0);
-                                    SolveSingleTxRxPair(irec, Hankel.get(), wavef, ifreq, tDipole.get());
-                                } // freq loop
-                            } // dipole loop
-                        } // mask
-                        //std::cout << "Normal Path\n";
-                        //std::cout << Receivers->GetHfield(0, irec) << std::endl;
-                        //if (irec == 1) exit(0);
-                        if (progressbar) {
-                            ++ *mdisp;
-                        }
-                    } // receiver loop
-                } // OMP_PARALLEL BLOCK
-            } else if (Antenna->GetNumberOfFrequencies() > 8) {
-                // parallel across frequencies
-                //std::cout << "freq parallel #2" << std::endl;
-                for (int irec=0; irec<Receivers->GetNumberOfPoints(); ++irec) {
-                    if (!Receivers->GetMask(irec)) {
-                        static_cast<PolygonalWireAntenna*>(Antenna.get())->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
-                        #ifdef LEMMAUSEOMP
-                        #pragma omp parallel
-                        #endif
-                        { // OpenMP Parallel Block
-
-                            auto Hankel = HankelTransformFactory::NewSP( HankelType );
+                    {
+                        // The number of dipoles is only known once the antenna is approximated
+                        const int irec = irecs[ii];
+                        const int iw = Worker();
+                        AntCopies[iw]->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
+                        const int ndip = AntCopies[iw]->GetDipoleSet().GetNumberOfDipoles();
+
+                        // Split across frequencies first, then dipoles, when there are too few
+                        // receivers to keep every worker busy
+                        const int nsplit = std::max(1, std::min(ndip*nfreq, (ntiles + nrec - 1)/nrec));
+                        const int nfblock = std::min(nfreq, nsplit);
+                        const int ndblock = std::max(1, std::min(ndip, (nsplit + nfblock - 1)/nfblock));
+                        if (nfblock*ndblock == 1) {
+                            SolveWireAntennaTile(Receivers, irec, 0, nfreq, 0, ndip, Hankels[iw].get(),
+                                    AntCopies[iw].get());
+                            if (progressbar) {
+                                Progress( nfreq );
+                            }
+                        } else {
+                            // Dipole blocks of a frequency may run on any worker, so each tile keeps
+                            // its own sum and the tiles are reduced in dipole order, which keeps the
+                            // result independent of the scheduling
+                            std::vector<Vector3Xcr> TileE(nfblock*ndblock);
+                            std::vector<Vector3Xcr> TileH(nfblock*ndblock);
+                            for (int ifb=0; ifb<nfblock; ++ifb) {
+                                for (int idb=0; idb<ndblock; ++idb) {
+                                    const int ifreq0 = ifb*nfreq/nfblock;
+                                    const int ifreq1 = (ifb+1)*nfreq/nfblock;
+                                    const int idip0 = idb*ndip/ndblock;
+                                    const int idip1 = (idb+1)*ndip/ndblock;
+                                    const int itile = ifb*ndblock + idb;
+                                    #ifdef LEMMAUSEOMP
+                                    #pragma omp task firstprivate(ifreq0, ifreq1, idip0, idip1, itile) shared(TileE, TileH)
+                                    #endif
+                                    {
+                                        const int jw = Worker();
+                                        std::shared_ptr<FieldPoints> Rx = TileReceivers[jw];
+                                        Rx->SetLocation(0, Receivers->GetLocation(irec));
+                                        Rx->SetComponents(0, Receivers->GetComponents(irec));
+                                        Rx->ClearFields();
+                                        SolveWireAntennaTile(Rx, 0, ifreq0, ifreq1, idip0, idip1,
+                                                Hankels[jw].get(), AntCopies[jw].get());
+                                        TileE[itile].resize(3, ifreq1-ifreq0);
+                                        TileH[itile].resize(3, ifreq1-ifreq0);
+                                        for (int ifreq=ifreq0; ifreq<ifreq1; ++ifreq) {
+                                            if (FieldsToCalculate != H) {
+                                                TileE[itile].col(ifreq-ifreq0) = Rx->GetEfield(ifreq, 0);
+                                            }
+                                            if (FieldsToCalculate != E) {
+                                                TileH[itile].col(ifreq-ifreq0) = Rx->GetHfield(ifreq, 0);
+                                            }
+                                        }
+                                        // count each frequency once, from the first dipole block
+                                        if (progressbar && idip0 == 0) {
+                                            Progress( ifreq1-ifreq0 );
+                                        }
+                                    } // task
+                                }
+                            }
                             #ifdef LEMMAUSEOMP
-                            #pragma omp for schedule(static, 1)
+                            #pragma omp taskwait
                             #endif
-                            for (int ifreq=0; ifreq<Antenna->GetNumberOfFrequencies(); ++ifreq) {
-                                for (int idip=0; idip< static_cast<int>(Antenna->GetNumberOfDipoles()); ++idip) {
-                                    auto tDipole = Antenna->GetDipoleSource(idip);
-                                    // Propogation constant in free space
-                                    Real wavef   = tDipole->GetAngularFrequency(ifreq) *
-                                          std::sqrt(MU0*EPSILON0);
-                                    SolveSingleTxRxPair(irec, Hankel.get(), wavef, ifreq, tDipole.get());
-                                } // dipole loop
-                            } // frequency loop
-                        } // OMP_PARALLEL BLOCK
-                    } // mask loop
-                    //if (Receivers->GetNumberOfPoints() > 100) {
-                    //    ++ mdisp;
-                    //}
-                } // receiver loop
-            } // Frequency Parallel
-              else {
-                //std::cout << "parallel across transmitter dipoles " << std::endl;
-                for (int irec=0; irec<Receivers->GetNumberOfPoints(); ++irec) {
-                    if (!Receivers->GetMask(irec)) {
-                        static_cast<PolygonalWireAntenna*>(Antenna.get())->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
-//                         std::cout << "Not Masked " << std::endl;
-//                         std::cout << "n Freqs " << Antenna->GetNumberOfFrequencies() << std::endl;
-//                         std::cout << "n Dipoles " << Antenna->GetNumberOfDipoles() << std::endl;
-//                         if ( !Antenna->GetNumberOfDipoles() ) {
-//                             std::cout << "NO DIPOLES!!!!!!!!!!!!!!!!!!!!!!!!!!\n";
-// //                            std::cout << "rec location " << Receivers->GetLocation(irec) << std::endl;
-// //                        }
-                        #ifdef LEMMAUSEOMP
-                        #pragma omp parallel
-                        #endif
-                        { // OpenMP Parallel Block
-                            auto Hankel = HankelTransformFactory::NewSP( HankelType );
-                            for (int ifreq=0; ifreq<Antenna->GetNumberOfFrequencies(); ++ifreq) {
-                                #ifdef LEMMAUSEOMP
-                                #pragma omp for schedule(static, 1)
-                                #endif
-                                for (int idip=0; idip<static_cast<int>(Antenna->GetNumberOfDipoles()); ++idip) {
-                                    //#pragma omp critical
-                                    //{
-                                    //cout << "idip=" << idip << "\tthread num=" << omp_get_thread_num() << '\n';
-                                    //}
-                                    auto tDipole = Antenna->GetDipoleSource(idip);
-                                    // Propogation constant in free space
-                                    Real wavef   = tDipole->GetAngularFrequency(ifreq) * std::sqrt(MU0*EPSILON0);
-                                    SolveSingleTxRxPair(irec, Hankel.get(), wavef, ifreq, tDipole.get());
-                                } // dipole loop
-                            } // frequency loop
-                        } // OMP_PARALLEL BLOCK
-                    } // mask loop
-                    //if (Receivers->GetNumberOfPoints() > 100) {
-                    //    ++ disp;
-                    //}
-                } // receiver loop
-           } // Polygonal parallel logic
+                            for (int ifb=0; ifb<nfblock; ++ifb) {
+                                const int ifreq0 = ifb*nfreq/nfblock;
+                                const int ifreq1 = (ifb+1)*nfreq/nfblock;
+                                for (int ifreq=ifreq0; ifreq<ifreq1; ++ifreq) {
+                                    Vector3cr Esum = Vector3cr::Zero();
+                                    Vector3cr Hsum = Vector3cr::Zero();
+                                    for (int idb=0; idb<ndblock; ++idb) {
+                                        if (FieldsToCalculate != H) {
+                                            Esum += TileE[ifb*ndblock + idb].col(ifreq-ifreq0);
+                                        }
+                                        if (FieldsToCalculate != E) {
+                                            Hsum += TileH[ifb*ndblock + idb].col(ifreq-ifreq0);
+                                        }
+                                    }
+                                    if (FieldsToCalculate != H) {
+                                        Receivers->AppendEfield(ifreq, irec, Esum(0), Esum(1), Esum(2));
+                                    }
+                                    if (FieldsToCalculate != E) {
+                                        Receivers->AppendHfield(ifreq, irec, Hsum(0), Hsum(1), Hsum(2));
+                                    }
+                                }
+                            }
+                        }
+                    } // task
+                }
+
+            } // Polygonal parallel logic
         } else {
              std::cerr << "Lemma with WireAntenna class is currently broken"
                   << " fix or use PolygonalWireAntenna\n" << std::endl;
@@ -407,6 +591,9 @@ namespace Lemma {
             this->Dipole = nullptr;
         }
 
+        #ifdef LEMMAUSEOMP
+        Receivers->EndThreadAccumulation();
+        #endif
     }
 
     #ifdef KIHALEE_EM1D
@@ -674,15 +861,29 @@ namespace Lemma {
 #endif
 
 
+    std::shared_ptr<HankelTransform> EMEarth1D::NewHankelTransform( ) {
+        if (HankelType == FHTAUTO) {
+            return AutoHankel->Share();
+        }
+        return HankelTransformFactory::NewSP( HankelType );
+    }
+
     void EMEarth1D::SolveSingleTxRxPair (const int &irec, HankelTransform *Hankel, const Real &wavef, const int &ifreq,
                    DipoleSource *tDipole) {
         ++icalcinner;
 
+        tDipole->SetKernels( ifreq, FieldsToCalculate, Receivers, irec, Earth );
+
+        // Loop sources choose their own transforms
+        if (tDipole->GetLoopRadius() > 0) {
+            tDipole->UpdateLoopFields( ifreq, Hankel, wavef );
+            return;
+        }
+
         // The PGI compilers fail on the below line, and others like it.
         Real rho = (Receivers->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
         //Real rho = ( ((Receivers->GetLocation(irec) - tDipole->GetLocation()).head(2)).eval() ).norm();
 
-        tDipole->SetKernels( ifreq, FieldsToCalculate, Receivers, irec, Earth );
         Hankel->ComputeRelated( rho, tDipole->GetKernelManager() );
         tDipole->UpdateFields( ifreq,  Hankel, wavef );
     }
@@ -700,12 +901,12 @@ namespace Lemma {
                     const Real &wavef, const int &ifreq, PolygonalWireAntenna* antenna) {
 
         antenna->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
+        const DipoleSet& Dipoles = antenna->GetDipoleSet();
         // Determine the min and max arguments
         Real rhomin = 1e9;
         Real rhomax = 1e-9;
-        for (unsigned int idip=0; idip<antenna->GetNumberOfDipoles(); ++idip) {
-            auto tDipole = antenna->GetDipoleSource(idip);
-            Real rho = (Receivers->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
+        for (int idip=0; idip<Dipoles.GetNumberOfDipoles(); ++idip) {
+            Real rho = (Receivers->GetLocation(irec).head<2>() - Dipoles.GetLocation(idip).head<2>()).norm();
             rhomin = std::min(rhomin, rho);
             rhomax = std::max(rhomax, rho);
         }
@@ -718,21 +919,20 @@ namespace Lemma {
             lrho *= Hankel->GetABSER();
         }
 
-        auto tDipole = antenna->GetDipoleSource(0);
+        // tDipole is moved to each dipole of the set in turn, the kernels of the first serve them all
+        auto tDipole = antenna->GetDipoleSetSource();
+        tDipole->SetLocation( Dipoles.GetLocation(0) );
+        tDipole->SetMoment( Dipoles.GetMoment(0) );
+        tDipole->SetPolarisation( Dipoles.GetPolarisation(0) );
         tDipole->SetKernels(ifreq, FieldsToCalculate, Receivers, irec, Earth);
 
         // Instead we should pass the antenna into this so that Hankel hass all the rho arguments...
         Hankel->ComputeLaggedRelated( 1.0*rhomax, nlag, tDipole->GetKernelManager() );
 
-        // Sort the dipoles by rho
-        for (unsigned int idip=0; idip<antenna->GetNumberOfDipoles(); ++idip) {
-            // Can we avoid these two lines, and instead vary the moment of the previous tDipole?
-            // SetKernels is somewhat heavy
-            auto rDipole = antenna->GetDipoleSource(idip);
-            //tDipole->SetKernels(ifreq, FieldsToCalculate, Receivers, irec, Earth); // expensive, and not used
-            tDipole->SetLocation( rDipole->GetLocation() );
-            tDipole->SetMoment( rDipole->GetMoment() );
-            tDipole->SetPolarisation( rDipole->GetPolarisation() );
+        for (int idip=0; idip<Dipoles.GetNumberOfDipoles(); ++idip) {
+            tDipole->SetLocation( Dipoles.GetLocation(idip) );
+            tDipole->SetMoment( Dipoles.GetMoment(idip) );
+            tDipole->SetPolarisation( Dipoles.GetPolarisation(idip) );
             tDipole->SetupLight( ifreq, FieldsToCalculate, irec );
 
             // Pass Hankel2 a message here so it knows which one to return in Zgauss!
@@ -742,9 +942,142 @@ namespace Lemma {
         }
     }
 
+    void EMEarth1D::SolveLineIntegralTxRxPair(const int &irec, HankelTransform* Hankel,
+                    const int &ifreq, PolygonalWireAntenna* antenna) {
+
+        antenna->ApproximateWithLineIntegral(Receivers->GetLocation(irec));
+        auto tDipole = antenna->GetLineIntegralSource();
+        tDipole->SetKernels(ifreq, FieldsToCalculate, Receivers, irec, Earth);
+
+        // Propogation constant in free space
+        Real wavef   = tDipole->GetAngularFrequency(ifreq) * std::sqrt(MU0*EPSILON0);
+        tDipole->UpdateLineIntegralFields( ifreq, Hankel, wavef, antenna->GetLineIntegralQuadrature() );
+    }
+
+    void EMEarth1D::SolveWireAntennaTile(const std::shared_ptr<FieldPoints>& Rx, const int &irec,
+                    const int& ifreq0, const int& ifreq1, const int& idip0, const int& idip1,
+                    HankelTransform* Hankel, PolygonalWireAntenna* antenna) {
+
+        // Repeated calls for the same receiver do not resplit the antenna
+        antenna->ApproximateWithElectricDipoles(Rx->GetLocation(irec));
+        const DipoleSet& Dipoles = antenna->GetDipoleSet();
+
+        // A single source is moved along the set, its kernels are rebuilt only if the
+        // configuration changes, which it does not for a wire in a single layer
+        auto tDipole = antenna->GetDipoleSetSource();
+        for (int idip=idip0; idip<idip1; ++idip) {
+            tDipole->SetLocation( Dipoles.GetLocation(idip) );
+            tDipole->SetMoment( Dipoles.GetMoment(idip) );
+            tDipole->SetPolarisation( Dipoles.GetPolarisation(idip) );
+            Real rho = (Rx->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
+            for (int ifreq=ifreq0; ifreq<ifreq1; ++ifreq) {
+                // Propogation constant in free space
+                Real wavef   = tDipole->GetAngularFrequency(ifreq) * std::sqrt(MU0*EPSILON0);
+                tDipole->SetKernels( ifreq, FieldsToCalculate, Rx, irec, Earth );
+                Hankel->ComputeRelated( rho, tDipole->GetKernelManager() );
+                tDipole->UpdateFields( ifreq, Hankel, wavef );
+            } // freq loop
+        } // dipole loop
+    }
+
+    std::shared_ptr<DipoleSource> EMEarth1D::PrepareSharedLaggedSource(const int &irec,
+                    const int &ifreq, PolygonalWireAntenna* antenna) {
+        // Any dipole will do, as they all share a height, type, and horizontal polarisation
+        antenna->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
+        const DipoleSet& Dipoles = antenna->GetDipoleSet();
+        auto tDipole = antenna->GetDipoleSetSource();
+        tDipole->SetLocation( Dipoles.GetLocation(0) );
+        tDipole->SetMoment( Dipoles.GetMoment(0) );
+        tDipole->SetPolarisation( Dipoles.GetPolarisation(0) );
+        tDipole->SetKernels(ifreq, FieldsToCalculate, Receivers, irec, Earth);
+        return tDipole;
+    }
+
+    void EMEarth1D::ComputeSharedLaggedPlane(const int &irec,
+                    const Real& rhomin, const Real& rhomax, HankelTransform* Hankel,
+                    const int &ifreq, PolygonalWireAntenna* antenna) {
+
+        // Determine number of lagged convolutions to do
+        int nlag = 1;
+        Real lrho ( 1.0 * rhomax );
+        while ( lrho > rhomin ) {
+            nlag += 1;
+            lrho *= Hankel->GetABSER();
+        }
+
+        auto tDipole = PrepareSharedLaggedSource(irec, ifreq, antenna);
+        Hankel->ComputeLaggedRelated( 1.0*rhomax, nlag, tDipole->GetKernelManager() );
+    }
+
+    void EMEarth1D::SolveSharedLaggedTxRxPair(const int &irec, HankelTransform* Hankel,
+                    const Real &wavef, const int &ifreq, PolygonalWireAntenna* antenna,
+                    DipoleSource* tDipole) {
+
+        antenna->ApproximateWithElectricDipoles(Receivers->GetLocation(irec));
+        const DipoleSet& Dipoles = antenna->GetDipoleSet();
+        for (int idip=0; idip<Dipoles.GetNumberOfDipoles(); ++idip) {
+            tDipole->SetLocation( Dipoles.GetLocation(idip) );
+            tDipole->SetMoment( Dipoles.GetMoment(idip) );
+            tDipole->SetPolarisation( Dipoles.GetPolarisation(idip) );
+            tDipole->SetupLight( ifreq, FieldsToCalculate, irec );
+
+            Real rho = (Receivers->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
+            Hankel->SetLaggedArg( rho );
+            tDipole->UpdateFields( ifreq,  Hankel, wavef );
+        }
+    }
+
+    void EMEarth1D::LaggedOffsetBounds(const int& irec, Real& rhomin, Real& rhomax) {
+        // Dipoles lie on the wire segments, so the wire itself bounds the offsets
+        Vector3Xr Points = Antenna->GetPoints();
+        Eigen::Matrix<Real, 2, 1> rp = Receivers->GetLocation(irec).head<2>();
+        rhomin = 1e9;
+        rhomax = 1e-9;
+        for (int ip=0; ip<Points.cols(); ++ip) {
+            rhomax = std::max(rhomax, (rp - Points.col(ip).head<2>()).norm());
+        }
+        for (int iseg=0; iseg<Points.cols()-1; ++iseg) {
+            Eigen::Matrix<Real, 2, 1> p0 = Points.col(iseg).head<2>();
+            Eigen::Matrix<Real, 2, 1> v  = Points.col(iseg+1).head<2>() - p0;
+            Real t = (v.squaredNorm() > 0) ? (rp-p0).dot(v) / v.squaredNorm() : 0;
+            t = std::max(Real(0), std::min(Real(1), t));
+            rhomin = std::min(rhomin, (rp - (p0 + t*v)).norm());
+        }
+        // receivers lying on the wire are singular anyway, avoid an unbounded number of lags
+        rhomin = std::max(rhomin, Real(1e-3));
+    }
+
     //////////////////////////////////////////////////////////
     // Thread safe OO Reimplimentation of KiHand's
     // EM1DNEW.for programme
+    void EMEarth1D::CalculateCircularLoopFields() {
+
+        if (Loop == nullptr) throw NullCircularLoop();
+
+        // The loop is computed as a single distributed dipole, any attached
+        // point dipole is restored afterwards.
+        auto PointDipole = Dipole;
+        AttachDipoleSource( Loop->GetDipoleSource() );
+        try {
+            MakeCalc3();
+        } catch (...) {
+            Dipole = PointDipole;
+            throw;
+        }
+        Dipole = PointDipole;
+    }
+
+    void EMEarth1D::CheckLoopSource( DipoleSource* src, LayeredEarthEM* earth ) const {
+        if (src->GetLoopRadius() > 0) {
+            if (HankelType == CHAVE) {
+                throw UnsupportedLoopSource("LOOP SOURCE WITH CHAVE HANKEL TRANSFORM");
+            }
+            if (earth->GetLayerAtThisDepth(src->GetLocation(2)) != 0) {
+                throw UnsupportedLoopSource("LOOP SOURCE BELOW THE SURFACE");
+            }
+        }
+    }
+
     void EMEarth1D::MakeCalc3() {
 
         if ( Dipole == nullptr ) throw NullDipoleSource();
@@ -753,8 +1086,20 @@ namespace Lemma {
 
         if (Receivers == nullptr) throw NullReceivers();
 
+        CheckLoopSource( Dipole.get(), Earth.get() );
+
+        // Evaluate the earth once per frequency, shared by all threads
+        VectorXr omega(Dipole->GetNumberOfFrequencies());
+        for (int ifreq=0; ifreq<Dipole->GetNumberOfFrequencies(); ++ifreq) {
+            omega(ifreq) = Dipole->GetAngularFrequency(ifreq);
+        }
+        Earth->EvaluateFrequencies( omega );
+
         #ifdef LEMMAUSEOMP
-        #pragma omp parallel
+        // Each receiver and frequency is solved by one thread, so the appends never meet
+        const bool ThreadPrivate = Receivers->GetThreadPrivate();
+        Receivers->SetThreadPrivate( true );
+        #pragma omp parallel num_threads(GetNumberOfThreads())
         #endif
         { // OpenMP Parallel Block
 
@@ -787,6 +1132,9 @@ namespace Lemma {
                 case QWEKEY:
                     Hankel = QWEKey::NewSP();
                     break;
+                case FHTAUTO:
+                    Hankel = NewHankelTransform();
+                    break;
                 default:
                     std::cerr << "Hankel transform cannot be created\n";
                     exit(EXIT_FAILURE);
@@ -810,6 +1158,554 @@ namespace Lemma {
                 }
             }
         } // OpenMP Parallel Block
+        #ifdef LEMMAUSEOMP
+        Receivers->SetThreadPrivate( ThreadPrivate );
+        #endif
+    }
+
+    void EMEarth1D::MakeIncrementalCalc() {
+
+        if ( Dipole == nullptr ) throw NullDipoleSource();
+
+        if (Earth == nullptr) throw NullEarth();
+
+        if (Receivers == nullptr) throw NullReceivers();
+
+        CheckLoopSource( Dipole.get(), Earth.get() );
+
+        const int nfreq = Dipole->GetNumberOfFrequencies();
+        const int nrec  = Receivers->GetNumberOfPoints();
+
+        VectorXr omega(nfreq);
+        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+            omega(ifreq) = Dipole->GetAngularFrequency(ifreq);
+        }
+        Earth->EvaluateFrequencies( omega );
+
+        const int nthreads = GetNumberOfThreads();
+
+        // The kept kernels belong to one source, transform and number of threads
+        if ( IncrementalSource != Dipole || IncrementalHankelType != HankelType ||
+             static_cast<int>(IncrementalDipoles.size()) != nthreads ) {
+            ResetIncrementalCalc();
+            IncrementalSource = Dipole;
+            IncrementalHankelType = HankelType;
+            IncrementalDipoles.resize(nthreads);
+            IncrementalHankels.resize(nthreads);
+        }
+
+        Receivers->ClearFields();
+
+        #ifdef LEMMAUSEOMP
+        // Each receiver and frequency is solved by one thread, so the appends never meet
+        const bool ThreadPrivate = Receivers->GetThreadPrivate();
+        Receivers->SetThreadPrivate( true );
+        #pragma omp parallel num_threads(nthreads)
+        #endif
+        { // OpenMP Parallel Block
+
+            #ifdef LEMMAUSEOMP
+            int tid = omp_get_thread_num();
+            int nth = omp_get_num_threads();
+            #else
+            int tid = 0;
+            int nth = 1;
+            #endif
+            if (IncrementalDipoles[tid] == nullptr) {
+                IncrementalDipoles[tid] = Dipole->Clone();
+                IncrementalHankels[tid] = NewHankelTransform();
+            }
+            DipoleSource* tDipole = IncrementalDipoles[tid].get();
+            HankelTransform* Hankel = IncrementalHankels[tid].get();
+
+            // The work is dealt out the same way on every call, so each thread finds the
+            // recursions it kept for its frequencies and receivers, one slot for each
+            for (int iw=tid; iw<nfreq*nrec; iw+=nth) {
+                const int ifreq = iw / nrec;
+                const int irec  = iw % nrec;
+                Real wavef = omega(ifreq) * std::sqrt(MU0*EPSILON0);
+                tDipole->SetKernels( ifreq, FieldsToCalculate, Receivers, irec, Earth );
+                tDipole->GetKernelManager()->SetIncrementalRecursion( true, iw );
+                if (tDipole->GetLoopRadius() > 0) {
+                    tDipole->UpdateLoopFields( ifreq, Hankel, wavef );
+                    continue;
+                }
+                Real rho = (Receivers->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
+                Hankel->ComputeRelated( rho, tDipole->GetKernelManager() );
+                tDipole->UpdateFields( ifreq, Hankel, wavef );
+            }
+        } // OpenMP Parallel Block
+        #ifdef LEMMAUSEOMP
+        Receivers->SetThreadPrivate( ThreadPrivate );
+        #endif
+    }
+
+    void EMEarth1D::UpdateLayer( const int& ilay, const Complex& sigma ) {
+        if (Earth == nullptr) throw NullEarth();
+        if (ilay < 1 || ilay > Earth->GetNumberOfLayers()-1) {
+            throw RequestForNonValidEarthModelParameter();
+        }
+        Earth->SetLayerConductivity( ilay, sigma );
+        MakeIncrementalCalc();
+    }
+
+    void EMEarth1D::UpdateLayer( const int& ilay, const Complex& sigma, const Real& thickness ) {
+        if (Earth == nullptr) throw NullEarth();
+        if (ilay < 1 || ilay > Earth->GetNumberOfLayers()-2) {
+            throw RequestForNonValidEarthModelParameter();
+        }
+        VectorXr thick = Earth->GetLayerThickness();
+        thick(ilay-1) = thickness;
+        Earth->SetLayerThickness( thick );
+        Earth->SetLayerConductivity( ilay, sigma );
+        MakeIncrementalCalc();
+    }
+
+    void EMEarth1D::ResetIncrementalCalc() {
+        IncrementalDipoles.clear();
+        IncrementalHankels.clear();
+        IncrementalSource = nullptr;
+    }
+
+    MatrixXcr EMEarth1D::CalculateSensitivities() {
+
+        if ( Dipole == nullptr ) throw NullDipoleSource();
+        if ( Earth == nullptr ) throw NullEarth();
+        if ( Receivers == nullptr ) throw NullReceivers();
+        if ( FieldsToCalculate == E ) {
+            throw UnsupportedSensitivities("SENSITIVITIES OF THE ELECTRIC FIELD");
+        }
+        if ( HankelType != FHTKEY201 && HankelType != FHTKEY101 && HankelType != FHTKEY51 ) {
+            throw UnsupportedSensitivities("SENSITIVITIES WITHOUT FHTKEY201, FHTKEY101 OR FHTKEY51");
+        }
+        if ( Dipole->GetLoopRadius() > 0 ) {
+            throw UnsupportedLoopSource("SENSITIVITIES OF LOOP SOURCES");
+        }
+        const int nfreq = Dipole->GetNumberOfFrequencies();
+        const int nrec  = Receivers->GetNumberOfPoints();
+        if ( Dipole->GetLocation(2) > 0 || (nrec > 0 && Receivers->GetLocations().row(2).maxCoeff() > 0) ) {
+            throw UnsupportedSensitivities("SENSITIVITIES OF SOURCES OR RECEIVERS BELOW THE SURFACE");
+        }
+        const int nlay  = Earth->GetNumberOfLayers();
+        const int npar  = 2*nlay-3;
+
+        VectorXr omega(nfreq);
+        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+            omega(ifreq) = Dipole->GetAngularFrequency(ifreq);
+        }
+        Earth->EvaluateFrequencies( omega );
+
+        MatrixXcr J = MatrixXcr::Zero(3*nfreq*nrec, npar);
+
+        #ifdef LEMMAUSEOMP
+        // Each receiver and frequency is solved by one thread, so the appends never meet
+        const bool ThreadPrivate = Receivers->GetThreadPrivate();
+        Receivers->SetThreadPrivate( true );
+        #pragma omp parallel num_threads(GetNumberOfThreads())
+        #endif
+        { // OpenMP Parallel Block
+
+            // Each pass of the dipole writes to the thread's own copy of the receivers, which
+            // is cleared before every pass
+            auto tDipole = Dipole->Clone();
+            auto Hankel = HankelTransformFactory::NewSP( HankelType );
+            auto tRx = FieldPoints::NewSP();
+                tRx->SetNumberOfPoints( nrec );
+            for (int irec=0; irec<nrec; ++irec) {
+                tRx->SetLocation( irec, Receivers->GetLocation(irec) );
+                tRx->SetComponents( irec, Receivers->GetComponents(irec) );
+            }
+            tRx->SetNumberOfBinsH( nfreq );
+            tRx->SetNumberOfBinsE( nfreq );
+
+            #ifdef LEMMAUSEOMP
+            #pragma omp for schedule(dynamic, 1)
+            #endif
+            for (int iw=0; iw<nfreq*nrec; ++iw) {
+                const int ifreq = iw / nrec;
+                const int irec  = iw % nrec;
+                Real wavef = omega(ifreq) * std::sqrt(MU0*EPSILON0);
+
+                tDipole->SetKernels( ifreq, FieldsToCalculate, tRx, irec, Earth );
+                Real rho = (tRx->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
+                auto Manager = tDipole->GetKernelManager();
+                Manager->SetComputeSensitivities( true );
+                Manager->SelectSensitivity( -1 );
+
+                Hankel->ComputeRelated( rho, Manager );
+                tRx->Hfield[ifreq].col(irec).setZero();
+                tRx->Efield[ifreq].col(irec).setZero();
+                tDipole->UpdateFields( ifreq, Hankel.get(), wavef );
+                Vector3cr h = tRx->Hfield[ifreq].col(irec);
+                Receivers->AppendHfield( ifreq, irec, h(0), h(1), h(2) );
+                if (FieldsToCalculate == BOTH) {
+                    Vector3cr e = tRx->Efield[ifreq].col(irec);
+                    Receivers->AppendEfield( ifreq, irec, e(0), e(1), e(2) );
+                }
+
+                for (int ipar=0; ipar<npar; ++ipar) {
+                    Manager->SelectSensitivity( ipar );
+                    Hankel->ComputeRelated( rho, Manager );
+                    tRx->Hfield[ifreq].col(irec).setZero();
+                    tDipole->UpdateFields( ifreq, Hankel.get(), wavef );
+                    J.block<3,1>(3*iw, ipar) = tRx->Hfield[ifreq].col(irec);
+                }
+
+                Manager->SelectSensitivity( -1 );
+                Manager->SetComputeSensitivities( false );
+            }
+        } // OpenMP Parallel Block
+        #ifdef LEMMAUSEOMP
+        Receivers->SetThreadPrivate( ThreadPrivate );
+        #endif
+
+        return J;
+    }
+
+    MatrixXcr EMEarth1D::CalculateModels( const std::vector< std::shared_ptr<LayeredEarthEM> >& models ) {
+
+        if ( Dipole == nullptr ) throw NullDipoleSource();
+        if ( Receivers == nullptr ) throw NullReceivers();
+        for (const auto& model : models) {
+            if (model == nullptr) throw NullEarth();
+        }
+        const int nmod  = static_cast<int>(models.size());
+        const int nfreq = Dipole->GetNumberOfFrequencies();
+        const int nlay  = (nmod > 0) ? models[0]->GetNumberOfLayers() : 0;
+        for (const auto& model : models) {
+            if (model->GetNumberOfLayers() != nlay) throw EarthModelParametersDoNotMatchNumberOfLayers();
+        }
+
+        std::vector<EvaluatedModelsEM> Models(nfreq);
+        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+            EvaluatedModelsEM& M = Models[ifreq];
+            M.omega = Dipole->GetAngularFrequency(ifreq);
+            M.zh.resize(nmod, nlay);
+            M.yh.resize(nmod, nlay);
+            M.kk.resize(nmod, nlay);
+            M.LayerThickness.resize(nmod, nlay);
+            for (int imod=0; imod<nmod; ++imod) {
+                auto evaluated = models[imod]->GetEvaluatedEarth( M.omega );
+                M.zh.row(imod) = evaluated->zh.transpose();
+                M.yh.row(imod) = evaluated->yh.transpose();
+                M.kk.row(imod) = evaluated->kk.transpose();
+                M.LayerThickness.row(imod) = evaluated->LayerThickness.transpose();
+            }
+        }
+        return SolveModels( (nmod > 0) ? models[0] : nullptr, Models );
+    }
+
+    MatrixXcr EMEarth1D::CalculateModels( std::shared_ptr<LayeredEarthEM> base,
+            const MatrixXcr& conductivity, const MatrixXr& thickness ) {
+
+        if ( Dipole == nullptr ) throw NullDipoleSource();
+        if ( Receivers == nullptr ) throw NullReceivers();
+        if ( base == nullptr ) throw NullEarth();
+        const int nlay = base->GetNumberOfLayers();
+        if ( conductivity.cols() != nlay || thickness.cols() != nlay - 2 ||
+             thickness.rows() != conductivity.rows() ) {
+            throw EarthModelParametersDoNotMatchNumberOfLayers();
+        }
+        const int nmod  = static_cast<int>(conductivity.rows());
+        const int nfreq = Dipole->GetNumberOfFrequencies();
+
+        // yh = sigma + i omega epsilon, only sigma differs from the base
+        std::vector<EvaluatedModelsEM> Models(nfreq);
+        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+            EvaluatedModelsEM& M = Models[ifreq];
+            M.omega = Dipole->GetAngularFrequency(ifreq);
+            auto evaluated = base->GetEvaluatedEarth( M.omega );
+            M.zh = evaluated->zh.transpose().replicate(nmod, 1);
+            M.yh.resize(nmod, nlay);
+            M.yh.col(0).setConstant( evaluated->yh(0) );
+            for (int ilay=1; ilay<nlay; ++ilay) {
+                M.yh.col(ilay) = conductivity.col(ilay).array() +
+                    (evaluated->yh(ilay) - base->GetLayerConductivity(ilay));
+            }
+            M.kk = -M.zh.cwiseProduct(M.yh);
+            M.LayerThickness.resize(nmod, nlay);
+            M.LayerThickness.col(0).setConstant( evaluated->LayerThickness(0) );
+            M.LayerThickness.middleCols(1, nlay-2) = thickness;
+            M.LayerThickness.col(nlay-1).setConstant( evaluated->LayerThickness(nlay-1) );
+        }
+        return SolveModels( base, Models );
+    }
+
+    MatrixXcr EMEarth1D::SolveModels( std::shared_ptr<LayeredEarthEM> Reference,
+            const std::vector<EvaluatedModelsEM>& Models ) {
+
+        if ( Dipole->GetLoopRadius() > 0 ) {
+            throw UnsupportedLoopSource("MODEL BATCHES OF LOOP SOURCES");
+        }
+        const int nfreq = Dipole->GetNumberOfFrequencies();
+        const int nrec  = Receivers->GetNumberOfPoints();
+        if ( Dipole->GetLocation(2) > 0 || (nrec > 0 && Receivers->GetLocations().row(2).maxCoeff() > 0) ) {
+            throw UnsupportedModelBatch("MODEL BATCHES OF SOURCES OR RECEIVERS BELOW THE SURFACE");
+        }
+
+        // H is followed by E when both are calculated
+        const int nmod = Models.empty() ? 0 : static_cast<int>(Models[0].zh.rows());
+        const int nH = (FieldsToCalculate != E) ? 3*nfreq*nrec : 0;
+        const int nE = (FieldsToCalculate != H) ? 3*nfreq*nrec : 0;
+        MatrixXcr Fields = MatrixXcr::Zero(nmod, nH+nE);
+        if (nmod == 0) {
+            return Fields;
+        }
+
+        VectorXr omega(nfreq);
+        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+            omega(ifreq) = Models[ifreq].omega;
+        }
+        Reference->EvaluateFrequencies( omega );
+
+        const int nblock = (nmod + ModelBlock - 1) / ModelBlock;
+
+        // Exceptions may not leave the parallel region, the first is rethrown after it
+        std::exception_ptr Error = nullptr;
+
+        #ifdef LEMMAUSEOMP
+        #pragma omp parallel num_threads(GetNumberOfThreads())
+        #endif
+        { // OpenMP Parallel Block
+
+            // Each pass of the dipole writes to the thread's own copy of the receivers, which
+            // is cleared before every pass
+            auto tDipole = Dipole->Clone();
+            auto Hankel = NewHankelTransform();
+            auto tRx = FieldPoints::NewSP();
+                tRx->SetThreadPrivate( true );
+                tRx->SetNumberOfPoints( nrec );
+            for (int irec=0; irec<nrec; ++irec) {
+                tRx->SetLocation( irec, Receivers->GetLocation(irec) );
+                tRx->SetComponents( irec, Receivers->GetComponents(irec) );
+            }
+            tRx->SetNumberOfBinsH( nfreq );
+            tRx->SetNumberOfBinsE( nfreq );
+
+            // H and E of a unit value of each related kernel, one row per kernel
+            MatrixXcr Unit;
+            VectorXcr Z1;
+            MatrixXcr Z;
+            int Pair = -1;
+
+            // The blocks of models of a frequency and receiver are consecutive, so each thread
+            // prepares the few pairs its static share of the blocks falls in
+            #ifdef LEMMAUSEOMP
+            #pragma omp for schedule(static)
+            #endif
+            for (int iw=0; iw<nfreq*nrec*nblock; ++iw) {
+                try {
+                    const int ipair = iw / nblock;
+                    const int ifreq = ipair / nrec;
+                    const int irec  = ipair % nrec;
+                    if (ipair != Pair) {
+                        Pair = -1;
+                        Real wavef = omega(ifreq) * std::sqrt(MU0*EPSILON0);
+                        tDipole->SetKernels( ifreq, FieldsToCalculate, tRx, irec, Reference );
+                        Real rho = (tRx->GetLocation(irec).head<2>() - tDipole->GetLocation().head<2>()).norm();
+                        if ( !Hankel->PrepareModelRelated( rho, tDipole->GetKernelManager() ) ) {
+                            throw UnsupportedModelBatch("MODEL BATCHES WITHOUT FHTKEY201, FHTKEY101 OR FHTKEY51");
+                        }
+                        // The fields are linear in the related kernels, with factors of the
+                        // geometry and the air alone
+                        const int nrel = static_cast<int>(tDipole->GetKernelManager()->GetSTLVector().size());
+                        Unit.resize(nrel, 6);
+                        Z1.setZero(nrel);
+                        for (int ir=0; ir<nrel; ++ir) {
+                            Z1(ir) = 1;
+                            Hankel->SetRelated( Z1 );
+                            Z1(ir) = 0;
+                            tRx->Hfield[ifreq].col(irec).setZero();
+                            tRx->Efield[ifreq].col(irec).setZero();
+                            tDipole->UpdateFields( ifreq, Hankel.get(), wavef );
+                            Unit.block<1,3>(ir, 0) = tRx->Hfield[ifreq].col(irec).transpose();
+                            Unit.block<1,3>(ir, 3) = tRx->Efield[ifreq].col(irec).transpose();
+                        }
+                        Pair = ipair;
+                    }
+
+                    const int imod = (iw % nblock) * ModelBlock;
+                    const int nm = std::min(ModelBlock, nmod - imod);
+                    Hankel->ComputeModelRelated( tDipole->GetKernelManager(), Models[ifreq], imod, nm, Z );
+                    if (nH > 0) {
+                        Fields.block(imod, 3*ipair, nm, 3).noalias() = Z * Unit.leftCols<3>();
+                    }
+                    if (nE > 0) {
+                        Fields.block(imod, nH+3*ipair, nm, 3).noalias() = Z * Unit.rightCols<3>();
+                    }
+                } catch (...) {
+                    #ifdef LEMMAUSEOMP
+                    #pragma omp critical (SolveModelsError)
+                    #endif
+                    if (Error == nullptr) Error = std::current_exception();
+                }
+            }
+        } // OpenMP Parallel Block
+
+        if (Error != nullptr) {
+            std::rethrow_exception(Error);
+        }
+        return Fields;
+    }
+
+    template <typename EarthSetter>
+    MatrixXcr EMEarth1D::SolveSoundings( const int& nsnd, EarthSetter SetEarth,
+            const std::vector< std::shared_ptr<DipoleSource> >& sources,
+            const std::vector< std::shared_ptr<FieldPoints> >& receivers ) {
+
+        // A single source or receiver set is shared by all soundings
+        const int nsrc = static_cast<int>(sources.size());
+        const int nrx  = static_cast<int>(receivers.size());
+        if ( (nsrc != 1 && nsrc != nsnd) || (nrx != 1 && nrx != nsnd) ) {
+            throw std::runtime_error("EMEarth1D::CalculateSoundings needs one source and receiver set per sounding, or one for all");
+        }
+        for (const auto& src : sources) {
+            if (src == nullptr) throw NullDipoleSource();
+        }
+        for (const auto& rx : receivers) {
+            if (rx == nullptr) throw NullReceivers();
+        }
+        const int nfreq = sources[0]->GetNumberOfFrequencies();
+        const int nrec  = receivers[0]->GetNumberOfPoints();
+        for (const auto& src : sources) {
+            if (src->GetNumberOfFrequencies() != nfreq) {
+                throw std::runtime_error("EMEarth1D::CalculateSoundings sources differ in number of frequencies");
+            }
+        }
+        for (const auto& rx : receivers) {
+            if (rx->GetNumberOfPoints() != nrec) {
+                throw std::runtime_error("EMEarth1D::CalculateSoundings receivers differ in number of points");
+            }
+        }
+
+        // H is followed by E when both are calculated
+        const int nH = (FieldsToCalculate != E) ? 3*nfreq*nrec : 0;
+        const int nE = (FieldsToCalculate != H) ? 3*nfreq*nrec : 0;
+        MatrixXcr Fields = MatrixXcr::Zero(nH+nE, nsnd);
+
+        // Exceptions may not leave the parallel region, the first is rethrown after it
+        std::exception_ptr Error = nullptr;
+
+        #ifdef LEMMAUSEOMP
+        #pragma omp parallel num_threads(GetNumberOfThreads())
+        #endif
+        { // OpenMP Parallel Block
+
+            // Each thread keeps its own calculator, transform, source, model and receiver
+            // copies. The source keeps its kernels between soundings and only the earth they
+            // are evaluated in changes. Nothing below opens a parallel region, and the
+            // receiver copy is only used by this thread.
+            auto tEmEarth = EMEarth1D::NewSP();
+                tEmEarth->SetFieldsToCalculate( FieldsToCalculate );
+            auto Hankel = NewHankelTransform();
+            std::shared_ptr<LayeredEarthEM> Model = nullptr;
+            std::shared_ptr<LayeredEarthEM> tEarth = nullptr;
+            std::shared_ptr<DipoleSource> Src = nullptr;
+            std::shared_ptr<DipoleSource> tDipole = nullptr;
+            std::shared_ptr<FieldPoints> Rx = nullptr;
+            auto tRx = FieldPoints::NewSP();
+                tRx->SetThreadPrivate( true );
+            VectorXr omega(nfreq);
+
+            #ifdef LEMMAUSEOMP
+            #pragma omp for schedule(dynamic, 1)
+            #endif
+            for (int isnd=0; isnd<nsnd; ++isnd) {
+                try {
+                    SetEarth( isnd, Model, tEarth );
+                    tEmEarth->AttachLayeredEarthEM( tEarth );
+                    auto& src = sources[ (nsrc == 1) ? 0 : isnd ];
+                    if (src != Src) {
+                        Src = src;
+                        tDipole = Src->Clone();
+                        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+                            omega(ifreq) = tDipole->GetAngularFrequency(ifreq);
+                        }
+                        tEmEarth->AttachDipoleSource( tDipole );
+                    }
+                    CheckLoopSource( tDipole.get(), tEarth.get() );
+                    auto& rx = receivers[ (nrx == 1) ? 0 : isnd ];
+                    if (rx != Rx) {
+                        Rx = rx;
+                        tRx->SetNumberOfPoints( nrec );
+                        tRx->UnMaskAllPoints();
+                        for (int irec=0; irec<nrec; ++irec) {
+                            tRx->SetLocation( irec, Rx->GetLocation(irec) );
+                            if (Rx->GetMask(irec)) tRx->MaskPoint(irec);
+                            tRx->SetComponents( irec, Rx->GetComponents(irec) );
+                        }
+                        tEmEarth->AttachFieldPoints( tRx );
+                    }
+                    tEarth->EvaluateFrequencies( omega );
+                    tRx->ClearFields();
+                    for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+                        Real wavef = omega(ifreq) * std::sqrt(MU0*EPSILON0);
+                        for (int irec=0; irec<nrec; ++irec) {
+                            tEmEarth->SolveSingleTxRxPair(irec, Hankel.get(), wavef, ifreq, tDipole.get());
+                        }
+                    }
+                    for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+                        for (int irec=0; irec<nrec; ++irec) {
+                            if (nH > 0) {
+                                Fields.block<3,1>(3*(ifreq*nrec+irec), isnd) = tRx->GetHfield(ifreq, irec);
+                            }
+                            if (nE > 0) {
+                                Fields.block<3,1>(nH+3*(ifreq*nrec+irec), isnd) = tRx->GetEfield(ifreq, irec);
+                            }
+                        }
+                    }
+                } catch (...) {
+                    #ifdef LEMMAUSEOMP
+                    #pragma omp critical (SolveSoundingsError)
+                    #endif
+                    if (Error == nullptr) Error = std::current_exception();
+                }
+            }
+        } // OpenMP Parallel Block
+
+        if (Error != nullptr) {
+            std::rethrow_exception(Error);
+        }
+        return Fields;
+    }
+
+    MatrixXcr EMEarth1D::CalculateSoundings( const std::vector< std::shared_ptr<LayeredEarthEM> >& models,
+            const std::vector< std::shared_ptr<DipoleSource> >& sources,
+            const std::vector< std::shared_ptr<FieldPoints> >& receivers ) {
+        for (const auto& model : models) {
+            if (model == nullptr) throw NullEarth();
+        }
+        auto SetEarth = [&models]( const int& isnd, std::shared_ptr<LayeredEarthEM>& Model,
+                std::shared_ptr<LayeredEarthEM>& tEarth ) {
+            // The earth caches its evaluation, copy it only when the model changes
+            if (models[isnd] != Model) {
+                Model = models[isnd];
+                tEarth = Model->Clone();
+            }
+        };
+        return SolveSoundings( static_cast<int>(models.size()), SetEarth, sources, receivers );
+    }
+
+    MatrixXcr EMEarth1D::CalculateSoundings( std::shared_ptr<LayeredEarthEM> base,
+            const MatrixXcr& conductivity, const MatrixXr& thickness,
+            const std::vector< std::shared_ptr<DipoleSource> >& sources,
+            const std::vector< std::shared_ptr<FieldPoints> >& receivers ) {
+        if (base == nullptr) throw NullEarth();
+        if ( conductivity.cols() != base->GetNumberOfLayers() ||
+             thickness.cols() != base->GetNumberOfLayers() - 2 ||
+             thickness.rows() != conductivity.rows() ) {
+            throw EarthModelParametersDoNotMatchNumberOfLayers();
+        }
+        auto SetEarth = [&]( const int& isnd, std::shared_ptr<LayeredEarthEM>& Model,
+                std::shared_ptr<LayeredEarthEM>& tEarth ) {
+            if (Model == nullptr) {
+                Model = base;
+                tEarth = base->Clone();
+            }
+            tEarth->SetLayerConductivity( conductivity.row(isnd).transpose() );
+            tEarth->SetLayerThickness( thickness.row(isnd).transpose() );
+        };
+        return SolveSoundings( static_cast<int>(conductivity.rows()), SetEarth, sources, receivers );
     }
 
     NullReceivers::NullReceivers() :
@@ -824,6 +1720,18 @@ namespace Lemma {
                   << ptr->GetName() << std::endl;
     }
 
+    NullCircularLoop::NullCircularLoop() :
+        runtime_error("nullptr CIRCULARLOOP") {}
+
+    UnsupportedLoopSource::UnsupportedLoopSource(const std::string& reason) :
+        runtime_error(reason) {}
+
+    UnsupportedSensitivities::UnsupportedSensitivities(const std::string& reason) :
+        runtime_error(reason) {}
+
+    UnsupportedModelBatch::UnsupportedModelBatch(const std::string& reason) :
+        runtime_error(reason) {}
+
     DipoleSourceSpecifiedForWireAntennaCalc::
         DipoleSourceSpecifiedForWireAntennaCalc() :
         runtime_error("DIPOLE SOURCE SPECIFIED FOR WIRE ANTENNA CALC"){}
@@ -22,7 +22,7 @@
 namespace Lemma {
 
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKEY201>::WT =
+    const Eigen::Matrix<Real, 201, 3>  FHT<FHTKEY201>::WT =
         ( Eigen::Matrix<Real, 201, 3>()   <<
         // Base                   J0                      J1
         4.1185887075357082e-06, 1.5020099209519960e-03, 4.7827871332506182e-10,
@@ -228,7 +228,7 @@ namespace Lemma {
         2.4280161749832361e+05, 2.2414416956474645e-11,-3.5668195345476294e-09).finished();
 
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKEY101>::WT =
+    const Eigen::Matrix<Real, 101, 3>  FHT<FHTKEY101>::WT =
         ( Eigen::Matrix<Real, 101, 3>()   <<
        // Base                   J0                        J1
        5.5308437014783363e-04,   5.1818808036862153e-02,   4.1746363961646286e-06,
@@ -334,7 +334,7 @@ namespace Lemma {
        1.8080424144560632e+03,   2.0794387557779629e-07,  -6.0462736574031818e-08 ).finished();
 
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKEY51>::WT =
+    const Eigen::Matrix<Real, 51, 3>  FHT<FHTKEY51>::WT =
         ( Eigen::Matrix<Real, 51, 3>()   <<
            // Base                   J0                        J1
            4.9915939069102170e-03,   6.5314496156480717e-02,   3.8409924166118657e-05,
@@ -390,7 +390,7 @@ namespace Lemma {
            2.0033680997479166e+02,  -8.0433917146487977e-06,   2.3403502580547994e-04).finished();
 
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKONG61>::WT =
+    const Eigen::Matrix<Real, 61, 3>  FHT<FHTKONG61>::WT =
         ( Eigen::Matrix<Real, 61, 3>()   <<
         // Base                   J0                        J1
         0.23517745856009100e-01,   0.14463210615326699e+03,   0.46440396425864918e+02,
@@ -456,7 +456,7 @@ namespace Lemma {
         0.42521082000062783e+02,   0.67792635718095777e-05,   0.18788896009128770e-04 ).finished();
 
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKONG121>::WT =
+    const Eigen::Matrix<Real, 121, 3>  FHT<FHTKONG121>::WT =
         ( Eigen::Matrix<Real, 121, 3>()   <<
        // Base                   J0                        J1
         0.10077854290485105e-02,  0.30018305463183890e+03,  0.14159106906236584e+05,
@@ -582,7 +582,7 @@ namespace Lemma {
         0.99227471560502624e+03,  -.19689609552964338e-08,  -.90671074377795857e-08 ).finished();
 
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<FHTKONG241>::WT =
+    const Eigen::Matrix<Real, 241, 3>  FHT<FHTKONG241>::WT =
         ( Eigen::Matrix<Real, 241, 3>()   <<
        // Base                   J0                        J1
         0.40973497897978643e-03,  0.20521734894828349e+02,  -.68036776043707992e+01,
@@ -829,7 +829,7 @@ namespace Lemma {
 
     // This is currently broken, clang doesn't like long filters entered like this
     template<>
-    const Eigen::Matrix<Real, Eigen::Dynamic, 3>  FHT<IRONS>::WT =
+    const Eigen::Matrix<Real, 961, 3>  FHT<IRONS>::WT =
         ( Eigen::Matrix<Real, 961, 3>()   <<
         // Base                   J0                        J1
         4.1613973942241638e-10,  1.5265062799860525e-03,  -1.0127607482027018e-03,
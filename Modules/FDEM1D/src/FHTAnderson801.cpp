@@ -886,11 +886,6 @@ namespace Lemma {
         return node;
     }
 
-    void FHTAnderson801::DeleteSplines() {
-        splineVecReal.clear();
-        splineVecImag.clear();
-    }
-
     //--------------------------------------------------------------------------------------
     //       Class:  FHTAnderson801
     //      Method:  GetName
@@ -947,24 +942,18 @@ namespace Lemma {
 #else
  		Compute(rho, 1, 1e-14);
 #endif
-        DeleteSplines();
-
-        // Now do cubic spline
-        for (int ii=0; ii<Zans.cols(); ++ii) {
-            auto Spline = CubicSplineInterpolator::NewSP();
-            Spline->SetKnots( Arg, Zans.col(ii).real() );
-            splineVecReal.push_back(Spline);
-
-            auto SplineI = CubicSplineInterpolator::NewSP();
-            SplineI->SetKnots( Arg, Zans.col(ii).imag() );
-            splineVecImag.push_back(SplineI);
-        }
+        // Arg is an exact geometric grid, so no spline is needed
+        SetLaggedTable( Arg, Zans );
     }
 
     void FHTAnderson801::SetLaggedArg(const Real& rho) {
-        for (int i=0; i<Zans.cols(); ++ i) {
-            Zans(0, i) = Complex( splineVecReal[i]->Interpolate(rho),
-                                  splineVecImag[i]->Interpolate(rho) );
+        InterpolateLagged(rho, Zans);
+    }
+
+    void FHTAnderson801::CopyLaggedRelated(const HankelTransform& Source) {
+        CopyLaggedTable(Source);
+        if (Zans.rows() < 1 || Zans.cols() != LaggedTable.cols()) {
+            Zans.setZero(1, LaggedTable.cols());
         }
     }
 
@@ -1051,6 +1040,31 @@ namespace Lemma {
   			if (ilag > 0) y1 *= ABSE;
   			Arg(istore) = ABSCISSA/y1;
 
+            // The right side convolution always starts with weights 298 to 338. For the first
+            // convolution none of these are stored yet, so compute them as one batch. Lambda is
+            // generated exactly as in the loops below.
+            if (ilag == 0) {
+                WindowLambda.resize(41);
+                Lambda = y1;
+                for (int iw=0; iw<41; ++iw) {
+                    Lambda *= ABSE;
+                    WindowLambda(iw) = Lambda;
+                }
+                Manager->ComputeReflectionCoeffs(WindowLambda);
+                const bool fused = Manager->ComputeRelatedKernels( this->Zwork.middleRows(298, 41) );
+                for (int iw=0; iw<41; ++iw) {
+                    Key[298+iw] = 298+iw;
+                    ++this->NumFun;
+                    if (fused) {
+                        continue;
+                    }
+                    Manager->SelectLambda(iw);
+                    for (unsigned int ir2=0; ir2<this->kernelVec.size(); ++ir2) {
+                        this->Zwork(298+iw, ir2) = this->kernelVec[ir2]->RelBesselArg(WindowLambda(iw));
+                    }
+                }
+            }
+
  			// 1000 Loop
  			for (unsigned int irel=0; irel < this->kernelVec.size(); ++irel) {
 
@@ -0,0 +1,387 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026 10:12:31 AM
+ * @author    Trevor Irons (ti)
+ * @email     Trevor.Irons@lemmasoftware.org
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include "FHTAuto.h"
+#include "FHT.h"
+#include "FHTAnderson801.h"
+#include "KernelEM1DManager.h"
+
+namespace Lemma {
+
+    // ====================  FRIEND METHODS  =====================
+
+    std::ostream &operator<<(std::ostream &stream, const FHTAuto &ob) {
+        stream << ob.Serialize()  << "\n"; // End of doc ---
+        return stream;
+    }
+
+    // ====================  STATIC CONST MEMBERS     ============
+
+    const std::array<HANKELTRANSFORMTYPE, FHTAuto::NFILT> FHTAuto::Types =
+        {{ FHTKEY51, FHTKEY101, FHTKEY201, ANDERSON801 }};
+
+    // ====================  LIFECYCLE     =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  FHTAuto
+    // Description:  constructor (locked)
+    //--------------------------------------------------------------------------------------
+    FHTAuto::FHTAuto( const ctor_key& key ) : HankelTransform( key ),
+        Shared( std::make_shared<Selection>() ) {
+        Filters[0] = FHT<FHTKEY51>::NewSP();
+        Filters[1] = FHT<FHTKEY101>::NewSP();
+        Filters[2] = FHT<FHTKEY201>::NewSP();
+        Filters[3] = FHTAnderson801::NewSP();
+        Chosen = Filters[2].get();
+    }  // -----  end of method FHTAuto::FHTAuto  (constructor)  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  FHTAuto
+    // Description:  constructor (locked)
+    //--------------------------------------------------------------------------------------
+    FHTAuto::FHTAuto( const YAML::Node& node, const ctor_key& key ) : FHTAuto( key ) {
+        if (node["Tolerance"]) {
+            Shared->Tolerance = node["Tolerance"].as<Real>();
+        }
+    }
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  NewSP
+    // Description:  public constructor
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<FHTAuto> FHTAuto::NewSP() {
+        return std::make_shared< FHTAuto >( ctor_key() );
+    }
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  Share
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<FHTAuto> FHTAuto::Share() {
+        auto Copy = std::make_shared< FHTAuto >( ctor_key() );
+        Copy->Shared = Shared;
+        return Copy;
+    }		// -----  end of method FHTAuto::Share  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  ~FHTAuto
+    // Description:  destructor
+    //--------------------------------------------------------------------------------------
+    FHTAuto::~FHTAuto () {
+
+    }  // -----  end of method FHTAuto::~FHTAuto  (destructor)  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  DeSerialize
+    // Description:  Factory method, converts YAML node into object
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<FHTAuto> FHTAuto::DeSerialize( const YAML::Node& node ) {
+        if (node.Tag() != "FHTAuto") {
+            throw  DeSerializeTypeMismatch( "FHTAuto", node.Tag());
+        }
+        return std::make_shared<FHTAuto> ( node, ctor_key() );
+    }
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  Serialize
+    // Description:  Converts object into Serialized version
+    //--------------------------------------------------------------------------------------
+    YAML::Node FHTAuto::Serialize() const {
+        YAML::Node node = HankelTransform::Serialize();
+        node.SetTag( GetName() );
+        node["Tolerance"] = Shared->Tolerance;
+        node["Samples"] = Shared->Samples;
+        for (int ifilt=0; ifilt<NFILT; ++ifilt) {
+            node["Evaluations"][enum2String(Types[ifilt])] = Shared->Evaluations[ifilt];
+            node["Choices"][enum2String(Types[ifilt])] = GetNumberOfChoices(Types[ifilt]);
+        }
+        return node;
+    }
+
+    // ====================  OPERATIONS    =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  Zgauss
+    //--------------------------------------------------------------------------------------
+    Complex FHTAuto::Zgauss ( const int &ikk, const EMMODE &imode,
+                            const int &itype, const Real &rho,
+                            const Real &wavef, KernelEM1DBase* Kernel ) {
+        return Chosen->Zgauss(ikk, imode, itype, rho, wavef, Kernel);
+    }		// -----  end of method FHTAuto::Zgauss  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  ComputeRelated
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::ComputeRelated ( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager ) {
+        const int ifilt = Choose(rho, KernelManager);
+        Chosen = Filters[ifilt].get();
+        Chosen->ComputeRelated(rho, KernelManager);
+        #ifdef LEMMAUSEOMP
+        #pragma omp critical (FHTAutoSelection)
+        #endif
+        {
+            ++Shared->Evaluations[ifilt];
+        }
+        return ;
+    }		// -----  end of method FHTAuto::ComputeRelated  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  ComputeLaggedRelated
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::ComputeLaggedRelated ( const Real& rhomax, const int& nlag,
+            std::shared_ptr<KernelEM1DManager> KernelManager ) {
+
+        // nlag spans the lagged arguments with the spacing of GetABSER, the finer filter of
+        // the two ends covers the same span with its own spacing
+        const Real rhomin = rhomax*std::pow(GetABSER(), nlag-1);
+        const int ifilt = std::max( Choose(rhomax, KernelManager), Choose(rhomin, KernelManager) );
+        Chosen = Filters[ifilt].get();
+        const int nlagc = 1 + static_cast<int>( std::ceil( (nlag-1)*std::log(GetABSER()) /
+                                                 std::log(Chosen->GetABSER()) - 1e-6 ) );
+        Chosen->ComputeLaggedRelated(rhomax, nlagc, KernelManager);
+        #ifdef LEMMAUSEOMP
+        #pragma omp critical (FHTAutoSelection)
+        #endif
+        {
+            ++Shared->Evaluations[ifilt];
+        }
+    }		// -----  end of method FHTAuto::ComputeLaggedRelated  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  Choose
+    //--------------------------------------------------------------------------------------
+    int FHTAuto::Choose ( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager ) {
+
+        const Regime regime = GetRegime(rho, KernelManager.get());
+
+        int ifilt = -1;
+        #ifdef LEMMAUSEOMP
+        #pragma omp critical (FHTAutoSelection)
+        #endif
+        {
+            auto it = Shared->Choices.find(regime);
+            if (it != Shared->Choices.end()) {
+                ifilt = it->second;
+            }
+        }
+        if (ifilt >= 0) {
+            return ifilt;
+        }
+
+        // The sample is taken at the centre of the offset bin, so the choice only depends on
+        // the regime. Two threads may sample the same regime, both find the same filter.
+        ifilt = Sample( std::pow(10., regime[2]/8.), KernelManager );
+        #ifdef LEMMAUSEOMP
+        #pragma omp critical (FHTAutoSelection)
+        #endif
+        {
+            // Sweeps over many heights or frequencies are not allowed to grow the map without
+            // bound, when full it is started again
+            if (static_cast<int>(Shared->Choices.size()) >= MaxChoices) {
+                Shared->Choices.clear();
+            }
+            if (Shared->Choices.emplace(regime, ifilt).second) {
+                ++Shared->Samples;
+            }
+        }
+        return ifilt;
+    }		// -----  end of method FHTAuto::Choose  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  Sample
+    //--------------------------------------------------------------------------------------
+    int FHTAuto::Sample ( const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager ) {
+
+        const int nrel = static_cast<int>(KernelManager->GetSTLVector().size());
+        Filters[0]->ComputeRelated(rho, KernelManager);
+        GetRelated(0, KernelManager.get(), Zcoarse);
+
+        for (int ifilt=1; ifilt<NFILT; ++ifilt) {
+            Filters[ifilt]->ComputeRelated(rho, KernelManager);
+            GetRelated(ifilt, KernelManager.get(), Zfine);
+            // Error estimate of the coarser filter, relative to each related kernel
+            Real err(0);
+            for (int ir=0; ir<nrel; ++ir) {
+                const Real mag = std::abs(Zfine(ir));
+                if (mag > std::numeric_limits<Real>::min()) {
+                    err = std::max(err, std::abs(Zcoarse(ir) - Zfine(ir)) / mag);
+                }
+            }
+            if (err <= Shared->Tolerance) {
+                return ifilt-1;
+            }
+            Zcoarse.swap(Zfine);
+        }
+        return NFILT-1;
+    }		// -----  end of method FHTAuto::Sample  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  GetRelated
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::GetRelated ( const int& ifilt, KernelEM1DManager* KernelManager, VectorXcr& Z ) {
+        const auto& Kernels = KernelManager->GetSTLVector();
+        Z.resize(Kernels.size());
+        for (unsigned int ir=0; ir<Kernels.size(); ++ir) {
+            Z(ir) = Filters[ifilt]->Zgauss(0, TE, Kernels[ir]->GetBesselOrder(), 0, 0, Kernels[ir].get());
+        }
+    }		// -----  end of method FHTAuto::GetRelated  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  GetRegime
+    //--------------------------------------------------------------------------------------
+    FHTAuto::Regime FHTAuto::GetRegime ( const Real& rho, KernelEM1DManager* KernelManager ) const {
+
+        // eight bins per decade
+        auto Bin = [] (const Real& val) {
+            return (val > 0) ? static_cast<Real>(std::lround(8.*std::log10(val)))
+                             : -std::numeric_limits<Real>::max();
+        };
+
+        // The configuration, frequency and heights are matched exactly. Of the model, only the
+        // number of layers and the skin depth of the top layer enter, binned as the offset, so
+        // that small changes of the model, as between iterations of an inversion, keep the
+        // choices of the regime.
+        DipoleSource* Dipole = KernelManager->GetDipole();
+        Vector3r Phat = Dipole->GetPolarisation();
+        const Real omega = Dipole->GetAngularFrequency(KernelManager->GetFrequencyIndex());
+        Regime regime;
+        regime.reserve(7);
+        regime.push_back( static_cast<int>(KernelManager->GetSTLVector().size()) +
+                          64*static_cast<int>(Dipole->GetType()) + 512*(std::abs(Phat[2]) > 0) +
+                          1024*(std::abs(Phat[0]) > 0 || std::abs(Phat[1]) > 0) );
+        regime.push_back( omega );
+        regime.push_back( Bin( rho ) );
+        regime.push_back( Dipole->GetLocation(2) );
+        regime.push_back( KernelManager->GetReceiverHeight() );
+        auto Earth = KernelManager->GetEarth();
+        if (Earth != nullptr) {
+            regime.push_back( Earth->GetNumberOfLayers() );
+            const Real sigma = std::abs( Earth->GetLayerConductivity(1) );
+            regime.push_back( (sigma > 0 && omega > 0) ? Bin( std::sqrt(2./(omega*MU0*sigma)) )
+                                                       : std::numeric_limits<Real>::max() );
+        }
+        return regime;
+    }		// -----  end of method FHTAuto::GetRegime  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  ClearChoices
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::ClearChoices (  ) {
+        Shared->Choices.clear();
+        ResetStatistics();
+    }		// -----  end of method FHTAuto::ClearChoices  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  ResetStatistics
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::ResetStatistics (  ) {
+        Shared->Samples = 0;
+        Shared->Evaluations.fill(0);
+    }		// -----  end of method FHTAuto::ResetStatistics  -----
+
+    // ====================  ACCESS        =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  SetTolerance
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::SetTolerance ( const Real& tol ) {
+        Shared->Tolerance = tol;
+        ClearChoices();
+    }		// -----  end of method FHTAuto::SetTolerance  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  SetLaggedArg
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::SetLaggedArg ( const Real& rho ) {
+        Chosen->SetLaggedArg(rho);
+    }		// -----  end of method FHTAuto::SetLaggedArg  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  CopyLaggedRelated
+    //--------------------------------------------------------------------------------------
+    void FHTAuto::CopyLaggedRelated ( const HankelTransform& Source ) {
+        const FHTAuto& Auto = static_cast<const FHTAuto&>(Source);
+        // The source chose its filter by the regimes of its own convolution
+        for (int ifilt=0; ifilt<NFILT; ++ifilt) {
+            if (Auto.Filters[ifilt].get() == Auto.Chosen) {
+                Chosen = Filters[ifilt].get();
+                Chosen->CopyLaggedRelated(*Auto.Chosen);
+                return;
+            }
+        }
+    }		// -----  end of method FHTAuto::CopyLaggedRelated  -----
+
+    // ====================  INQUIRY       =======================
+
+    Real FHTAuto::GetTolerance (  ) const {
+        return Shared->Tolerance;
+    }
+
+    int FHTAuto::GetNumberOfSamples (  ) const {
+        return Shared->Samples;
+    }
+
+    int FHTAuto::GetNumberOfEvaluations ( const HANKELTRANSFORMTYPE& type ) const {
+        return Shared->Evaluations[FilterIndex(type)];
+    }
+
+    int FHTAuto::GetNumberOfChoices ( const HANKELTRANSFORMTYPE& type ) const {
+        const int ifilt = FilterIndex(type);
+        int nchoice(0);
+        for (const auto& choice : Shared->Choices) {
+            nchoice += (choice.second == ifilt);
+        }
+        return nchoice;
+    }
+
+    Real FHTAuto::GetABSER (  ) {
+        return Filters[FilterIndex(FHTKEY201)]->GetABSER();
+    }
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  FHTAuto
+    //      Method:  FilterIndex
+    //--------------------------------------------------------------------------------------
+    int FHTAuto::FilterIndex ( const HANKELTRANSFORMTYPE& type ) const {
+        for (int ifilt=0; ifilt<NFILT; ++ifilt) {
+            if (Types[ifilt] == type) return ifilt;
+        }
+        throw std::runtime_error("FHTAuto only uses FHTKEY51, FHTKEY101, FHTKEY201 and ANDERSON801");
+    }		// -----  end of method FHTAuto::FilterIndex  -----
+
+}		// -----  end of Lemma  name  -----
+
+/* vim: set tabstop=4 expandtab: */
+/* vim: set filetype=cpp: */
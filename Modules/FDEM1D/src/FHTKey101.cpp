@@ -17,6 +17,7 @@
  */
 
 #include "FHTKey101.h"
+#include "FHT.h"
 
 namespace Lemma {
 
@@ -134,6 +135,8 @@ namespace Lemma {
        1.5561965278371533e+03,  -1.8949818224609619e-06,   4.8072849734177625e-07,
        1.8080424144560632e+03,   2.0794387557779629e-07,  -6.0462736574031818e-08).finished();
 
+    const Eigen::Matrix<Real, 202, 2>  FHTKey101::WT101RI = InterleaveFilterWeights<101>( WT101 );
+
     // ====================  LIFECYCLE     =======================
 
     //--------------------------------------------------------------------------------------
@@ -240,22 +243,22 @@ namespace Lemma {
 
         //kernelVec = KernelManager->GetSTLVector();
         int nrel = (int)(KernelManager->GetSTLVector().size());
-        Eigen::Matrix<Complex, 101, Eigen::Dynamic > Zwork;
         // TODO, if we want to allow lagged, then 1 below should be nlag
-        Zans= Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>::Zero(1, nrel);
+        Zans.setZero(1, nrel);
         Zwork.resize(101, nrel);
-        VectorXr lambda = WT101.col(0).array()/rho;
+        lambda = WT101.col(0).array()/rho;
         int NumFun = 0;
-        int idx = 0;
 
         // Get Kernel values
-        for (int ir=0; ir<lambda.size(); ++ir) {
-            // irelated loop
-            ++NumFun;
-            KernelManager->ComputeReflectionCoeffs(lambda(ir), idx, rho);
-            for (int ir2=0; ir2<nrel; ++ir2) {
-                // Zwork* needed due to sign convention of filter weights
- 			    Zwork(ir, ir2) = std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir)));
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeRelatedKernels(Zwork)) {
+            for (int ir=0; ir<lambda.size(); ++ir) {
+                // irelated loop
+                ++NumFun;
+                KernelManager->SelectLambda(ir);
+                for (int ir2=0; ir2<nrel; ++ir2) {
+                    Zwork(ir, ir2) = KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir));
+                }
             }
         }
 
@@ -265,7 +268,8 @@ namespace Lemma {
         // more multiplies, but the same number of kernel evaluations, which is the expensive part.
         // Inner product and scale
         for (int ir2=0; ir2<nrel; ++ir2) {
-            Zans(0, ir2) = Zwork.col(ir2).dot(WT101.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder() + 1))/rho;
+            Zans(0, ir2) = FilterConvolve<101>( Zwork.col(ir2).data(),
+                    WT101RI.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()).data() )/rho;
         }
 
         return ;
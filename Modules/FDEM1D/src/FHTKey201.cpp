@@ -16,6 +16,7 @@
  */
 
 #include "FHTKey201.h"
+#include "FHT.h"
 
 namespace Lemma {
 
@@ -233,6 +234,8 @@ namespace Lemma {
         , 2.1448605423174356e+05,-2.0575286298055636e-10, 3.0748587523233524e-08
         , 2.4280161749832361e+05, 2.2414416956474645e-11,-3.5668195345476294e-09 ).finished();
 
+    const Eigen::Matrix<Real, 402, 2>  FHTKey201::WT201RI = InterleaveFilterWeights<201>( WT201 );
+
     // ====================  LIFECYCLE     =======================
 
     //--------------------------------------------------------------------------------------
@@ -339,21 +342,21 @@ namespace Lemma {
 
         //kernelVec = KernelManager->GetSTLVector();
         int nrel = (int)(KernelManager->GetSTLVector().size());
-        Eigen::Matrix<Complex, 201, Eigen::Dynamic > Zwork;
-        Zans= Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>::Zero(1, nrel);
+        Zans.setZero(1, nrel);
         Zwork.resize(201, nrel);
-        VectorXr lambda = WT201.col(0).array()/rho;
+        lambda = WT201.col(0).array()/rho;
         int NumFun = 0;
-        int idx = 0;
 
         // Get Kernel values
-        for (int ir=0; ir<lambda.size(); ++ir) {
-            // irelated loop
-            ++NumFun;
-            KernelManager->ComputeReflectionCoeffs(lambda(ir), idx, rho);
-            for (int ir2=0; ir2<nrel; ++ir2) {
-                // Zwork* needed due to sign convention of filter weights
- 			    Zwork(ir, ir2) = std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir)));
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeRelatedKernels(Zwork)) {
+            for (int ir=0; ir<lambda.size(); ++ir) {
+                // irelated loop
+                ++NumFun;
+                KernelManager->SelectLambda(ir);
+                for (int ir2=0; ir2<nrel; ++ir2) {
+                    Zwork(ir, ir2) = KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir));
+                }
             }
         }
 
@@ -363,7 +366,8 @@ namespace Lemma {
         // more multiplies, but the same number of kernel evaluations, which is the expensive part.
         // Inner product and scale
         for (int ir2=0; ir2<nrel; ++ir2) {
-            Zans(0, ir2) = Zwork.col(ir2).dot(WT201.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder() + 1))/rho;
+            Zans(0, ir2) = FilterConvolve<201>( Zwork.col(ir2).data(),
+                    WT201RI.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()).data() )/rho;
         }
         return ;
     }		// -----  end of method FHTKey201::ComputeRelated  -----
@@ -387,7 +391,6 @@ namespace Lemma {
         }
 
         int NumFun = 0;
-        int idx = 0;
 
         VectorXr Arg(nlag);
         Arg(nlag-1) = rho;
@@ -396,12 +399,15 @@ namespace Lemma {
         }
 
         // Get Kernel values
-        for (int ir=0; ir<lambda.size(); ++ir) {
-            // irelated loop
-            ++NumFun;
-            KernelManager->ComputeReflectionCoeffs(lambda(ir), idx, rho);
-            for (int ir2=0; ir2<nrel; ++ir2) {
- 			    Zwork(ir, ir2) = std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir)));
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeRelatedKernels(Zwork)) {
+            for (int ir=0; ir<lambda.size(); ++ir) {
+                // irelated loop
+                ++NumFun;
+                KernelManager->SelectLambda(ir);
+                for (int ir2=0; ir2<nrel; ++ir2) {
+                    Zwork(ir, ir2) = KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir));
+                }
             }
         }
 
@@ -413,7 +419,8 @@ namespace Lemma {
         int ilagr = nlag-1; // Zwork is in opposite order from Arg
         for (int ilag=0; ilag<nlag; ++ilag) {
             for (int ir2=0; ir2<nrel; ++ir2) {
-                Zans(ilagr, ir2) = Zwork.col(ir2).segment(ilag,201).dot( WT201.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()+1) ) / Arg(ilagr);
+                Zans(ilagr, ir2) = FilterConvolve<201>( Zwork.col(ir2).data()+ilag,
+                    WT201RI.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()).data() ) / Arg(ilagr);
             }
             ilagr -= 1;
         }
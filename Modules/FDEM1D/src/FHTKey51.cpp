@@ -18,6 +18,7 @@
  */
 
 #include "FHTKey51.h"
+#include "FHT.h"
 
 namespace Lemma {
 
@@ -85,6 +86,8 @@ namespace Lemma {
            1.6206540689269471e+02,   4.8238483411813232e-05,  -1.2668720233377250e-03,
            2.0033680997479166e+02,  -8.0433917146487977e-06,   2.3403502580547994e-04).finished();
 
+    const Eigen::Matrix<Real, 102, 2>  FHTKey51::WT51RI = InterleaveFilterWeights<51>( WT51 );
+
     // ====================  LIFECYCLE     =======================
 
     //--------------------------------------------------------------------------------------
@@ -191,24 +194,23 @@ namespace Lemma {
 
         //kernelVec = KernelManager->GetSTLVector();
         int nrel = (int)(KernelManager->GetSTLVector().size());
-        Eigen::Matrix<Complex, 51, Eigen::Dynamic > Zwork;
         // TODO, if we want to allow lagged, then 1 below should be nlag
-        Zans= Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>::Zero(1, nrel);
+        Zans.setZero(1, nrel);
         Zwork.resize(51, nrel);
-        VectorXr lambda = WT51.col(0).array()/rho;
+        lambda = WT51.col(0).array()/rho;
         int NumFun = 0;
-        int idx = 0;
 
         // Get Kernel values
-        for (int ir=0; ir<lambda.size(); ++ir) {
-            // irelated loop
-            ++NumFun;
-            KernelManager->ComputeReflectionCoeffs(lambda(ir), idx, rho);
-            for (int ir2=0; ir2<nrel; ++ir2) {
-                // Zwork* needed due to sign convention of filter weights
- 			    Zwork(ir, ir2) = std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir)));
+        KernelManager->ComputeReflectionCoeffs(lambda);
+        if (!KernelManager->ComputeRelatedKernels(Zwork)) {
+            for (int ir=0; ir<lambda.size(); ++ir) {
+                // irelated loop
+                ++NumFun;
+                KernelManager->SelectLambda(ir);
+                for (int ir2=0; ir2<nrel; ++ir2) {
+                    Zwork(ir, ir2) = KernelManager->GetSTLVector()[ir2]->RelBesselArg(lambda(ir));
+                }
             }
-
         }
 
         // We diverge slightly from Key here, each kernel is evaluated seperately, whereby instead
@@ -217,7 +219,8 @@ namespace Lemma {
         // more multiplies, but the same number of kernel evaluations, which is the expensive part.
         // Inner product and scale
         for (int ir2=0; ir2<nrel; ++ir2) {
-            Zans(0, ir2) = Zwork.col(ir2).dot(WT51.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder() + 1))/rho;
+            Zans(0, ir2) = FilterConvolve<51>( Zwork.col(ir2).data(),
+                    WT51RI.col(KernelManager->GetSTLVector()[ir2]->GetBesselOrder()).data() )/rho;
         }
 
         return ;
@@ -13,6 +13,10 @@
 
 #include "FieldPoints.h"
 
+#ifdef LEMMAUSEOMP
+#include "omp.h"
+#endif
+
 namespace Lemma {
 
     // ====================    FRIENDS     ======================
@@ -39,6 +43,11 @@ namespace Lemma {
         NumberOfBinsE = node["NumberOfBinsE"].as<int>();
         NumberOfBinsH = node["NumberOfBinsH"].as<int>();
         Mask = node["Mask"].as<VectorXi>();
+        if (node["Components"]) {
+            Components = node["Components"].as<VectorXi>();
+        } else {
+            Components = VectorXi::Constant(NumberOfPoints, ALLMASK);
+        }
         Locations = node["Locations"].as<Vector3Xr>();
     }  // -----  end of method FieldPoints::FieldPoints  (constructor)  -----
 
@@ -62,6 +71,7 @@ namespace Lemma {
         node["NumberOfBinsE"] = NumberOfBinsE;
         node["NumberOfBinsH"] = NumberOfBinsH;
         node["Mask"] = Mask;
+        node["Components"] = Components;
         node["Locations"] = Locations;// Can be huge
         //std::cout << "Locations.data" << Locations.data()[0] << std::endl;
         return node;
@@ -103,6 +113,8 @@ namespace Lemma {
         this->Mask.resize(nrec);
         Mask.setZero();
 
+        Components = VectorXi::Constant(nrec, ALLMASK);
+
         ResizeEField();
         ResizeHField();
     }
@@ -156,6 +168,18 @@ namespace Lemma {
                     const Complex &ex,
                     const Complex &ey, const Complex &ez) {
         #ifdef LEMMAUSEOMP
+        if (ThreadPrivate) {
+            this->Efield[nbin].col(loc) += Vector3cr(ex, ey, ez);
+            return;
+        }
+        if (!EfieldThread.empty()) {
+            std::vector<Vector3Xcr>& Ebuf = EfieldThread[omp_get_thread_num()];
+            if (Ebuf.empty()) {
+                Ebuf.resize(NumberOfBinsE, Vector3Xcr::Zero(3, NumberOfPoints));
+            }
+            Ebuf[nbin].col(loc) += Vector3cr(ex, ey, ez);
+            return;
+        }
         #pragma omp critical
         #endif
         this->Efield[nbin].col(loc) += Vector3cr(ex, ey, ez); //temp;
@@ -170,30 +194,64 @@ namespace Lemma {
     void FieldPoints::AppendHfield(const int &nbin, const int& loc,
                     const Complex &hx, const Complex &hy,
                     const Complex &hz) {
-//      #ifdef LEMMAUSEOMP
-//      #pragma omp atomic
-//      std::real(this->Hfield[nbin].col(loc)[0]) += std::real(hx);
-//      #pragma omp atomic
-//      std::imag(this->Hfield[nbin].col(loc)[0]) += std::imag(hx);
-//      #pragma omp atomic
-//      std::real(this->Hfield[nbin].col(loc)[1]) += std::real(hy);
-//      #pragma omp atomic
-//      std::imag(this->Hfield[nbin].col(loc)[1]) += std::imag(hy);
-//      #pragma omp atomic
-//      std::real(this->Hfield[nbin].col(loc)[2]) += std::real(hz);
-//      #pragma omp atomic
-//      std::imag(this->Hfield[nbin].col(loc)[2]) += std::imag(hz);
-//          #else
-        //(critical sections are slow)
         #ifdef LEMMAUSEOMP
+        if (ThreadPrivate) {
+            this->Hfield[nbin].col(loc) += Vector3cr(hx, hy, hz);
+            return;
+        }
+        if (!HfieldThread.empty()) {
+            std::vector<Vector3Xcr>& Hbuf = HfieldThread[omp_get_thread_num()];
+            if (Hbuf.empty()) {
+                Hbuf.resize(NumberOfBinsH, Vector3Xcr::Zero(3, NumberOfPoints));
+            }
+            Hbuf[nbin].col(loc) += Vector3cr(hx, hy, hz);
+            return;
+        }
         #pragma omp critical
         #endif
         this->Hfield[nbin].col(loc) += Vector3cr(hx,hy,hz);
-        //#endif
     }
 
+    void FieldPoints::BeginThreadAccumulation(const int& nthreads) {
+        #ifdef LEMMAUSEOMP
+        EfieldThread.assign(nthreads, std::vector<Vector3Xcr>());
+        HfieldThread.assign(nthreads, std::vector<Vector3Xcr>());
+        #endif
+    }
+
+    void FieldPoints::EndThreadAccumulation() {
+        #ifdef LEMMAUSEOMP
+        // bins are independent, but threads are always summed in the same order
+        #pragma omp parallel for schedule(static)
+        for (int ibin=0; ibin<NumberOfBinsE; ++ibin) {
+            for (unsigned int it=0; it<EfieldThread.size(); ++it) {
+                if (!EfieldThread[it].empty()) {
+                    Efield[ibin] += EfieldThread[it][ibin];
+                }
+            }
+        }
+        #pragma omp parallel for schedule(static)
+        for (int ibin=0; ibin<NumberOfBinsH; ++ibin) {
+            for (unsigned int it=0; it<HfieldThread.size(); ++it) {
+                if (!HfieldThread[it].empty()) {
+                    Hfield[ibin] += HfieldThread[it][ibin];
+                }
+            }
+        }
+        EfieldThread.clear();
+        HfieldThread.clear();
+        #endif
+    }
+
+    void FieldPoints::SetThreadPrivate(const bool& priv) {
+        ThreadPrivate = priv;
+    }
 
     // ====================  INQUIRY       ===================================
+    bool FieldPoints::GetThreadPrivate() {
+        return ThreadPrivate;
+    }
+
     Vector3Xr FieldPoints::GetLocations() {
         return this->Locations;
     }
@@ -266,6 +324,18 @@ namespace Lemma {
         return Mask(i);
     }
 
+    void FieldPoints::SetComponents(const int& i, const int& mask) {
+        Components(i) = mask & ALLMASK;
+    }
+
+    void FieldPoints::SetComponents(const int& mask) {
+        Components.setConstant(mask & ALLMASK);
+    }
+
+    int FieldPoints::GetComponents(const int& i) {
+        return Components(i);
+    }
+
     int FieldPoints::GetNumberOfPoints() {
         return this->NumberOfPoints;
     }
@@ -277,6 +347,8 @@ namespace Lemma {
         for (int i=0; i<NumberOfBinsH; ++i) {
             this->Hfield[i].setZero();
         }
+        EfieldThread.clear();
+        HfieldThread.clear();
     }
 
     #ifdef LEMMAUSEVTK
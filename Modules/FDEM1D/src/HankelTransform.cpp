@@ -37,4 +37,57 @@ namespace Lemma {
 
     void HankelTransform::ComputeRelated(const Real& rho, std::shared_ptr<KernelEM1DManager> KernelManager) {
     }
+
+    void HankelTransform::SetLaggedTable( const VectorXr& Arg,
+            const Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& Z ) {
+        nLagged = static_cast<int>(Arg.size());
+        if (LaggedTable.rows() < nLagged || LaggedTable.cols() != Z.cols()) {
+            LaggedTable.resize( std::max(nLagged, static_cast<int>(LaggedTable.rows())), Z.cols() );
+        }
+        for (int ilag=0; ilag<nLagged; ++ilag) {
+            LaggedTable.row(ilag) = Arg(ilag) * Z.row(ilag);
+        }
+        LaggedLogArg0 = std::log(Arg(0));
+        LaggedInvLogStep = (nLagged > 1) ? 1./std::log(Arg(1)/Arg(0)) : 0;
+    }
+
+    void HankelTransform::CopyLaggedTable( const HankelTransform& Source ) {
+        nLagged = Source.nLagged;
+        if (LaggedTable.rows() < nLagged || LaggedTable.cols() != Source.LaggedTable.cols()) {
+            LaggedTable.resize( std::max(nLagged, static_cast<int>(LaggedTable.rows())),
+                    Source.LaggedTable.cols() );
+        }
+        LaggedTable.topRows(nLagged) = Source.LaggedTable.topRows(nLagged);
+        LaggedLogArg0 = Source.LaggedLogArg0;
+        LaggedInvLogStep = Source.LaggedInvLogStep;
+    }
+
+    void HankelTransform::InterpolateLagged( const Real& rho,
+            Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>& Z ) {
+
+        if (nLagged < 1) {
+            throw std::runtime_error("In HankelTransform InterpolateLagged without lagged convolutions");
+        }
+
+        // position in the table, the stencil is shifted inwards at the ends
+        const int m = std::min(4, nLagged);
+        Real t = (std::log(rho) - LaggedLogArg0) * LaggedInvLogStep;
+        int s = static_cast<int>(std::floor(t)) - 1;
+        s = std::max(0, std::min(s, nLagged-m));
+        Real u = t - s;
+
+        // Lagrange weights for nodes s to s+m-1, with the 1/rho scaling folded in
+        Real w[4] = {0, 0, 0, 0};
+        for (int k=0; k<m; ++k) {
+            w[k] = 1./rho;
+            for (int j=0; j<m; ++j) {
+                if (j != k) w[k] *= (u-j)/(k-j);
+            }
+        }
+
+        Z.row(0) = w[0] * LaggedTable.row(s);
+        for (int k=1; k<m; ++k) {
+            Z.row(0) += w[k] * LaggedTable.row(s+k);
+        }
+    }
 }
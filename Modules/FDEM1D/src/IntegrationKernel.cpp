@@ -24,4 +24,8 @@ namespace Lemma {
     IntegrationKernel<T>::~IntegrationKernel( ) {
     }
 
+    // Kernels are derived in other modules, so the instantiations are provided here
+    template class IntegrationKernel<Real>;
+    template class IntegrationKernel<Complex>;
+
 }		// -----  end of Lemma  name  -----
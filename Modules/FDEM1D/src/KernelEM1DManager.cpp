@@ -72,6 +72,18 @@ namespace Lemma {
         return Dipole;
     }
 
+    int KernelEM1DManager::GetFrequencyIndex( ) const {
+        return ifreq;
+    }
+
+    Real KernelEM1DManager::GetReceiverHeight( ) const {
+        return rx_z;
+    }
+
+    std::shared_ptr<LayeredEarthEM> KernelEM1DManager::GetEarth( ) const {
+        return Earth;
+    }
+
     // ====================  OPERATIONS    =======================
 
     void KernelEM1DManager::ComputeReflectionCoeffs(const Real& lambda, const int& idx, const Real& rho0) {
@@ -79,13 +91,238 @@ namespace Lemma {
         if (TEReflBase != nullptr) {
             TEReflBase->ComputeReflectionCoeffs(lambda);
             TEReflBase->PreComputePotentialTerms( );
+            TEReflBase->ApplyLoopWeight(lambda);
         }
 
         if (TMReflBase != nullptr) {
             TMReflBase->ComputeReflectionCoeffs(lambda);
             TMReflBase->PreComputePotentialTerms( );
+            TMReflBase->ApplyLoopWeight(lambda);
+        }
+
+    }
+
+    void KernelEM1DManager::ComputeReflectionCoeffs(const VectorXr& lambda) {
+
+        if (TEReflBase != nullptr) {
+            TEReflBase->ComputeReflectionCoeffs(lambda);
+        }
+
+        if (TMReflBase != nullptr) {
+            TMReflBase->ComputeReflectionCoeffs(lambda);
+        }
+
+    }
+
+    void KernelEM1DManager::SelectLambda(const int& ilam) {
+
+        if (TEReflBase != nullptr) {
+            TEReflBase->SelectLambda(ilam);
+        }
+
+        if (TMReflBase != nullptr) {
+            TMReflBase->SelectLambda(ilam);
+        }
+
+    }
+
+    bool KernelEM1DManager::ComputeRelatedKernels( Eigen::Ref<MatrixXcr> Z ) {
+
+        if (!Fused || KernelVec.empty() || Z.cols() != (int)(FusedKernels.size())) {
+            return false;
+        }
+
+        // Sign of relenukadz for each potential term and relIud, SS_SL of KernelEM1DSpec
+        static const Real SS_SL[4][2] = { {1, 1}, {-1, 1}, {1, -1}, {-1, -1} };
+
+        KernelEM1DReflBase* Bases[2] = { TEReflBase.get(), TMReflBase.get() };
+        const VectorXr* lambda = nullptr;
+        const DipoleSource* LoopSource = nullptr;
+        for (KernelEM1DReflBase* Base : Bases) {
+            if (Base == nullptr) {
+                continue;
+            }
+            if (!Base->batchTerms || Base->layr != 0 || Base->nBatch != Z.rows()) {
+                return false;
+            }
+            lambda = &Base->BatchLambda;
+            LoopSource = Base->LoopSource;
+        }
+
+        // @see KernelEM1DReflBase::ApplyLoopWeight
+        if (LoopSource != nullptr) {
+            FusedWeight.resize(Z.rows());
+            for (int il=0; il<Z.rows(); ++il) {
+                FusedWeight(il) = LoopSource->LoopWeight( (*lambda)(il) );
+            }
         }
 
+        for (int im=0; im<2; ++im) {
+            const KernelEM1DReflBase* Base = Bases[im];
+            if (Base == nullptr) {
+                continue;
+            }
+            if (Base->SensitivityParameter >= 0) {
+                // kernels are affine in relCon, the source term drops out
+                FusedCon[im][0] = Base->BatchdRelCon.col(Base->SensitivityParameter);
+                FusedCon[im][1] = FusedCon[im][0];
+            } else {
+                FusedCon[im][0] = Base->BatchRelCon + Base->BatchRelenukadz;
+                FusedCon[im][1] = Base->BatchRelCon - Base->BatchRelenukadz;
+            }
+            if (LoopSource != nullptr) {
+                FusedCon[im][0].array() *= FusedWeight.array();
+                FusedCon[im][1].array() *= FusedWeight.array();
+            }
+        }
+
+        for (int ik=0; ik<Z.cols(); ++ik) {
+            const FusedKernel& Kern = FusedKernels[ik];
+            const int im = (Kern.Mode == TE) ? 0 : 1;
+            const KernelEM1DReflBase* Base = Bases[im];
+            const VectorXcr& con = FusedCon[im][ SS_SL[Kern.Potential-1][Base->relIud] < 0 ];
+            auto Zk = Z.col(ik).array();
+            switch (Kern.Potential) {
+                case 1:
+                    Zk = con.array() / Base->BatchUk.array();
+                    break;
+                case 4:
+                    Zk = con.array() * Base->BatchUk.array();
+                    break;
+                default:
+                    Zk = con.array();
+            }
+            switch (Kern.LambdaPower) {
+                case 1:
+                    Zk *= lambda->array();
+                    break;
+                case 2:
+                    Zk *= lambda->array().square();
+                    break;
+                case 3:
+                    Zk *= lambda->array().cube();
+                    break;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+
+    bool KernelEM1DManager::ComputeAffineKernels( Eigen::Ref<MatrixXcr> Zcon, Eigen::Ref<MatrixXcr> Zrest ) {
+
+        KernelEM1DReflBase* Bases[2] = { TEReflBase.get(), TMReflBase.get() };
+        for (KernelEM1DReflBase* Base : Bases) {
+            if (Base != nullptr && (Base->LoopSource != nullptr || Base->SensitivityParameter >= 0)) {
+                return false;
+            }
+        }
+
+        // The fused kernels are evaluated with relCon one and the source term zero, then
+        // with relCon zero, and the batch is restored
+        VectorXcr Con[2];
+        VectorXcr Enukadz[2];
+        for (int im=0; im<2; ++im) {
+            if (Bases[im] == nullptr) {
+                continue;
+            }
+            Con[im] = Bases[im]->BatchRelCon;
+            Enukadz[im] = Bases[im]->BatchRelenukadz;
+            Bases[im]->BatchRelCon.setOnes();
+            Bases[im]->BatchRelenukadz.setZero();
+        }
+        bool fused = ComputeRelatedKernels( Zcon );
+        if (fused) {
+            for (int im=0; im<2; ++im) {
+                if (Bases[im] != nullptr) {
+                    Bases[im]->BatchRelCon.setZero();
+                    Bases[im]->BatchRelenukadz = Enukadz[im];
+                }
+            }
+            fused = ComputeRelatedKernels( Zrest );
+        }
+        for (int im=0; im<2; ++im) {
+            if (Bases[im] != nullptr) {
+                Bases[im]->BatchRelCon.swap( Con[im] );
+                Bases[im]->BatchRelenukadz.swap( Enukadz[im] );
+            }
+        }
+        return fused;
+    }
+
+    void KernelEM1DManager::ComputeModelReflectionCoeffs( const VectorXr& lambda,
+            const EvaluatedModelsEM& Models, const int& imod, const int& nmod ) {
+
+        if (Dipole == nullptr || Models.omega != Dipole->GetAngularFrequency(ifreq)) {
+            throw std::runtime_error("KernelEM1DManager: models are not evaluated at the source frequency");
+        }
+
+        if (TEReflBase != nullptr) {
+            TEReflBase->ComputeInAirModelRelCon( lambda, Models.zh.middleRows(imod, nmod),
+                    Models.kk.middleRows(imod, nmod), Models.LayerThickness.middleRows(imod, nmod) );
+        }
+
+        if (TMReflBase != nullptr) {
+            TMReflBase->ComputeInAirModelRelCon( lambda, Models.yh.middleRows(imod, nmod),
+                    Models.kk.middleRows(imod, nmod), Models.LayerThickness.middleRows(imod, nmod) );
+        }
+
+    }
+
+    const MatrixXcr& KernelEM1DManager::GetModelRelCon( const int& ik ) const {
+        return (FusedKernels[ik].Mode == TE) ? TEReflBase->ModelRelCon : TMReflBase->ModelRelCon;
+    }
+
+    void KernelEM1DManager::SetComputeSensitivities(const bool& compute) {
+
+        if (TEReflBase != nullptr) {
+            TEReflBase->SetComputeSensitivities(compute);
+        }
+
+        if (TMReflBase != nullptr) {
+            TMReflBase->SetComputeSensitivities(compute);
+        }
+
+    }
+
+    void KernelEM1DManager::SelectSensitivity(const int& iparam) {
+
+        if (TEReflBase != nullptr) {
+            TEReflBase->SelectSensitivity(iparam);
+        }
+
+        if (TMReflBase != nullptr) {
+            TMReflBase->SelectSensitivity(iparam);
+        }
+
+    }
+
+    void KernelEM1DManager::SetIncrementalRecursion(const bool& incremental, const int& slot) {
+
+        if (TEReflBase != nullptr) {
+            TEReflBase->SetIncrementalRecursion(incremental, slot);
+        }
+
+        if (TMReflBase != nullptr) {
+            TMReflBase->SetIncrementalRecursion(incremental, slot);
+        }
+
+    }
+
+    void KernelEM1DManager::ReSetDipoleSource( DipoleSource* DipoleIn,
+                                               const int& ifreqin,
+                                               const Real& rx_zin) {
+        SetDipoleSource(DipoleIn, ifreqin, rx_zin);
+        if (TEReflBase != nullptr) {
+            TEReflBase->Initialise(Earth);
+            TEReflBase->SetUpSource(Dipole, ifreq);
+            TEReflBase->SetUpReceiver(rx_z);
+        }
+        if (TMReflBase != nullptr) {
+            TMReflBase->Initialise(Earth);
+            TMReflBase->SetUpSource(Dipole, ifreq);
+            TMReflBase->SetUpReceiver(rx_z);
+        }
     }
 
     void KernelEM1DManager::ResetSource(const int& ifreq) {
@@ -17,6 +17,11 @@ namespace Lemma {
     template<>
     void KernelEM1DReflSpec<TM, INAIR, INAIR>::ComputeReflectionCoeffs(const Real& lambda) {
 
+        if (EvaluatedEarth->Reduced) {
+            ComputeReducedReflectionCoeffs(lambda, yh);
+            return;
+        }
+
         rams = lambda*lambda;
         u = (rams-kk.array()).sqrt(); // CRITICAL
 
@@ -51,6 +56,11 @@ namespace Lemma {
     template<>
     void KernelEM1DReflSpec<TE, INAIR, INAIR>::ComputeReflectionCoeffs(const Real& lambda) {
 
+        if (EvaluatedEarth->Reduced) {
+            ComputeReducedReflectionCoeffs(lambda, zh);
+            return;
+        }
+
         rams = lambda*lambda;
         u = (rams-kk.array()).sqrt(); // CRITICAL
 
@@ -164,6 +174,26 @@ namespace Lemma {
         return;
     }
 
+    template<>
+    void KernelEM1DReflSpec<TM, INAIR, INAIR>::ComputeReflectionCoeffs(const VectorXr& lambda) {
+        ComputeInAirSourceReflectionCoeffs(lambda, yh, 1);
+    }
+
+    template<>
+    void KernelEM1DReflSpec<TE, INAIR, INAIR>::ComputeReflectionCoeffs(const VectorXr& lambda) {
+        ComputeInAirSourceReflectionCoeffs(lambda, zh, 0);
+    }
+
+    template<>
+    void KernelEM1DReflSpec<TM, INAIR, INGROUND>::ComputeReflectionCoeffs(const VectorXr& lambda) {
+        ComputeInAirSourceReflectionCoeffs(lambda, yh, 1);
+    }
+
+    template<>
+    void KernelEM1DReflSpec<TE, INAIR, INGROUND>::ComputeReflectionCoeffs(const VectorXr& lambda) {
+        ComputeInAirSourceReflectionCoeffs(lambda, zh, 0);
+    }
+
     template<>
     void KernelEM1DReflSpec<TM, INAIR, INAIR>::PreComputePotentialTerms( ) {
         relIud = 0;
@@ -235,4 +265,499 @@ namespace Lemma {
         }
     }
 
+    // Receivers in the air only need Zyd(1), which the reduced stack gives by recursing over
+    // its layers alone, each with the thickness of its run of identical layers. Layers of a
+    // run below its first have zero stack thickness, so cf = 1 and th = 0 there.
+    void KernelEM1DReflBase::ComputeReducedReflectionCoeffs(const Real& lambda, const VectorXcr& Zh) {
+
+        rams = lambda*lambda;
+        const VectorXi& stack = EvaluatedEarth->StackLayers;
+        const int ns = stack.size();
+        const int nb = stack(ns-1);
+
+        u.head(nb+1) = (rams-kk.head(nb+1).array()).sqrt();
+        uk = u(0);
+        um = u(0);
+
+        Zyu(1) = -u(0)/Zh(0);
+        Zyi.head(nb+1) = u.head(nb+1).array() / Zh.head(nb+1).array();
+
+        cf.segment(1,nb-1) = (-2.*u.segment(1, nb-1).array() *
+                              EvaluatedEarth->StackThickness.segment(1, nb-1).array()).exp();
+        th.segment(1,nb-1) = (1.-cf.segment(1, nb-1).array()) / (1.+cf.segment(1, nb-1).array());
+
+        Zyd(nb) = Zyi(nb);
+        for (int is=ns-2; is >= 0; --is) {
+            const int N = stack(is);
+            const int next = stack(is+1);
+            Zyd(N) = Zyi(N)*(Zyd(next)+Zyi(N)*th(N)) / (Zyi(N)+Zyd(next)*th(N));
+        }
+
+        rtd(0) = (Zyu(1)+Zyd(1)) / (Zyu(1)-Zyd(1));
+    }
+
+    // ====================  BATCHED      =======================
+
+    // The batched calculations below mirror the per lambda specialisations above, but each
+    // complex quantity is held as separate real and imaginary columns with one row per lambda.
+    // Each step is then a single loop over lambda of Real arithmetic, which the compiler
+    // vectorises, the recursion over layers is the only serial part.
+
+    void KernelEM1DReflBase::ComputeInAirSourceReflectionCoeffs(const VectorXr& lambda,
+            const VectorXcr& Zh, const Real& dZhdSigma) {
+
+        // A sensitivity pass loads its terms from the batch of the preceding forward pass
+        if (SensitivityParameter >= 0) {
+            if ( !batchTerms || lambda.size() != nBatch || lambda != BatchLambda ) {
+                throw std::runtime_error("KernelEM1DReflBase: sensitivities need the lambda of the forward pass");
+            }
+            return;
+        }
+
+        nBatch = lambda.size();
+        BatchLambda = lambda;
+
+        // With incremental recursion the terms of an earlier batch at the same frequency and
+        // lambda values are swapped in, and only the layers that changed since are recomputed
+        int deepest = nlay-1;
+        LayerChanged.assign(nlay, true);
+
+        // Receivers in the air only need Zyd(1), so with a reduced stack the recursion only
+        // visits its layers, @see LayeredEarthEM::SetTruncationTolerance. Reduced batches
+        // are not kept, and sensitivities need every layer.
+        const bool reduced = EvaluatedEarth->Reduced && layr == 0 && !ComputeSensitivity;
+        const VectorXi& stack = EvaluatedEarth->StackLayers;
+        if (reduced) {
+            LayerChanged.assign(nlay, false);
+            LayerChanged[0] = true;
+            for (int is=0; is<stack.size(); ++is) {
+                LayerChanged[stack(is)] = true;
+            }
+        } else if (IncrementalRecursion) {
+            deepest = SwapInBatchRecursion(Zh);
+        }
+        const VectorXr& hcf = reduced ? EvaluatedEarth->StackThickness : LayerThickness;
+        const int bottom = reduced ? stack(stack.size()-1) : nlay-1;
+
+        // no-ops once sized
+        BuRe.resize(nBatch, nlay);    BuIm.resize(nBatch, nlay);
+        BZyiRe.resize(nBatch, nlay);  BZyiIm.resize(nBatch, nlay);
+        BZydRe.resize(nBatch, nlay);  BZydIm.resize(nBatch, nlay);
+        BcfRe.resize(nBatch, nlay);   BcfIm.resize(nBatch, nlay);
+        BrtdRe.resize(nBatch, nlay);  BrtdIm.resize(nBatch, nlay);
+        BatchUk.resize(nBatch);          BatchUm.resize(nBatch);
+        BatchRelCon.resize(nBatch);      BatchRelenukadz.resize(nBatch);
+        BatchRel_a.resize(nBatch);       BatchRtdr.resize(nBatch);
+        BatchRelexp_pbs1.resize(nBatch); BatchRelexp_pbs2.resize(nBatch);
+
+        const int n = nBatch;
+        const Real* lam = BatchLambda.data();
+
+        // u = sqrt(rams-kk) and Zyi = u/Zh. The imaginary part of rams-kk is constant across
+        // lambda, so the sign of the principal root is known up front.
+        for (int ilay=0; ilay<nlay; ++ilay) {
+            if (!LayerChanged[ilay]) continue;
+            const Real ka  = std::real(kk(ilay));
+            const Real b   = -std::imag(kk(ilay));
+            const Real ab  = std::abs(b);
+            const Real sgn = std::signbit(b) ? -1. : 1.;
+            const Complex zinv = (Real)(1.) / Zh(ilay);
+            const Real zr = std::real(zinv);
+            const Real zi = std::imag(zinv);
+            Real* ur = BuRe.col(ilay).data();
+            Real* ui = BuIm.col(ilay).data();
+            Real* yr = BZyiRe.col(ilay).data();
+            Real* yi = BZyiIm.col(ilay).data();
+            for (int i=0; i<n; ++i) {
+                const Real a = lam[i]*lam[i] - ka;
+                const Real t = std::sqrt( (Real)(.5)*(std::sqrt(a*a + b*b) + std::abs(a)) );
+                const Real re = (a >= 0) ? t : ab/(2.*t);
+                const Real im = (a >= 0) ? b/(2.*t) : sgn*t;
+                ur[i] = re;
+                ui[i] = im;
+                yr[i] = re*zr - im*zi;
+                yi[i] = re*zi + im*zr;
+            }
+        }
+
+        // cf = exp(-2 u h), cf of the bottom layer is never set in the per lambda path
+        BcfRe.col(nlay-1).setZero();
+        BcfIm.col(nlay-1).setZero();
+        for (int ilay=1; ilay<bottom; ++ilay) {
+            if (!LayerChanged[ilay]) continue;
+            const Real m2h = -2.*hcf(ilay);
+            const Real* ur = BuRe.col(ilay).data();
+            const Real* ui = BuIm.col(ilay).data();
+            Real* cr = BcfRe.col(ilay).data();
+            Real* ci = BcfIm.col(ilay).data();
+            for (int i=0; i<n; ++i) {
+                const Real e = std::exp(m2h*ur[i]);
+                cr[i] = e*std::cos(m2h*ui[i]);
+                ci[i] = e*std::sin(m2h*ui[i]);
+            }
+        }
+
+        // Zyd(N) = Zyi(N) (Zyd(next)+Zyi(N) th(N)) / (Zyi(N)+Zyd(next) th(N)), th = (1-cf)/(1+cf),
+        // where next is the layer below N, or the next layer of the reduced stack
+        auto ZydStep = [&]( const int& N, const int& next ) {
+            const Real* cr = BcfRe.col(N).data();
+            const Real* ci = BcfIm.col(N).data();
+            const Real* yr = BZyiRe.col(N).data();
+            const Real* yi = BZyiIm.col(N).data();
+            const Real* dr = BZydRe.col(next).data();
+            const Real* di = BZydIm.col(next).data();
+            Real* zr = BZydRe.col(N).data();
+            Real* zi = BZydIm.col(N).data();
+            for (int i=0; i<n; ++i) {
+                const Real den = ((Real)(1.)+cr[i])*((Real)(1.)+cr[i]) + ci[i]*ci[i];
+                const Real tr  = ((Real)(1.) - cr[i]*cr[i] - ci[i]*ci[i]) / den;
+                const Real ti  = -2.*ci[i] / den;
+                const Real nr  = dr[i] + yr[i]*tr - yi[i]*ti;
+                const Real ni  = di[i] + yr[i]*ti + yi[i]*tr;
+                const Real qr  = yr[i] + dr[i]*tr - di[i]*ti;
+                const Real qi  = yi[i] + dr[i]*ti + di[i]*tr;
+                const Real q   = qr*qr + qi*qi;
+                const Real fr  = (nr*qr + ni*qi) / q;
+                const Real fi  = (ni*qr - nr*qi) / q;
+                zr[i] = yr[i]*fr - yi[i]*fi;
+                zi[i] = yr[i]*fi + yi[i]*fr;
+            }
+        };
+        if (LayerChanged[bottom]) {
+            BZydRe.col(bottom) = BZyiRe.col(bottom);
+            BZydIm.col(bottom) = BZyiIm.col(bottom);
+        }
+        if (reduced) {
+            for (int is=stack.size()-2; is >= 0; --is) {
+                ZydStep(stack(is), stack(is+1));
+            }
+        } else {
+            // Zyd below the deepest changed layer is unchanged
+            for (int N=std::min(deepest, nlay-2); N >= 1; --N) {
+                ZydStep(N, N+1);
+            }
+        }
+
+        // rtd(N) = (Zyi(N)-Zyd(N+1)) / (Zyi(N)+Zyd(N+1)), for N=0 this is the usual
+        // (Zyu(1)+Zyd(1)) / (Zyu(1)-Zyd(1)) as Zyu(1) = -Zyi(0)
+        int le = layr;
+        if (le == nlay-1) --le;
+        BrtdRe.col(nlay-1).setZero();
+        BrtdIm.col(nlay-1).setZero();
+        for (int N=0; N<=le; ++N) {
+            const Real* yr = BZyiRe.col(N).data();
+            const Real* yi = BZyiIm.col(N).data();
+            const Real* dr = BZydRe.col(N+1).data();
+            const Real* di = BZydIm.col(N+1).data();
+            Real* rr = BrtdRe.col(N).data();
+            Real* ri = BrtdIm.col(N).data();
+            for (int i=0; i<n; ++i) {
+                const Real ar = yr[i]-dr[i];
+                const Real ai = yi[i]-di[i];
+                const Real br = yr[i]+dr[i];
+                const Real bi = yi[i]+di[i];
+                const Real q  = br*br + bi*bi;
+                rr[i] = (ar*br + ai*bi) / q;
+                ri[i] = (ai*br - ar*bi) / q;
+            }
+        }
+
+        ///////////////////////////////////
+        // Potential terms, @see PreComputePotentialTerms
+
+        relIud = 0;
+        if (rx_z <= tx_z) relIud = 1;
+
+        BatchUk.real() = BuRe.col(0);
+        BatchUk.imag() = BuIm.col(0);
+        BatchUm.real() = BuRe.col(layr);
+        BatchUm.imag() = BuIm.col(layr);
+        BatchRtdr.real() = BrtdRe.col(layr);
+        BatchRtdr.imag() = BrtdIm.col(layr);
+
+        if (layr == 0) {
+            const Real zsum = rx_z + tx_z;
+            const Real adz  = std::abs(rx_z - tx_z);
+            for (int i=0; i<n; ++i) {
+                const Real ur = BuRe(i,0);
+                const Real ui = BuIm(i,0);
+                // relCon = rtd(0) exp(u(0) (rx_z+tx_z))
+                const Real e  = std::exp(ur*zsum);
+                const Real er = e*std::cos(ui*zsum);
+                const Real ei = e*std::sin(ui*zsum);
+                BatchRelCon(i) = Complex(BrtdRe(i,0)*er - BrtdIm(i,0)*ei, BrtdRe(i,0)*ei + BrtdIm(i,0)*er);
+                // relenukadz = exp(-uk |rx_z - tx_z|)
+                const Real f  = std::exp(-adz*ur);
+                BatchRelenukadz(i) = Complex(f*std::cos(-adz*ui), f*std::sin(-adz*ui));
+            }
+            // unused by kernels with the receiver in the air
+            BatchRel_a.setZero();
+            BatchRelexp_pbs1.setZero();
+            BatchRelexp_pbs2.setZero();
+        } else {
+            const Real dz = (layr < nlay-1) ? (Real)(2.)*LayerDepth(layr) - rx_z : 0;
+            for (int i=0; i<n; ++i) {
+                // rel_a = (1+rtd(0)) / (1+rtd(1) cf(1)) prod_n (1+rtd(n-1)) / (1+rtd(n) cf(n))
+                Complex a = Complex((Real)(1.) + BrtdRe(i,0), BrtdIm(i,0)) /
+                            ((Real)(1.) + Complex(BrtdRe(i,1), BrtdIm(i,1))*Complex(BcfRe(i,1), BcfIm(i,1)));
+                Complex p(0,0);
+                p += Complex(BuRe(i,1)-BuRe(i,0), BuIm(i,1)-BuIm(i,0)) * LayerDepth(0);
+                for (int nn=2; nn<=layr; ++nn) {
+                    a *= Complex((Real)(1.) + BrtdRe(i,nn-1), BrtdIm(i,nn-1));
+                    if (nn < nlay-1) {
+                        a /= ((Real)(1.) + Complex(BrtdRe(i,nn), BrtdIm(i,nn))*Complex(BcfRe(i,nn), BcfIm(i,nn)));
+                    }
+                    p += Complex(BuRe(i,nn)-BuRe(i,nn-1), BuIm(i,nn)-BuIm(i,nn-1)) * LayerDepth(nn-1);
+                }
+                BatchRel_a(i) = a;
+                const Complex uk0(BuRe(i,0), BuIm(i,0));
+                const Complex umr(BuRe(i,layr), BuIm(i,layr));
+                BatchRelexp_pbs1(i) = std::exp(uk0*tx_z - umr*rx_z + p);
+                BatchRelexp_pbs2(i) = (layr < nlay-1) ? std::exp(uk0*tx_z - umr*dz + p) : Complex(0);
+            }
+            // unused by kernels with the receiver in the ground
+            BatchRelCon.setZero();
+            BatchRelenukadz.setZero();
+        }
+
+        batchTerms = true;
+
+        if (ComputeSensitivity) {
+            ComputeInAirSourceSensitivities(Zh, dZhdSigma);
+        }
+
+        if (IncrementalRecursion && !reduced) {
+            SwapOutBatchRecursion(Zh);
+        }
+    }
+
+    int KernelEM1DReflBase::SwapInBatchRecursion(const VectorXcr& Zh) {
+
+        // kept recursions of an earth with a different number of layers are of no use
+        if (!RecursionCache.empty() && RecursionCache.begin()->second.Zh.size() != nlay) {
+            RecursionCache.clear();
+        }
+
+        const Real omega = EvaluatedEarth->omega;
+        BatchRecursion& kept = RecursionCache[ std::make_pair(RecursionSlot, SlotBatch++) ];
+        KeptRecursion = &kept;
+        const bool found = kept.Zh.size() == nlay && kept.omega == omega &&
+                           kept.Lambda.size() == nBatch && kept.Lambda == BatchLambda;
+
+        // A new or replaced recursion gets storage of its own, so that the working terms
+        // swapped out to it come back sized
+        if (!found) {
+            kept.omega = omega;
+            kept.Lambda = BatchLambda;
+            kept.Zh.resize(0);
+            kept.BuRe.resize(nBatch, nlay);    kept.BuIm.resize(nBatch, nlay);
+            kept.BZyiRe.resize(nBatch, nlay);  kept.BZyiIm.resize(nBatch, nlay);
+            kept.BZydRe.resize(nBatch, nlay);  kept.BZydIm.resize(nBatch, nlay);
+            kept.BcfRe.resize(nBatch, nlay);   kept.BcfIm.resize(nBatch, nlay);
+        }
+
+        BuRe.swap(kept.BuRe);       BuIm.swap(kept.BuIm);
+        BZyiRe.swap(kept.BZyiRe);   BZyiIm.swap(kept.BZyiIm);
+        BZydRe.swap(kept.BZydRe);   BZydIm.swap(kept.BZydIm);
+        BcfRe.swap(kept.BcfRe);     BcfIm.swap(kept.BcfIm);
+
+        if (!found) {
+            return nlay-1;
+        }
+
+        int deepest = -1;
+        for (int ilay=0; ilay<nlay; ++ilay) {
+            LayerChanged[ilay] = kept.Zh(ilay) != Zh(ilay) || kept.kk(ilay) != kk(ilay) ||
+                                 kept.LayerThickness(ilay) != LayerThickness(ilay);
+            if (LayerChanged[ilay]) deepest = ilay;
+        }
+        return deepest;
+    }
+
+    void KernelEM1DReflBase::SwapOutBatchRecursion(const VectorXcr& Zh) {
+        BatchRecursion& kept = *KeptRecursion;
+        kept.Zh = Zh;
+        kept.kk = kk;
+        kept.LayerThickness = LayerThickness;
+        BuRe.swap(kept.BuRe);       BuIm.swap(kept.BuIm);
+        BZyiRe.swap(kept.BZyiRe);   BZyiIm.swap(kept.BZyiIm);
+        BZydRe.swap(kept.BZydRe);   BZydIm.swap(kept.BZydIm);
+        BcfRe.swap(kept.BcfRe);     BcfIm.swap(kept.BcfIm);
+    }
+
+    // The only earth dependence of the kernels with source and receiver in the air is
+    // relCon = rtd(0) exp(u(0) (rx_z+tx_z)), with rtd(0) = (Zyi(0)-Zyd(1)) / (Zyi(0)+Zyd(1)).
+    // The adjoint a of Zyd(N) is carried down the recursion
+    //     Zyd(N) = Zyi(N) (Zyd(N+1)+Zyi(N) th(N)) / (Zyi(N)+Zyd(N+1) th(N)),  th(N) = tanh(u(N) h(N))
+    // and each layer adds its local derivatives, through u(N) = sqrt(rams-kk(N)), kk = -zh yh.
+    void KernelEM1DReflBase::ComputeInAirSourceSensitivities(const VectorXcr& Zh, const Real& dZhdSigma) {
+
+        if (layr != 0 || lays != 0) {
+            throw std::runtime_error("KernelEM1DReflBase: sensitivities need the source and receiver in the air");
+        }
+
+        const int n = nBatch;
+        BatchdRelCon.resize(n, 2*nlay-3);
+
+        auto column = [n]( const MatrixXr& re, const MatrixXr& im, const int& ilay ) {
+            Eigen::Array<Complex, Eigen::Dynamic, 1> c(n);
+            c.real() = re.col(ilay);
+            c.imag() = im.col(ilay);
+            return c;
+        };
+
+        const Eigen::Array<Complex, Eigen::Dynamic, 1> Z0 = column(BZyiRe, BZyiIm, 0);
+        const Eigen::Array<Complex, Eigen::Dynamic, 1> D1 = column(BZydRe, BZydIm, 1);
+        const Eigen::Array<Complex, Eigen::Dynamic, 1> u0 = column(BuRe, BuIm, 0);
+
+        // adjoint of Zyd(1), d relCon / d Zyd(1)
+        Eigen::Array<Complex, Eigen::Dynamic, 1> a = (Real)(-2.)*Z0 / (Z0+D1).square() *
+                                                     (u0*(rx_z+tx_z)).exp();
+
+        for (int N=1; N<nlay; ++N) {
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> u = column(BuRe, BuIm, N);
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> Z = column(BZyiRe, BZyiIm, N);
+            // du/dsigma = zh/(2u), Zyi = u/Zh
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> du = zh(N) / ((Real)(2.)*u);
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> dZ = du/Zh(N) - dZhdSigma*u/(Zh(N)*Zh(N));
+            if (N == nlay-1) {
+                // bottom layer, Zyd = Zyi
+                BatchdRelCon.col(N-1) = (a*dZ).matrix();
+                break;
+            }
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> cf = column(BcfRe, BcfIm, N);
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> t  = ((Real)(1.)-cf) / ((Real)(1.)+cf);
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> D  = column(BZydRe, BZydIm, N+1);
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> q  = (Z + D*t).square();
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> sech2 = (Real)(1.) - t.square();
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> dZydZ = t*(D.square() + Z.square() + (Real)(2.)*Z*D*t) / q;
+            const Eigen::Array<Complex, Eigen::Dynamic, 1> dZydt = Z*(Z.square() - D.square()) / q;
+            BatchdRelCon.col(N-1) = (a*(dZydZ*dZ + dZydt*LayerThickness(N)*sech2*du)).matrix();
+            BatchdRelCon.col(nlay-2+N) = (a*dZydt*u*sech2).matrix();
+            // carry the adjoint to Zyd(N+1)
+            a *= Z.square()*sech2 / q;
+        }
+    }
+
+    // The batched recursion of ComputeInAirSourceReflectionCoeffs, turned on its side. Each
+    // lambda value is recursed for every model at once, bottom up, keeping only the terms of
+    // the current layer, and ends in relCon = rtd(0) exp(u(0) (rx_z+tx_z)).
+    void KernelEM1DReflBase::ComputeInAirModelRelCon(const VectorXr& lambda,
+            const Eigen::Ref<const MatrixXcr>& Zh, const Eigen::Ref<const MatrixXcr>& kkm,
+            const Eigen::Ref<const MatrixXr>& thickness) {
+
+        if (layr != 0 || lays != 0) {
+            throw std::runtime_error("KernelEM1DReflBase: model batches need the source and receiver in the air");
+        }
+
+        const int n  = static_cast<int>(Zh.rows());
+        const int nl = static_cast<int>(Zh.cols());
+        if (kkm.rows() != n || kkm.cols() != nl || thickness.rows() != n || thickness.cols() != nl) {
+            throw std::runtime_error("KernelEM1DReflBase: model properties differ in size");
+        }
+
+        // no-ops once sized
+        ModelRelCon.resize(n, lambda.size());
+        MkkRe = kkm.real();
+        MkkIm = kkm.imag();
+        MZinvRe.resize(n, nl);
+        MZinvIm.resize(n, nl);
+        for (int ilay=0; ilay<nl; ++ilay) {
+            for (int i=0; i<n; ++i) {
+                const Complex zinv = (Real)(1.) / Zh(i, ilay);
+                MZinvRe(i, ilay) = std::real(zinv);
+                MZinvIm(i, ilay) = std::imag(zinv);
+            }
+        }
+        Mm2h = -2.*thickness;
+
+        MuRe.resize(n);   MuIm.resize(n);
+        MZyiRe.resize(n); MZyiIm.resize(n);
+        MZydRe.resize(n); MZydIm.resize(n);
+        McfRe.resize(n);  McfIm.resize(n);
+
+        Real* ur = MuRe.data();
+        Real* ui = MuIm.data();
+        Real* yr = MZyiRe.data();
+        Real* yi = MZyiIm.data();
+        Real* dr = MZydRe.data();
+        Real* di = MZydIm.data();
+        Real* cr = McfRe.data();
+        Real* ci = McfIm.data();
+        const Real zsum = rx_z + tx_z;
+
+        // u = sqrt(rams-kk(N)), the principal root, and Zyi = u/Zh(N) of every model
+        auto ZyiStep = [&]( const Real& rams, const int& N ) {
+            const Real* kr = MkkRe.col(N).data();
+            const Real* ki = MkkIm.col(N).data();
+            const Real* zr = MZinvRe.col(N).data();
+            const Real* zi = MZinvIm.col(N).data();
+            for (int i=0; i<n; ++i) {
+                const Real a = rams - kr[i];
+                const Real b = -ki[i];
+                const Real t = std::sqrt( (Real)(.5)*(std::sqrt(a*a + b*b) + std::abs(a)) );
+                ur[i] = (a >= 0) ? t : std::abs(b)/(2.*t);
+                ui[i] = (a >= 0) ? b/(2.*t) : std::copysign(t, b);
+                yr[i] = ur[i]*zr[i] - ui[i]*zi[i];
+                yi[i] = ur[i]*zi[i] + ui[i]*zr[i];
+            }
+        };
+
+        // As in the batched recursion, the loops without calls to exp, cos and sin are kept
+        // apart from those with, so that they vectorise
+        for (int ilam=0; ilam<lambda.size(); ++ilam) {
+            const Real rams = lambda(ilam)*lambda(ilam);
+
+            // bottom layer, Zyd = Zyi
+            ZyiStep(rams, nl-1);
+            std::copy(yr, yr+n, dr);
+            std::copy(yi, yi+n, di);
+
+            // Zyd(N) = Zyi(N) (Zyd(N+1)+Zyi(N) th(N)) / (Zyi(N)+Zyd(N+1) th(N)),
+            // th = (1-cf)/(1+cf) and cf = exp(-2 u h)
+            for (int N=nl-2; N>=1; --N) {
+                ZyiStep(rams, N);
+                const Real* m2h = Mm2h.col(N).data();
+                for (int i=0; i<n; ++i) {
+                    const Real e = std::exp(m2h[i]*ur[i]);
+                    cr[i] = e*std::cos(m2h[i]*ui[i]);
+                    ci[i] = e*std::sin(m2h[i]*ui[i]);
+                }
+                for (int i=0; i<n; ++i) {
+                    const Real den = ((Real)(1.)+cr[i])*((Real)(1.)+cr[i]) + ci[i]*ci[i];
+                    const Real tr  = ((Real)(1.) - cr[i]*cr[i] - ci[i]*ci[i]) / den;
+                    const Real ti  = -2.*ci[i] / den;
+                    const Real nr  = dr[i] + yr[i]*tr - yi[i]*ti;
+                    const Real ni  = di[i] + yr[i]*ti + yi[i]*tr;
+                    const Real qr  = yr[i] + dr[i]*tr - di[i]*ti;
+                    const Real qi  = yi[i] + dr[i]*ti + di[i]*tr;
+                    const Real q   = qr*qr + qi*qi;
+                    const Real fr  = (nr*qr + ni*qi) / q;
+                    const Real fi  = (ni*qr - nr*qi) / q;
+                    dr[i] = yr[i]*fr - yi[i]*fi;
+                    di[i] = yr[i]*fi + yi[i]*fr;
+                }
+            }
+
+            // rtd(0) = (Zyi(0)-Zyd(1)) / (Zyi(0)+Zyd(1)), into cf as scratch
+            ZyiStep(rams, 0);
+            for (int i=0; i<n; ++i) {
+                const Real ar = yr[i] - dr[i];
+                const Real ai = yi[i] - di[i];
+                const Real br = yr[i] + dr[i];
+                const Real bi = yi[i] + di[i];
+                const Real q  = br*br + bi*bi;
+                cr[i] = (ar*br + ai*bi) / q;
+                ci[i] = (ai*br - ar*bi) / q;
+            }
+            Complex* con = ModelRelCon.col(ilam).data();
+            for (int i=0; i<n; ++i) {
+                const Real e  = std::exp(ur[i]*zsum);
+                const Real er = e*std::cos(ui[i]*zsum);
+                const Real ei = e*std::sin(ui[i]*zsum);
+                con[i] = Complex(cr[i]*er - ci[i]*ei, cr[i]*ei + ci[i]*er);
+            }
+        }
+    }
+
 }		// -----  end of Lemma  name  -----
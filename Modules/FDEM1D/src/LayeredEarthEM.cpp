@@ -105,33 +105,127 @@ namespace Lemma {
 
     // ====================  OPERATIONS    ===================================
     void LayeredEarthEM::EvaluateColeColeModel(const Real& omega) {
-
         for (int ilay=0; ilay<GetNumberOfLayers(); ++ilay) {
-            if ( LayerTauSusceptibility(ilay) > 1e-10) {
-                LayerSusceptibility(ilay) = LayerHighFreqSusceptibility(ilay) + (LayerLowFreqSusceptibility(ilay) -
-                     LayerHighFreqSusceptibility(ilay)) /
-                    ((Real)(1.) + std::pow(Complex(0, omega*
-                                    LayerTauSusceptibility(ilay)),
-                             LayerBreathSusceptibility(ilay)));
-            } else {
-                LayerSusceptibility(ilay) = LayerLowFreqSusceptibility(ilay);
+            LayerSusceptibility(ilay) = ColeColeSusceptibility(ilay, omega);
+            LayerPermitivity(ilay) = ColeColePermitivity(ilay, omega);
+        }
+    }
+
+    Complex LayeredEarthEM::ColeColeSusceptibility(const int& ilay, const Real& omega) const {
+        if ( LayerTauSusceptibility(ilay) > 1e-10) {
+            return LayerHighFreqSusceptibility(ilay) + (LayerLowFreqSusceptibility(ilay) -
+                 LayerHighFreqSusceptibility(ilay)) /
+                ((Real)(1.) + std::pow(Complex(0, omega*
+                                LayerTauSusceptibility(ilay)),
+                         LayerBreathSusceptibility(ilay)));
+        }
+        return LayerLowFreqSusceptibility(ilay);
+    }
+
+    Complex LayeredEarthEM::ColeColePermitivity(const int& ilay, const Real& omega) const {
+        if ( LayerTauPermitivity(ilay) > 1e-10) {
+            return LayerHighFreqPermitivity(ilay) +
+                (LayerLowFreqPermitivity(ilay) -
+                 LayerHighFreqPermitivity(ilay)) /
+                ((Real)(1.) + std::pow(Complex(0,
+                                omega*LayerTauPermitivity(ilay)),
+                        LayerBreathPermitivity(ilay)));
+        }
+        return LayerLowFreqPermitivity(ilay);
+    }
+
+    void LayeredEarthEM::EvaluateFrequencies(const VectorXr& omega) {
+        // The cache is cleared by every setter, so matching entries are still valid
+        if ( (int)(EvaluatedEarths.size()) == omega.size() ) {
+            bool match(true);
+            for (int iw=0; iw<omega.size(); ++iw) {
+                if (EvaluatedEarths[iw]->omega != omega(iw)) {
+                    match = false;
+                    break;
+                }
             }
+            if (match) return;
+        }
+        EvaluatedEarths.clear();
+        for (int iw=0; iw<omega.size(); ++iw) {
+            EvaluatedEarths.push_back( BuildEvaluatedEarth(omega(iw)) );
+        }
+    }
+
+    std::shared_ptr<const EvaluatedEarthEM> LayeredEarthEM::GetEvaluatedEarth(const Real& omega) {
+        for (const auto& evaluated : EvaluatedEarths) {
+            if (evaluated->omega == omega) {
+                return evaluated;
+            }
+        }
+        return BuildEvaluatedEarth(omega);
+    }
+
+    std::shared_ptr<const EvaluatedEarthEM> LayeredEarthEM::BuildEvaluatedEarth(const Real& omega) {
+
+        auto evaluated = std::make_shared<EvaluatedEarthEM>();
+        int nlay = GetNumberOfLayers();
+        evaluated->omega = omega;
+        evaluated->nlay = nlay;
+        evaluated->zh.resize(nlay);
+        evaluated->yh.resize(nlay);
+        evaluated->kk.resize(nlay);
+        evaluated->LayerThickness.resize(nlay);
+        evaluated->LayerDepth.resize(nlay);
+
+        // Layer 0 is always treated as free space
+        evaluated->zh(0) = Complex(0, omega*MU0);
+        evaluated->yh(0) = Complex(0, omega*EPSILON0);
+        evaluated->kk(0) = -evaluated->zh(0) * evaluated->yh(0);
+        for (int ilay=1; ilay<nlay; ++ilay) {
+            evaluated->zh(ilay) = evaluated->zh(0) * ColeColeSusceptibility(ilay, omega);
+            evaluated->yh(ilay) = LayerConductivity(ilay) +
+                    evaluated->yh(0)*ColeColePermitivity(ilay, omega);
+            evaluated->kk(ilay) = -evaluated->zh(ilay)*evaluated->yh(ilay);
+        }
+
+        Real depth(0);
+        for (int ilay=0; ilay<nlay; ++ilay) {
+            evaluated->LayerThickness(ilay) = GetLayerThickness(ilay);
+            if (ilay > 0) depth += evaluated->LayerThickness(ilay);
+            evaluated->LayerDepth(ilay) = depth;
+        }
 
-            if ( LayerTauPermitivity(ilay) > 1e-10) {
-                LayerPermitivity(ilay) = LayerHighFreqPermitivity(ilay) +
-                    (LayerLowFreqPermitivity(ilay) -
-                     LayerHighFreqPermitivity(ilay)) /
-                    ((Real)(1.) + std::pow(Complex(0,
-                                    omega*LayerTauPermitivity(ilay)),
-                            LayerBreathPermitivity(ilay)));
+        // Reduced stack of the recursion, runs of identical layers are merged into their first
+        // layer, and the stack ends once reflections from deeper are screened off
+        std::vector<int> stack;
+        evaluated->StackThickness = VectorXr::Zero(nlay);
+        evaluated->TruncationBound = 0;
+        const Real logTol = (TruncationTolerance > 0) ? std::log(TruncationTolerance) : 0;
+        Real logAtt(0);
+        for (int ilay=1; ilay<nlay; ++ilay) {
+            const bool bottom = (ilay == nlay-1);
+            const Real h = bottom ? 0 : evaluated->LayerThickness(ilay);
+            if ( MergeIdenticalLayers && !stack.empty() &&
+                 evaluated->zh(ilay) == evaluated->zh(stack.back()) &&
+                 evaluated->yh(ilay) == evaluated->yh(stack.back()) ) {
+                evaluated->StackThickness(stack.back()) += h;
             } else {
-                LayerPermitivity(ilay) = LayerLowFreqPermitivity(ilay);
+                stack.push_back(ilay);
+                evaluated->StackThickness(ilay) = h;
+            }
+            if (bottom) break;
+            logAtt -= 2.*std::real(std::sqrt(-evaluated->kk(ilay)))*h;
+            if (TruncationTolerance > 0 && logAtt < logTol) {
+                evaluated->TruncationBound = std::exp(logAtt);
+                break;
             }
         }
+        evaluated->StackLayers = Eigen::Map<VectorXi>(stack.data(), stack.size());
+        evaluated->Reduced = static_cast<int>(stack.size()) < nlay-1;
+
+        return evaluated;
     }
 
 	std::shared_ptr<LayeredEarthEM> LayeredEarthEM::Clone() {
 		auto copy = LayeredEarthEM::NewSP();
+		// sizes the layers first, this resets them to free space
+		copy->SetNumberOfLayers( this->GetNumberOfLayers() );
 		copy->LayerConductivity = this->LayerConductivity;
 		copy->LayerSusceptibility = this->LayerSusceptibility;
 		copy->LayerLowFreqSusceptibility = this->LayerLowFreqSusceptibility;
@@ -143,24 +237,37 @@ namespace Lemma {
 		copy->LayerHighFreqPermitivity = this->LayerHighFreqPermitivity;
 		copy->LayerTauPermitivity = this->LayerTauPermitivity;
 		copy->LayerBreathPermitivity = this->LayerBreathPermitivity;
-		copy->SetNumberOfLayers( this->GetNumberOfLayers() );
 		copy->NumberOfInterfaces = this->NumberOfInterfaces;
 		copy->LayerThickness = this->LayerThickness;
+		copy->TruncationTolerance = this->TruncationTolerance;
+		copy->MergeIdenticalLayers = this->MergeIdenticalLayers;
 		return copy;
 	}
 
     // ====================  ACCESS        ==================================
 
+    void LayeredEarthEM::SetTruncationTolerance(const Real& tol) {
+        TruncationTolerance = tol;
+        EvaluatedEarths.clear();
+    }
+
+    void LayeredEarthEM::SetMergeIdenticalLayers(const bool& merge) {
+        MergeIdenticalLayers = merge;
+        EvaluatedEarths.clear();
+    }
+
     void LayeredEarthEM::SetLayerConductivity(const VectorXcr &sig) {
         if (sig.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerConductivity = sig;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerConductivity(const int& ilay, const Complex &sig) {
         if (ilay > this->GetNumberOfLayers() || ilay < 1 )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerConductivity[ilay] = sig;
+        EvaluatedEarths.clear();
     }
 
 /*  // TODO fix layer 0 problem, 1/0 --> infty, plus layer 0 is ignored anyway
@@ -175,54 +282,63 @@ namespace Lemma {
         if (sus.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerHighFreqSusceptibility = sus;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerLowFreqSusceptibility(const VectorXr &sus) {
         if (sus.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerLowFreqSusceptibility = sus;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerBreathSusceptibility(const VectorXr &sus) {
         if (sus.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerBreathSusceptibility = sus;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerTauSusceptibility(const VectorXr &sus) {
         if (sus.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerTauSusceptibility = sus;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerHighFreqPermitivity(const VectorXr &per) {
         if (per.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerHighFreqPermitivity = per;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerLowFreqPermitivity(const VectorXr &per) {
         if (per.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerLowFreqPermitivity = per;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerBreathPermitivity(const VectorXr &per) {
         if (per.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerBreathPermitivity = per;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerTauPermitivity(const VectorXr &per) {
         if (per.size() != this->GetNumberOfLayers() )
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerTauPermitivity = per;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetLayerThickness(const VectorXr &thick) {
         if (thick.size() != this->GetNumberOfLayers() - 2)
             throw EarthModelParametersDoNotMatchNumberOfLayers( );
         LayerThickness = thick;
+        EvaluatedEarths.clear();
     }
 
     void LayeredEarthEM::SetNumberOfLayers(const int&nlay) {
@@ -271,10 +387,20 @@ namespace Lemma {
         LayerTauPermitivity = LayerPermitivity.imag();          // 0
         LayerBreathPermitivity = LayerPermitivity.imag();       // 0
 
+        EvaluatedEarths.clear();
     }
 
     // ====================  INQUIRY       ===================================
 
+    Real LayeredEarthEM::GetTruncationBound(const Real& omega) {
+        return GetEvaluatedEarth(omega)->TruncationBound;
+    }
+
+    int LayeredEarthEM::GetTruncationLayer(const Real& omega) {
+        auto evaluated = GetEvaluatedEarth(omega);
+        return evaluated->StackLayers(evaluated->StackLayers.size()-1);
+    }
+
     VectorXcr LayeredEarthEM::GetLayerConductivity() {
         return this->LayerConductivity;
     }
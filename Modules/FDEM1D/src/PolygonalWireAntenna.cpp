@@ -121,11 +121,9 @@ namespace Lemma {
         // Only resplit if necessary. Save a few cycles if repeated
         if ( (rRepeat-rp).norm() > 1e-16 ) {
 
+            // Full dipoles are rebuilt from the set only if requested
             Dipoles.clear();
-
-            ///////////////////
-		    // dipole array, this has impoved performance over directly pushing
-		    std::vector< std::shared_ptr<DipoleSource> >       xDipoles;
+            XYZDipoles.Clear();
 
             // check to see if loop is closed
             /*
@@ -139,7 +137,7 @@ namespace Lemma {
 		    int iseg;
             for (iseg=0; iseg<NumberOfPoints-1; ++iseg) { // closed loop
             //for (iseg=1; iseg<NumberOfPoints-2; ++iseg) { // grounded wire
-			    InterpolateLineSegment(Points.col(iseg), Points.col(iseg+1), rp, xDipoles);
+			    InterpolateLineSegment(Points.col(iseg), Points.col(iseg+1), rp);
 		    }
 
             // check to see if loop is closed
@@ -155,15 +153,119 @@ namespace Lemma {
             //    xDipoles.back()->SetType(GROUNDEDELECTRICDIPOLE);
             //}
 
-            Dipoles = std::move(xDipoles);
             rRepeat = rp;
+        }
+	}
+
+    void PolygonalWireAntenna::ApproximateWithLineIntegral(const Vector3r &rp) {
 
-        } else {
-            for (unsigned int id=0; id<Dipoles.size(); ++id) {
-                Dipoles[id]->SetFrequencies(Freqs);
+        // Only rebuild if necessary
+        if ( (lRepeat-rp).norm() < 1e-16 ) {
+            return;
+        }
+
+        // 8 point Gauss-Legendre rule on [-1, 1]
+        static const Real GLx[4] = { 0.1834346424956498, 0.5255324099163290,
+                                     0.7966664774136267, 0.9602898564975363 };
+        static const Real GLw[4] = { 0.3626837833783620, 0.3137066458778873,
+                                     0.2223810344533745, 0.1012285362903763 };
+
+        std::vector<Real> nodes;
+        for (int iseg=0; iseg<NumberOfPoints-1; ++iseg) {
+            // horizontal offsets, the antenna is planar
+            Vector3r dp = Points.col(iseg+1) - Points.col(iseg);
+            dp(2) = 0;
+            Real L = dp.norm();
+            if (L < 1e-12) continue;
+            Vector3r t = dp/L;
+            Vector3r n( t(1), -t(0), 0 );
+
+            // The normal distance is constant along the segment
+            Vector3r dr = rp - Points.col(iseg);
+            Real dz = dr(2);
+            dr(2) = 0;
+            Real d  = dr.dot(n);
+            Real sc = std::min( L, std::max( (Real)(0.), dr.dot(t) ) );
+            Real delta = std::max( std::sqrt(d*d + dz*dz), (Real)(1e-6)*L );
+
+            // panels doubling in length away from sc, on either side
+            for (Real end : {(Real)(0.), L}) {
+                Real a = sc;
+                Real len = delta;
+                while ( std::abs(end - a) > 1e-12*L ) {
+                    Real b = (end > sc) ? std::min(a + len, end) : std::max(a - len, end);
+                    Real mid = (Real)(.5)*(a + b);
+                    Real half = (Real)(.5)*std::abs(b - a);
+                    for (int ig=0; ig<8; ++ig) {
+                        Real s = mid + ((ig < 4) ? -GLx[ig] : GLx[ig-4])*half;
+                        Real w = GLw[ig % 4]*half;
+                        Real R = std::max( (dr - s*t).norm(), (Real)(1e-9)*L );
+                        nodes.push_back( R );
+                        nodes.push_back( w*d/R );
+                        nodes.push_back( w*n(0) );
+                        nodes.push_back( w*n(1) );
+                    }
+                    a = b;
+                    len *= 2.;
+                }
             }
         }
-	}
+
+        LineQuadrature = Eigen::Map< const Eigen::Matrix<Real, Eigen::Dynamic, 4, Eigen::RowMajor> >
+            ( nodes.data(), nodes.size()/4, 4 );
+        lRepeat = rp;
+    }
+
+    std::shared_ptr<DipoleSource> PolygonalWireAntenna::GetLineIntegralSource() {
+        if (LineSource == nullptr) {
+            LineSource = DipoleSource::NewSP();
+            LineSource->SetType(MAGNETICDIPOLE);
+            LineSource->SetPolarisation(0, 0, 1);
+            LineSource->SetLineIntegral(true);
+        }
+        LineSource->SetLocation( Points.col(0) );
+        LineSource->SetMoment( (Real)(NumberOfTurns)*Current );
+        LineSource->SetFrequencies( Freqs );
+        return LineSource;
+    }
+
+    const Eigen::Matrix<Real, Eigen::Dynamic, 4>& PolygonalWireAntenna::GetLineIntegralQuadrature() const {
+        return LineQuadrature;
+    }
+
+    std::shared_ptr<DipoleSource> PolygonalWireAntenna::GetDipoleSetSource() {
+        if (SetSource == nullptr) {
+            SetSource = DipoleSource::NewSP();
+            SetSource->SetType(UNGROUNDEDELECTRICDIPOLE);
+            SetSource->SetPolarisation(1, 0, 0);
+        }
+        SetSource->SetFrequencies( Freqs );
+        return SetSource;
+    }
+
+    const DipoleSet& PolygonalWireAntenna::GetDipoleSet() const {
+        return XYZDipoles;
+    }
+
+    std::shared_ptr<DipoleSource> PolygonalWireAntenna::GetDipoleSource(const int &dip) {
+        if ( static_cast<int>(Dipoles.size()) != XYZDipoles.GetNumberOfDipoles() ) {
+            Dipoles.clear();
+            for (int id=0; id<XYZDipoles.GetNumberOfDipoles(); ++id) {
+                auto tx = DipoleSource::NewSP();
+                    tx->SetLocation(XYZDipoles.GetLocation(id));
+                    tx->SetType(UNGROUNDEDELECTRICDIPOLE);
+                    tx->SetPolarisation(XYZDipoles.GetPolarisation(id));
+                    tx->SetMoment(XYZDipoles.GetMoment(id));
+                Dipoles.push_back(tx);
+            }
+        }
+        Dipoles[dip]->SetFrequencies(Freqs);
+        return Dipoles[dip];
+    }
+
+    size_t PolygonalWireAntenna::GetNumberOfDipoles() {
+        return XYZDipoles.GetNumberOfDipoles();
+    }
 
     void PolygonalWireAntenna::AddGroundingPoint( const Vector3r &cp, const Vector3r& dir,
                                 std::vector< std::shared_ptr<DipoleSource> > &xDipoles) {
@@ -211,36 +313,25 @@ namespace Lemma {
 	}
 
 	void PolygonalWireAntenna::PushXYZDipoles(const Vector3r &step,
-				    const Vector3r &cp, const Vector3r &dir,
-					std::vector< std::shared_ptr<DipoleSource> > &xDipoles) {
+				    const Vector3r &cp, const Vector3r &dir) {
 
 		Real scale = (Real)(NumberOfTurns)*Current;
-
-        auto tx = DipoleSource::NewSP();
-		    tx->SetLocation(cp);
-		    tx->SetType(UNGROUNDEDELECTRICDIPOLE);
-			tx->SetPolarisation(dir);
-			tx->SetFrequencies(Freqs);
-			tx->SetMoment(scale*step.norm());
-			xDipoles.push_back(tx);
+        XYZDipoles.Push(cp, dir/dir.norm(), scale*step.norm());
 	}
 
 	void PolygonalWireAntenna::CorrectOverstepXYZDipoles(const Vector3r &step,
-				    const Vector3r &cp,	const Vector3r &dir,
-					std::vector< std::shared_ptr<DipoleSource> > &xDipoles ) {
+				    const Vector3r &cp,	const Vector3r &dir) {
 
 		Real scale = (Real)(NumberOfTurns)*Current;
 
 		// X oriented dipoles
 		if (step.norm() > minDipoleMoment) {
-			xDipoles[xDipoles.size()-1]->SetLocation(cp);
-			xDipoles[xDipoles.size()-1]->SetMoment(scale*step.norm());
+			XYZDipoles.CorrectLast(cp, scale*step.norm());
 		}
 	}
 
 	void PolygonalWireAntenna::InterpolateLineSegment(const Vector3r &p1,
-					const Vector3r &p2, const Vector3r & tp,
-					std::vector< std::shared_ptr<DipoleSource> > &xDipoles ) {
+					const Vector3r &p2, const Vector3r & tp) {
 
 		Vector3r phat = (p1-p2).array() / (p1-p2).norm();
 		Vector3r c    = this->ClosestPointOnLine(p1, p2, tp);
@@ -269,7 +360,7 @@ namespace Lemma {
 			// (dir-phat) just shows if we are stepping towards or away  from p1
 			while (dist < dist_old && (dir-phat).norm() < 1e-8) {
 
-				PushXYZDipoles(step, cp, cdir, xDipoles);
+				PushXYZDipoles(step, cp, cdir);
 
 				// Make 1/2 of previous step, 1/2 of this step, store this step
 				stepold  = step;
@@ -294,12 +385,12 @@ namespace Lemma {
 				// case 1: understep, add dipole
 				step  = (p1-cp).array();
 				cp   += .5*step;
-				PushXYZDipoles(step, cp, cdir, xDipoles);
+				PushXYZDipoles(step, cp, cdir);
 			} else if (distLastSeg > dc1 + minDipoleMoment) {
 				// case 2: overstep, reposition dipole and size
 				step  = (p1 - (lp-.5*stepold));
 				cp =  (lp-.5*stepold) + (.5*step);
-				CorrectOverstepXYZDipoles(step, cp, cdir, xDipoles);
+				CorrectOverstepXYZDipoles(step, cp, cdir);
 			}
 			// else case 0: nearly 'perfect' fit do nothing
 		}
@@ -327,7 +418,7 @@ namespace Lemma {
  			// (dir-phat) just shows if we are stepping towards or away  from p1
  			while (dist < dist_old && (dir+phat).norm() < 1e-8) {
 
- 				PushXYZDipoles(step, cp, cdir, xDipoles);
+ 				PushXYZDipoles(step, cp, cdir);
 
 				// Make 1/2 of previous step, 1/2 of this step, store this step
 				stepold  = step;
@@ -351,14 +442,14 @@ namespace Lemma {
 				// case 1: understep, add dipole
 				step  = (p2-cp).array();
 				cp   += .5*step;
-				PushXYZDipoles(step, cp, cdir, xDipoles);
+				PushXYZDipoles(step, cp, cdir);
 
 			} else if (distLastSeg > dc2 + minDipoleMoment) {
 
 				// case 2: overstep, reposition dipole and size
 				step  = (p2 - (lp-.5*stepold));
 				cp =  (lp-.5*stepold) + (.5*step);
-				CorrectOverstepXYZDipoles(step, cp, cdir, xDipoles);
+				CorrectOverstepXYZDipoles(step, cp, cdir);
 
 			}
 			// else case 0: nearly 'perfect' fit do nothing
@@ -311,8 +311,9 @@ namespace Lemma {
         int nrel = (int)(KernelManager->GetSTLVector().size());
         Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic > Zwork =
             Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic>::Zero(nQuad, nrel);
+        KernelManager->ComputeReflectionCoeffs( Lambda.segment(bidx, nQuad) );
         for (int ik=0; ik<nQuad; ++ik) {
-            KernelManager->ComputeReflectionCoeffs( Lambda(bidx+ik), idx, rho );
+            KernelManager->SelectLambda( ik );
             for (int ir2=0; ir2<nrel; ++ir2) {
                 // Zwork* needed due to sign convention (e^-jwt) of FT in filter weights
  			    Zwork(ik, ir2) =    std::conj(KernelManager->GetSTLVector()[ir2]->RelBesselArg(Lambda(bidx+ik)));
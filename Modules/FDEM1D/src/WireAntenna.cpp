@@ -232,7 +232,7 @@ namespace Lemma {
 
     #ifdef LEMMAUSEVTK
     vtkActor* WireAntenna::GetVtkActor(const int &idip) {
-        return Dipoles[idip]->GetVtkActor();
+        return GetDipoleSource(idip)->GetVtkActor();
     }
     #endif
 
@@ -251,5 +251,17 @@ namespace Lemma {
         }
     }		// -----  end of method WireAntenna::IsPlanar  -----
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  WireAntenna
+    //      Method:  IsClosed
+    //--------------------------------------------------------------------------------------
+    bool WireAntenna::IsClosed (  ) {
+        if ( NumberOfPoints > 2 && (Points.col(0) - Points.col(NumberOfPoints-1)).norm() < 1e-3 ) {
+            return true ;
+        } else {
+            return false;
+        }
+    }		// -----  end of method WireAntenna::IsClosed  -----
+
 
 }
@@ -0,0 +1,102 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+#include <cstdio>
+#include <fstream>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    /** The grouped sources of ForwardModel, computed above the sounding with the
+     *  receivers translated, agree with each source computed where it is
+     */
+    void testForwardModelMatchesSources( void )
+    {
+        // Sources sharing a frequency, type and height at several offsets, a second
+        // frequency of the same group, a coplanar and an electric source and one at
+        // another height
+        const std::string fname = "AEMSurveyCheck.dat";
+        {
+            std::ofstream file(fname);
+            file << "6\n"
+                 << "900 MD 7.9 0 0 1\n"
+                 << "7200 MD 7.9 0 0 1\n"
+                 << "900 MD 0 7.9 0 1\n"
+                 << "5500 MD 6.3 0 0 1\n"
+                 << "900 ED 7.9 0 0 1\n"
+                 << "56000 MD 6.3 0 -.5 1\n"
+                 << "3\n"
+                 << "0 0 -30 0 0 1\n"
+                 << "10 0 -35 0 1 0\n"
+                 << "20 5 -40 1 0 0\n";
+        }
+        auto Reader = AEMSurveyReader::NewSP();
+            Reader->ReadASCIIAEMFile(fname);
+        std::remove(fname.c_str());
+        auto Survey = Reader->GetSurvey();
+        const int nloc = Survey->GetNumberOfLocations();
+        const int nsrc = Survey->GetNumberOfSourcesPerLocation();
+        TS_ASSERT_EQUALS( nloc, 3 );
+        TS_ASSERT_EQUALS( nsrc, 6 );
+
+        // the last two soundings share a model
+        std::vector< std::shared_ptr<LayeredEarthEM> > models = { Earth(1), Earth(3), Earth(3) };
+        models[2] = models[1];
+
+        Survey->SetFieldsToCalculate( BOTH );
+        MatrixXcr Fields = Survey->ForwardModel( models );
+        TS_ASSERT_EQUALS( Fields.rows(), 6*nsrc );
+        TS_ASSERT_EQUALS( Fields.cols(), nloc );
+
+        for (int iloc=0; iloc<nloc; ++iloc) {
+            for (int isrc=0; isrc<nsrc; ++isrc) {
+                auto Receiver = FieldPoints::NewSP();
+                    Receiver->SetNumberOfPoints(1);
+                    Receiver->SetLocation( 0, Vector3r(Survey->GetLocations().col(iloc)) );
+                auto EmEarth = EMEarth1D::NewSP();
+                    EmEarth->AttachDipoleSource( Survey->GetSource(iloc*nsrc + isrc) );
+                    EmEarth->AttachLayeredEarthEM( models[iloc] );
+                    EmEarth->AttachFieldPoints( Receiver );
+                    EmEarth->SetFieldsToCalculate( BOTH );
+                    EmEarth->SetHankelTransformMethod( ANDERSON801 );
+                    EmEarth->MakeCalc3();
+                Vector3cr H0 = Receiver->GetHfield(0, 0);
+                Vector3cr E0 = Receiver->GetEfield(0, 0);
+                Vector3cr H1 = Fields.block<3,1>(3*isrc, iloc);
+                Vector3cr E1 = Fields.block<3,1>(3*nsrc + 3*isrc, iloc);
+                TS_ASSERT_LESS_THAN_EQUALS( (H1-H0).norm(), 1e-10*H0.norm() );
+                TS_ASSERT_LESS_THAN_EQUALS( (E1-E0).norm(), 1e-10*E0.norm() );
+            }
+        }
+    }
+
+    private:
+
+    /** A layered earth, with the conductivities scaled */
+    std::shared_ptr<LayeredEarthEM> Earth( const Real& scale ) {
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( scale*(VectorXcr(4) << 0., 1./100., 1./10., 1./50.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 20, 30).finished() );
+        return earth;
+    }
+
+};
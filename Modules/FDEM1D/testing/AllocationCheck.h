@@ -0,0 +1,116 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+#include <cstdlib>
+
+using namespace Lemma;
+
+// Counts heap allocations made while AllocCounting is set. Eigen allocates with std::malloc,
+// which is only wrapped with glibc. Elsewhere the allocations cannot all be counted and the
+// test is skipped.
+static bool AllocCounting = false;
+static long AllocCount = 0;
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* malloc(size_t size) {
+    if (AllocCounting) ++AllocCount;
+    return __libc_malloc(size);
+}
+#endif
+
+/** Exposes the inner loop of EMEarth1D */
+class EMEarth1DProbe : public EMEarth1D {
+    public:
+    EMEarth1DProbe( ) : EMEarth1D( ctor_key() ) {
+    }
+    void Solve(const int& irec, HankelTransform* Hankel, const int& ifreq, DipoleSource* Dipole) {
+        Real wavef = Dipole->GetAngularFrequency(ifreq) * std::sqrt(MU0*EPSILON0);
+        SolveSingleTxRxPair(irec, Hankel, wavef, ifreq, Dipole);
+    }
+};
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testSteadyStateAllocations( void )
+    {
+        #if !defined(__GLIBC__)
+        TS_SKIP("allocations are only counted with glibc");
+        #endif
+
+        // the counter must see Eigen's allocations, or the test below checks nothing
+        AllocCount = 0;
+        AllocCounting = true;
+        {
+            VectorXcr probe(64);
+            probe.setZero();
+        }
+        AllocCounting = false;
+        TS_ASSERT_LESS_THAN( 0, AllocCount );
+
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( (VectorXcr(4) << 0., 1./2., 1./.2, 1./.3).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 20).finished() );
+
+        auto receivers = FieldPoints::NewSP();
+            receivers->SetNumberOfPoints(4);
+            for (int irec=0; irec<4; ++irec) {
+                receivers->SetLocation(irec, 10.+irec, 5.+2.*irec, 1.+irec);
+            }
+
+        for (auto type : {MAGNETICDIPOLE, GROUNDEDELECTRICDIPOLE}) {
+
+            auto dipole = DipoleSource::NewSP();
+                dipole->SetType(type);
+                dipole->SetPolarisation(1., 0., 1.);
+                dipole->SetLocation(0, 0, -1);
+                dipole->SetNumberOfFrequencies(2);
+                dipole->SetFrequency(0, 100);
+                dipole->SetFrequency(1, 1000);
+
+            auto EmEarth = std::make_shared<EMEarth1DProbe>();
+                EmEarth->AttachDipoleSource(dipole);
+                EmEarth->AttachLayeredEarthEM(earth);
+                EmEarth->AttachFieldPoints(receivers);
+                EmEarth->SetFieldsToCalculate(BOTH);
+
+            // MakeCalc3 does this before entering the inner loop
+            earth->EvaluateFrequencies( 2.*PI*dipole->GetFrequencies() );
+
+            for (auto htype : {ANDERSON801, FHTKEY201, FHTKEY101, FHTKEY51, FHTKONG61, IRONS}) {
+                auto Hankel = HankelTransformFactory::NewSP( htype );
+                // warm up
+                EmEarth->Solve(0, Hankel.get(), 0, dipole.get());
+
+                AllocCount = 0;
+                AllocCounting = true;
+                for (int ifreq=0; ifreq<2; ++ifreq) {
+                    for (int irec=0; irec<4; ++irec) {
+                        EmEarth->Solve(irec, Hankel.get(), ifreq, dipole.get());
+                    }
+                }
+                AllocCounting = false;
+                TS_ASSERT_EQUALS( AllocCount, 0 );
+            }
+        }
+    }
+
+};
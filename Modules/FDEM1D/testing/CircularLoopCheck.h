@@ -0,0 +1,111 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testCircularLoopMatchesWire( void )
+    {
+        const Real radius = 40;
+        const Real zloop = -1;
+        const int nside = 720;
+
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( (VectorXcr(4) << 0., 1./20., 1./2., 1./30.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 20).finished() );
+
+        // receivers at the centre, inside of, near to the wire, and outside of the loop, a
+        // quarter of a radius above it
+        std::vector<Vector3r> locations = { Vector3r(0, 0, -11), Vector3r(15, 10, -11),
+            Vector3r(-30, 5, -13), Vector3r(36, 20, -11), Vector3r(48, 0, -13),
+            Vector3r(60, -45, -11), Vector3r(150, 30, -15), Vector3r(300, 0, -11) };
+
+        // The polygon is scaled to the area of the circle, so that both have the same moment
+        auto wire = PolygonalWireAntenna::NewSP();
+            wire->SetNumberOfPoints(nside+1);
+            Real rpoly = radius*std::sqrt( 2.*PI/(nside*std::sin(2.*PI/nside)) );
+            for (int ip=0; ip<=nside; ++ip) {
+                Real phi = 2.*PI*(ip%nside)/nside;
+                wire->SetPoint(ip, Vector3r(rpoly*std::cos(phi), rpoly*std::sin(phi), zloop));
+            }
+            wire->SetNumberOfFrequencies(2);
+            wire->SetFrequency(0, 100);
+            wire->SetFrequency(1, 10000);
+            wire->SetCurrent(1);
+            wire->SetNumberOfTurns(1);
+
+        auto loop = CircularLoop::NewSP();
+            loop->SetRadius( radius );
+            loop->SetLocation( 0, 0, zloop );
+            loop->SetNumberOfTurns( 1 );
+            loop->SetCurrent( 1 );
+            loop->SetNumberOfFrequencies( 2 );
+            loop->SetFrequency( 0, 100 );
+            loop->SetFrequency( 1, 10000 );
+
+        // Of the filters, ANDERSON801 best resolves the oscillation that the radius adds to
+        // the kernels outside of the loop
+        auto wirepoints = Points(locations);
+        auto EmWire = EMEarth1D::NewSP();
+            EmWire->AttachWireAntenna(wire);
+            EmWire->AttachLayeredEarthEM(earth);
+            EmWire->AttachFieldPoints(wirepoints);
+            EmWire->SetFieldsToCalculate(BOTH);
+            EmWire->SetHankelTransformMethod(ANDERSON801);
+            EmWire->SetLineIntegralEvaluation(true);
+            EmWire->CalculateWireAntennaFields();
+
+        auto looppoints = Points(locations);
+        auto EmLoop = EMEarth1D::NewSP();
+            EmLoop->AttachCircularLoop(loop);
+            EmLoop->AttachLayeredEarthEM(earth);
+            EmLoop->AttachFieldPoints(looppoints);
+            EmLoop->SetFieldsToCalculate(BOTH);
+            EmLoop->SetHankelTransformMethod(ANDERSON801);
+            EmLoop->CalculateCircularLoopFields();
+
+        for (int ifreq=0; ifreq<2; ++ifreq) {
+            for (unsigned int irec=0; irec<locations.size(); ++irec) {
+                Vector3cr H0 = wirepoints->GetHfield(ifreq, irec);
+                Vector3cr H1 = looppoints->GetHfield(ifreq, irec);
+                Vector3cr E0 = wirepoints->GetEfield(ifreq, irec);
+                Vector3cr E1 = looppoints->GetEfield(ifreq, irec);
+                TS_ASSERT_LESS_THAN( (H1-H0).norm(), 5e-3*H0.norm() );
+                // the electric field vanishes at the centre
+                TS_ASSERT_LESS_THAN_EQUALS( (E1-E0).norm(), 5e-3*E0.norm() + 1e-12*H0.norm() );
+            }
+        }
+    }
+
+    private:
+
+    std::shared_ptr<FieldPoints> Points( const std::vector<Vector3r>& locations ) {
+        auto points = FieldPoints::NewSP();
+            points->SetNumberOfPoints(locations.size());
+            for (unsigned int irec=0; irec<locations.size(); ++irec) {
+                points->SetLocation(irec, locations[irec]);
+            }
+        return points;
+    }
+
+};
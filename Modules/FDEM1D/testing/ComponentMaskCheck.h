@@ -0,0 +1,172 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testDipoleMasks( void )
+    {
+        const DIPOLESOURCETYPE Types[] = { GROUNDEDELECTRICDIPOLE, GROUNDINGPOINT,
+                                           UNGROUNDEDELECTRICDIPOLE, MAGNETICDIPOLE };
+        for (auto Type : Types) {
+            for (Real zs : {-2., 3.}) {
+                auto dipole = DipoleSource::NewSP();
+                    dipole->SetType( Type );
+                    dipole->SetPolarisation( .48, .6, .64 );
+                    dipole->SetLocation( 1, 2, zs );
+                    dipole->SetMoment( 1 );
+                    dipole->SetNumberOfFrequencies( 2 );
+                    dipole->SetFrequency( 0, 100 );
+                    dipole->SetFrequency( 1, 10000 );
+
+                auto receivers = MaskedPoints();
+                auto EmEarth = EMEarth1D::NewSP();
+                    EmEarth->AttachDipoleSource(dipole);
+                    EmEarth->AttachFieldPoints(receivers);
+                    EmEarth->AttachLayeredEarthEM(Earth());
+                    EmEarth->SetFieldsToCalculate(BOTH);
+                    EmEarth->SetHankelTransformMethod(FHTKEY201);
+                    EmEarth->MakeCalc3();
+                CheckMasks(receivers, 2);
+            }
+        }
+    }
+
+    void testCircularLoopMasks( void )
+    {
+        auto loop = CircularLoop::NewSP();
+            loop->SetRadius( 20 );
+            loop->SetLocation( 0, 0, -1 );
+            loop->SetNumberOfTurns( 1 );
+            loop->SetCurrent( 1 );
+            loop->SetNumberOfFrequencies( 2 );
+            loop->SetFrequency( 0, 100 );
+            loop->SetFrequency( 1, 10000 );
+
+        auto receivers = MaskedPoints();
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachCircularLoop(loop);
+            EmEarth->AttachFieldPoints(receivers);
+            EmEarth->AttachLayeredEarthEM(Earth());
+            EmEarth->SetFieldsToCalculate(BOTH);
+            EmEarth->SetHankelTransformMethod(FHTKEY201);
+            EmEarth->CalculateCircularLoopFields();
+        CheckMasks(receivers, 2);
+    }
+
+    void testWireAntennaMasks( void )
+    {
+        for (bool line : {false, true}) {
+            auto loop = PolygonalWireAntenna::NewSP();
+                loop->SetNumberOfPoints(5);
+                loop->SetPoint(0, Vector3r(-20, -20, -1e-3));
+                loop->SetPoint(1, Vector3r( 20, -20, -1e-3));
+                loop->SetPoint(2, Vector3r( 20,  20, -1e-3));
+                loop->SetPoint(3, Vector3r(-20,  20, -1e-3));
+                loop->SetPoint(4, Vector3r(-20, -20, -1e-3));
+                loop->SetNumberOfFrequencies(2);
+                loop->SetFrequency(0, 100);
+                loop->SetFrequency(1, 10000);
+                loop->SetCurrent(1);
+                loop->SetNumberOfTurns(1);
+                loop->SetMinDipoleRatio(.1);
+                loop->SetMaxDipoleMoment(10);
+
+            auto receivers = MaskedPoints();
+            auto EmEarth = EMEarth1D::NewSP();
+                EmEarth->AttachWireAntenna(loop);
+                EmEarth->AttachFieldPoints(receivers);
+                EmEarth->AttachLayeredEarthEM(Earth());
+                EmEarth->SetFieldsToCalculate(BOTH);
+                EmEarth->SetHankelTransformMethod(FHTKEY201);
+                EmEarth->SetLineIntegralEvaluation(line);
+                EmEarth->CalculateWireAntennaFields();
+            CheckMasks(receivers, 2);
+        }
+    }
+
+    private:
+
+    /** Masks checked, each is applied to a copy of every location */
+    std::vector<int> Masks() {
+        return { EXMASK, EYMASK, EZMASK, HXMASK, HYMASK, HZMASK, EMASK, HMASK, EXMASK|HZMASK };
+    }
+
+    std::shared_ptr<LayeredEarthEM> Earth() {
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( (VectorXcr(4) << 0., 1./50., 1./5., 1./100.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 25).finished() );
+        return earth;
+    }
+
+    /** Points at a few locations, in the air and in the ground, with ALLMASK and then a
+     *  copy of them for each of the Masks
+     */
+    std::shared_ptr<FieldPoints> MaskedPoints() {
+        const std::vector<Vector3r> locations = { Vector3r(5, 3, -1), Vector3r(31, -14, -1),
+            Vector3r(-7, 65, -5), Vector3r(12, 40, 6) };
+        const std::vector<int> masks = Masks();
+        const int nloc = locations.size();
+        auto points = FieldPoints::NewSP();
+            points->SetNumberOfPoints( nloc*(1+masks.size()) );
+            for (int im=-1; im<static_cast<int>(masks.size()); ++im) {
+                for (int iloc=0; iloc<nloc; ++iloc) {
+                    points->SetLocation( (im+1)*nloc + iloc, locations[iloc] );
+                    if (im >= 0) {
+                        points->SetComponents( (im+1)*nloc + iloc, masks[im] );
+                    }
+                }
+            }
+        return points;
+    }
+
+    /** Selected components agree with the ALLMASK points, the others are zero */
+    void CheckMasks( std::shared_ptr<FieldPoints> points, const int& nfreq ) {
+        const std::vector<int> masks = Masks();
+        const int nloc = points->GetNumberOfPoints() / (1+masks.size());
+        for (int ifreq=0; ifreq<nfreq; ++ifreq) {
+            for (unsigned int im=0; im<masks.size(); ++im) {
+                for (int iloc=0; iloc<nloc; ++iloc) {
+                    const int ip = (im+1)*nloc + iloc;
+                    Vector3cr E0 = points->GetEfield(ifreq, iloc);
+                    Vector3cr H0 = points->GetHfield(ifreq, iloc);
+                    Vector3cr E1 = points->GetEfield(ifreq, ip);
+                    Vector3cr H1 = points->GetHfield(ifreq, ip);
+                    for (int ic=0; ic<3; ++ic) {
+                        if (masks[im] & (EXMASK << ic)) {
+                            TS_ASSERT_LESS_THAN_EQUALS( std::abs(E1(ic)-E0(ic)), 1e-12*E0.norm() );
+                        } else {
+                            TS_ASSERT_EQUALS( E1(ic), Complex(0) );
+                        }
+                        if (masks[im] & (HXMASK << ic)) {
+                            TS_ASSERT_LESS_THAN_EQUALS( std::abs(H1(ic)-H0(ic)), 1e-12*H0.norm() );
+                        } else {
+                            TS_ASSERT_EQUALS( H1(ic), Complex(0) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+};
@@ -0,0 +1,291 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+/** Fields of a dipole source, pinned for every source type, polarisation, field set and
+ *  source and receiver on either side of the surface. The values are weighted sums of the
+ *  field components at two receivers. They were computed with the field updates before they
+ *  were templated, except for the configurations marked as corrected, which read kernels
+ *  that were never registered or discarded the ones that were.
+ */
+struct DipoleUpdaterCase {
+    DIPOLESOURCETYPE    Type;
+    int                 Pol;
+    FIELDCALCULATIONS   Fields;
+    int                 SourceInGround;
+    int                 ReceiverInGround;
+    bool                Corrected;
+    Real                E[2];
+    Real                H[2];
+};
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testDipoleUpdaters( void )
+    {
+        static const DipoleUpdaterCase Cases[] = {
+            { GROUNDEDELECTRICDIPOLE,    0, E,    0, 0, false, { 2.07697385981034e-04, -3.21157639016887e+01 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    0, E,    0, 1, false, { 2.42616865533597e-04, -2.51921756938979e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    0, E,    1, 0, false, { 1.82688333855092e-04, -6.27989626552256e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    0, E,    1, 1, false, { 1.25166637349124e-04, -2.07346211593931e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    0, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 6.11440371188645e-06, -3.94982107501618e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.05991457597695e-05, -4.07492511853551e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 2.45895621688769e-05, -4.23136511913998e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -3.60356385277439e-08, -4.36782833326877e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, BOTH, 0, 0, false, { 2.07697385981034e-04, -3.21157639016887e+01 }, { 6.11440371188645e-06, -3.94982107501618e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, BOTH, 0, 1, false, { 2.42616865533597e-04, -2.51921756938979e-05 }, { -2.05991457597695e-05, -4.07492511853551e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, BOTH, 1, 0, false, { 1.82688333855092e-04, -6.27989626552256e-05 }, { 2.45895621688769e-05, -4.23136511913998e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    0, BOTH, 1, 1, false, { 1.25166637349124e-04, -2.07346211593931e-05 }, { -3.60356385277439e-08, -4.36782833326877e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, E,    0, 0, false, { -2.09726966608750e-04, 1.20215669090723e+01 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    1, E,    0, 1, false, { -2.21080862609482e-04, -2.36234992978703e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    1, E,    1, 0, false, { -1.95295980016829e-04, -3.69804163624841e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    1, E,    1, 1, false, { -1.70747117885901e-04, -2.18471233405496e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    1, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.87893040907283e-04, 4.31397646560554e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.71029809393113e-04, 5.26515710976011e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.90000101109657e-04, 5.07279082269644e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.92958310097680e-04, 6.23750102803449e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, BOTH, 0, 0, false, { -2.09726966608750e-04, 1.20215669090723e+01 }, { -2.87893040907283e-04, 4.31397646560554e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, BOTH, 0, 1, false, { -2.21080862609482e-04, -2.36234992978703e-05 }, { -2.71029809393113e-04, 5.26515710976011e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, BOTH, 1, 0, false, { -1.95295980016829e-04, -3.69804163624841e-05 }, { -2.90000101109657e-04, 5.07279082269644e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    1, BOTH, 1, 1, false, { -1.70747117885901e-04, -2.18471233405496e-05 }, { -2.92958310097680e-04, 6.23750102803449e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    2, E,    0, 0, false, { 4.13727384241961e-04, 2.82785565458302e+02 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    2, E,    0, 1, false, { -8.89724120351400e-04, 2.65522918002806e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    2, E,    1, 0, false, { -8.88659256812984e-04, 5.33688516403355e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    2, E,    1, 1, false, { -1.08511715538800e-04, 3.00007879310770e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    2, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.24655074581381e-04, -1.47357533997606e-10 } },
+            { GROUNDEDELECTRICDIPOLE,    2, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.47378364497231e-04, -1.62455998522995e-06 } },
+            { GROUNDEDELECTRICDIPOLE,    2, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 2.73214985331995e-12, 3.96112632888912e-10 } },
+            { GROUNDEDELECTRICDIPOLE,    2, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.15605443705100e-05, -4.36939738306128e-07 } },
+            { GROUNDEDELECTRICDIPOLE,    2, BOTH, 0, 0, false, { 4.13727384241961e-04, 2.82785565458302e+02 }, { 1.24655074581381e-04, -1.47357533997606e-10 } },
+            { GROUNDEDELECTRICDIPOLE,    2, BOTH, 0, 1, false, { -8.89724120351400e-04, 2.65522918002806e-05 }, { 1.47378364497231e-04, -1.62455998522995e-06 } },
+            { GROUNDEDELECTRICDIPOLE,    2, BOTH, 1, 0, false, { -8.88659256812984e-04, 5.33688516403355e-06 }, { 2.73214985331995e-12, 3.96112632888912e-10 } },
+            { GROUNDEDELECTRICDIPOLE,    2, BOTH, 1, 1, false, { -1.08511715538800e-04, 3.00007879310770e-06 }, { 1.15605443705100e-05, -4.36939738306128e-07 } },
+            { GROUNDEDELECTRICDIPOLE,    3, E,    0, 0, false, { 2.38644091220503e-04, 1.72780135365946e+02 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    3, E,    0, 1, false, { -5.85615859134459e-04, -9.27287715961366e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    3, E,    1, 0, false, { -5.98229112119965e-04, -4.89161453870173e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    3, E,    1, 1, false, { -1.11815782748792e-04, -2.11408417332496e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDEDELECTRICDIPOLE,    3, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -9.00216630305813e-05, 6.92462332473382e-06 } },
+            { GROUNDEDELECTRICDIPOLE,    3, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -7.81833223223285e-05, 1.09915836990430e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    3, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.62197069076157e-04, 1.01264458763918e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    3, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.68393534767975e-04, 1.61797887360010e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    3, BOTH, 0, 0, false, { 2.38644091220503e-04, 1.72780135365946e+02 }, { -9.00216630305813e-05, 6.92462332473382e-06 } },
+            { GROUNDEDELECTRICDIPOLE,    3, BOTH, 0, 1, false, { -5.85615859134459e-04, -9.27287715961366e-06 }, { -7.81833223223285e-05, 1.09915836990430e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    3, BOTH, 1, 0, false, { -5.98229112119965e-04, -4.89161453870173e-05 }, { -1.62197069076157e-04, 1.01264458763918e-05 } },
+            { GROUNDEDELECTRICDIPOLE,    3, BOTH, 1, 1, false, { -1.11815782748792e-04, -2.11408417332496e-05 }, { -1.68393534767975e-04, 1.61797887360010e-05 } },
+            { GROUNDINGPOINT,            0, E,    0, 0, false, { 2.12229593544105e-04, -3.21157848946375e+01 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            0, E,    0, 1, false, { 2.47018334639670e-04, -3.88871861119920e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            0, E,    1, 0, false, { 1.87127209568348e-04, -8.05292492834063e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            0, E,    1, 1, false, { 1.29319217349449e-04, -4.03552127616801e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            0, H,    0, 0, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 8.86534455230155e-05, -3.06028019869184e-10 } },
+            { GROUNDINGPOINT,            0, H,    0, 1, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 5.24803499731315e-05, 8.74274991096198e-07 } },
+            { GROUNDINGPOINT,            0, H,    1, 0, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -9.97893592621867e-11, -2.23447501983823e-10 } },
+            { GROUNDINGPOINT,            0, H,    1, 1, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 8.72958617474909e-05, 5.50593906338536e-07 } },
+            { GROUNDINGPOINT,            0, BOTH, 0, 0, true, { 2.12229593544105e-04, -3.21157848946375e+01 }, { 8.86534455230155e-05, -3.06028019869184e-10 } },
+            { GROUNDINGPOINT,            0, BOTH, 0, 1, true, { 2.47018334639670e-04, -3.88871861119920e-05 }, { 5.24803499731315e-05, 8.74274991096198e-07 } },
+            { GROUNDINGPOINT,            0, BOTH, 1, 0, true, { 1.87127209568348e-04, -8.05292492834063e-05 }, { -9.97893592621867e-11, -2.23447501983823e-10 } },
+            { GROUNDINGPOINT,            0, BOTH, 1, 1, true, { 1.29319217349449e-04, -4.03552127616801e-05 }, { 8.72958617474909e-05, 5.50593906338536e-07 } },
+            { GROUNDINGPOINT,            1, E,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            1, E,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            1, E,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            1, E,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            1, H,    0, 0, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -3.24758312617058e-04, 4.62054573365621e-10 } },
+            { GROUNDINGPOINT,            1, H,    0, 1, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.96887686706993e-04, 3.11532142139279e-06 } },
+            { GROUNDINGPOINT,            1, H,    1, 0, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.26193113395700e-11, 3.64025968774105e-10 } },
+            { GROUNDINGPOINT,            1, H,    1, 1, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -3.31068254911030e-04, 3.34509930563626e-06 } },
+            { GROUNDINGPOINT,            1, BOTH, 0, 0, true, { -1.96668048582018e-04, 1.20215853407354e+01 }, { -3.24758312617058e-04, 4.62054573365621e-10 } },
+            { GROUNDINGPOINT,            1, BOTH, 0, 1, true, { -2.06618299138326e-04, -5.37346867154421e-06 }, { -2.96887686706993e-04, 3.11532142139279e-06 } },
+            { GROUNDINGPOINT,            1, BOTH, 1, 0, true, { -1.81222629224454e-04, -1.88093685609120e-05 }, { 1.26193113395700e-11, 3.64025968774105e-10 } },
+            { GROUNDINGPOINT,            1, BOTH, 1, 1, true, { -1.55178267330757e-04, -5.80413024918628e-06 }, { -3.31068254911030e-04, 3.34509930563626e-06 } },
+            { GROUNDINGPOINT,            2, E,    0, 0, false, { 4.13727384241961e-04, 2.82785565458302e+02 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            2, E,    0, 1, false, { -8.89724120351400e-04, 2.65522918002806e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            2, E,    1, 0, false, { -8.88659256812984e-04, 5.33688516403355e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            2, E,    1, 1, false, { -1.08511715538800e-04, 3.00007879310770e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            2, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.24655074581381e-04, -1.47357533997606e-10 } },
+            { GROUNDINGPOINT,            2, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.47378364497231e-04, -1.62455998522995e-06 } },
+            { GROUNDINGPOINT,            2, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 2.73214985331995e-12, 3.96112632888912e-10 } },
+            { GROUNDINGPOINT,            2, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.15605443705100e-05, -4.36939738306128e-07 } },
+            { GROUNDINGPOINT,            2, BOTH, 0, 0, false, { 4.13727384241961e-04, 2.82785565458302e+02 }, { 1.24655074581381e-04, -1.47357533997606e-10 } },
+            { GROUNDINGPOINT,            2, BOTH, 0, 1, false, { -8.89724120351400e-04, 2.65522918002806e-05 }, { 1.47378364497231e-04, -1.62455998522995e-06 } },
+            { GROUNDINGPOINT,            2, BOTH, 1, 0, false, { -8.88659256812984e-04, 5.33688516403355e-06 }, { 2.73214985331995e-12, 3.96112632888912e-10 } },
+            { GROUNDINGPOINT,            2, BOTH, 1, 1, false, { -1.08511715538800e-04, 3.00007879310770e-06 }, { 1.15605443705100e-05, -4.36939738306128e-07 } },
+            { GROUNDINGPOINT,            3, E,    0, 0, false, { 3.66655730816028e-04, 1.65567185143887e+02 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            3, E,    0, 1, false, { -4.50854636397855e-04, -1.67238258157664e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            3, E,    1, 0, false, { -4.78920863767503e-04, -3.52384331510535e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            3, E,    1, 1, false, { -7.37427361709598e-06, -1.74504516980175e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { GROUNDINGPOINT,            3, H,    0, 0, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -7.25220859871047e-05, 3.60304727236958e-11 } },
+            { GROUNDINGPOINT,            3, H,    0, 1, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -5.86198907588648e-05, 1.24912645801467e-06 } },
+            { GROUNDINGPOINT,            3, H,    1, 0, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -3.85787297359830e-11, 3.64672865361132e-10 } },
+            { GROUNDINGPOINT,            3, H,    1, 1, true, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.49340190910695e-04, 1.99170322590833e-06 } },
+            { GROUNDINGPOINT,            3, BOTH, 0, 0, true, { 2.48654901666817e-04, 1.72780136348328e+02 }, { -7.25220859871047e-05, 3.60304727236958e-11 } },
+            { GROUNDINGPOINT,            3, BOTH, 0, 1, true, { -5.74825615880850e-04, -4.89646378450314e-06 }, { -5.86198907588648e-05, 1.24912645801467e-06 } },
+            { GROUNDINGPOINT,            3, BOTH, 1, 0, true, { -5.87654441302177e-04, -4.65240542876007e-05 }, { -3.85787297359830e-11, 3.64672865361132e-10 } },
+            { GROUNDINGPOINT,            3, BOTH, 1, 1, true, { -1.00481234015551e-04, -2.09329298475293e-05 }, { -1.49340190910695e-04, 1.99170322590833e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, E,    0, 0, true, { -4.53220756307176e-06, 2.09929487356048e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, E,    0, 1, true, { -4.40146910607272e-06, 1.36950104180942e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, E,    1, 0, true, { -4.43887571325612e-06, 1.77302866281807e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, E,    1, 1, true, { -4.15258000032472e-06, 1.96205916022870e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.25390418111291e-05, -3.94979047221419e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -7.30794957329009e-05, -4.16235261764513e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 2.45896619582362e-05, -4.23134277438978e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.73318973860183e-05, -4.42288772390263e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, BOTH, 0, 0, false, { -4.53220756307176e-06, 2.09929487356048e-05 }, { -8.25390418111291e-05, -3.94979047221419e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, BOTH, 0, 1, false, { -4.40146910607272e-06, 1.36950104180942e-05 }, { -7.30794957329009e-05, -4.16235261764513e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, BOTH, 1, 0, false, { -4.43887571325612e-06, 1.77302866281807e-05 }, { 2.45896619582362e-05, -4.23134277438978e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  0, BOTH, 1, 1, false, { -4.15258000032472e-06, 1.96205916022870e-05 }, { -8.73318973860183e-05, -4.42288772390263e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, E,    0, 0, true, { -1.30589180267332e-05, -1.84316631044135e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, E,    0, 1, true, { -1.44625634711557e-05, -1.82500306263261e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, E,    1, 0, true, { -1.40733507923759e-05, -1.81710478015721e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, E,    1, 1, true, { -1.55688505551438e-05, -1.60429930913633e-05 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 3.68652717097758e-05, 4.31393026014820e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 2.58578773138803e-05, 4.95362496762083e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.90000113728968e-04, 5.07275442009957e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 3.81099448133486e-05, 5.90299109747087e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, BOTH, 0, 0, false, { -1.30589180267332e-05, -1.84316631044135e-05 }, { 3.68652717097758e-05, 4.31393026014820e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, BOTH, 0, 1, false, { -1.44625634711557e-05, -1.82500306263261e-05 }, { 2.58578773138803e-05, 4.95362496762083e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, BOTH, 1, 0, false, { -1.40733507923759e-05, -1.81710478015721e-05 }, { -2.90000113728968e-04, 5.07275442009957e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  1, BOTH, 1, 1, false, { -1.55688505551438e-05, -1.60429930913633e-05 }, { 3.81099448133486e-05, 5.90299109747087e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, E,    0, 0, false, { 4.52235657868796e-04, 2.80820313587726e+02 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, E,    0, 1, false, { -8.87418440577919e-04, 7.82191362604542e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, E,    1, 0, false, { -8.82618250359692e-04, 4.88872602529774e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, E,    1, 1, false, { -1.08340285602604e-04, 2.66622814847159e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.24655074581381e-04, -1.47357533997606e-10 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.47378364497231e-04, -1.62455998522995e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 2.73214985331995e-12, 3.96112632888912e-10 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 1.15605443705100e-05, -4.36939738306128e-07 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, BOTH, 0, 0, false, { 4.52235657868796e-04, 2.80820313587726e+02 }, { 1.24655074581381e-04, -1.47357533997606e-10 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, BOTH, 0, 1, false, { -8.87418440577919e-04, 7.82191362604542e-06 }, { 1.47378364497231e-04, -1.62455998522995e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, BOTH, 1, 0, false, { -8.82618250359692e-04, 4.88872602529774e-06 }, { 2.73214985331995e-12, 3.96112632888912e-10 } },
+            { UNGROUNDEDELECTRICDIPOLE,  2, BOTH, 1, 1, false, { -1.08340285602604e-04, 2.66622814847159e-06 }, { 1.15605443705100e-05, -4.36939738306128e-07 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, E,    0, 0, true, { 2.79420010589716e-04, 1.79724999713762e+02 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, E,    0, 1, true, { -5.78738045223476e-04, 6.29611345558577e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, E,    1, 0, true, { -5.75450351047991e-04, 7.36693556774018e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, E,    1, 1, true, { -8.06723315189088e-05, 1.49847412930157e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 6.22796706886068e-05, 6.92449298543933e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { 7.47587217147640e-05, 8.70273885048118e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.62197028748851e-04, 1.01263347156115e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.16545954601532e-05, 1.39084440775767e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, BOTH, 0, 0, false, { 2.79420010589716e-04, 1.79724999713762e+02 }, { 6.22796706886068e-05, 6.92449298543933e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, BOTH, 0, 1, false, { -5.78738045223476e-04, 6.29611345558577e-07 }, { 7.47587217147640e-05, 8.70273885048118e-06 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, BOTH, 1, 0, false, { -5.75450351047991e-04, 7.36693556774018e-07 }, { -1.62197028748851e-04, 1.01263347156115e-05 } },
+            { UNGROUNDEDELECTRICDIPOLE,  3, BOTH, 1, 1, false, { -8.06723315189088e-05, 1.49847412930157e-06 }, { -1.16545954601532e-05, 1.39084440775767e-05 } },
+            { MAGNETICDIPOLE,            0, E,    0, 0, false, { 1.98611386206638e-07, -9.48436901083079e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            0, E,    0, 1, false, { 2.18188488784819e-07, -3.12197984410009e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            0, E,    1, 0, false, { 1.93740474948112e-07, -1.12522539898907e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            0, E,    1, 1, false, { 2.17915439224497e-07, -4.96597158484332e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            0, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -4.28091680854640e-06, -1.41570026578996e-06 } },
+            { MAGNETICDIPOLE,            0, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.40195979410139e-06, -1.71952796631910e-06 } },
+            { MAGNETICDIPOLE,            0, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -6.54794064965603e-06, -1.57235193914550e-06 } },
+            { MAGNETICDIPOLE,            0, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -3.58049294650136e-06, -1.93644108080893e-06 } },
+            { MAGNETICDIPOLE,            0, BOTH, 0, 0, false, { 1.98611386206638e-07, -9.48436901083079e-07 }, { -4.28091680854640e-06, -1.41570026578996e-06 } },
+            { MAGNETICDIPOLE,            0, BOTH, 0, 1, false, { 2.18188488784819e-07, -3.12197984410009e-07 }, { -1.40195979410139e-06, -1.71952796631910e-06 } },
+            { MAGNETICDIPOLE,            0, BOTH, 1, 0, false, { 1.93740474948112e-07, -1.12522539898907e-06 }, { -6.54794064965603e-06, -1.57235193914550e-06 } },
+            { MAGNETICDIPOLE,            0, BOTH, 1, 1, false, { 2.17915439224497e-07, -4.96597158484332e-07 }, { -3.58049294650136e-06, -1.93644108080893e-06 } },
+            { MAGNETICDIPOLE,            1, E,    0, 0, false, { 1.20549915883948e-08, 3.99846581674397e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            1, E,    0, 1, false, { 3.82204099674852e-08, 1.05041449783963e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            1, E,    1, 0, false, { 6.47641189166676e-08, 4.42263121359927e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            1, E,    1, 1, false, { 7.84040859686999e-08, 1.39116715075135e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            1, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.19126439471213e-06, -5.71595994764963e-07 } },
+            { MAGNETICDIPOLE,            1, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -3.02103522345488e-06, -5.28442333176881e-07 } },
+            { MAGNETICDIPOLE,            1, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -1.39685218173736e-06, -5.47045679170157e-07 } },
+            { MAGNETICDIPOLE,            1, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -2.59735564195179e-06, -4.86557122172847e-07 } },
+            { MAGNETICDIPOLE,            1, BOTH, 0, 0, false, { 1.20549915883948e-08, 3.99846581674397e-06 }, { -2.19126439471213e-06, -5.71595994764963e-07 } },
+            { MAGNETICDIPOLE,            1, BOTH, 0, 1, false, { 3.82204099674852e-08, 1.05041449783963e-06 }, { -3.02103522345488e-06, -5.28442333176881e-07 } },
+            { MAGNETICDIPOLE,            1, BOTH, 1, 0, false, { 6.47641189166676e-08, 4.42263121359927e-06 }, { -1.39685218173736e-06, -5.47045679170157e-07 } },
+            { MAGNETICDIPOLE,            1, BOTH, 1, 1, false, { 7.84040859686999e-08, 1.39116715075135e-06 }, { -2.59735564195179e-06, -4.86557122172847e-07 } },
+            { MAGNETICDIPOLE,            2, E,    0, 0, false, { 8.15268274262728e-08, -5.99734627097740e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            2, E,    0, 1, false, { 7.78648988817338e-08, -5.35496806181567e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            2, E,    1, 0, false, { 7.89757919671186e-08, -5.89154790837948e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            2, E,    1, 1, false, { 6.91007655029284e-08, -6.10459015473160e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            2, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.41413169747077e-06, -1.33783581372151e-07 } },
+            { MAGNETICDIPOLE,            2, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -6.64363240184195e-06, -6.57053744859682e-08 } },
+            { MAGNETICDIPOLE,            2, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.33841215738084e-06, -4.20153103479228e-08 } },
+            { MAGNETICDIPOLE,            2, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.18631360262476e-06, 9.69520812471061e-08 } },
+            { MAGNETICDIPOLE,            2, BOTH, 0, 0, false, { 8.15268274262728e-08, -5.99734627097740e-07 }, { -8.41413169747077e-06, -1.33783581372151e-07 } },
+            { MAGNETICDIPOLE,            2, BOTH, 0, 1, false, { 7.78648988817338e-08, -5.35496806181567e-07 }, { -6.64363240184195e-06, -6.57053744859682e-08 } },
+            { MAGNETICDIPOLE,            2, BOTH, 1, 0, false, { 7.89757919671186e-08, -5.89154790837948e-07 }, { -8.33841215738084e-06, -4.20153103479228e-08 } },
+            { MAGNETICDIPOLE,            2, BOTH, 1, 1, false, { 6.91007655029284e-08, -6.10459015473160e-07 }, { -8.18631360262476e-06, 9.69520812471061e-08 } },
+            { MAGNETICDIPOLE,            3, E,    0, 0, false, { 1.54743629885038e-07, 1.55999961618395e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            3, E,    0, 1, false, { 1.77496255881514e-07, 1.37675710230765e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            3, E,    1, 0, false, { 1.82398406184051e-07, 1.73641147050853e-06 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            3, E,    1, 1, false, { 1.95866352330852e-07, 2.05639884475501e-07 }, { 0.00000000000000e+00, 0.00000000000000e+00 } },
+            { MAGNETICDIPOLE,            3, H,    0, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.75464299131083e-06, -1.10811521651633e-06 } },
+            { MAGNETICDIPOLE,            3, H,    0, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -6.73748657242044e-06, -1.18449026341032e-06 } },
+            { MAGNETICDIPOLE,            3, H,    1, 0, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -9.31770660160104e-06, -1.10984613691461e-06 } },
+            { MAGNETICDIPOLE,            3, H,    1, 1, false, { 0.00000000000000e+00, 0.00000000000000e+00 }, { -8.51629070517159e-06, -1.15937666009385e-06 } },
+            { MAGNETICDIPOLE,            3, BOTH, 0, 0, false, { 1.54743629885038e-07, 1.55999961618395e-06 }, { -8.75464299131083e-06, -1.10811521651633e-06 } },
+            { MAGNETICDIPOLE,            3, BOTH, 0, 1, false, { 1.77496255881514e-07, 1.37675710230765e-07 }, { -6.73748657242044e-06, -1.18449026341032e-06 } },
+            { MAGNETICDIPOLE,            3, BOTH, 1, 0, false, { 1.82398406184051e-07, 1.73641147050853e-06 }, { -9.31770660160104e-06, -1.10984613691461e-06 } },
+            { MAGNETICDIPOLE,            3, BOTH, 1, 1, false, { 1.95866352330852e-07, 2.05639884475501e-07 }, { -8.51629070517159e-06, -1.15937666009385e-06 } },
+        };
+
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( (VectorXcr(4) << 0., 1./50., 1./5., 1./100.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 25).finished() );
+
+        const Vector3r Pols[] = { Vector3r(1,0,0), Vector3r(0,1,0), Vector3r(0,0,1), Vector3r(.48,.6,.64) };
+        const Real zs[] = { -2, 3 };
+        const Real zr[] = { -1, 6 };
+
+        for (const auto& Case : Cases) {
+            auto dipole = DipoleSource::NewSP();
+                dipole->SetType( Case.Type );
+                dipole->SetPolarisation( Pols[Case.Pol] );
+                dipole->SetLocation( 1, 2, zs[Case.SourceInGround] );
+                dipole->SetMoment( 1 );
+                dipole->SetNumberOfFrequencies( 1 );
+                dipole->SetFrequency( 0, 1000 );
+
+            auto receivers = FieldPoints::NewSP();
+                receivers->SetNumberOfPoints(2);
+                receivers->SetLocation( 0, Vector3r(31, -14, zr[Case.ReceiverInGround]) );
+                receivers->SetLocation( 1, Vector3r(-7,  65, zr[Case.ReceiverInGround]) );
+
+            auto EmEarth = EMEarth1D::NewSP();
+                EmEarth->AttachDipoleSource(dipole);
+                EmEarth->AttachFieldPoints(receivers);
+                EmEarth->AttachLayeredEarthEM(earth);
+                EmEarth->SetFieldsToCalculate( Case.Fields );
+                EmEarth->SetHankelTransformMethod( FHTKEY201 );
+                EmEarth->MakeCalc3();
+
+            Complex SE(0), SH(0);
+            Real scaleE(0), scaleH(0);
+            for (int irec=0; irec<2; ++irec) {
+                for (int ic=0; ic<3; ++ic) {
+                    const Real w = 1 + ic + 3*irec;
+                    if (Case.Fields != H) {
+                        SE += w*receivers->GetEfield(0, irec)(ic);
+                        scaleE += w*std::abs(receivers->GetEfield(0, irec)(ic));
+                    }
+                    if (Case.Fields != E) {
+                        SH += w*receivers->GetHfield(0, irec)(ic);
+                        scaleH += w*std::abs(receivers->GetHfield(0, irec)(ic));
+                    }
+                }
+            }
+            TS_ASSERT_LESS_THAN_EQUALS( std::abs(SE - Complex(Case.E[0], Case.E[1])), 1e-8*scaleE );
+            TS_ASSERT_LESS_THAN_EQUALS( std::abs(SH - Complex(Case.H[0], Case.H[1])), 1e-8*scaleH );
+        }
+    }
+
+};
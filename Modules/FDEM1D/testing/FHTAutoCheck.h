@@ -0,0 +1,121 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testMatchesAnderson801( void )
+    {
+        auto earth = Earth( 1 );
+        auto reference = Receivers();
+        Calculate( ANDERSON801, earth, reference );
+
+        auto points = Receivers();
+        auto EmEarth = Calculate( FHTAUTO, earth, points );
+        TS_ASSERT_LESS_THAN( 0, EmEarth->GetAutoHankelTransform()->GetNumberOfSamples() );
+
+        for (int ifreq=0; ifreq<3; ++ifreq) {
+            for (int irec=0; irec<points->GetNumberOfPoints(); ++irec) {
+                Vector3cr H0 = reference->GetHfield(ifreq, irec);
+                Vector3cr H1 = points->GetHfield(ifreq, irec);
+                Vector3cr E0 = reference->GetEfield(ifreq, irec);
+                Vector3cr E1 = points->GetEfield(ifreq, irec);
+                TS_ASSERT_LESS_THAN( (H1-H0).norm(), 1e-4*H0.norm() );
+                TS_ASSERT_LESS_THAN( (E1-E0).norm(), 1e-4*E0.norm() );
+            }
+        }
+    }
+
+    void testPerturbedModelReusesChoices( void )
+    {
+        auto points = Receivers();
+        auto EmEarth = Calculate( FHTAUTO, Earth( 1 ), points );
+        auto Auto = EmEarth->GetAutoHankelTransform();
+        const int nsamples = Auto->GetNumberOfSamples();
+        TS_ASSERT_LESS_THAN( 0, nsamples );
+
+        // A few percent change of the model stays in the same regimes
+        EmEarth->AttachLayeredEarthEM( Earth( .97 ) );
+        points->ClearFields();
+        EmEarth->MakeCalc3();
+        TS_ASSERT_EQUALS( Auto->GetNumberOfSamples(), nsamples );
+
+        auto reference = Receivers();
+        Calculate( ANDERSON801, Earth( .97 ), reference );
+        for (int ifreq=0; ifreq<3; ++ifreq) {
+            for (int irec=0; irec<points->GetNumberOfPoints(); ++irec) {
+                Vector3cr H0 = reference->GetHfield(ifreq, irec);
+                Vector3cr H1 = points->GetHfield(ifreq, irec);
+                TS_ASSERT_LESS_THAN( (H1-H0).norm(), 1e-4*H0.norm() );
+            }
+        }
+
+        // A model a decade more conductive is a new regime
+        EmEarth->AttachLayeredEarthEM( Earth( 10 ) );
+        points->ClearFields();
+        EmEarth->MakeCalc3();
+        TS_ASSERT_LESS_THAN( nsamples, Auto->GetNumberOfSamples() );
+    }
+
+    private:
+
+    /** A layered earth, with the conductivities scaled */
+    std::shared_ptr<LayeredEarthEM> Earth( const Real& scale ) {
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( scale*(VectorXcr(4) << 0., 1./50., 1./5., 1./100.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 25).finished() );
+        return earth;
+    }
+
+    std::shared_ptr<FieldPoints> Receivers() {
+        auto points = FieldPoints::NewSP();
+            points->SetNumberOfPoints(6);
+            for (int irec=0; irec<6; ++irec) {
+                Real r = 5*std::pow(2.5, irec);
+                points->SetLocation(irec, r*std::cos(.4*irec), r*std::sin(.4*irec), -1);
+            }
+        return points;
+    }
+
+    std::shared_ptr<EMEarth1D> Calculate( const HANKELTRANSFORMTYPE& type,
+            std::shared_ptr<LayeredEarthEM> earth, std::shared_ptr<FieldPoints> points ) {
+        auto dipole = DipoleSource::NewSP();
+            dipole->SetType( MAGNETICDIPOLE );
+            dipole->SetPolarisation( .6, 0, .8 );
+            dipole->SetLocation( 0, 0, -2 );
+            dipole->SetMoment( 1 );
+            dipole->SetNumberOfFrequencies( 3 );
+            dipole->SetFrequency( 0, 100 );
+            dipole->SetFrequency( 1, 3000 );
+            dipole->SetFrequency( 2, 90000 );
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachDipoleSource(dipole);
+            EmEarth->AttachLayeredEarthEM(earth);
+            EmEarth->AttachFieldPoints(points);
+            EmEarth->SetFieldsToCalculate(BOTH);
+            EmEarth->SetHankelTransformMethod(type);
+            EmEarth->MakeCalc3();
+        return EmEarth;
+    }
+
+};
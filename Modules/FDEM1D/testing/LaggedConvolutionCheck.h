@@ -0,0 +1,104 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testFHTKey201( void )
+    {
+        CheckLagged( FHTKEY201, 3e-3 );
+    }
+
+    void testAnderson801( void )
+    {
+        CheckLagged( ANDERSON801, 3e-3 );
+    }
+
+    private:
+
+    /** Interpolated lagged convolutions agree with direct transforms between the lagged
+     *  arguments, for every related kernel
+     */
+    void CheckLagged( const HANKELTRANSFORMTYPE& type, const Real& tol ) {
+
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( (VectorXcr(4) << 0., 1./50., 1./5., 1./100.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 25).finished() );
+
+        auto dipole = DipoleSource::NewSP();
+            dipole->SetType( MAGNETICDIPOLE );
+            dipole->SetPolarisation( .6, 0, .8 );
+            dipole->SetLocation( 0, 0, -2 );
+            dipole->SetMoment( 1 );
+            dipole->SetNumberOfFrequencies( 1 );
+            dipole->SetFrequency( 0, 3000 );
+
+        earth->EvaluateFrequencies( (VectorXr(1) << dipole->GetAngularFrequency(0)).finished() );
+
+        // TE kernels of either Bessel order. The in-air TM kernels do not decay with lambda,
+        // and their filtered transforms are not smooth enough in rho to be compared alone.
+        auto Manager = KernelEM1DManager::NewSP();
+            Manager->SetEarth( earth );
+            Manager->SetDipoleSource( dipole.get(), 0, -1 );
+            Manager->AddKernel<TE, 0, INAIR, INAIR>( );
+            Manager->AddKernel<TE, 1, INAIR, INAIR>( );
+            Manager->AddKernel<TE, 4, INAIR, INAIR>( );
+            Manager->AddKernel<TE, 10, INAIR, INAIR>( );
+            Manager->AddKernel<TE, 11, INAIR, INAIR>( );
+            Manager->AddKernel<TE, 12, INAIR, INAIR>( );
+        const auto& Kernels = Manager->GetSTLVector();
+
+        auto Lagged = HankelTransformFactory::NewSP( type );
+        auto Direct = HankelTransformFactory::NewSP( type );
+
+        // lagged arguments from rhomax down past rhomin, padded as the callers do
+        const Real rhomin(5), rhomax(800);
+        const Real step = Lagged->GetABSER();
+        int nlag = 4;
+        for (Real lrho = rhomax/std::pow(step, 3); lrho > rhomin; lrho *= step) {
+            nlag += 1;
+        }
+        Lagged->ComputeLaggedRelated( rhomax/std::pow(step, 3), nlag, Manager );
+
+        // offsets between the lagged arguments, at a third and a half of the step
+        std::vector<Real> offsets;
+        for (Real rho = rhomax; rho > rhomin; rho *= std::pow(step, 7)) {
+            offsets.push_back( rho*std::pow(step, 1./3.) );
+            offsets.push_back( rho*std::pow(step, .5) );
+        }
+        offsets.push_back( 37.3 );
+        offsets.push_back( 123.4 );
+
+        for (Real rho : offsets) {
+            Lagged->SetLaggedArg( rho );
+            Direct->ComputeRelated( rho, Manager );
+            for (const auto& Kernel : Kernels) {
+                const int order = Kernel->GetBesselOrder();
+                Complex zl = Lagged->Zgauss( 0, TE, order, rho, 0, Kernel.get() );
+                Complex zd = Direct->Zgauss( 0, TE, order, rho, 0, Kernel.get() );
+                TS_ASSERT_LESS_THAN_EQUALS( std::abs(zl-zd), tol*std::abs(zd) );
+            }
+        }
+    }
+
+};
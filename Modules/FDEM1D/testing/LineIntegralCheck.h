@@ -0,0 +1,85 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    void testLineIntegralMatchesDipoles( void )
+    {
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers(4);
+            earth->SetLayerConductivity( (VectorXcr(4) << 0., 1./20., 1./2., 1./30.).finished() );
+            earth->SetLayerThickness( (VectorXr(2) << 10, 20).finished() );
+
+        // receivers inside of, near to, and outside of the loop, and in the ground
+        std::vector<Vector3r> locations = { Vector3r(30, 10, -5), Vector3r(49, 0, -.5),
+            Vector3r(51, 20, -.5), Vector3r(75, 0, -5), Vector3r(150, 30, -5),
+            Vector3r(300, 0, -30), Vector3r(20, 0, 5), Vector3r(150, 0, 5) };
+
+        std::vector< std::shared_ptr<FieldPoints> > receivers;
+        for (bool line : {false, true}) {
+            auto loop = PolygonalWireAntenna::NewSP();
+                loop->SetNumberOfPoints(5);
+                loop->SetPoint(0, Vector3r(-50, -50, -1e-3));
+                loop->SetPoint(1, Vector3r( 50, -50, -1e-3));
+                loop->SetPoint(2, Vector3r( 50,  50, -1e-3));
+                loop->SetPoint(3, Vector3r(-50,  50, -1e-3));
+                loop->SetPoint(4, Vector3r(-50, -50, -1e-3));
+                loop->SetNumberOfFrequencies(2);
+                loop->SetFrequency(0, 100);
+                loop->SetFrequency(1, 10000);
+                loop->SetCurrent(1);
+                loop->SetNumberOfTurns(1);
+                // a fine dipole approximation as reference
+                loop->SetMinDipoleRatio(.02);
+                loop->SetMaxDipoleMoment(1);
+
+            auto points = FieldPoints::NewSP();
+                points->SetNumberOfPoints(locations.size());
+                for (unsigned int irec=0; irec<locations.size(); ++irec) {
+                    points->SetLocation(irec, locations[irec]);
+                }
+
+            auto EmEarth = EMEarth1D::NewSP();
+                EmEarth->AttachWireAntenna(loop);
+                EmEarth->AttachLayeredEarthEM(earth);
+                EmEarth->AttachFieldPoints(points);
+                EmEarth->SetFieldsToCalculate(BOTH);
+                EmEarth->SetHankelTransformMethod(ANDERSON801);
+                EmEarth->SetLineIntegralEvaluation(line);
+                EmEarth->CalculateWireAntennaFields();
+            receivers.push_back(points);
+        }
+
+        for (int ifreq=0; ifreq<2; ++ifreq) {
+            for (unsigned int irec=0; irec<locations.size(); ++irec) {
+                Vector3cr H0 = receivers[0]->GetHfield(ifreq, irec);
+                Vector3cr H1 = receivers[1]->GetHfield(ifreq, irec);
+                Vector3cr E0 = receivers[0]->GetEfield(ifreq, irec);
+                Vector3cr E1 = receivers[1]->GetEfield(ifreq, irec);
+                TS_ASSERT_LESS_THAN( (H1-H0).norm(), 2e-2*H0.norm() );
+                TS_ASSERT_LESS_THAN( (E1-E0).norm(), 2e-2*E0.norm() );
+            }
+        }
+    }
+
+};
@@ -0,0 +1,149 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    /** Every model of the batch agrees with MakeCalc3 of that model, for magnetic and
+     *  electric sources and both fields. More models than EMEarth1D::ModelBlock are used,
+     *  so that the last block is partial.
+     */
+    void testModelsMatchMakeCalc3( void )
+    {
+        const int nmod = 300;
+        MatrixXcr sigma(nmod, 4);
+        MatrixXr thick(nmod, 2);
+        for (int imod=0; imod<nmod; ++imod) {
+            sigma.row(imod) << 0., 1./(5.+(37*imod)%200), 1./(1.+(11*imod)%50), 1./(20.+(7*imod)%300);
+            thick.row(imod) << 2.+(13*imod)%40, 5.+(17*imod)%60;
+        }
+        std::vector< std::shared_ptr<LayeredEarthEM> > models;
+        for (int imod=0; imod<nmod; ++imod) {
+            models.push_back( Earth(sigma.row(imod).transpose(), thick.row(imod).transpose()) );
+        }
+
+        for (auto Type : {MAGNETICDIPOLE, UNGROUNDEDELECTRICDIPOLE, GROUNDEDELECTRICDIPOLE}) {
+            for (auto Fields : {H, BOTH}) {
+                auto EmEarth = EMEarth1D::NewSP();
+                    EmEarth->AttachDipoleSource( Dipole(Type) );
+                    EmEarth->AttachFieldPoints( Receivers() );
+                    EmEarth->SetFieldsToCalculate( Fields );
+                    EmEarth->SetHankelTransformMethod( FHTKEY201 );
+                MatrixXcr F0 = EmEarth->CalculateModels( models );
+                MatrixXcr F1 = EmEarth->CalculateModels( Earth(sigma.row(0).transpose(),
+                        thick.row(0).transpose()), sigma, thick );
+                TS_ASSERT_EQUALS( F0.rows(), nmod );
+                TS_ASSERT_EQUALS( F0.cols(), (Fields == BOTH ? 2 : 1)*3*2*3 );
+                TS_ASSERT_LESS_THAN_EQUALS( (F1-F0).norm(), 1e-12*F0.norm() );
+
+                for (int imod=0; imod<nmod; imod+=7) {
+                    VectorXcr F = Reference( Type, Fields, models[imod] );
+                    TS_ASSERT_LESS_THAN( 0, F.norm() );
+                    TS_ASSERT_LESS_THAN_EQUALS( (F0.row(imod).transpose() - F).norm(), 1e-10*F.norm() );
+                }
+            }
+        }
+    }
+
+    void testUnsupported( void )
+    {
+        std::vector< std::shared_ptr<LayeredEarthEM> > models = {
+            Earth( (VectorXcr(2) << 0., .1).finished(), VectorXr() ) };
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachDipoleSource( Dipole(MAGNETICDIPOLE) );
+            EmEarth->AttachFieldPoints( Receivers() );
+            EmEarth->SetFieldsToCalculate( H );
+            EmEarth->SetHankelTransformMethod( ANDERSON801 );
+        TS_ASSERT_THROWS( EmEarth->CalculateModels( models ), UnsupportedModelBatch );
+
+        auto buried = Receivers();
+            buried->SetLocation( 0, 5, 5, 3 );
+            EmEarth->AttachFieldPoints( buried );
+            EmEarth->SetHankelTransformMethod( FHTKEY201 );
+        TS_ASSERT_THROWS( EmEarth->CalculateModels( models ), UnsupportedModelBatch );
+
+        // models differing in their number of layers
+            EmEarth->AttachFieldPoints( Receivers() );
+            models.push_back( Earth( (VectorXcr(3) << 0., .1, .2).finished(), VectorXr::Constant(1, 10) ) );
+        TS_ASSERT_THROWS( EmEarth->CalculateModels( models ), EarthModelParametersDoNotMatchNumberOfLayers );
+    }
+
+    private:
+
+    std::shared_ptr<LayeredEarthEM> Earth( const VectorXcr& sigma, const VectorXr& thick ) {
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers( sigma.size() );
+            earth->SetLayerConductivity( sigma );
+            earth->SetLayerThickness( thick );
+        return earth;
+    }
+
+    std::shared_ptr<DipoleSource> Dipole( const DIPOLESOURCETYPE& Type ) {
+        auto dipole = DipoleSource::NewSP();
+            dipole->SetType( Type );
+            dipole->SetPolarisation( .6, 0, .8 );
+            dipole->SetLocation( 0, 0, -30 );
+            dipole->SetMoment( 1 );
+            dipole->SetNumberOfFrequencies( 2 );
+            dipole->SetFrequency( 0, 900 );
+            dipole->SetFrequency( 1, 7200 );
+        return dipole;
+    }
+
+    /** Receivers off the height of the source, where the direct field does not swamp
+     *  the response of the earth
+     */
+    std::shared_ptr<FieldPoints> Receivers() {
+        auto points = FieldPoints::NewSP();
+            points->SetNumberOfPoints(3);
+            points->SetLocation( 0, 7.9, 0, -31 );
+            points->SetLocation( 1, 20, 15, -25 );
+            points->SetLocation( 2, -60, 30, -35 );
+        return points;
+    }
+
+    /** @return the fields of MakeCalc3, in the order of a row of CalculateModels */
+    VectorXcr Reference( const DIPOLESOURCETYPE& Type, const FIELDCALCULATIONS& Fields,
+            std::shared_ptr<LayeredEarthEM> earth ) {
+        auto points = Receivers();
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachDipoleSource( Dipole(Type) );
+            EmEarth->AttachLayeredEarthEM( earth );
+            EmEarth->AttachFieldPoints( points );
+            EmEarth->SetFieldsToCalculate( Fields );
+            EmEarth->SetHankelTransformMethod( FHTKEY201 );
+            EmEarth->MakeCalc3();
+        const int nrec = points->GetNumberOfPoints();
+        const int nH = 3*2*nrec;
+        VectorXcr F( (Fields == BOTH) ? 2*nH : nH );
+        for (int ifreq=0; ifreq<2; ++ifreq) {
+            for (int irec=0; irec<nrec; ++irec) {
+                F.segment<3>(3*(ifreq*nrec+irec)) = points->GetHfield(ifreq, irec);
+                if (Fields == BOTH) {
+                    F.segment<3>(nH+3*(ifreq*nrec+irec)) = points->GetEfield(ifreq, irec);
+                }
+            }
+        }
+        return F;
+    }
+
+};
@@ -0,0 +1,147 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <FDEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    /** The analytic sensitivities agree with central differences of MakeCalc3, for the
+     *  conductivity and thickness of every layer
+     */
+    void testCentralDifferences( void )
+    {
+        const VectorXcr sigma = (VectorXcr(4) << 0., 1./50., 1./5., 1./100.).finished();
+        const VectorXr thick = (VectorXr(2) << 10, 25).finished();
+        const int nlay = sigma.size();
+        const int npar = 2*nlay-3;
+
+        auto points = Receivers();
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachDipoleSource( Dipole() );
+            EmEarth->AttachLayeredEarthEM( Earth(sigma, thick) );
+            EmEarth->AttachFieldPoints( points );
+            EmEarth->SetFieldsToCalculate( H );
+            EmEarth->SetHankelTransformMethod( FHTKEY201 );
+        MatrixXcr J = EmEarth->CalculateSensitivities();
+        TS_ASSERT_EQUALS( J.cols(), npar );
+
+        // the fields are returned as well
+        MatrixXcr H0 = Fields( sigma, thick );
+        TS_ASSERT_LESS_THAN_EQUALS( (Fields(points)-H0).norm(), 1e-10*H0.norm() );
+
+        for (int ipar=0; ipar<npar; ++ipar) {
+            VectorXcr sp(sigma), sm(sigma);
+            VectorXr tp(thick), tm(thick);
+            Real h;
+            if (ipar < nlay-1) {
+                h = 1e-4*std::abs( sigma(ipar+1) );
+                sp(ipar+1) += h;
+                sm(ipar+1) -= h;
+            } else {
+                h = 1e-4*thick(ipar-nlay+1);
+                tp(ipar-nlay+1) += h;
+                tm(ipar-nlay+1) -= h;
+            }
+            VectorXcr Jfd = Vectorise( (Fields(sp, tp) - Fields(sm, tm)) / (2.*h) );
+            TS_ASSERT_LESS_THAN( 0, Jfd.norm() );
+            TS_ASSERT_LESS_THAN_EQUALS( (J.col(ipar) - Jfd).norm(), 1e-5*Jfd.norm() );
+        }
+    }
+
+    void testUnsupported( void )
+    {
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachDipoleSource( Dipole() );
+            EmEarth->AttachLayeredEarthEM( Earth( (VectorXcr(2) << 0., .1).finished(), VectorXr() ) );
+            EmEarth->AttachFieldPoints( Receivers() );
+            EmEarth->SetFieldsToCalculate( E );
+            EmEarth->SetHankelTransformMethod( FHTKEY201 );
+        TS_ASSERT_THROWS( EmEarth->CalculateSensitivities(), UnsupportedSensitivities );
+            EmEarth->SetFieldsToCalculate( H );
+            EmEarth->SetHankelTransformMethod( ANDERSON801 );
+        TS_ASSERT_THROWS( EmEarth->CalculateSensitivities(), UnsupportedSensitivities );
+    }
+
+    private:
+
+    std::shared_ptr<LayeredEarthEM> Earth( const VectorXcr& sigma, const VectorXr& thick ) {
+        auto earth = LayeredEarthEM::NewSP();
+            earth->SetNumberOfLayers( sigma.size() );
+            earth->SetLayerConductivity( sigma );
+            earth->SetLayerThickness( thick );
+        return earth;
+    }
+
+    std::shared_ptr<DipoleSource> Dipole() {
+        auto dipole = DipoleSource::NewSP();
+            dipole->SetType( MAGNETICDIPOLE );
+            dipole->SetPolarisation( .6, 0, .8 );
+            dipole->SetLocation( 0, 0, -30 );
+            dipole->SetMoment( 1 );
+            dipole->SetNumberOfFrequencies( 2 );
+            dipole->SetFrequency( 0, 900 );
+            dipole->SetFrequency( 1, 7200 );
+        return dipole;
+    }
+
+    /** Receivers off the height of the source, where the large direct field adds round
+     *  off to the differences
+     */
+    std::shared_ptr<FieldPoints> Receivers() {
+        auto points = FieldPoints::NewSP();
+            points->SetNumberOfPoints(3);
+            points->SetLocation(0, 7.9, 0, -31);
+            points->SetLocation(1, 20, 15, -25);
+            points->SetLocation(2, -60, 30, -35);
+        return points;
+    }
+
+    /** @return H of MakeCalc3 with the layer parameters, a column per frequency */
+    MatrixXcr Fields( const VectorXcr& sigma, const VectorXr& thick ) {
+        auto points = Receivers();
+        auto EmEarth = EMEarth1D::NewSP();
+            EmEarth->AttachDipoleSource( Dipole() );
+            EmEarth->AttachLayeredEarthEM( Earth(sigma, thick) );
+            EmEarth->AttachFieldPoints( points );
+            EmEarth->SetFieldsToCalculate( H );
+            EmEarth->SetHankelTransformMethod( FHTKEY201 );
+            EmEarth->MakeCalc3();
+        return Fields( points );
+    }
+
+    /** @return H of points, rows 3*irec to 3*irec+2 and a column per frequency */
+    MatrixXcr Fields( std::shared_ptr<FieldPoints> points ) {
+        const int nrec = points->GetNumberOfPoints();
+        MatrixXcr F(3*nrec, 2);
+        for (int ifreq=0; ifreq<2; ++ifreq) {
+            for (int irec=0; irec<nrec; ++irec) {
+                F.block<3,1>(3*irec, ifreq) = points->GetHfield(ifreq, irec);
+            }
+        }
+        return F;
+    }
+
+    /** @return the fields in the row order of CalculateSensitivities */
+    VectorXcr Vectorise( const MatrixXcr& F ) {
+        return Eigen::Map<const VectorXcr>( F.data(), F.size() );
+    }
+
+};
@@ -34,6 +34,8 @@ struct SplineSet{
     VectorXr c;
     VectorXr d;
     VectorXr x;
+    /// Integral of the spline from the first knot to each knot
+    VectorXr I;
 
     SplineSet( ) {
     }
@@ -44,6 +46,7 @@ struct SplineSet{
         c = VectorXr::Zero(n+1);
         d = VectorXr::Zero(n);
         x = VectorXr::Zero(n+1);
+        I = VectorXr::Zero(n+1);
     }
 };
 
@@ -123,22 +126,33 @@ class CubicSplineInterpolator : public LemmaObject {
     /** Interpolate a monotonically increasing ordered set.
         @param[in] x are the interpolation abscissa points
         @return the ordinate values at x
+        @see Interpolate(const VectorXr&)
      */
     VectorXr InterpolateOrderedSet(const VectorXr& x);
 
-    /** integrates the spline from x0 to x1. Uses composite Simpson's rule and n is the number of segments
+    /** integrates the spline from x0 to x1. The integral is exact, n is no longer used
+     *  and is retained for compatibility, as this formerly used composite Simpson's rule.
      *  @param[in] x0 is left argument
      *  @param[in] x1 is right argument
-     *  @param[in] n is the number of points, must be even
+     *  @param[in] n is ignored
      */
     Real Integrate(const Real& x0, const Real& x1, const int& n);
 
-    /** integrates using cubic spline values. Taken from AMRIRA P223F project code Leroi, which in turn was based on
-        This is a modification of the FUNCTION PPVALU in the book
-        "A PRACTICAL GUIDE TO SPLINES"  by C. DE BOOR
+    /** integrates the spline from x0 to x1, exactly. Integrals from the first knot to
+        every knot are stored by SetKnots, so only the partial intervals at x0 and x1
+        are evaluated. Beyond the knots the end polynomials are extended.
+        @param[in] x0 is left argument
+        @param[in] x1 is right argument
      */
     Real Integrate(const Real& x0, const Real& x1);
 
+    /** integrates the spline exactly over many intervals, element by element.
+        @param[in] x0 are the left arguments
+        @param[in] x1 are the right arguments, of the same length as x0
+        @return the integrals from x0(i) to x1(i)
+     */
+    VectorXr Integrate(const VectorXr& x0, const VectorXr& x1);
+
     /** @returns the know abscissa values
      */
     VectorXr GetKnotAbscissa();
@@ -149,11 +163,19 @@ class CubicSplineInterpolator : public LemmaObject {
 
     /** Interpolation at a single point.
         @param[in] x is the interpolation abscissa point
-        @param[in] i is an optional index to start searching at. Defaults to zero
+        @param[in,out] i is the interval to try first, if x does not lie in it or the next
+                       a bisection search is made. On return holds the interval of x.
         @return the ordinate value at x
      */
     Real Interpolate(const Real& x, int& i);
 
+    /** Interpolation at many points. Intervals are found first, then the polynomials are
+        evaluated together. The points need not be ordered, but lookup is fastest if they are.
+        @param[in] x are the interpolation abscissa points
+        @return the ordinate values at x
+     */
+    VectorXr Interpolate(const VectorXr& x);
+
     /** Interpolation at a single point.
         @param[in] x is the interpolation abscissa point
         @return the ordinate value at x
@@ -173,9 +195,18 @@ class CubicSplineInterpolator : public LemmaObject {
 
     // ====================  OPERATIONS    =======================
 
-    /** Finds the interval of knots in spline to use for integration.
+    /** Finds the interval of knots containing x, by bisection unless x lies in
+        interval i or the one following it. Points beyond the knots are assigned to
+        the first or last interval.
+        @param[in] x is the abscissa point
+        @param[in] i is the interval to try first
+     */
+    Index Interval(const Real& x, const Index& i) const;
+
+    /** @return the integral of the spline from the first knot to x, which lies in
+        interval i
      */
-    Index Interval(const Real& x);
+    Real Primitive(const Real& x, const Index& i) const;
 
     private:
 
@@ -187,10 +218,6 @@ class CubicSplineInterpolator : public LemmaObject {
 
     SplineSet Spline;
 
-    Index ilo;
-
-    int mflag;
-
     // ====================  DATA MEMBERS  =========================
 
 }; // -----  end of class  CubicSplineInterpolator  -----
@@ -293,9 +293,10 @@
          *  FHTKEY201       Key's 101 point filter
          *  FHTKEY51        Key's 51 point filter
          *  QWEKEY          Key's Gaussian quadrature integration method
+         *  FHTAUTO         Cheapest of the Key and Anderson filters meeting a tolerance
          */
         enum HANKELTRANSFORMTYPE { ANDERSON801, CHAVE, FHTKEY201, FHTKEY101, FHTKEY51, QWEKEY,
-                                    FHTKONG61, FHTKONG121, FHTKONG241, IRONS };
+                                    FHTKONG61, FHTKONG121, FHTKONG241, IRONS, FHTAUTO };
 
         /** Enum is OK because these are the only physically possible sources.
          @param NOSOURCETYPE is default.
@@ -322,6 +323,12 @@
         */
         enum FIELDCALCULATIONS {E, H, BOTH};
 
+        /** Components of the fields at a receiver, combined as a bit mask to select the
+         *  components that are calculated
+         */
+        enum FIELDCOMPONENTMASK {EXMASK=1, EYMASK=2, EZMASK=4, HXMASK=8, HYMASK=16, HZMASK=32,
+                                 EMASK=7, HMASK=56, ALLMASK=63};
+
         /** Windowing function type
          */
         enum WINDOWTYPE { HAMMING, /*!< A hamming window */
@@ -83,6 +83,7 @@ PYBIND11_MODULE(LemmaCore, m) {
         .value("FHTKONG121", Lemma::FHTKONG121)
         .value("FHTKONG241", Lemma::FHTKONG241)
         .value("IRONS", Lemma::IRONS)
+        .value("FHTAUTO", Lemma::FHTAUTO)
         .export_values();
 
 
@@ -92,6 +93,18 @@ PYBIND11_MODULE(LemmaCore, m) {
         .value("BOTH", Lemma::BOTH)
         .export_values();
 
+    py::enum_<Lemma::FIELDCOMPONENTMASK>(m, "FIELDCOMPONENTMASK", py::arithmetic())
+        .value("EXMASK", Lemma::EXMASK)
+        .value("EYMASK", Lemma::EYMASK)
+        .value("EZMASK", Lemma::EZMASK)
+        .value("HXMASK", Lemma::HXMASK)
+        .value("HYMASK", Lemma::HYMASK)
+        .value("HZMASK", Lemma::HZMASK)
+        .value("EMASK", Lemma::EMASK)
+        .value("HMASK", Lemma::HMASK)
+        .value("ALLMASK", Lemma::ALLMASK)
+        .export_values();
+
     //what the what? This won't compile on gcc?? Maybe because not all caps?
     /*
     py::enum_<Lemma::DipoleSourcePolarity>(m "DipoleSourcePolarity")
@@ -217,11 +230,15 @@ PYBIND11_MODULE(LemmaCore, m) {
         .def("Integrate", py::overload_cast<const Lemma::Real&, const Lemma::Real& >(&Lemma::CubicSplineInterpolator::Integrate),
                 "Integrates between the arguments using cubic spline values.")
         .def("IntegrateN", py::overload_cast<const Lemma::Real&, const Lemma::Real&, const int& >(&Lemma::CubicSplineInterpolator::Integrate),
-                "Integrates the spline from x0 to x1. Uses composite Simpson's rule and n is the number of segments")
+                "Integrates the spline from x0 to x1. The integral is exact, n is ignored")
+        .def("IntegrateSet", py::overload_cast<const Lemma::VectorXr&, const Lemma::VectorXr& >(&Lemma::CubicSplineInterpolator::Integrate),
+                "Integrates the spline over each interval x0[i] to x1[i]")
         .def("Interpolate", py::overload_cast<const Lemma::Real& >(&Lemma::CubicSplineInterpolator::Interpolate),
                 "Interpolation at a single point, x is the interpolation abscissa point, returns the ordinate value at x")
         .def("InterpolateI", py::overload_cast<const Lemma::Real&, int& >(&Lemma::CubicSplineInterpolator::Interpolate),
                 "Interpolation at a single point, x is the interpolation abscissa point and i is the knot to begin searchin at returns the ordinate value at x")
+        .def("InterpolateSet", py::overload_cast<const Lemma::VectorXr& >(&Lemma::CubicSplineInterpolator::Interpolate),
+                "Interpolation at many points, x are the interpolation abscissa points, returns the ordinate values at x")
 
     ;
 
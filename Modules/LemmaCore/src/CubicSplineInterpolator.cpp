@@ -101,43 +101,42 @@ namespace Lemma {
     //--------------------------------------------------------------------------------------
     void CubicSplineInterpolator::SetKnots ( const VectorXr& x, const VectorXr& y ) {
 
-        //int n = x.size()-1;
         Index n = x.size()-1;
 
-        Spline = SplineSet(n);
+        // storage is reused when the number of knots is unchanged
+        if (Spline.x.size() != n+1) {
+            Spline = SplineSet(n);
+        }
 
         Spline.a = y;
         Spline.x = x;
-        VectorXr h = VectorXr::Zero(n);
-        for(Index i=0; i<n; ++i)
-            h(i) = Spline.x(i+1)-Spline.x(i);
-
-        VectorXr alpha(n-1);
-        for(Index i=1; i<n-1; ++i)
-            alpha(i) =  3.*(Spline.a[i+1]-Spline.a[i])/h[i] - 3.*(Spline.a[i]-Spline.a[i-1])/h[i-1] ;
-
-        VectorXr l = VectorXr::Zero(n+1);
-        VectorXr mu  = VectorXr::Zero(n+1);
-        VectorXr z = VectorXr::Zero(n+1);
-        l[0] = 1;
-        mu[0] = 0;
-        z[0] = 0;
-
-        for(Index i = 1; i < n-1; ++i) {
-            l[i] = 2 *(Spline.x[i+1]-Spline.x[i-1])-h[i-1]*mu[i-1];
-            mu[i] = h[i]/l[i];
-            z[i] = (alpha[i]-h[i-1]*z[i-1])/l[i];
+
+        // Tridiagonal system for the natural spline, solved by forward elimination. The
+        // elimination terms mu and z are held in d and c until the back substitution.
+        Spline.c(0) = 0;
+        if (n > 0) Spline.d(0) = 0;
+        for (Index i=1; i<n; ++i) {
+            Real h0 = Spline.x(i) - Spline.x(i-1);
+            Real h1 = Spline.x(i+1) - Spline.x(i);
+            Real alpha = 3.*(Spline.a(i+1)-Spline.a(i))/h1 - 3.*(Spline.a(i)-Spline.a(i-1))/h0;
+            Real l = 2.*(Spline.x(i+1)-Spline.x(i-1)) - h0*Spline.d(i-1);
+            Spline.d(i) = h1/l;
+            Spline.c(i) = (alpha - h0*Spline.c(i-1))/l;
+        }
+        Spline.c(n) = 0;
+
+        for (Index j=n-1; j>=0; --j) {
+            Real h = Spline.x(j+1) - Spline.x(j);
+            Spline.c(j) = Spline.c(j) - Spline.d(j)*Spline.c(j+1);
+            Spline.b(j) = (Spline.a(j+1)-Spline.a(j))/h - h*(Spline.c(j+1)+2.*Spline.c(j))/3.;
+            Spline.d(j) = (Spline.c(j+1)-Spline.c(j))/(3.*h);
         }
-        l[n] = 1;
-        z[n] = 0;
 
-        for(Index j = n-1; j >= 0; --j) {
-            Spline.c[j] = z[j] - mu[j] * Spline.c[j+1];
-            Spline.b[j] = (Spline.a[j+1]-Spline.a[j])/h[j]-h[j]*(Spline.c[j+1]+2*Spline.c[j])/3;
-            Spline.d[j] = (Spline.c[j+1]-Spline.c[j])/3/h[j];
+        // Integrals from the first knot
+        Spline.I(0) = 0;
+        for (Index j=0; j<n; ++j) {
+            Spline.I(j+1) = Primitive(Spline.x(j+1), j);
         }
-        // On OSX, this causes a strange bug 'sometimes', alignment?
-        //Spline.c = Spline.c.head(n);
 
         return;
     }		// -----  end of method CubicSplineInterpolator::SetKnots  -----
@@ -159,12 +158,7 @@ namespace Lemma {
     //      Method:  InterpolateOrderedSet
     //--------------------------------------------------------------------------------------
     VectorXr CubicSplineInterpolator::InterpolateOrderedSet ( const VectorXr& x ) {
-        VectorXr y = VectorXr::Zero(x.size());
-        int ii = 0;
-        for (int iy=0; iy<y.size(); ++iy) {
-            y[iy] = Interpolate(x[iy], ii);
-        }
-        return y;
+        return Interpolate(x);
     }		// -----  end of method CubicSplineInterpolator::InterpolateOrderedSet  -----
 
 
@@ -173,23 +167,9 @@ namespace Lemma {
     //      Method:  Interpolate
     //--------------------------------------------------------------------------------------
     Real CubicSplineInterpolator::Interpolate ( const Real& x, int& i) {
-
-        // O(n) search, could do bisection, but if these are sorted, then this is quick
-        while(Spline.x[i] < x && i<Spline.x.size()-1) {
-            ++i;
-        }
-        --i;
-
-//         if ( x > Spline.x[i] ) {
-//             std::cout << "DOOM in interplate\t x=" <<  x << "\ti=" << i << "\tSpline.x[i]=" << Spline.x[i] << std::endl;
-//             std::cout <<"Spline.x.size()" << Spline.x.size() << std::endl;
-//             std::cout << "Spline.x" << Spline.x.transpose() << std::endl;
-//             //throw std::runtime_error("CubicSplineInterpolator::Interpolate ATTEMPT TO INTERPOLATE PAST LAST KNOT");
-//         }
-
-
-        return Spline.a[i] + Spline.b[i]*(x-Spline.x[i]) + Spline.c[i]*((x-Spline.x[i])*(x-Spline.x[i])) +
-               Spline.d[i]*((x-Spline.x[i])*(x-Spline.x[i])*(x-Spline.x[i]) );
+        i = static_cast<int>( Interval(x, i) );
+        Real dx = x - Spline.x(i);
+        return Spline.a(i) + dx*(Spline.b(i) + dx*(Spline.c(i) + dx*Spline.d(i)));
     }		// -----  end of method CubicSplineInterpolator::Interpolate  -----
 
     //--------------------------------------------------------------------------------------
@@ -201,32 +181,48 @@ namespace Lemma {
         return Interpolate(x, ii);
     }
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  CubicSplineInterpolator
-    //      Method:  Integrate
+    //      Method:  Interpolate
     //--------------------------------------------------------------------------------------
-    Real CubicSplineInterpolator::Integrate ( const Real& x0, const Real& x1, const int& n ) {
-
-        assert(n > 0);
-        // force n to be even?
-        //n += (n % 2);
-
-        Real S = Interpolate(x0) + Interpolate(x1);
-        Real h = (x1 - x0) / Real(n);
-
-        int ik = 0;
-        for (int i=1; i<n; i+=2) {
-            S += 4. * Interpolate(x0 + (Real)(i)*h, ik);
+    VectorXr CubicSplineInterpolator::Interpolate ( const VectorXr& x ) {
+
+        VectorXr y(x.size());
+
+        // Points are taken in blocks that stay in cache. The coefficients of each point's
+        // interval are gathered, then the polynomials of the block are evaluated together.
+        const int nb = 64;
+        Eigen::Array<Real, nb, 1> a, b, c, d, dx;
+        Index i = 0;
+        for (Index ix0=0; ix0<x.size(); ix0+=nb) {
+            const Index m = std::min(static_cast<Index>(nb), x.size()-ix0);
+            for (Index ix=0; ix<m; ++ix) {
+                i = Interval(x(ix0+ix), i);
+                dx(ix) = x(ix0+ix) - Spline.x(i);
+                a(ix) = Spline.a(i);
+                b(ix) = Spline.b(i);
+                c(ix) = Spline.c(i);
+                d(ix) = Spline.d(i);
+            }
+            if (m == nb) {
+                y.segment<nb>(ix0) = ( a + dx*(b + dx*(c + dx*d)) ).matrix();
+            } else {
+                y.segment(ix0, m) = ( a.head(m) + dx.head(m)*(b.head(m) + dx.head(m)*(c.head(m)
+                                    + dx.head(m)*d.head(m))) ).matrix();
+            }
         }
+        return y;
+    }		// -----  end of method CubicSplineInterpolator::Interpolate  -----
 
-        ik = 0;
-        for (int i=2; i<n-1; i+=2) {
-            S += 2. * Interpolate(x0 + (Real)(i)*h, ik);
-        }
 
-        return  S * h / 3.;
-    }
+    //--------------------------------------------------------------------------------------
+    //       Class:  CubicSplineInterpolator
+    //      Method:  Integrate
+    //--------------------------------------------------------------------------------------
+    Real CubicSplineInterpolator::Integrate ( const Real& x0, const Real& x1, const int& ) {
+        // the integral is exact, the number of Simpson's rule intervals is not needed
+        return Integrate(x0, x1);
+    }		// -----  end of method CubicSplineInterpolator::Integrate  -----
 
 
     //--------------------------------------------------------------------------------------
@@ -234,95 +230,61 @@ namespace Lemma {
     //      Method:  Integrate
     //--------------------------------------------------------------------------------------
     Real CubicSplineInterpolator::Integrate ( const Real& x0, const Real& x1 ) {
+        Index i0 = Interval(x0, 0);
+        Index i1 = Interval(x1, i0);
+        return Primitive(x1, i1) - Primitive(x0, i0);
+    }		// -----  end of method CubicSplineInterpolator::Integrate  -----
 
-        Index i0 = Interval(x0);
-        Index i1 = Interval(x1);
-
-        Real h0 = x0 - Spline.x(i0);
-        if (mflag == -1) h0 = 0;
-        Real h1 = x1 - Spline.x(i1);
-
-        Real cubint = (((Spline.d(i1)*h1/4.0 + Spline.c(i1) )*h1/3.0 +
-                         Spline.b(i1) )*h1/2.0 + Spline.a(i1) )*h1
-                    - (((Spline.d(i0)*h0/4.0 + Spline.c(i0) )*h0/3.0 +
-                         Spline.b(i0) )*h0/2.0 + Spline.a(i0) )*h0;
 
-        // Include integrals over intervening intervals.
-        if (i1 > i0) {
-            for (Index i=i0; i<i1-1; ++i) {
-                Real h = Spline.x(i+1) - Spline.x(i);
-                cubint +=  (((Spline.d(i)*h/4.0 + Spline.c(i) )*h/3.0 +
-                              Spline.b(i))*h/2.0 + Spline.a(i) )*h;
-            }
+    //--------------------------------------------------------------------------------------
+    //       Class:  CubicSplineInterpolator
+    //      Method:  Integrate
+    //--------------------------------------------------------------------------------------
+    VectorXr CubicSplineInterpolator::Integrate ( const VectorXr& x0, const VectorXr& x1 ) {
+        assert(x0.size() == x1.size());
+        VectorXr I(x0.size());
+        // each limit keeps its own search hint, so ordered limits are found without bisection
+        Index i0(0), i1(0);
+        for (Index ix=0; ix<x0.size(); ++ix) {
+            i0 = Interval(x0(ix), i0);
+            i1 = Interval(x1(ix), i1);
+            I(ix) = Primitive(x1(ix), i1) - Primitive(x0(ix), i0);
         }
-        return cubint;
+        return I;
     }		// -----  end of method CubicSplineInterpolator::Integrate  -----
 
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  CubicSplineInterpolator
-    //      Method:  Interval
+    //      Method:  Primitive
     //--------------------------------------------------------------------------------------
-    Index CubicSplineInterpolator::Interval ( const Real& x ) {
+    Real CubicSplineInterpolator::Primitive ( const Real& x, const Index& i ) const {
+        Real h = x - Spline.x(i);
+        return Spline.I(i) + h*(Spline.a(i) + h*(Spline.b(i)/2. + h*(Spline.c(i)/3. + h*Spline.d(i)/4.)));
+    }		// -----  end of method CubicSplineInterpolator::Primitive  -----
 
-        std::cerr << "ENTERING CubicSplineInterpolator::Inverval. Known bugs here"  << std::endl;
-        Index nx = Spline.x.size() - 2; // TODO check if this is correct or just -1
-        // when x not in range
-        if (x <= Spline.x(0) || nx <= 1 ) {
-            mflag = -1;
-            return 1;
-        }
 
-        if (x >= Spline.x(nx)) {
-            mflag = 1;
-            return nx;
-        }
+    //--------------------------------------------------------------------------------------
+    //       Class:  CubicSplineInterpolator
+    //      Method:  Interval
+    //--------------------------------------------------------------------------------------
+    Index CubicSplineInterpolator::Interval ( const Real& x, const Index& i ) const {
 
-        mflag = 0;
-        if (ilo >= nx) ilo = nx-1;
-        Index ihi = ilo+1;
+        // last interval, points beyond the knots use the end polynomials
+        const Index nx = Spline.x.size() - 2;
+        if (nx <= 0) return 0;
 
-        // if x is already in the interval
-        if ( x<Spline.x(ihi) && x >= Spline.x(ilo) ) {
-            //std::cout << "TRIVIAL INTERVAL " << Spline.x(ilo) << "\t" << x << "\t" << Spline.x(ihi) << std::endl;
-            return ilo;
+        // ordered access usually stays in the same interval, or moves to the next
+        if (i >= 0 && i <= nx && x >= Spline.x(i)) {
+            if (i == nx || x < Spline.x(i+1)) return i;
+            if (i+1 == nx || x < Spline.x(i+2)) return i+1;
         }
 
-        if (x <= Spline.x(ilo)) { // decrease ilo to capture
-            Index istep = 1;
-            for (Index ix=1; ix<nx; ++ix) {
-                ihi = ilo;
-                ilo = ihi - istep;
-                ilo = std::max(Index(1), ilo);
-                if (x >= Spline.x(ilo) || ilo == 1) break;
-                istep *= 2;
-            }
-        } else if (x >= Spline.x(ihi)) { // increase ihi to capture
-            Index istep = 1;
-            for (Index ix=1; ix<nx; ++ix) {
-                ilo = ihi;
-                ihi = ilo + istep;
-                ihi = std::min(ihi, nx);
-                if (x <= Spline.x(ihi) || ihi == nx) break;
-                istep *= 2;
-            }
-        }
-
-        // Now Spline.x(ilo) <= x < Spline.x(ihi) --> Narrow the interval.
-        //std::cout << "WIDE INTERVAL " << Spline.x(ilo) << "\t" << x << "\t" << Spline.x(ihi) << std::endl;
-        for (Index ix=1; ix<nx; ++ix) {
-            Index middle = (ilo+ihi) / 2;
-            if (middle == ilo) break;
-            if (x < Spline.x(middle)) {
-                ihi = middle;
-            } else {
-                ilo = middle;
-            }
-        }
-        assert ( Spline.x(ilo) < x && x < Spline.x(ihi) );
-        return ilo;
-    }		// -----  end of method CubicSplineInterpolator::Inverval  -----
+        // bisection over the interior knots
+        const Real* begin = Spline.x.data() + 1;
+        const Real* end   = Spline.x.data() + nx + 1;
+        return static_cast<Index>( std::upper_bound(begin, end, x) - begin );
+    }		// -----  end of method CubicSplineInterpolator::Interval  -----
 
 
 
@@ -158,6 +158,9 @@ std::string enum2String(const HANKELTRANSFORMTYPE& Type) {
         case IRONS:
             t = std::string("IRONS");
             break;
+        case FHTAUTO:
+            t = std::string("FHTAUTO");
+            break;
 
     }
     return t;
@@ -217,6 +220,7 @@ HANKELTRANSFORMTYPE string2Enum<HANKELTRANSFORMTYPE>( const std::string& str ) {
     else if  (str == "FHTKONG121") return  FHTKONG121;
     else if  (str == "FHTKONG241") return  FHTKONG241;
     else if  (str == "IRONS") return  IRONS;
+    else if  (str == "FHTAUTO") return  FHTAUTO;
     else {
         throw std::runtime_error("string not recognized as HANKELTRANSFORMTYPE");
     }
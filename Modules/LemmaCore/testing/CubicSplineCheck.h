@@ -0,0 +1,66 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <LemmaCore>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    /// A natural spline through a straight line is that line, so values and
+    /// integrals are exact, including beyond the knots
+    void testLinearIsExact(void)
+    {
+        VectorXr x = VectorXr::LinSpaced(11, 0, 1).array().square();
+        VectorXr y = 2.*x.array() + 1.;
+        auto Spline = CubicSplineInterpolator::NewSP();
+        Spline->SetKnots(x, y);
+
+        VectorXr xi = VectorXr::LinSpaced(57, -.1, 1.1);
+        VectorXr yi = Spline->Interpolate(xi);
+        for (int i=0; i<xi.size(); ++i) {
+            TS_ASSERT_DELTA( yi(i), 2.*xi(i) + 1., 1e-12 );
+        }
+        TS_ASSERT_DELTA( Spline->Integrate(.05, .93), (.93*.93 + .93) - (.05*.05 + .05), 1e-12 );
+        TS_ASSERT_DELTA( Spline->Integrate(-.1, 1.1, 2), (1.1*1.1 + 1.1) - (.01 - .1), 1e-12 );
+    }
+
+    /// Batched and scalar evaluation agree, in any order, and the integral matches
+    /// a fine midpoint sum of the interpolant
+    void testBatchedAndIntegral(void)
+    {
+        VectorXr x = VectorXr::LinSpaced(40, -2, 1).array().exp();
+        VectorXr y = x.array().sin() / x.array();
+        auto Spline = CubicSplineInterpolator::NewSP();
+        Spline->SetKnots(x, y);
+
+        VectorXr xi = (VectorXr(5) << 2.5, .2, .2, 1.9, .14).finished();
+        VectorXr yi = Spline->Interpolate(xi);
+        for (int i=0; i<xi.size(); ++i) {
+            TS_ASSERT_DELTA( yi(i), Spline->Interpolate(xi(i)), 1e-15 );
+        }
+
+        int n = 20000;
+        Real x0(.2), x1(2.5), h((x1-x0)/n), sum(0);
+        for (int i=0; i<n; ++i) {
+            sum += h*Spline->Interpolate(x0 + (i+.5)*h);
+        }
+        TS_ASSERT_DELTA( Spline->Integrate(x0, x1), sum, 1e-8 );
+    }
+};
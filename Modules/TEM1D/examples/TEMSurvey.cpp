@@ -141,41 +141,48 @@ int main() {
 
         RxLM->SetWindows(centresLM, widthsLM, SEC);
 
-//     // Specifies survey, this is the Glue Class, the top of the structure, etc.
-//     TEMSurvey* Survey = TEMSurvey::New();
-//         Survey->SetNumberOfLines(1);  // Flight lines or
-//                                       // Internally each line is a class? But that's sort of hidden to the
-//                                       // end user. Having each line seperate is nice for constrained inversion, where
-//                                       // each line is a nice thing to deal with.
-//         Survey->GetLine(0)->SetNumberOfRecords(1);    // Each Record then contains everything needed for modelling response curve(s)
-//         Survey->GetLine(0)->GetRecord(0)->SetNumberOfPulseSequences( 1 );
-//         Survey->GetLine(0)->GetRecord(0)->SetTransmitterReceiverPair( 0, TxHM, RxHM );
-//         //Survey->GetLine(0)->GetRecord(0)->SetTransmitterReceiverPair( 1, TxHM, RxHM );
-//
-//
-//     LayeredEarthEM* Earth = LayeredEarthEM::New();
-//         Earth->SetNumberOfLayers(31);
-//         Earth->SetLayerThickness( (VectorXr(29) <<  5.00E+00,  5.40E+00,
-//              5.80E+00, 6.30E+00, 6.80E+00, 7.30E+00, 7.80E+00, 8.50E+00,
-//              9.10E+00, 9.80E+00, 1.06E+01, 1.14E+01, 1.23E+01, 1.33E+01,
-//              1.43E+01, 1.54E+01, 1.66E+01, 1.79E+01, 1.93E+01, 2.08E+01,
-//              2.25E+01, 2.42E+01, 2.61E+01, 2.81E+01, 3.03E+01, 3.27E+01,
-//              3.52E+01, 3.80E+01, 4.10E+01).finished() );
-//
-//         VectorXcr rho = ( (VectorXcr(31) << 0, 1.54E+01, 4.21E+01,
-//             9.25E+01, 1.26E+02, 1.17E+02, 7.57E+01, 3.21E+01, 1.40E+01, 1.96E+01,
-//             2.67E+01, 2.56E+01, 2.00E+01, 1.86E+01, 2.31E+01, 2.97E+01, 3.50E+01,
-//             3.79E+01, 3.75E+01, 3.32E+01, 2.52E+01, 1.57E+01, 8.38E+00, 5.38E+00,
-//             5.49E+00, 6.34E+00, 7.07E+00, 7.81E+00, 8.67E+00, 9.59E+00, 1.05E+01
-//         ).finished() ); // 200 Ohm-m half space
-//
-//         Earth->SetLayerConductivity( 1./rho.array() );
-//         // ALL SET UP
-//         std::cout << *Survey << std::endl;
-//
-//         // OK do your thinc
-//         //DataTEM* data =
-//         Survey->ForwardModel( Earth );
+    // Specifies survey, this is the Glue Class, the top of the structure, etc.
+    auto Survey = TEMSurvey::NewSP();
+        Survey->SetNumberOfLines(1);  // Flight lines or
+                                      // Internally each line is a class? But that's sort of hidden to the
+                                      // end user. Having each line seperate is nice for constrained inversion, where
+                                      // each line is a nice thing to deal with.
+        Survey->GetLine(0)->SetNumberOfRecords(1);    // Each Record then contains everything needed for modelling response curve(s)
+        Survey->GetLine(0)->GetRecord(0)->SetNumberOfPulseSequences( 2 );
+        // Both moments drive the same loop, and share a single earth response
+        Survey->GetLine(0)->GetRecord(0)->SetTransmitterReceiverPair( 0, TxHM, RxHM );
+        Survey->GetLine(0)->GetRecord(0)->SetTransmitterReceiverPair( 1, TxLM, RxLM );
+
+    auto Earth = LayeredEarthEM::NewSP();
+        Earth->SetNumberOfLayers(31);
+        Earth->SetLayerThickness( (VectorXr(29) <<  5.00E+00,  5.40E+00,
+             5.80E+00, 6.30E+00, 6.80E+00, 7.30E+00, 7.80E+00, 8.50E+00,
+             9.10E+00, 9.80E+00, 1.06E+01, 1.14E+01, 1.23E+01, 1.33E+01,
+             1.43E+01, 1.54E+01, 1.66E+01, 1.79E+01, 1.93E+01, 2.08E+01,
+             2.25E+01, 2.42E+01, 2.61E+01, 2.81E+01, 3.03E+01, 3.27E+01,
+             3.52E+01, 3.80E+01, 4.10E+01).finished() );
+
+        VectorXcr rho = ( (VectorXcr(31) << 1e12 /* air */, 1.54E+01, 4.21E+01,
+            9.25E+01, 1.26E+02, 1.17E+02, 7.57E+01, 3.21E+01, 1.40E+01, 1.96E+01,
+            2.67E+01, 2.56E+01, 2.00E+01, 1.86E+01, 2.31E+01, 2.97E+01, 3.50E+01,
+            3.79E+01, 3.75E+01, 3.32E+01, 2.52E+01, 1.57E+01, 8.38E+00, 5.38E+00,
+            5.49E+00, 6.34E+00, 7.07E+00, 7.81E+00, 8.67E+00, 9.59E+00, 1.05E+01
+        ).finished() );
+
+        Earth->SetLayerConductivity( 1./rho.array() );
+        // ALL SET UP
+        std::cout << *Survey << std::endl;
+
+    auto Data = Survey->ForwardModel( Earth );
+
+    std::cout.precision(12);
+    for (int iseq=0; iseq<Data->GetNumberOfSeries(0, 0); ++iseq) {
+        std::cout << "// pulse sequence " << iseq << "\n// time [s]  dB/dt [T/s] \n";
+        VectorXr gates = Data->GetSeriesGateCentres(0, 0, iseq);
+        VectorXr dbdt  = Data->GetSeries(0, 0, iseq);
+        for (int ig=0; ig<gates.size(); ++ig) {
+            std::cout << "  " << gates(ig) << "  " << dbdt(ig) << "\n";
+        }
+    }
 
 }
-
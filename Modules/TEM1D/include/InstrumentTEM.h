@@ -14,197 +14,185 @@
 #ifndef __INSTRUMENTTEM_H
 #define __INSTRUMENTTEM_H
 
-#include "Instrument.h"
 #include "EMEarth1D.h"
-#include "WireAntenna.h"
-#include "PolygonalWireAntenna.h"
-#include "FieldPoints.h"
-#include "DipoleSource.h"
 #include "LayeredEarthEM.h"
-
-//#include "DigitalFilterCosTrans.h"
-//#include "DigitalFilterSinTrans.h"
-//#include "TEMIntegrationKernel.h"
+#include "FastCosTransformAnderson.h"
 #include "CubicSplineInterpolator.h"
 
-namespace Lemma {
+#include "TEMTransmitter.h"
+#include "TEMReceiver.h"
+#include "TEMIntegrationKernel.h"
 
-enum ReceiverType { INDUCTIVE, MAGNETOMETER, ELECTRIC };
+namespace Lemma {
 
 // ===================================================================
 //        Class:  InstrumentTem
 /// \brief  TEM Instrument Class
-/// \details Provides utility to forward model TEM data in Lemma.
+/// \details Forward models the gated response of TEM receivers to the
+///          waveform of a TEMTransmitter over a layered earth. The step off
+///          response of every receiver is found with a single lagged cosine
+///          transform, each kernel evaluation being one frequency domain
+///          calculation covering all receivers. The response is splined and
+///          convolved with the waveform and gates in closed form.
+///          A sounding is one transmitter, its receivers and an earth model;
+///          many soundings are computed in parallel by MakeLaggedCalculations.
 // ===================================================================
-class InstrumentTem : public Instrument {
+class InstrumentTem : public LemmaObject {
 
 	friend std::ostream &operator<<(std::ostream &stream,
 		const InstrumentTem &ob);
 
+    struct Workspace;
+
 	public:
 
 	    // ====================  LIFECYCLE     =======================
 
-		static InstrumentTem* NewSP();
-
-	    // ====================  OPERATORS     =======================
+        /** Default locked constructor, use NewSP */
+        explicit InstrumentTem ( const ctor_key& key );
 
-	    // ====================  OPERATIONS    =======================
+        /** Locked deserializing constructor, use DeSerialize */
+        InstrumentTem ( const YAML::Node& node, const ctor_key& key );
 
-		/// Perform the forward model calculation
-		void MakeDirectCalculation( const HANKELTRANSFORMTYPE& hType );
+        /** Default destructor */
+        ~InstrumentTem ();
 
-        /** Perform the forward model calculation, use lagged convolutions to
-         *  speed up the calculations
+        /**
+         * @copybrief LemmaObject::New()
+         * @copydetails LemmaObject::New()
          */
-		void MakeLaggedCalculation( const HANKELTRANSFORMTYPE& hType );
-
-	    // ====================  ACCESS        =======================
+		static std::shared_ptr<InstrumentTem> NewSP();
 
-		/** Sets pulse parameters as a linearly segmented graph, so
-         *  for example a triangle wave needs three points in Amps and
-         *  times, a trapazoidal needs for. The pulse is assumed (defaults) to be
-         *  bipolar, only the positive polarity should be specified.
-         *  @param[in] Amp is the waveform current in Amps
-         *  @param[in] times are the abscissa values of the waveform
-         *  @param[in] bipolar specifies whether or not the pulse is bipolar
+        /**
+         *  Uses YAML to serialize this object.
+         *  @note The transmitter, receivers and model are not serialized.
+         *  @return a YAML::Node
          */
-		void SetPulse( const VectorXr& Amp, const VectorXr& times, bool bipolar=true );
-
-		/// Sets layered earth model
-		void EMEarthModel(LayeredEarthEM* Earth);
+        YAML::Node Serialize() const;
 
-		/// Sets transmitter parameters
-		void SetTransmitLoop(WireAntenna *antennae);
+        /**
+         *   Constructs an object from a YAML::Node.
+         *   @note The transmitter, receivers and model must be set again.
+         */
+        static std::shared_ptr< InstrumentTem > DeSerialize(const YAML::Node& node);
 
-		/// Sets dipole source parameters
-		void SetDipoleSource(DipoleSource* dipolesource);
+	    // ====================  OPERATORS     =======================
 
-		/// Sets receiver points and parameters
-		void SetReceiver(ReceiverPoints* Receivers);
+	    // ====================  OPERATIONS    =======================
 
-        /** Sets the type of receiver/measurement
+        /** Forward models this sounding, using lagged convolutions for all
+         *  gates of all receivers.
          */
-        void SetReceiverType( const ReceiverType& rtype  );
-
-		/// Return calculated data
-		MatrixXr GetMeasurements();
+		void MakeLaggedCalculation( );
 
-		/**
-            Set time gates, assumes gates widths are delta (instantaneous)
-            @param[in] times gate centres units are in seconds
+        /** Forward models many soundings, in parallel across soundings. Each thread
+         *  keeps its own earth, kernel, transform and spline and reuses them for every
+         *  sounding it is given. The first exception thrown by any sounding is rethrown
+         *  once all have been computed.
+         *  @param[in] Soundings are the instruments to compute
          */
+        static void MakeLaggedCalculations( const std::vector< std::shared_ptr<InstrumentTem> >& Soundings );
 
-		void SetTimes(const VectorXr &times);
+	    // ====================  ACCESS        =======================
 
-        /** Sets time gates centres and widths, both in seconds. The window is assumed to be
-         *  a simple boxcar. Simpson's rule is used to integrate the response
-         * @param[in] times gate centres units are in seconds
-         * @param[in] widths gate widths units are in seconds
+		/** Sets the transmitter, its waveform is used for the convolution. The
+         *  transmitter is copied for the calculation and is not modified.
          */
-        void SetTimeGates(const VectorXr &centres, const VectorXr& widths);
-
-		/// Get number of times
-		int GetNumberOfTimes();
+		void SetTransmitter( std::shared_ptr<TEMTransmitter> Tx );
 
-        /** Sets reference time for time gate to pulse time offset.
+		/** Sets the receivers, every receiver has a single location and its own gates
          */
-        void SetReferenceTime(const Real& RefTime);
+		void SetReceivers( const std::vector< std::shared_ptr<TEMReceiver> >& Rx );
 
-		/// Attach EMEarth1D
-		//void AttachEMEarth1D(EMEarth1D *EMEarth);
-
-	// ====================  INQUIRY       =======================
-
-
-
-	protected:
-
-	// ====================  LIFECYCLE     =======================
-
-		/// Default protected constructor.
-		InstrumentTem (const std::string &name);
-
-		/// Default protected constructor.
-		~InstrumentTem ();
+        /** Sets the waveform convolved with each receiver, for instance the low and
+         *  high moments of a dual moment system driving the same loop. Only the
+         *  waveforms are used, the loop is that of the transmitter. When not set
+         *  every receiver uses the waveform of the transmitter.
+         *  @param[in] Wfms are the waveforms, one per receiver
+         */
+        void SetWaveforms( const std::vector< std::shared_ptr<TEMTransmitter> >& Wfms );
 
-    // ====================  OPERATIONS    =======================
+		/** Sets the layered earth model */
+		void SetEarthModel( std::shared_ptr<LayeredEarthEM> Earth );
 
-        /**
-         *  Converts impulse B response (step db/dt) into inductive db/dt
-         *  response for general waveform.
+        /** Sets the Hankel transform used by the frequency domain calculations,
+         *  defaults to ANDERSON801
          */
-        void FoldAndConvolve( CubicSplineInterpolator* Spline );
+        void SetHankelTransformType( const HANKELTRANSFORMTYPE& type );
 
-        /** Convolves the transmitter waveform(s), takes the impulse response
-            and uses simpson's rule to evaluate the integral.
-            @param[in] Spline is the Cubic Spline object representing the solution.
-            @param[in] t is the evaluation time.
+        /** Sets the truncation tolerance of the cosine transform, defaults to 1e-7
+         *  @see DigitalFilterIntegratorAnderson::Compute
          */
-        Real ConvolveWaveform( CubicSplineInterpolator* Spline, const Real& t );
+        void SetTransformTolerance( const Real& tol );
 
-        /** Subtracts previous waveform(s) from current impulse response, and re-splines.
+        /** Evaluates closed loop transmitters as integrals along the wire rather than
+         *  with dipoles, defaults to false
+         *  @see EMEarth1D::SetLineIntegralEvaluation
          */
-        void SubtractPrevious( CubicSplineInterpolator* Spline );
+        void SetLineIntegralEvaluation( const bool& line );
 
+	    // ====================  INQUIRY       =======================
 
-	// ====================  DATA MEMBERS  =========================
-
-		//EMEarth1D* EmEarth;
+		/** @return the modelled data, for each receiver its gated response, in
+         *          \f$ T/s \f$, scaled by the receiver moment.
+         */
+		std::vector<VectorXr> GetMeasurements();
 
-		WireAntenna* Antenna;
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual std::string GetName() const {
+            return this->CName;
+        }
 
-		ReceiverPoints* Receiver;
+	protected:
 
-		LayeredEarthEM* EarthMod;
+	    // ====================  OPERATIONS    =======================
 
-		DipoleSource* Dipole;
+        /** Computes this sounding with the buffers of ws */
+        void MakeLaggedCalculation( Workspace& ws );
 
-        bool     bipolarWaveform;
+        /** Throws if the sounding is incomplete */
+        void CheckSetup( ) const;
 
-        /** Number of previous pules to model */
-        int      NPreviousPulse;
+        /** @return the waveform convolved with receiver irx */
+        std::shared_ptr<TEMTransmitter> GetWaveform( const int& irx ) const;
 
-        /** Reference time (relative to pulse abscissa) for time gates */
-        Real     RefTime;
+	    // ====================  DATA MEMBERS  =========================
 
-        /** Pulse period, if bimodal 1/2 repitition period */
-        Real     PulseT;
+        std::shared_ptr<TEMTransmitter>                 Transmitter;
 
-        /** Transmitter repitition frequency */
-        Real     TxFreq;
+        std::vector< std::shared_ptr<TEMReceiver> >     Receivers;
 
-        /** Receiver type */
-        ReceiverType  RType;
+        std::vector< std::shared_ptr<TEMTransmitter> >  Waveforms;
 
-        MatrixXr ModelledData;
+        std::shared_ptr<LayeredEarthEM>                 EarthMod;
 
-        /** Centre of time gate */
-		VectorXr TimeGates;
+        HANKELTRANSFORMTYPE                             HankelType;
 
-        /** Width of time gates */
-        VectorXr GateWidths;
+        Real                                            Tolerance;
 
-        /** Pulse waveform */
-        VectorXr Waveform;
+        bool                                            LineIntegral;
 
-        /** Current Amplitude of pulse */
-        VectorXr  TxAmp;
+        /** Gated response of each receiver */
+        std::vector<VectorXr>                           ModelledData;
 
-        /** Current -delta of pulse */
-        VectorXr  TxDelta;
+	private:
 
-        /** Current derivative of pulse */
-        VectorXr  TxDiff;
+        /** ASCII string representation of the class name */
+        static constexpr auto CName = "InstrumentTem";
 
-        /** times associated with TxAmp segments */
-        VectorXr  TxAbs;
+}; // -----  end of class  InstrumentTem  -----
 
-	private:
+    /////////////////////////////////////////
+    // Exception classes
 
-}; // -----  end of class  InstrumentTem  -----
+    /** If the waveforms set on an InstrumentTem are not one per receiver, throw this.
+     */
+    class WaveformsDoNotMatchReceivers : public std::runtime_error {
+            /** Thrown when the number of waveforms and receivers differ
+             */
+            public: WaveformsDoNotMatchReceivers();
+    };
 
 } // End of namespace Lemma
 
 #endif // __TEMINSTRUMENT_H
-
@@ -85,7 +85,7 @@ namespace Lemma {
 
         // ====================  DATA MEMBERS  =========================
 
-        static constexpr auto CName = "PolygonalWireAntenna";
+        static constexpr auto CName = "TEMInductiveReceiver";
 
     }; // -----  end of class  TEMInductiveReceiver  -----
 
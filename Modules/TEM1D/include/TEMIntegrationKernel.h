@@ -0,0 +1,118 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+  @file
+  @author   M. Andy Kass
+  @date     02/10/2011
+  @version  $Id: temintegrationkernel.h 190 2014-10-16 23:02:09Z tirons $
+ **/
+
+#ifndef __TEMINTEGRATIONKERNEL_H
+#define __TEMINTEGRATIONKERNEL_H
+
+#include "IntegrationKernel.h"
+#include "EMEarth1D.h"
+#include "WireAntenna.h"
+#include "FieldPoints.h"
+
+namespace Lemma {
+
+// ===================================================================
+//        Class:  TEMIntegrationKernel
+/// \brief  Integration kernel for calculation of TEM data
+/// \details Calculates the argument of the cosine transform giving the step off
+///          response of a wire antenna. Each receiver point is a related kernel,
+///          so all receivers are evaluated together by a single frequency domain
+///          calculation, which is kept until a different frequency is requested.
+// ===================================================================
+class TEMIntegrationKernel : public IntegrationKernel<Real> {
+
+	public:
+
+	// ====================  LIFECYCLE     =======================
+
+        /** Default locked constructor, use NewSP */
+		explicit TEMIntegrationKernel (const ctor_key& key);
+
+		/** Default destructor */
+		~TEMIntegrationKernel ();
+
+        /**
+         * @copybrief LemmaObject::New()
+         * @copydetails LemmaObject::New()
+         */
+		static std::shared_ptr<TEMIntegrationKernel> NewSP();
+
+	// ====================  OPERATORS     =======================
+
+	// ====================  OPERATIONS    =======================
+
+		/** Calculates the integration argument,
+         *  \f$ \Im \left( H(\omega) \right) / \omega \f$, of one receiver
+         *  @param[in] w is the angular frequency
+         *  @param[in] iRelated is the receiver index
+         */
+		Real Argument(const Real& w, const int& iRelated);
+
+	// ====================  ACCESS        =======================
+
+		/** Sets the EMEarth1D used for the frequency domain calculations, the
+         *  transmitter, receivers and earth model are attached to it
+         */
+		void SetEMEarth1D( std::shared_ptr<EMEarth1D> earth );
+
+		/** Sets the transmitter, its first frequency is overwritten for each evaluation
+         */
+		void SetTransmitter( std::shared_ptr<WireAntenna> antenna );
+
+		/** Sets the receiver points, and the field component used at each
+         *  @param[in] receivers are the receiver points
+         *  @param[in] comps are the field components, one per receiver point
+         */
+		void SetReceivers( std::shared_ptr<FieldPoints> receivers,
+                           const std::vector<FIELDCOMPONENT>& comps );
+
+	// ====================  INQUIRY       =======================
+
+        /** @return the number of related kernels, one per receiver point */
+		int GetNumRel();
+
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual std::string GetName() const {
+            return this->CName;
+        }
+
+	protected:
+
+	// ====================  LIFECYCLE     =======================
+
+	// ====================  DATA MEMBERS  =========================
+
+		std::shared_ptr<EMEarth1D>      EmEarthInt;
+
+		std::shared_ptr<WireAntenna>    Trans;
+
+		std::shared_ptr<FieldPoints>    Receivers;
+
+        /** Field component of each receiver */
+        std::vector<FIELDCOMPONENT>     Components;
+
+        /** Angular frequency of the cached arguments */
+        Real                            CachedOmega;
+
+        /** Arguments of every receiver at CachedOmega */
+        VectorXr                        CachedArgs;
+
+	private:
+
+        static constexpr auto CName = "TEMIntegrationKernel";
+
+}; // -----  end of class  TEMIntegrationKernel  -----
+
+} // End of namespace Lemma
+
+#endif // __TEMINTEGRATIONKERNEL_H
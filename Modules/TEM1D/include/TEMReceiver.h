@@ -23,6 +23,7 @@
 //#include "yaml-cpp/yaml.h"
 #include <LemmaCore>
 #include <FDEM1D>
+#include "TEMTransmitter.h"
 
 //#include <boost/random.hpp>
 //#include <boost/random/normal_distribution.hpp>
@@ -81,6 +82,17 @@ class TEMReceiver : public FieldPoints {
      */
     VectorXr SampleNoise();
 
+    /**
+     *  Converts an impulse response into the gated response of this receiver for the
+     *  waveform of Tx. Each boxcar gate is the difference of the convolved response at
+     *  its edges divided by its width. The edges of all gates are convolved together.
+     *  @param[in] Spline is the impulse response, with abscissa in seconds
+     *  @param[in] Tx is the transmitter providing the waveform
+     *  @return the response in each window
+     */
+    VectorXr FoldAndConvolve( std::shared_ptr<CubicSplineInterpolator> Spline,
+                              std::shared_ptr<TEMTransmitter> Tx );
+
     // ====================  ACCESS        =======================
 
     /**
@@ -137,6 +149,16 @@ class TEMReceiver : public FieldPoints {
      */
     Real    GetReferenceTime();
 
+    /**
+     *  @return the moment of the receiver
+     */
+    Real    GetMoment();
+
+    /**
+     *  @return the field component measured
+     */
+    FIELDCOMPONENT GetComponent();
+
     /** Returns the name of the underlying class, similiar to Python's type */
     virtual std::string GetName() const {
         return this->CName;
@@ -24,18 +24,15 @@
 #include "TEMSurveyLine.h"
 #include "TEMSurveyData.h"
 
-#include "layeredearthem.h"
-
-#ifdef HAVE_YAMLCPP
-#include "yaml-cpp/yaml.h"
-#endif
+#include "LayeredEarthEM.h"
 
 namespace Lemma {
 
-
     /**
       \brief   Describes a TEM survey.
-      \details This class aims to encapulate any type of TEM survey.
+      \details This class aims to encapulate any type of TEM survey. The
+               whole survey is forward modelled at once, the records are
+               computed in parallel.
      */
     class TEMSurvey : public LemmaObject {
 
@@ -46,30 +43,44 @@ namespace Lemma {
 
         // ====================  LIFECYCLE     =======================
 
+        /** Default locked constructor, use NewSP */
+        explicit TEMSurvey ( const ctor_key& key );
+
+        /** Locked DeSerializing constructor, use DeSerialize */
+        TEMSurvey ( const YAML::Node& node, const ctor_key& key );
+
+        /** Default destructor */
+        ~TEMSurvey ();
+
         /**
          * @copybrief LemmaObject::New()
          * @copydetails LemmaObject::New()
          */
-        static TEMSurvey* New();
+        static std::shared_ptr<TEMSurvey> NewSP();
 
         /**
-         *  @copybrief   LemmaObject::Delete()
-         *  @copydetails LemmaObject::Delete()
+         *  Uses YAML to serialize this object.
+         *  @return a YAML::Node
          */
-        void Delete();
+        YAML::Node Serialize() const;
+
+        /**
+         *   Constructs an object from a YAML::Node.
+         */
+        static std::shared_ptr<TEMSurvey> DeSerialize(const YAML::Node& node);
 
         // ====================  OPERATORS     =======================
 
         /**  @param[in] idx the index to return
          *   @return the SurveyLine with index idx
          */
-        TEMSurveyLine* operator( ) ( const int& idx ) const ;
+        std::shared_ptr<TEMSurveyLine> operator( ) ( const int& idx ) const ;
 
         /**  @param[in] iline the line index to return
          *   @param[in] irec the line index to return
          *   @return the SurveyLine with index iline, irec
          */
-        TEMSurveyLineRecord* operator( ) ( const int& iline, const int& irec ) const;
+        std::shared_ptr<TEMSurveyLineRecord> operator( ) ( const int& iline, const int& irec ) const;
 
         // ====================  OPERATIONS    =======================
 
@@ -82,56 +93,74 @@ namespace Lemma {
 
         /**
          *  Most basic form of forward modelling. Uses input model for ALL TEMSurveyLines and
-         *  TEMSurveyLineRecords (atomic). Most useful in the
-         *  case that there is only 1 line and 1 record. But even in that case it can be called directly from
-         *  the record. This method will likely be replaced  soon.
+         *  TEMSurveyLineRecords.
+         *  @param[in] model is the earth model
+         *  @param[in] additiveNoise is whether or not to add noise to the response, defaults to false
+         *  @return the modelled data
          */
-        TEMSurveyData* ForwardModel(LayeredEarthEM* model, bool additiveNoise=false);
-
-        // ====================  ACCESS        =======================
+        std::shared_ptr<TEMSurveyData> ForwardModel( std::shared_ptr<LayeredEarthEM> model,
+                bool additiveNoise=false );
 
         /**
-         *   @return pointer to requested TEMSurveyLine
+         *  Forward models the survey with a model for every record.
+         *  @param[in] models are the earth models, one per record ordered by line and
+         *             then by record along the line
+         *  @param[in] additiveNoise is whether or not to add noise to the response, defaults to false
+         *  @return the modelled data
          */
-        TEMSurveyLine*  GetLine(const unsigned int& iline);
+        std::shared_ptr<TEMSurveyData> ForwardModel( const std::vector< std::shared_ptr<LayeredEarthEM> >& models,
+                bool additiveNoise=false );
 
-        // ====================  INQUIRY       =======================
-
-        #ifdef HAVE_YAMLCPP
-        YAML::Node Serialize() const;
-        static TEMSurvey* DeSerialize(const YAML::Node& node);
-        #endif
-
-        protected:
+        /**
+         *  Forward models the survey with a model for every record, into existing data.
+         *  Every pulse sequence driving the same loop over the same model, within a
+         *  record or across records, shares one earth response, and these soundings
+         *  are computed in parallel. Models are compared by pointer.
+         *  The data is only reallocated if the layout of the survey changed, so
+         *  repeated calls, for instance by an inversion, reuse its storage.
+         *  @param[in] models are the earth models, one per record ordered by line and
+         *             then by record along the line
+         *  @param[in,out] Data receives the modelled data
+         *  @param[in] additiveNoise is whether or not to add noise to the response, defaults to false
+         */
+        void ForwardModel( const std::vector< std::shared_ptr<LayeredEarthEM> >& models,
+                std::shared_ptr<TEMSurveyData> Data, bool additiveNoise=false );
 
-        // ====================  LIFECYCLE     =======================
+        // ====================  ACCESS        =======================
 
-        /** Default protected constructor, use New */
-        TEMSurvey (const std::string& name);
+        /**
+         *   @return the requested TEMSurveyLine
+         */
+        std::shared_ptr<TEMSurveyLine> GetLine(const unsigned int& iline);
 
-        #ifdef HAVE_YAMLCPP
-        /** Default protected constructor, use New */
-        TEMSurvey (const YAML::Node& node);
-        #endif
+        // ====================  INQUIRY       =======================
 
-        /** Default protected destructor, use Delete */
-        ~TEMSurvey ();
+        /**
+         *   @return the number of lines in the survey
+         */
+        int GetNumberOfLines() const;
 
         /**
-         *  @copybrief   LemmaObject::Release()
-         *  @copydetails LemmaObject::Release()
+         *   @return the number of records in the survey, over all lines
          */
-        void Release();
+        int GetNumberOfRecords() const;
+
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual std::string GetName() const {
+            return this->CName;
+        }
 
         private:
 
+        /** ASCII string representation of the class name */
+        static constexpr auto CName = "TEMSurvey";
+
         // ====================  DATA MEMBERS  =========================
 
-        std::vector<TEMSurveyLine*>     Lines;
+        std::vector< std::shared_ptr<TEMSurveyLine> >     Lines;
 
     }; // -----  end of class  TEMSurvey  -----
 
-
 }		// -----  end of Lemma  name  -----
 
 #endif   // ----- #ifndef TEMSURVEY_INC  -----
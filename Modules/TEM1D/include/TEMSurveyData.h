@@ -21,7 +21,6 @@
 #define  TEMSURVEYDATA_INC
 
 #include "LemmaObject.h"
-#include "TEMSurveyLineData.h"
 
 namespace Lemma {
 
@@ -29,7 +28,11 @@ namespace Lemma {
       \brief    Holds data from a TEMSurvey.
       \details  Any form of TEMSurvey may be represented here. The
                 majority of the specification can be found in the associated
-                TEMSurvey. The TEMSurveyData object is intended to be lightweight.
+                TEMSurvey. The TEMSurveyData object is intended to be lightweight,
+                the data of every line, record and pulse sequence are stored
+                contiguously in a single vector, ordered by line, then record,
+                then pulse sequence. Individual series are accessed as segments
+                of that vector.
      */
     class TEMSurveyData : public LemmaObject {
 
@@ -42,35 +45,48 @@ namespace Lemma {
 
         // ====================  LIFECYCLE     =======================
 
+        /** Default locked constructor, use NewSP */
+        explicit TEMSurveyData ( const ctor_key& key );
+
+        /** Locked DeSerializing constructor, use DeSerialize */
+        TEMSurveyData ( const YAML::Node& node, const ctor_key& key );
+
+        /** Default destructor */
+        ~TEMSurveyData ();
+
         /**
          * @copybrief LemmaObject::New()
          * @copydetails LemmaObject::New()
          */
-        static TEMSurveyData* New();
+        static std::shared_ptr<TEMSurveyData> NewSP();
+
+        /**
+         *   Constructs an object from a YAML::Node.
+         */
+        static std::shared_ptr<TEMSurveyData> DeSerialize(const YAML::Node& node);
 
         /**
-         *  @return a deep copy of this, this is acomplished through Serialize
-         *          and DeSerialize methods.
+         *  @return a deep copy of this
          */
-        TEMSurveyData* Clone();
+        std::shared_ptr<TEMSurveyData> Clone() const;
 
         /**
-         *  @copybrief   LemmaObject::Delete()
-         *  @copydetails LemmaObject::Delete()
+         *  Uses YAML to serialize this object.
+         *  @return a YAML::Node
          */
-        void Delete();
+        YAML::Node Serialize() const;
 
         // ====================  OPERATORS     =======================
 
-        /** Surveys can be added or subtracted from each other, throws a
-         *  pointer that will need to be managed (Deleted)
+        /** Surveys can be added or subtracted from each other, the result is
+         *  a new object
          */
-        TEMSurveyData* operator+(const TEMSurveyData& Survey);
+        std::shared_ptr<TEMSurveyData> operator+(const TEMSurveyData& Survey) const;
 
-        /** Surveys can be added or subtracted from each other, throws a
-         *  pointer that will need to be managed (Deleted).
+        /** Surveys can be added or subtracted from each other, the result is
+         *  a new object
          */
-        TEMSurveyData* operator-(const TEMSurveyData& Survey);
+        std::shared_ptr<TEMSurveyData> operator-(const TEMSurveyData& Survey) const;
 
         /** Surveys can be added or subtracted from each other
          */
@@ -80,81 +96,110 @@ namespace Lemma {
          */
         void operator-=(const TEMSurveyData& Survey);
 
+        // ====================  ACCESS        =======================
 
-        /**  @param[in] idx the index to return
-         *   @return the SurveyLine with index idx
+        /**
+         *  @param[in] iline is the line index
+         *  @param[in] irec is the record index along the line
+         *  @param[in] iseq is the pulse sequence index of the record
+         *  @return the data of one pulse sequence, a segment of GetData()
          */
-        TEMSurveyLineData* operator( ) ( const int& idx ) const;
+        VectorXr::SegmentReturnType GetSeries( const int& iline, const int& irec, const int& iseq );
+
+        /** @copydoc GetSeries */
+        VectorXr::ConstSegmentReturnType GetSeries( const int& iline, const int& irec, const int& iseq ) const;
 
-        /**  @param[in] iline the line index to return
-         *   @param[in] irec the line index to return
-         *   @return the SurveyLine with index iline, irec
+        /**
+         *  @return the gate centres of one pulse sequence, aligned with GetSeries
          */
-        TEMSurveyLineRecordData* operator( ) ( const int& iline, const int& irec ) const;
+        VectorXr::ConstSegmentReturnType GetSeriesGateCentres( const int& iline, const int& irec,
+                const int& iseq ) const;
 
+        /**
+         *  @param[in] iline is the line index
+         *  @param[in] irec is the record index along the line
+         *  @return the data of every pulse sequence of a record, a segment of GetData()
+         */
+        VectorXr::SegmentReturnType GetRecord( const int& iline, const int& irec );
 
-        // ====================  OPERATIONS    =======================
+        /** @copydoc GetRecord */
+        VectorXr::ConstSegmentReturnType GetRecord( const int& iline, const int& irec ) const;
 
-        /** Sets the number of lines
+        /**
+         *  @return the gate centres of a record, aligned with GetRecord
          */
-        void SetNumberOfLines( const int& nlines );
-
-        // ====================  ACCESS        =======================
+        VectorXr::ConstSegmentReturnType GetRecordGateCentres( const int& iline, const int& irec ) const;
 
-        /** @return the number of lines in the data
+        /**
+         *  @return all of the data, ordered by line, record and pulse sequence
          */
-        int GetNumberOfLines() const;
+        const VectorXr& GetData() const;
 
         /**
-         *   @return pointer to line
+         *  @return all of the gate centres, aligned with GetData
          */
-        TEMSurveyLineData* GetLine(const int& iline) const;
+        const VectorXr& GetGateCentres() const;
 
         // ====================  INQUIRY       =======================
 
-#ifdef HAVE_YAMLCPP
-        /**
-         *  Uses YAML to serialize this object.
-         *  @return a YAML::Node
+        /** @return the number of lines in the data
          */
-        YAML::Node Serialize() const;
+        int GetNumberOfLines() const;
 
-        /**
-         *   Constructs an object from a YAML::Node.
+        /** @return the number of records of line iline
          */
-        static TEMSurveyData* DeSerialize(const YAML::Node& node);
-#endif
+        int GetNumberOfRecords( const int& iline ) const;
 
-        protected:
-
-        // ====================  LIFECYCLE     =======================
+        /** @return the number of pulse sequences of record irec of line iline
+         */
+        int GetNumberOfSeries( const int& iline, const int& irec ) const;
 
-        /** Default protected constructor, use New */
-        TEMSurveyData (const std::string& name);
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual std::string GetName() const {
+            return this->CName;
+        }
 
-#ifdef HAVE_YAMLCPP
-        /** Protected DeDerializing constructor, use factory DeSerialize  method*/
-        TEMSurveyData (const YAML::Node& node);
-#endif
+        protected:
 
-        /** Default protected destructor, use Delete */
-        ~TEMSurveyData ();
+        // ====================  OPERATIONS    =======================
 
         /**
-         *  @copybrief   LemmaObject::Release()
-         *  @copydetails LemmaObject::Release()
+         *  Sets the layout of the data, and zeros it. Nothing is reallocated if the
+         *  layout is unchanged.
+         *  @param[in] nrec is the number of records of each line
+         *  @param[in] nseq is the number of pulse sequences of each record, over all lines
+         *  @param[in] centres are the gate centres of each pulse sequence, over all records
          */
-        void Release();
+        void SetLayout( const std::vector<int>& nrec, const std::vector<int>& nseq,
+                const std::vector<VectorXr>& centres );
+
+        /** @return the index of record irec of line iline over all lines */
+        int RecordIndex( const int& iline, const int& irec ) const;
+
+        /** @return the index of a pulse sequence over all records */
+        int SeriesIndex( const int& iline, const int& irec, const int& iseq ) const;
 
         private:
 
+        /** ASCII string representation of the class name */
+        static constexpr auto CName = "TEMSurveyData";
+
         // ====================  DATA MEMBERS  =========================
 
-        std::vector<TEMSurveyLineData*>  LineData;
+        /** First record of each line, and one past the last */
+        std::vector<int>    LineOffsets;
 
-    }; // -----  end of class  TEMSurveyData  -----
+        /** First pulse sequence of each record, and one past the last */
+        std::vector<int>    RecordOffsets;
+
+        /** First datum of each pulse sequence, and one past the last */
+        std::vector<int>    SeriesOffsets;
 
+        VectorXr            Data;
 
+        VectorXr            GateCentres;
+
+    }; // -----  end of class  TEMSurveyData  -----
 
 }		// -----  end of Lemma  name  -----
 
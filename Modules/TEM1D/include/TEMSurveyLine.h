@@ -22,15 +22,13 @@
 
 #include "LemmaObject.h"
 #include "TEMSurveyLineRecord.h"
-#include "TEMSurveyLineData.h"
 
 namespace Lemma {
 
     /**
       \brief    Represents a TEM survey line.
-      \details  This class is managed by TEMSurvey. You cannot create a TEMSurvey line directly
-                this should be done through a TEMSurvey.
-                @todo neeed to impliment a BaseClass besides LemmaObject without pure virtual Delete.
+      \details  Lines are normally created through a TEMSurvey, which also
+                forward models them.
      */
     class TEMSurveyLine : public LemmaObject {
 
@@ -43,27 +41,21 @@ namespace Lemma {
 
         // ====================  LIFECYCLE     =======================
 
+        /** Default locked constructor, use NewSP */
+        explicit TEMSurveyLine ( const ctor_key& key );
 
+        /** Locked DeSerializing constructor, use DeSerialize */
+        TEMSurveyLine ( const YAML::Node& node, const ctor_key& key );
 
-        // ====================  OPERATORS     =======================
-
-        // ====================  OPERATIONS    =======================
-
-        // ====================  ACCESS        =======================
-
-        /**
-            @return returns pointer to a specific record along the line
-         */
-        TEMSurveyLineRecord*  GetRecord(const unsigned int& irec);
+        /** Default destructor */
+        ~TEMSurveyLine ();
 
         /**
-            @param[in] nrec is the number of records along the line
+         * @copybrief LemmaObject::New()
+         * @copydetails LemmaObject::New()
          */
-        void SetNumberOfRecords( const int& nrec );
+        static std::shared_ptr<TEMSurveyLine> NewSP();
 
-        // ====================  INQUIRY       =======================
-
-#ifdef HAVE_YAMLCPP
         /**
          *  Uses YAML to serialize this object.
          *  @return a YAML::Node
@@ -73,42 +65,44 @@ namespace Lemma {
         /**
          *   Constructs an object from a YAML::Node.
          */
-        static TEMSurveyLine* DeSerialize(const YAML::Node& node);
-#endif
+        static std::shared_ptr<TEMSurveyLine> DeSerialize(const YAML::Node& node);
 
-        protected:
+        // ====================  OPERATORS     =======================
 
-        TEMSurveyLineData* ForwardModel(LayeredEarthEM* model, bool additiveNoise = false);
+        // ====================  OPERATIONS    =======================
 
-        // ====================  LIFECYCLE     =======================
+        // ====================  ACCESS        =======================
 
-        /** Default protected constructor, use New */
-        TEMSurveyLine (const std::string& name);
+        /**
+            @return a specific record along the line
+         */
+        std::shared_ptr<TEMSurveyLineRecord> GetRecord(const unsigned int& irec);
 
-#ifdef HAVE_YAMLCPP
-        /** Protected DeDerializing constructor, use factory DeSerialize  method*/
-        TEMSurveyLine (const YAML::Node& node);
-#endif
+        /**
+            @param[in] nrec is the number of records along the line
+         */
+        void SetNumberOfRecords( const int& nrec );
 
-        /** Default protected destructor, use Delete */
-        ~TEMSurveyLine ();
+        // ====================  INQUIRY       =======================
 
         /**
-         *  @copybrief   LemmaObject::Release()
-         *  @copydetails LemmaObject::Release()
+            @return the number of records along the line
          */
-        void Release();
+        int GetNumberOfRecords() const;
+
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual std::string GetName() const {
+            return this->CName;
+        }
 
         private:
 
-        /**
-         *   Delete should not be called...
-         */
-        void Delete();
+        /** ASCII string representation of the class name */
+        static constexpr auto CName = "TEMSurveyLine";
 
         // ====================  DATA MEMBERS  =========================
 
-        std::vector<TEMSurveyLineRecord*>     Records;
+        std::vector< std::shared_ptr<TEMSurveyLineRecord> >     Records;
 
     }; // -----  end of class  TEMSurveyLine  -----
 
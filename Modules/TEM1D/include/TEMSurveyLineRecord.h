@@ -23,8 +23,7 @@
 #include "LemmaObject.h"
 #include "TEMReceiver.h"
 #include "TEMTransmitter.h"
-#include "TEMSurveyLineRecordData.h"
-#include "instrumenttem.h"
+#include "InstrumentTEM.h"
 
 namespace Lemma {
 
@@ -39,99 +38,94 @@ namespace Lemma {
         friend std::ostream &operator<<(std::ostream &stream,
                 const TEMSurveyLineRecord &ob);
 
-        friend class TEMSurveyLine;
+        friend class TEMSurvey;
 
         public:
 
         // ====================  LIFECYCLE     =======================
 
-        // ====================  OPERATORS     =======================
+        /** Default locked constructor, use NewSP */
+        explicit TEMSurveyLineRecord ( const ctor_key& key );
 
-        // ====================  OPERATIONS    =======================
+        /** Locked DeSerializing constructor, use DeSerialize */
+        TEMSurveyLineRecord ( const YAML::Node& node, const ctor_key& key );
+
+        /** Default destructor */
+        ~TEMSurveyLineRecord ();
 
         /**
-         *  Perfoms forward modelling given model.
-         *  @param[in] model is the earth model responsible for the response
-         *  @param[in] additiveNoise is whether or not to add noise to the response, defaults to false
-         *  @return the modelled data.
+         * @copybrief LemmaObject::New()
+         * @copydetails LemmaObject::New()
          */
-        TEMSurveyLineRecordData* ForwardModel(LayeredEarthEM* model, bool additiveNoise=false);
+        static std::shared_ptr<TEMSurveyLineRecord> NewSP();
 
         /**
-         *  @param[in] nseq is the number of pulse sequences
+         *  Uses YAML to serialize this object.
+         *  @return a YAML::Node
          */
-        void SetNumberOfPulseSequences( const int& nseq );
+        YAML::Node Serialize() const;
 
         /**
-         *  @return the number of pulse sequences
+         *   Constructs an object from a YAML::Node.
          */
-        int GetNumberOfPulseSequences();
+        static std::shared_ptr<TEMSurveyLineRecord> DeSerialize(const YAML::Node& node);
+
+        // ====================  OPERATORS     =======================
+
+        // ====================  OPERATIONS    =======================
 
         /**
-         *  Sets the PulseSequence and Receiver pair used to model a *SINGLE* response curve.
-         *  @param[in] Seq is the Pulse Sequence
-         *  @param[in] Rx is the receiver for that pulse sequence
+         *  @param[in] nseq is the number of pulse sequences
          */
-        void SetTransmitterReceiverPair( const int& ii, TEMTransmitter* Seq, TEMReceiver* Rx );
-
-        // ====================  ACCESS        =======================
+        void SetNumberOfPulseSequences( const int& nseq );
 
         /**
-         *  @return a pointer to the specified receiver
+         *  Sets the PulseSequence and Receiver pair used to model a *SINGLE* response curve.
+         *  Pulse sequences driving the same loop, for instance the low and high moments of
+         *  a dual moment system, share a single calculation of the earth response, also
+         *  across records with the same model.
+         *  @param[in] ii is the pulse sequence index
+         *  @param[in] Tx is the Pulse Sequence
+         *  @param[in] Rx is the receiver for that pulse sequence
          */
-        TEMReceiver*   GetReceiver(const int& irec);
+        void SetTransmitterReceiverPair( const int& ii, std::shared_ptr<TEMTransmitter> Tx,
+                std::shared_ptr<TEMReceiver> Rx );
 
-        // ====================  INQUIRY       =======================
+        // ====================  ACCESS        =======================
 
-#ifdef HAVE_YAMLCPP
         /**
-         *  Uses YAML to serialize this object.
-         *  @return a YAML::Node
+         *  @return the specified receiver
          */
-        YAML::Node Serialize() const;
+        std::shared_ptr<TEMReceiver> GetReceiver(const int& irec);
 
         /**
-         *   Constructs an object from a YAML::Node.
+         *  @return the specified transmitter
          */
-        static TEMSurveyLineRecord* DeSerialize(const YAML::Node& node);
-#endif
-
-        protected:
-
-
+        std::shared_ptr<TEMTransmitter> GetTransmitter(const int& itx);
 
-        // ====================  LIFECYCLE     =======================
-
-        /** Default protected constructor, use New */
-        TEMSurveyLineRecord (const std::string& name);
-
-#ifdef HAVE_YAMLCPP
-        /** Protected DeDerializing constructor, use factory DeSerialize  method*/
-        TEMSurveyLineRecord (const YAML::Node& node);
-#endif
-
-        /** Default protected destructor, use Delete */
-        ~TEMSurveyLineRecord ();
+        // ====================  INQUIRY       =======================
 
         /**
-         *  @copybrief   LemmaObject::Release()
-         *  @copydetails LemmaObject::Release()
+         *  @return the number of pulse sequences
          */
-        void Release();
+        int GetNumberOfPulseSequences() const;
+
+        /** Returns the name of the underlying class, similiar to Python's type */
+        virtual std::string GetName() const {
+            return this->CName;
+        }
 
         private:
 
-        /**
-         *   Delete is private, this class is managed through TEMSurvey
-         */
-        void Delete();
+        /** ASCII string representation of the class name */
+        static constexpr auto CName = "TEMSurveyLineRecord";
 
         // ====================  DATA MEMBERS  =========================
 
         int     numberOfPulseSequences;
 
-        std::vector<TEMTransmitter*>    Transmitters;
-        std::vector<TEMReceiver*>       Receivers;
+        std::vector< std::shared_ptr<TEMTransmitter> >    Transmitters;
+        std::vector< std::shared_ptr<TEMReceiver> >       Receivers;
 
     }; // -----  end of class  TEMSurveyLineRecord  -----
 
@@ -19,6 +19,7 @@
 #define  TEMTRANSMITTER_INC
 
 #include "PolygonalWireAntenna.h"
+#include "CubicSplineInterpolator.h"
 
 namespace Lemma {
 
@@ -63,6 +64,16 @@ class TEMTransmitter : public PolygonalWireAntenna {
 
     // ====================  OPERATIONS    =======================
 
+    /** Convolves the transmitter waveform with an impulse response. The waveform
+     *  is piecewise linear and the response a cubic spline, so each ramp contributes
+     *  the exact integral of the spline and each step a spline value. All times are
+     *  evaluated together.
+     *  @param[in] Spline is the impulse response, with abscissa in seconds
+     *  @param[in] t are the evaluation times, in seconds on the waveform time axis
+     *  @return the convolved response at t
+     */
+    VectorXr ConvolveWaveform( std::shared_ptr<CubicSplineInterpolator> Spline, const VectorXr& t ) const;
+
     // ====================  ACCESS        =======================
 
     /** Sets the repetition frequency
@@ -14,436 +14,327 @@
 
 namespace Lemma {
 
+    // ====================  FRIEND METHODS  =====================
+
 	std::ostream &operator<<(std::ostream &stream,
 		const InstrumentTem &ob) {
-	stream << *(LemmaObject*)(&ob);
-	return stream;
-	}
-
-	// =======================  Lifecycle  ==================================
-
-	InstrumentTem::InstrumentTem(const std::string &name) : Instrument(name),
-		Antenna(NULL), Receiver(NULL), EarthMod(NULL), Dipole(NULL), bipolarWaveform(true),
-        NPreviousPulse(0), RefTime(0.0), PulseT(.06), TxFreq(0.30), RType(INDUCTIVE) {
-	}
-
-	InstrumentTem::~InstrumentTem() {
-		if (NumberOfReferences != 0) {
-			throw DeleteObjectWithReferences(this);
-		}
-
-        if (this->Antenna != NULL) {
-			this->Antenna->DetachFrom(this);
-		}
-
-		if (this->Dipole != NULL) {
-			this->Dipole->DetachFrom(this);
-		}
-
-        if (this->EarthMod != NULL) {
-			this->EarthMod->DetachFrom(this);
-		}
-
-        if (this->Receiver != NULL) {
-			this->Receiver->DetachFrom(this);
-		}
-
-	}
-
-	InstrumentTem* InstrumentTem::New() {
-		InstrumentTem* Obj = new InstrumentTem("InstrumentTem");
-		Obj->AttachTo(Obj);
-		return Obj;
-	}
-
-	void InstrumentTem::Delete() {
-		this->DetachFrom(this);
-	}
-
-	void InstrumentTem::Release() {
-		delete this;
-	}
-
-	// =======================  Operations  =================================
-	void InstrumentTem::MakeDirectCalculation( const HANKELTRANSFORMTYPE& hType) {
-
-		//int temp;
-		int NumTimes;
-		Real answer;
-		EMEarth1D *EMEarthLocal=EMEarth1D::New();
-		EMEarthLocal->AttachLayeredEarthEM(this->EarthMod);
-
-		//DigitalFilterCosTrans *DFIntegrate=DigitalFilterCosTrans::New();
-		DigitalFilterSinTrans *DFIntegrate=DigitalFilterSinTrans::New();
-
-		TemIntegrationKernel *TEMIntKern=TemIntegrationKernel::New();
-		TEMIntKern->SetEMEarth1D(EMEarthLocal);
-		//TEMIntKern->SetTransmitter(this->Antenna);
-		TEMIntKern->SetReceiver(this->Receiver);
-		DFIntegrate->AttachKernel(TEMIntKern);
-
-		if (this->Dipole != NULL) {  //AND this->Antenna == NULL
-			EMEarthLocal->AttachDipoleSource(this->Dipole);
-			TEMIntKern->SetDipole(this->Dipole);
-		}
-		if (this->Antenna != NULL) { //AND this->Dipole == NULL
-			EMEarthLocal->AttachWireAntenna(this->Antenna);
-			TEMIntKern->SetTransmitter(this->Antenna);
-		}
-		EMEarthLocal->SetFieldsToCalculate(H);
-		    //EMEarthLocal->SetHankelTransformMethod(DIGITALFILTERING);
-		    //EMEarthLocal->SetHankelTransformMethod(FHTKEY201);
-		    EMEarthLocal->SetHankelTransformMethod(hType);
-		    //EMEarthLocal->SetHankelTransformMethod(GAUSSIANQUADRATURE);
-
-		//EMEarthLocal->AttachReceiverPoints(this->Receiver);
-		// For testing with one time only
-		//DFIntegrate->Compute(1,1,1e-16);
-		//std::cout<<DFIntegrate->GetAnswer()<<std::endl;
-		//
-		NumTimes = this->TimeGates.size();
-		//Testing
-		//std::cout << "NumTimes: " << NumTimes << std::endl;
-		this->ModelledData.resize(NumTimes,2);
-		for (int ii=0;ii<NumTimes;ii++) {
-			//TESTING!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-			//RELAXING THE VALUE!
-			DFIntegrate->Compute(this->TimeGates(ii), 1, 1e-7);
-			//Testing
-			//std::cout << "DFIntegrate done computing" << std::endl;
-			answer = DFIntegrate->GetAnswer()(0);
-			answer = (2./PI)*answer;
-			this->ModelledData(ii,0) = this->TimeGates(ii);
-			this->ModelledData(ii,1) = answer;
-			//std::cout << "   " << TimeGates(ii) << "  " <<
-			//	answer << std::endl;
-			//std::cout << "   " << this->ModelledData(ii,0) << "  " <<
-			//	this->ModelledData(ii,1) << std::endl;
-			// Call cosine transform which calls argument
-		}
-		//
-		TEMIntKern->Delete();
-		EMEarthLocal->Delete();
-		DFIntegrate->Delete();
-
-	}
-
-    void InstrumentTem::MakeLaggedCalculation(const HANKELTRANSFORMTYPE& hType) {
-
-        EMEarth1D *EMEarthLocal=EMEarth1D::New();
-		    EMEarthLocal->AttachLayeredEarthEM(this->EarthMod);
-		    EMEarthLocal->SetFieldsToCalculate(H);
-		    EMEarthLocal->SetHankelTransformMethod(hType);
-            EMEarthLocal->AttachReceiverPoints(this->Receiver);
-
-		TemIntegrationKernel *TEMIntKern=TemIntegrationKernel::New();
-
-		    TEMIntKern->SetReceiver(this->Receiver);
-		    TEMIntKern->SetEMEarth1D(EMEarthLocal);
-
-
-		if (this->Dipole != NULL) {  //AND this->Antenna == NULL
-			EMEarthLocal->AttachDipoleSource(this->Dipole);
-			TEMIntKern->SetDipole(this->Dipole);
-            Dipole->SetNumberOfFrequencies(1);
-		}
-		if (this->Antenna != NULL) { //AND this->Dipole == NULL
-			EMEarthLocal->AttachWireAntenna(this->Antenna);
-            Antenna->SetCurrent(1);
-			TEMIntKern->SetTransmitter(this->Antenna);
-            Antenna->SetNumberOfFrequencies(1);
-		}
-
-
-        // TODO IMPORTANT!!
-        // Compute number of lagged convolutions to do, TODO, need to make sure we do these
-        // TO THE LATEST time needed for multiple pulse subtraction!!!
-        int ilag = 1;
-        Real sub = 2.1*PulseT + 2.*NPreviousPulse*PulseT;
-        if (!bipolarWaveform) sub = NPreviousPulse*PulseT;
-
-        //TimeGates.array() += RefTime;
-        //RefTime = 0;
-
-        // This is a critical line, for reasons I don't understand, it's important to calculate past the
-        // theoretical GateWidths(0)/2.
-        while ( (TimeGates.tail(1)(0)+sub)*std::pow(1./exp(.1), ilag-1) > TimeGates(0)-GateWidths(0) ) ++ ilag;
-
-		//DigitalFilterSinTrans *DFIntegrate=DigitalFilterSinTrans::New(); // use with step response kernel
-		DigitalFilterCosTrans *DFIntegrate=DigitalFilterCosTrans::New();   // use with impulse response kernel
-		    DFIntegrate->AttachKernel(TEMIntKern);
-            DFIntegrate->SetNumConv(ilag);
-		    DFIntegrate->Compute( this->TimeGates.tail(1)(0)+sub, 1, 1e-7 ); // rho ntol, tol=1e-7 to 1e-13
-
-        CubicSplineInterpolator *Spline = CubicSplineInterpolator::New();
-            //Spline->SetKnots( DFIntegrate->GetAbscissaArguments().array(), (2./PI) * DFIntegrate->GetAnswer().col(0).array() );
-            Spline->SetKnots( DFIntegrate->GetAbscissaArguments().array(), (.25/PI) * DFIntegrate->GetAnswer().col(0).array() );
-
-
-		this->ModelledData.resize(TimeGates.size(), 2);
-            this->ModelledData.col(0) = TimeGates;
-            this->ModelledData.col(1).setZero();
-
-        //  This is non-extrapolated times and values
-        //this->ModelledData.resize(ilag, 2);
-        //    this->ModelledData.col(0) = DFIntegrate->GetAbscissaArguments(); // this->TimeGates(ii);
-		//	this->ModelledData.col(1) = (2./PI)*DFIntegrate->GetAnswer();
-        //std::cout <<  (2./PI)*DFIntegrate->GetAnswer().transpose()  << std::endl;
-
-        // Take into account receiver gate integration and tx waveform
-        FoldAndConvolve(Spline);
-
-        // Direct caclulation, step response to use need re reset temintegrationkernel back to step!
-		//	this->ModelledData.col(1) = (2./PI)*Spline->InterpolateOrderedSet( TimeGates );
-
-        Spline->Delete();
-	    TEMIntKern->Delete();
-		EMEarthLocal->Delete();
-		DFIntegrate->Delete();
-
+        stream << ob.Serialize()  << "\n";
+        return stream;
 	}
 
-	// =======================  Access  =====================================
-
-	void InstrumentTem::SetPulse( const VectorXr& Amp, const VectorXr& times, bool bipolar ) {
-
-        bipolarWaveform = bipolar;
-        assert(Amp.size() == times.size());
-
-        TxAmp = Amp;
-        TxAbs = times;
-
-        TxDiff = VectorXr::Zero(TxAmp.size());
-        TxDelta = VectorXr::Zero(TxAmp.size());
-
-        for (int ip=1; ip<TxAmp.size(); ++ ip) {
-            TxDiff(ip)  = (TxAmp(ip-1)-TxAmp(ip  )) /
-                          (TxAbs(ip  )-TxAbs(ip-1)) ;
-            TxDelta(ip) = (TxAmp(ip-1)-TxAmp(ip  )) ;
+    // ====================  WORKSPACE     =======================
+
+    /** Objects used to compute a sounding. They are kept by a thread and reused for
+     *  every sounding it computes.
+     */
+    struct InstrumentTem::Workspace {
+
+        std::shared_ptr<EMEarth1D>                  Earth;
+        std::shared_ptr<TEMIntegrationKernel>       Kernel;
+        std::shared_ptr<FastCosTransformAnderson>   Cosine;
+        std::shared_ptr<CubicSplineInterpolator>    Spline;
+        std::shared_ptr<FieldPoints>                Points;
+        std::vector<FIELDCOMPONENT>                 Components;
+
+        Workspace() :
+            Earth( EMEarth1D::NewSP() ),
+            Kernel( TEMIntegrationKernel::NewSP() ),
+            Cosine( FastCosTransformAnderson::NewSP() ),
+            Spline( CubicSplineInterpolator::NewSP() ),
+            Points( FieldPoints::NewSP() ) {
+            Earth->SetFieldsToCalculate(H);
+            Earth->AttachFieldPoints(Points);
+            Cosine->AttachKernel(Kernel);
         }
+    };
 
-        /*
-        std::cout << "diff "  << TxDiff.transpose() << std::endl;
-        std::cout << "delta "  << TxDelta.transpose() << std::endl;
-        std::cout << "amp "  << TxAmp.transpose() << std::endl;
-        std::cout << "abs "  << TxAbs.transpose() << std::endl;
-        */
-	}
-
-	void InstrumentTem::EMEarthModel(LayeredEarthEM* Earth) {
-		if (this->EarthMod != NULL) {
-			this->EarthMod->DetachFrom(this);
-		}
-		//std::cout << "InstrumentTem: EarthMod null test" << std::endl;
-		Earth->AttachTo(this);
-		//std::cout << "InstrumentTem: EarthMod attached" << std::endl;
-		this->EarthMod = Earth;
-		//std::cout << "InstrumentTem: EMEarthModel Attached" << std::endl;
-
-	}
-
-	void InstrumentTem::SetTransmitLoop(WireAntenna *antennae) {
-		if (this->Antenna != NULL) {
-			this->Antenna->DetachFrom(this);
-		}
-		antennae->AttachTo(this);
-		this->Antenna = antennae;
-		if (this->Dipole != NULL) {
-			this->Dipole->DetachFrom(this);
-		}
-		//std::cout << "InstrumentTem: TransmitLoop Attached" << std::endl;
+	// ====================  LIFECYCLE     =======================
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  InstrumentTem
+    // Description:  constructor (locked)
+    //--------------------------------------------------------------------------------------
+	InstrumentTem::InstrumentTem( const ctor_key& key ) : LemmaObject(key),
+        HankelType(ANDERSON801), Tolerance(1e-7), LineIntegral(false) {
 	}
 
-	void InstrumentTem::SetDipoleSource(DipoleSource* dipolesource) {
-		if (this->Dipole != NULL) {
-			this->Dipole->DetachFrom(this);
-		}
-		dipolesource->AttachTo(this);
-		this->Dipole = dipolesource;
-		if (this->Antenna != NULL) {
-			this->Antenna->DetachFrom(this);
-		}
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  InstrumentTem
+    // Description:  DeSerializing constructor (locked)
+    //--------------------------------------------------------------------------------------
+	InstrumentTem::InstrumentTem( const YAML::Node& node, const ctor_key& key ) : LemmaObject(node, key) {
+        HankelType = string2Enum<HANKELTRANSFORMTYPE>( node["HankelType"].as<std::string>() );
+        Tolerance = node["Tolerance"].as<Real>();
+        LineIntegral = node["LineIntegral"].as<bool>();
 	}
 
-	void InstrumentTem::SetReceiver(ReceiverPoints* Receivers) {
-		if (this->Receiver != NULL) {
-			this->Receiver->DetachFrom(this);
-		}
-		Receivers->AttachTo(this);
-		this->Receiver = Receivers;
-		//std::cout << "InstrumentTem: Receivers Attached" << std::endl;
-
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  ~InstrumentTem
+    // Description:  destructor
+    //--------------------------------------------------------------------------------------
+	InstrumentTem::~InstrumentTem() {
 	}
 
-	void InstrumentTem::SetTimes(const VectorXr &times) {
-		this->TimeGates = times;
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  NewSP
+    //--------------------------------------------------------------------------------------
+	std::shared_ptr<InstrumentTem> InstrumentTem::NewSP() {
+		return std::make_shared<InstrumentTem>( ctor_key() );
 	}
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  InstrumentTem
-    //      Method:  SetReceiverType
+    //      Method:  Serialize
     //--------------------------------------------------------------------------------------
-    void InstrumentTem::SetReceiverType ( const ReceiverType& rt ) {
-        RType = rt;
-        return ;
-    }		// -----  end of method InstrumentTem::SetReceiverType  -----
-
+    YAML::Node InstrumentTem::Serialize (  ) const {
+        YAML::Node node = LemmaObject::Serialize();
+        node.SetTag( GetName() );
+        node["HankelType"] = enum2String(HankelType);
+        node["Tolerance"] = Tolerance;
+        node["LineIntegral"] = LineIntegral;
+        return node;
+    }		// -----  end of method InstrumentTem::Serialize  -----
 
     //--------------------------------------------------------------------------------------
-    //       Class:  InstrumentTEM
-    //      Method:  SetTimeGates
+    //       Class:  InstrumentTem
+    //      Method:  DeSerialize
     //--------------------------------------------------------------------------------------
-    void InstrumentTem::SetTimeGates ( const VectorXr &centres, const VectorXr& widths  ) {
-        assert (centres.size() == widths.size());
-        TimeGates = centres;
-        GateWidths = widths;
-        return ;
-    }		// -----  end of method InstrumentTEM::SetTimeGates  -----
-
-
-
+    std::shared_ptr<InstrumentTem> InstrumentTem::DeSerialize ( const YAML::Node& node ) {
+        if (node.Tag() != "InstrumentTem") {
+            throw  DeSerializeTypeMismatch( "InstrumentTem", node.Tag());
+        }
+        return std::make_shared<InstrumentTem> ( node, ctor_key() );
+    }		// -----  end of method InstrumentTem::DeSerialize  -----
 
-	int InstrumentTem::GetNumberOfTimes() {
+	// ====================  OPERATIONS    =======================
 
-		return this->TimeGates.size();
-	}
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  MakeLaggedCalculation
+    //--------------------------------------------------------------------------------------
+    void InstrumentTem::MakeLaggedCalculation( ) {
+        Workspace ws;
+        MakeLaggedCalculation( ws );
+    }		// -----  end of method InstrumentTem::MakeLaggedCalculation  -----
 
-	MatrixXr InstrumentTem::GetMeasurements() {
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  MakeLaggedCalculations
+    //--------------------------------------------------------------------------------------
+    void InstrumentTem::MakeLaggedCalculations( const std::vector< std::shared_ptr<InstrumentTem> >& Soundings ) {
 
-		return this->ModelledData;
-	}
+        // Incomplete soundings are reported before any is computed
+        for (const auto& Sounding : Soundings) {
+            Sounding->CheckSetup();
+        }
 
+        // Exceptions may not leave the parallel region, the first is rethrown after it
+        std::exception_ptr Error = nullptr;
+
+        const int ns = static_cast<int>(Soundings.size());
+        #ifdef LEMMAUSEOMP
+        #pragma omp parallel
+        #endif
+        {
+            // soundings are the parallel work, the frequency domain calculations of a
+            // sounding stay on its thread
+            Workspace ws;
+                ws.Earth->SetNumberOfThreads(1);
+            #ifdef LEMMAUSEOMP
+            #pragma omp for schedule(dynamic, 1)
+            #endif
+            for (int is=0; is<ns; ++is) {
+                try {
+                    Soundings[is]->MakeLaggedCalculation( ws );
+                } catch (...) {
+                    #ifdef LEMMAUSEOMP
+                    #pragma omp critical (InstrumentTemError)
+                    #endif
+                    if (Error == nullptr) Error = std::current_exception();
+                }
+            }
+        }
 
+        if (Error != nullptr) {
+            std::rethrow_exception(Error);
+        }
+    }		// -----  end of method InstrumentTem::MakeLaggedCalculations  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  InstrumentTem
-    //      Method:  SetReferenceTime
+    //      Method:  MakeLaggedCalculation
     //--------------------------------------------------------------------------------------
-    void InstrumentTem::SetReferenceTime ( const Real& rtime ) {
-        RefTime = rtime;
-        return ;
-    }		// -----  end of method InstrumentTem::SetReferenceTime  -----
-
+    void InstrumentTem::MakeLaggedCalculation( Workspace& ws ) {
+
+        CheckSetup();
+
+        // Frequencies are set on copies, so that soundings may share a transmitter or model.
+        // The waveform carries the current.
+        auto Tx = Transmitter->Clone();
+            Tx->SetCurrent(1);
+            Tx->SetNumberOfFrequencies(1);
+
+        // All receivers are evaluated together. Receivers at the same location recording
+        // the same component, such as the gates of several pulse sequences, share a point.
+        const int nrx = static_cast<int>(Receivers.size());
+        std::vector<int> Point(nrx);
+        int npoint = 0;
+        for (int irx=0; irx<nrx; ++irx) {
+            int ir = 0;
+            while ( ir < irx && !(Receivers[ir]->GetComponent() == Receivers[irx]->GetComponent() &&
+                    Receivers[ir]->GetLocation(0) == Receivers[irx]->GetLocation(0)) ) ++ir;
+            Point[irx] = (ir < irx) ? Point[ir] : npoint++;
+        }
+        ws.Points->SetNumberOfPoints(npoint);
+        ws.Components.resize(npoint);
+        for (int irx=0; irx<nrx; ++irx) {
+            ws.Points->SetLocation( Point[irx], Receivers[irx]->GetLocation(0) );
+            ws.Components[Point[irx]] = Receivers[irx]->GetComponent();
+        }
 
+        ws.Earth->AttachWireAntenna(Tx);
+        ws.Earth->AttachLayeredEarthEM(EarthMod->Clone());
+        ws.Earth->SetHankelTransformMethod(HankelType);
+        ws.Earth->SetLineIntegralEvaluation(LineIntegral);
+        ws.Kernel->SetEMEarth1D(ws.Earth);
+        ws.Kernel->SetTransmitter(Tx);
+        ws.Kernel->SetReceivers(ws.Points, ws.Components);
+
+        // Range of times the convolution needs the step response at, from the earliest gate edge
+        // after the end of the waveform to the latest gate edge after its start
+        Real tmin = std::numeric_limits<Real>::max();
+        Real tmax = 0;
+        for (int irx=0; irx<nrx; ++irx) {
+            const VectorXr wfmTimes = GetWaveform(irx)->GetWfmTimes();
+            const VectorXr centres = Receivers[irx]->GetWindowCentres();
+            const VectorXr widths = Receivers[irx]->GetWindowWidths();
+            const Real ref = Receivers[irx]->GetReferenceTime();
+            tmin = std::min(tmin, ref + (centres - widths/2.).minCoeff() - wfmTimes.tail(1)(0));
+            tmax = std::max(tmax, ref + (centres + widths/2.).maxCoeff() - wfmTimes(0));
+        }
+        // the response is not needed closer to the waveform than this
+        tmin = std::max(tmin, static_cast<Real>(1e-7));
+
+        // Lagged arguments are spaced by exp(.1), and are snapped to the fixed lattice exp(.1*k)
+        // so that soundings sharing a loop sample the step response at the same times however
+        // wide their combined range. Off the lattice, the early gates move by percents with the
+        // range, as they fall between knots where the response changes fastest. Five extra
+        // arguments above and four below the needed range keep the end conditions of the
+        // spline away from the gates, with fewer the late gates also move with the range.
+        const int ktop = static_cast<int>( std::ceil(10.*std::log(tmax)) ) + 5;
+        const int kbot = static_cast<int>( std::floor(10.*std::log(tmin)) ) - 4;
+        const Real rho = std::exp(.1*ktop);
+        const int nlag = ktop - kbot + 1;
+        ws.Cosine->SetNumConv(nlag);
+        ws.Cosine->Compute(rho, 1, Tolerance);
+
+        // Step off response of B from the cosine transform of Im(H)/w
+        const VectorXr Arg = ws.Cosine->GetAbscissaArguments();
+        const MatrixXr Ans = ws.Cosine->GetAnswer();
+        ModelledData.resize(nrx);
+        for (int irx=0; irx<nrx; ++irx) {
+            ws.Spline->SetKnots( Arg, (-2.*MU0/PI) * Ans.col(Point[irx]) );
+            ModelledData[irx] = Receivers[irx]->GetMoment() * Receivers[irx]->FoldAndConvolve( ws.Spline, GetWaveform(irx) );
+        }
+    }		// -----  end of method InstrumentTem::MakeLaggedCalculation  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  InstrumentTem
-    //      Method:  FoldAndConvolve
+    //      Method:  CheckSetup
     //--------------------------------------------------------------------------------------
-    void InstrumentTem::FoldAndConvolve ( CubicSplineInterpolator* Spline ) {
-
-        const static Real GLW[3] = {.5555556, .8888889, .5555556};
-        const static Real GLX[3] = {-.7745967, 0., .7745967};
+    void InstrumentTem::CheckSetup( ) const {
+        if (Transmitter == nullptr) throw NullAntenna();
+        if (EarthMod == nullptr) throw NullEarth();
+        if (Receivers.empty()) throw NullReceivers();
+        for (const auto& Rx : Receivers) {
+            if (Rx == nullptr) throw NullReceivers();
+        }
+        if (!Waveforms.empty() && Waveforms.size() != Receivers.size()) {
+            throw WaveformsDoNotMatchReceivers();
+        }
+    }		// -----  end of method InstrumentTem::CheckSetup  -----
 
-        // TODO BUG check against LEROI!!!
-        //SubtractPrevious(Spline);
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  GetWaveform
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMTransmitter> InstrumentTem::GetWaveform( const int& irx ) const {
+        return Waveforms.empty() ? Transmitter : Waveforms[irx];
+    }		// -----  end of method InstrumentTem::GetWaveform  -----
 
+	// ====================  ACCESS        =======================
 
-        switch (RType) {
-            case INDUCTIVE:
-                // Differentiate to compute impulse response for step input
-                // Iterate over time gate
-                for (int ig=0; ig<TimeGates.size(); ++ig) {
-                    this->ModelledData.col(1)[ig] =
-                                  ( ( ConvolveWaveform(Spline, RefTime + TimeGates[ig] - GateWidths[ig]/2.) -
-                                      ConvolveWaveform(Spline, RefTime + TimeGates[ig] + GateWidths[ig]/2.) ) / GateWidths[ig]);
-                }
-                break;
-
-            case MAGNETOMETER:
-                for (int ig=0; ig<TimeGates.size(); ++ig) {
-                    /*
-                    TC(2) = (TCLS(JT) + TOPN(JT)) / 2.
-                    TC(1) = TC(2) + HWIDTH * GLX(1)
-                    TC(3) = TC(2) + HWIDTH * GLX(3)
-                    */
-                    this->ModelledData.col(1)[ig] = 0;
-                    for (int ii=0; ii<3; ++ii) {
-                        //Real tt = RefTime + TimeGates[ig] + GLX[ii]*(GateWidths[ig]/2.);
-                        Real tt = RefTime + TimeGates[ig] + GLX[ii]*(GateWidths[ig]/2.);
-                        this->ModelledData.col(1)[ig] += ConvolveWaveform(Spline, tt) * GLW[ii]/2.;
-                    }
-                }
-                break;
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  SetTransmitter
+    //--------------------------------------------------------------------------------------
+	void InstrumentTem::SetTransmitter( std::shared_ptr<TEMTransmitter> Tx ) {
+		Transmitter = Tx;
+	}		// -----  end of method InstrumentTem::SetTransmitter  -----
 
-            case ELECTRIC:
-                throw std::runtime_error("InstrumentTEM->FoldAndConvolve with Electic Receivers is not implimented");
-                break;
-        }
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  SetReceivers
+    //--------------------------------------------------------------------------------------
+	void InstrumentTem::SetReceivers( const std::vector< std::shared_ptr<TEMReceiver> >& Rx ) {
+		Receivers = Rx;
+	}		// -----  end of method InstrumentTem::SetReceivers  -----
 
-        return ;
-    }		// -----  end of method InstrumentTem::FoldAndConvolve  -----
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  SetWaveforms
+    //--------------------------------------------------------------------------------------
+    void InstrumentTem::SetWaveforms( const std::vector< std::shared_ptr<TEMTransmitter> >& Wfms ) {
+        Waveforms = Wfms;
+    }		// -----  end of method InstrumentTem::SetWaveforms  -----
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  SetEarthModel
+    //--------------------------------------------------------------------------------------
+	void InstrumentTem::SetEarthModel( std::shared_ptr<LayeredEarthEM> Earth ) {
+		EarthMod = Earth;
+	}		// -----  end of method InstrumentTem::SetEarthModel  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  InstrumentTem
-    //      Method:  ConvolveWaveform
-    //--------------------------------------------------------------------------------------
-    Real InstrumentTem::ConvolveWaveform ( CubicSplineInterpolator* Spline, const Real& t ) {
-        static const Real T0MIN = 1e-7;
-        Real cnv(0);
-        Real tf = t - Spline->GetKnotAbscissa()[0];
-        bool der = false;
-        Real tend(0);
-        for (int ip=1; ip<TxAmp.size(); ++ip) {
-            if (TxAbs(ip) < T0MIN) continue;
-            if (TxAbs(ip-1) > tf)  break;
-
-            Real tb = t - std::min(tf, TxAbs(ip));
-            Real delt = TxAbs(ip) - TxAbs(ip-1);
-
-            der = false;
-            if (delt > T0MIN) {
-                tend = t - TxAbs(ip-1);
-                der = true;
-            }
+    //      Method:  SetHankelTransformType
+    //--------------------------------------------------------------------------------------
+    void InstrumentTem::SetHankelTransformType( const HANKELTRANSFORMTYPE& type ) {
+        HankelType = type;
+    }		// -----  end of method InstrumentTem::SetHankelTransformType  -----
 
-            if (der) {
-                //std::cout.precision(16);
-                // TODO Integrate seems to be kind of screwy!! Affecting early/on times
-                cnv += TxDiff(ip) * Spline->Integrate(tb, tend, 41200); //CUBINT (TRP,YPLS,NTYPLS,TB,TEND)
-                // TODO bug in direct spline integration, works sometimes
-                //cnv += TxDiff(ip) * Spline->Integrate(tb, tend);
-                //cnv += Spline->Integrate(tb, tend, 6264); //CUBINT (TRP,YPLS,NTYPLS,TB,TEND)
-                //Real temp = Spline->Integrate(tb, tend, 10036); //CUBINT (TRP,YPLS,NTYPLS,TB,TEND)
-                //Real temp2 = Spline->Integrate(tb, tend); //CUBINT (TRP,YPLS,NTYPLS,TB,TEND)
-                //std::cout << "der " << TxDiff(ip) << "\t" << std::scientific << tb << "\t" << tend << "\t" << MU0*temp2 << "\t" << MU0*temp << "\n";
-                //cnv += temp;
-            } else {
-                cnv += TxDelta(ip) * Spline->Interpolate(tb); //CUBVAL (TRP,YPLS,NTYPLS,TB)
-            }
-        }
-        return cnv;
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  SetTransformTolerance
+    //--------------------------------------------------------------------------------------
+    void InstrumentTem::SetTransformTolerance( const Real& tol ) {
+        Tolerance = tol;
+    }		// -----  end of method InstrumentTem::SetTransformTolerance  -----
 
-    }		// -----  end of method InstrumentTem::ConvolveWaveform  -----
+    //--------------------------------------------------------------------------------------
+    //       Class:  InstrumentTem
+    //      Method:  SetLineIntegralEvaluation
+    //--------------------------------------------------------------------------------------
+    void InstrumentTem::SetLineIntegralEvaluation( const bool& line ) {
+        LineIntegral = line;
+    }		// -----  end of method InstrumentTem::SetLineIntegralEvaluation  -----
 
+	// ====================  INQUIRY       =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  InstrumentTem
-    //      Method:  SubtractPrevious
-    //--------------------------------------------------------------------------------------
-    void InstrumentTem::SubtractPrevious ( CubicSplineInterpolator *Spline ) {
-        // Start by calculating impulse response of this pulse plus any arbitrary number of previous pulses at this
-        // repetition frequency
-        VectorXr aTimeGates = Spline->GetKnotAbscissa();
-        Real pol (1.);
-        if (bipolarWaveform) pol = -1.;
-        VectorXr PrevPulse = aTimeGates.array() + PulseT;
-		// TODO, if not bipolar what does convention say, is this added or should this be zero and handled only by nPreviousPulse?
-        VectorXr Fold = Spline->GetKnotOrdinate( ); // +
-        //VectorXr Fold =  pol*Spline->InterpolateOrderedSet( PrevPulse ) ;
-        VectorXr PrevPulse1; // = PrevPulse.array(); // + PulseT;
-        for (int ip=0; ip<NPreviousPulse; ++ip) {
-            PrevPulse1.array() += PrevPulse.array() + PulseT;
-            PrevPulse.array() += PrevPulse1.array() + PulseT;
-            Fold += Spline->InterpolateOrderedSet( PrevPulse1 ) + pol*Spline->InterpolateOrderedSet( PrevPulse ) ;
-        }
-        Spline->ResetKnotOrdinate(Fold);
-        return ;
-    }		// -----  end of method InstrumentTem::SubtractPrevious  -----
-
+    //      Method:  GetMeasurements
+    //--------------------------------------------------------------------------------------
+	std::vector<VectorXr> InstrumentTem::GetMeasurements() {
+		return ModelledData;
+	}		// -----  end of method InstrumentTem::GetMeasurements  -----
 
+    WaveformsDoNotMatchReceivers::WaveformsDoNotMatchReceivers() :
+        runtime_error("InstrumentTem needs one waveform per receiver, or none") {}
 
 } // namespace Lemma
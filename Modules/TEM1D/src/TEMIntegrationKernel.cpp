@@ -0,0 +1,75 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/**
+  @file
+  @author   M. Andy Kass
+  @date     02/10/2011
+  @version  $Id: temintegrationkernel.cpp 266 2015-04-01 03:24:00Z tirons $
+ **/
+
+#include "TEMIntegrationKernel.h"
+
+namespace Lemma {
+
+	// =======================  Lifecycle  ==================================
+
+	TEMIntegrationKernel::TEMIntegrationKernel(const ctor_key& key) :
+		IntegrationKernel<Real>(key), EmEarthInt(nullptr), Trans(nullptr),
+		Receivers(nullptr), CachedOmega(-1) {
+	}
+
+	TEMIntegrationKernel::~TEMIntegrationKernel() {
+	}
+
+	std::shared_ptr<TEMIntegrationKernel> TEMIntegrationKernel::NewSP() {
+		return std::make_shared<TEMIntegrationKernel>( ctor_key() );
+	}
+
+	// =======================  Operations  =================================
+
+	Real TEMIntegrationKernel::Argument(const Real& w, const int& iRelated) {
+
+        // The filter asks for every related kernel at the same frequency in turn, all
+        // receivers are computed by the first request
+        if (w != CachedOmega) {
+			Trans->SetFrequency(0, w / (2.*PI));
+			EmEarthInt->CalculateWireAntennaFields();
+            CachedArgs.resize(Components.size());
+            for (int irec=0; irec<static_cast<int>(Components.size()); ++irec) {
+		        CachedArgs(irec) = std::imag(Receivers->GetHfield(0, irec)(Components[irec])) / w;
+            }
+            CachedOmega = w;
+        }
+		return CachedArgs(iRelated);
+	}
+
+	// =======================  Access  =====================================
+
+	void TEMIntegrationKernel::SetEMEarth1D( std::shared_ptr<EMEarth1D> earth ) {
+		EmEarthInt = earth;
+        CachedOmega = -1;
+	}
+
+	void TEMIntegrationKernel::SetTransmitter( std::shared_ptr<WireAntenna> antenna ) {
+		Trans = antenna;
+        CachedOmega = -1;
+	}
+
+	void TEMIntegrationKernel::SetReceivers( std::shared_ptr<FieldPoints> receivers,
+            const std::vector<FIELDCOMPONENT>& comps ) {
+		Receivers = receivers;
+        Components = comps;
+        CachedOmega = -1;
+	}
+
+	// =======================  Inquiry  ====================================
+
+	int TEMIntegrationKernel::GetNumRel() {
+		return static_cast<int>(Components.size());
+	}
+
+} // end namespace Lemma
@@ -34,7 +34,8 @@ namespace Lemma {
     //      Method:  TEMReceiver
     // Description:  constructor (locked)
     //--------------------------------------------------------------------------------------
-    TEMReceiver::TEMReceiver ( const ctor_key& key ) : FieldPoints(key), moment(1), referenceTime(0) {
+    TEMReceiver::TEMReceiver ( const ctor_key& key ) : FieldPoints(key), moment(1), referenceTime(0),
+        component(ZCOMPONENT) {
 
     }  // -----  end of method TEMReceiver::TEMReceiver  (constructor)  -----
 
@@ -176,6 +177,21 @@ namespace Lemma {
     }		// -----  end of method TEMReceiver::SampleNoise  -----
 
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMReceiver
+    //      Method:  FoldAndConvolve
+    //--------------------------------------------------------------------------------------
+    VectorXr TEMReceiver::FoldAndConvolve ( std::shared_ptr<CubicSplineInterpolator> Spline,
+            std::shared_ptr<TEMTransmitter> Tx ) {
+        const int ng = windowCentres.size();
+        VectorXr edges(2*ng);
+            edges.head(ng) = referenceTime + windowCentres.array() - windowWidths.array()/2.;
+            edges.tail(ng) = referenceTime + windowCentres.array() + windowWidths.array()/2.;
+        VectorXr cnv = Tx->ConvolveWaveform( Spline, edges );
+        return (cnv.head(ng) - cnv.tail(ng)).array() / windowWidths.array();
+    }		// -----  end of method TEMReceiver::FoldAndConvolve  -----
+
+
     //--------------------------------------------------------------------------------------
     //       Class:  TEMReceiver
     //      Method:  SetReferenceTime
@@ -267,6 +283,24 @@ namespace Lemma {
     }		// -----  end of method TEMReceiver::GetReferenceTime  -----
 
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMReceiver
+    //      Method:  GetMoment
+    //--------------------------------------------------------------------------------------
+    Real TEMReceiver::GetMoment (  ) {
+        return moment;
+    }		// -----  end of method TEMReceiver::GetMoment  -----
+
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMReceiver
+    //      Method:  GetComponent
+    //--------------------------------------------------------------------------------------
+    FIELDCOMPONENT TEMReceiver::GetComponent (  ) {
+        return component;
+    }		// -----  end of method TEMReceiver::GetComponent  -----
+
+
     //--------------------------------------------------------------------------------------
     //       Class:  TEMReceiver
     //      Method:  Serialize
@@ -19,96 +19,75 @@
 
 #include	"TEMSurvey.h"
 
-namespace Lemma {
+#include <map>
+#include <tuple>
 
+namespace Lemma {
 
     // ====================  FRIEND METHODS  =====================
 
-    #ifdef HAVE_YAMLCPP
     std::ostream &operator << (std::ostream &stream, const TEMSurvey &ob) {
-        stream << ob.Serialize()  << "\n---\n"; // End of doc --- a direct stream should encapulste object
+        stream << ob.Serialize()  << "\n";
         return stream;
     }
-    #else
-    std::ostream &operator<<(std::ostream &stream, const TEMSurvey &ob) {
-        stream << *(LemmaObject*)(&ob);
-        return stream;
+
+    /** @return true if both transmitters drive the same loop, their waveforms may differ */
+    static bool SameLoop( std::shared_ptr<TEMTransmitter> Tx0, std::shared_ptr<TEMTransmitter> Tx1 ) {
+        if (Tx0 == Tx1) return true;
+        const Vector3Xr Points0 = Tx0->GetPoints();
+        const Vector3Xr Points1 = Tx1->GetPoints();
+        return Tx0->GetNumberOfTurns() == Tx1->GetNumberOfTurns() &&
+               Points0.cols() == Points1.cols() && Points0 == Points1;
     }
-    #endif
 
     // ====================  LIFECYCLE     =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  TEMSurvey
-    // Description:  constructor (protected)
+    // Description:  constructor (locked)
     //--------------------------------------------------------------------------------------
-    TEMSurvey::TEMSurvey (const std::string& name) : LemmaObject(name) {
+    TEMSurvey::TEMSurvey ( const ctor_key& key ) : LemmaObject(key) {
 
     }  // -----  end of method TEMSurvey::TEMSurvey  (constructor)  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  TEMSurvey
-    // Description:  DeSerializing constructor (protected)
+    // Description:  DeSerializing constructor (locked)
     //--------------------------------------------------------------------------------------
-    #ifdef HAVE_YAMLCPP
-    TEMSurvey::TEMSurvey (const YAML::Node& node) : LemmaObject(node) {
-
-        Lines.resize( node["numberOfLines"].as<int>( ) );
-
+    TEMSurvey::TEMSurvey ( const YAML::Node& node, const ctor_key& key ) : LemmaObject(node, key) {
+        const int nlines = node["numberOfLines"].as<int>();
+        Lines.reserve(nlines);
+        for (int il=0; il<nlines; ++il) {
+            Lines.push_back( TEMSurveyLine::DeSerialize( node[std::string("line_") + to_string(il)] ) );
+        }
     }  // -----  end of method TEMSurvey::TEMSurvey  (constructor)  -----
-    #endif
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
-    //      Method:  New()
-    // Description:  public constructor
+    //      Method:  NewSP
     //--------------------------------------------------------------------------------------
-    TEMSurvey* TEMSurvey::New() {
-        TEMSurvey*  Obj = new TEMSurvey("TEMSurvey");
-        Obj->AttachTo(Obj);
-        return Obj;
+    std::shared_ptr<TEMSurvey> TEMSurvey::NewSP() {
+        return std::make_shared<TEMSurvey>( ctor_key() );
     }
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  ~TEMSurvey
-    // Description:  destructor (protected)
+    // Description:  destructor
     //--------------------------------------------------------------------------------------
     TEMSurvey::~TEMSurvey () {
 
     }  // -----  end of method TEMSurvey::~TEMSurvey  (destructor)  -----
 
-    //--------------------------------------------------------------------------------------
-    //       Class:  TEMSurvey
-    //      Method:  Delete
-    // Description:  public destructor
-    //--------------------------------------------------------------------------------------
-    void TEMSurvey::Delete() {
-        this->DetachFrom(this);
-    }
-
-    //--------------------------------------------------------------------------------------
-    //       Class:  TEMSurvey
-    //      Method:  Release
-    // Description:  destructor (protected)
-    //--------------------------------------------------------------------------------------
-    void TEMSurvey::Release() {
-        for (std::vector<TEMSurveyLine*>::iterator it = Lines.begin() ; it != Lines.end(); ++it) {
-            (*it)->DetachFrom(this);
-        }
-        delete this;
-    }
-
-    #ifdef HAVE_YAMLCPP
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  Serialize
     //--------------------------------------------------------------------------------------
     YAML::Node  TEMSurvey::Serialize (  ) const {
-        YAML::Node node;
-        node.SetTag( this->Name );
+        YAML::Node node = LemmaObject::Serialize();
+        node.SetTag( GetName() );
         node["numberOfLines"] = Lines.size();
         for (unsigned int it = 0; it< Lines.size();  ++it) {
             node[std::string("line_") +  to_string(it)] = Lines[it]->Serialize();
@@ -116,87 +95,196 @@ namespace Lemma {
         return node;
     }		// -----  end of method TEMSurvey::Serialize  -----
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  DeSerialize
     //--------------------------------------------------------------------------------------
-    TEMSurvey* TEMSurvey::DeSerialize ( const YAML::Node& node  ) {
-        TEMSurvey* Object = new TEMSurvey(node);
-        Object->AttachTo(Object);
-        DESERIALIZECHECK( node, Object )
-        return Object ;
+    std::shared_ptr<TEMSurvey> TEMSurvey::DeSerialize ( const YAML::Node& node  ) {
+        if (node.Tag() != "TEMSurvey") {
+            throw  DeSerializeTypeMismatch( "TEMSurvey", node.Tag());
+        }
+        return std::make_shared<TEMSurvey>( node, ctor_key() );
     }		// -----  end of method TEMSurvey::DeSerialize  -----
-    #endif
-
 
+    // ====================  OPERATORS    =======================
 
-        // ====================  OPERATORS    =======================
-
-    TEMSurveyLine* TEMSurvey::operator( ) ( const int& idx ) const {
+    std::shared_ptr<TEMSurveyLine> TEMSurvey::operator( ) ( const int& idx ) const {
         return this->Lines[ idx ];
     }
 
-    TEMSurveyLineRecord* TEMSurvey::operator( ) ( const int& iline, const int& irec ) const {
+    std::shared_ptr<TEMSurveyLineRecord> TEMSurvey::operator( ) ( const int& iline, const int& irec ) const {
         return Lines[ iline ]->GetRecord( irec );
     }
 
+    // ====================  OPERATIONS    =======================
+
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  SetNumberOfLines
     //--------------------------------------------------------------------------------------
     void TEMSurvey::SetNumberOfLines ( const int& nlines  ) {
-
-        // clean up any old lines
-        for (std::vector<TEMSurveyLine*>::iterator it = Lines.begin() ; it != Lines.end(); ++it) {
-            (*it)->DetachFrom(this);
-        }
         Lines.clear();
-
-        // Allocate these lines
         Lines.reserve(nlines);
         for (int il=0; il<nlines; ++il) {
-            Lines.push_back( new TEMSurveyLine("TEMSurveyLine") );
-            Lines[il]->AttachTo(this);
+            Lines.push_back( TEMSurveyLine::NewSP() );
         }
-
         return ;
     }		// -----  end of method TEMSurvey::SetNumberOfLines  -----
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
-    //      Method:  GetLine
+    //      Method:  ForwardModel
     //--------------------------------------------------------------------------------------
-    TEMSurveyLine* TEMSurvey::GetLine ( const unsigned int&  iline ) {
-        return Lines[iline];
-    }		// -----  end of method TEMSurvey::GetLine  -----
-
+    std::shared_ptr<TEMSurveyData> TEMSurvey::ForwardModel ( std::shared_ptr<LayeredEarthEM> model,
+            bool additiveNoise ) {
+        return ForwardModel( std::vector< std::shared_ptr<LayeredEarthEM> >(GetNumberOfRecords(), model),
+                additiveNoise );
+    }		// -----  end of method TEMSurvey::ForwardModel  -----
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurvey
+    //      Method:  ForwardModel
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMSurveyData> TEMSurvey::ForwardModel (
+            const std::vector< std::shared_ptr<LayeredEarthEM> >& models, bool additiveNoise ) {
+        auto Data = TEMSurveyData::NewSP();
+        ForwardModel( models, Data, additiveNoise );
+        return Data;
+    }		// -----  end of method TEMSurvey::ForwardModel  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurvey
     //      Method:  ForwardModel
     //--------------------------------------------------------------------------------------
-    TEMSurveyData* TEMSurvey::ForwardModel ( LayeredEarthEM* model, bool additiveNoise ) {
+    void TEMSurvey::ForwardModel ( const std::vector< std::shared_ptr<LayeredEarthEM> >& models,
+            std::shared_ptr<TEMSurveyData> Data, bool additiveNoise ) {
 
-        TEMSurveyData* ForwardData = TEMSurveyData::New();
-            //ForwardData->SetNumberOfLines(Lines.size());
+        if ( static_cast<int>(models.size()) != GetNumberOfRecords() ) {
+            throw std::runtime_error( "TEMSurvey::ForwardModel, one model is needed for each record" );
+        }
 
-        for (std::vector<TEMSurveyLine*>::iterator it = Lines.begin() ; it != Lines.end(); ++it) {
+        // Layout of the data
+        std::vector<int> nrec;
+        std::vector<int> nseq;
+        std::vector<VectorXr> centres;
+        for (const auto& Line : Lines) {
+            nrec.push_back( Line->GetNumberOfRecords() );
+            for (const auto& Record : Line->Records) {
+                nseq.push_back( Record->GetNumberOfPulseSequences() );
+                for (const auto& Rx : Record->Receivers) {
+                    if (Rx == nullptr) {
+                        throw std::runtime_error( "TEMSurvey::ForwardModel, unset transmitter receiver pair" );
+                    }
+                    centres.push_back( Rx->GetWindowCentres() );
+                }
+            }
+        }
+        Data->SetLayout( nrec, nseq, centres );
+
+        // Pulse sequences are grouped into soundings by loop and model, across records,
+        // the earth response of a loop does not depend on the waveform. Models are compared
+        // by pointer, records meant to share a sounding must be given the same model.
+        struct Target {
+            int line;
+            int record;
+            int sequence;
+        };
+        std::vector< std::shared_ptr<TEMTransmitter> > Loops;
+        std::vector< std::shared_ptr<LayeredEarthEM> > Models;
+        std::vector< std::vector<Target> > Targets;
+        std::map< std::tuple<LayeredEarthEM*, int, Real, Real, Real>, std::vector<int> > Buckets;
+        int ir = 0;
+        for (int il=0; il<GetNumberOfLines(); ++il) {
+            for (int irec=0; irec<Lines[il]->GetNumberOfRecords(); ++irec, ++ir) {
+                const auto& Record = Lines[il]->Records[irec];
+                for (int iseq=0; iseq<Record->GetNumberOfPulseSequences(); ++iseq) {
+                    if (Record->Transmitters[iseq] == nullptr) {
+                        throw std::runtime_error( "TEMSurvey::ForwardModel, unset transmitter receiver pair" );
+                    }
+                    // only loops with the same model, turns and first point are compared
+                    const Vector3Xr Points = Record->Transmitters[iseq]->GetPoints();
+                    const Vector3r First = Points.cols() > 0 ? Vector3r(Points.col(0)) : Vector3r::Zero();
+                    std::vector<int>& Candidates = Buckets[ std::make_tuple( models[ir].get(),
+                            Record->Transmitters[iseq]->GetNumberOfTurns(), First(0), First(1), First(2) ) ];
+                    unsigned int ic = 0;
+                    while ( ic < Candidates.size() && !SameLoop(Loops[Candidates[ic]], Record->Transmitters[iseq]) ) ++ic;
+                    if (ic == Candidates.size()) {
+                        Candidates.push_back( static_cast<int>(Loops.size()) );
+                        Loops.push_back( Record->Transmitters[iseq] );
+                        Models.push_back( models[ir] );
+                        Targets.emplace_back();
+                    }
+                    Targets[ Candidates[ic] ].push_back( Target{ il, irec, iseq } );
+                }
+            }
+        }
 
-            TEMSurveyLineData* LineData = ((*it)->ForwardModel( model, additiveNoise ) );
-            LineData->AttachTo(ForwardData);
-            ForwardData->LineData.push_back( LineData );
+        std::vector< std::shared_ptr<InstrumentTem> > Soundings;
+        for (unsigned int is=0; is<Loops.size(); ++is) {
+            std::vector< std::shared_ptr<TEMReceiver> > rx;
+            std::vector< std::shared_ptr<TEMTransmitter> > wfm;
+            for (const Target& t : Targets[is]) {
+                rx.push_back( Lines[t.line]->Records[t.record]->Receivers[t.sequence] );
+                wfm.push_back( Lines[t.line]->Records[t.record]->Transmitters[t.sequence] );
+            }
+            auto Sounding = InstrumentTem::NewSP();
+                Sounding->SetTransmitter( Loops[is] );
+                Sounding->SetReceivers( rx );
+                Sounding->SetWaveforms( wfm );
+                Sounding->SetEarthModel( Models[is] );
+            Soundings.push_back( Sounding );
         }
 
-        //for (int it=0; it<Lines.size(); ++it) {
-        //    Lines[it]->ForwardModel( model );
-        //}
+        InstrumentTem::MakeLaggedCalculations( Soundings );
+
+        for (unsigned int is=0; is<Soundings.size(); ++is) {
+            const std::vector<VectorXr> meas = Soundings[is]->GetMeasurements();
+            for (unsigned int irx=0; irx<Targets[is].size(); ++irx) {
+                const Target& t = Targets[is][irx];
+                Data->GetSeries( t.line, t.record, t.sequence ) = meas[irx];
+                if (additiveNoise) {
+                    Data->GetSeries( t.line, t.record, t.sequence ) +=
+                        Lines[t.line]->Records[t.record]->Receivers[t.sequence]->SampleNoise();
+                }
+            }
+        }
 
-        return  ForwardData;
+        return ;
     }		// -----  end of method TEMSurvey::ForwardModel  -----
 
+    // ====================  ACCESS        =======================
 
-}		// -----  end of Lemma  name  -----
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurvey
+    //      Method:  GetLine
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMSurveyLine> TEMSurvey::GetLine ( const unsigned int&  iline ) {
+        if ( iline >= Lines.size() ) {
+            throw std::runtime_error( "TEMSurvey::GetLine(const int& iline)--array bounds error" );
+        }
+        return Lines[iline];
+    }		// -----  end of method TEMSurvey::GetLine  -----
+
+    // ====================  INQUIRY       =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurvey
+    //      Method:  GetNumberOfLines
+    //--------------------------------------------------------------------------------------
+    int TEMSurvey::GetNumberOfLines (  ) const {
+        return static_cast<int>(Lines.size());
+    }		// -----  end of method TEMSurvey::GetNumberOfLines  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurvey
+    //      Method:  GetNumberOfRecords
+    //--------------------------------------------------------------------------------------
+    int TEMSurvey::GetNumberOfRecords (  ) const {
+        int nrec = 0;
+        for (const auto& Line : Lines) {
+            nrec += Line->GetNumberOfRecords();
+        }
+        return nrec;
+    }		// -----  end of method TEMSurvey::GetNumberOfRecords  -----
 
+}		// -----  end of Lemma  name  -----
@@ -21,224 +21,294 @@
 
 namespace Lemma {
 
-// ====================  FRIEND METHODS  =====================
-#ifdef HAVE_YAMLCPP
-std::ostream &operator << (std::ostream &stream, const TEMSurveyData &ob) {
-    stream << ob.Serialize()  << "\n---\n"; // End of doc --- as a direct stream should encapulste thingy
-    return stream;
-}
-#else
-std::ostream &operator<<(std::ostream &stream, const TEMSurveyData& ob) {
-    stream << *(LemmaObject*)(&ob);
-    return stream;
-}
-#endif
-
-// =================== OPERATORS ===============================
-
-TEMSurveyData* TEMSurveyData::operator + (const TEMSurveyData& d) {
-    TEMSurveyData* clone = Clone();
-    *clone += d;
-    return clone;
-}
-
-void TEMSurveyData::operator += (const TEMSurveyData& rhs) {
-
-    if ( this->GetNumberOfLines() != rhs.GetNumberOfLines() ) {
-        throw std::runtime_error( "Line mismatch in TEMSurveyData +=" );
-    }
+    // ====================  FRIEND METHODS  =====================
 
-    for (int iline=0; iline<this->GetNumberOfLines(); ++iline ) {
-        *(*this)(iline) += *rhs(iline);
-        //*LineData[iline] += *rhs(iline);
-        //*LineData[iline] += *rhs.GetLine(iline);
+    std::ostream &operator << (std::ostream &stream, const TEMSurveyData &ob) {
+        stream << ob.Serialize()  << "\n";
+        return stream;
     }
-}
-
-void TEMSurveyData::operator -= (const TEMSurveyData& rhs) {
 
-    if ( this->GetNumberOfLines() != rhs.GetNumberOfLines() ) {
-        throw std::runtime_error( "Line mismatch in TEMSurveyData +=" );
+    // ====================  LIFECYCLE     =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  TEMSurveyData
+    // Description:  constructor (locked)
+    //--------------------------------------------------------------------------------------
+    TEMSurveyData::TEMSurveyData ( const ctor_key& key ) : LemmaObject(key),
+        LineOffsets(1, 0), RecordOffsets(1, 0), SeriesOffsets(1, 0) {
+
+    }  // -----  end of method TEMSurveyData::TEMSurveyData  (constructor)  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  TEMSurveyData
+    // Description:  DeSerializing constructor (locked)
+    //--------------------------------------------------------------------------------------
+    TEMSurveyData::TEMSurveyData ( const YAML::Node& node, const ctor_key& key ) : LemmaObject(node, key) {
+        LineOffsets   = node["LineOffsets"].as< std::vector<int> >();
+        RecordOffsets = node["RecordOffsets"].as< std::vector<int> >();
+        SeriesOffsets = node["SeriesOffsets"].as< std::vector<int> >();
+        Data          = node["Data"].as<VectorXr>();
+        GateCentres   = node["GateCentres"].as<VectorXr>();
+    }  // -----  end of method TEMSurveyData::TEMSurveyData  (constructor)  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  NewSP
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMSurveyData> TEMSurveyData::NewSP() {
+        return std::make_shared<TEMSurveyData>( ctor_key() );
     }
 
-    for (int iline=0; iline<this->GetNumberOfLines(); ++iline ) {
-        *(*this)(iline) -= *rhs(iline);
-        //*LineData[iline] -= *rhs(iline);
-        //*LineData[iline] -= *rhs.GetLine(iline);
-    }
-
-}
-
-TEMSurveyData* TEMSurveyData::operator - (const TEMSurveyData& d) {
-    TEMSurveyData* clone = Clone();
-    *clone -= d;
-    return clone;
-}
-
-TEMSurveyLineData* TEMSurveyData::operator( ) ( const int& idx ) const {
-    return LineData[ idx ];
-}
-
-TEMSurveyLineRecordData* TEMSurveyData::operator( ) ( const int& iline, const int& irec ) const {
-    return LineData[ iline ]->GetRecord( irec );
-}
-
-// ====================  LIFECYCLE     =======================
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  TEMSurveyData
-// Description:  constructor (protected)
-//--------------------------------------------------------------------------------------
-TEMSurveyData::TEMSurveyData (const std::string& name) : LemmaObject(name) {
-
-}  // -----  end of method TEMSurveyData::TEMSurveyData  (constructor)  -----
-
-#ifdef HAVE_YAMLCPP
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  TEMSurveyData
-// Description:  DeSerializing constructor (protected)
-//--------------------------------------------------------------------------------------
-TEMSurveyData::TEMSurveyData (const YAML::Node& node) : LemmaObject(node) {
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  ~TEMSurveyData
+    // Description:  destructor
+    //--------------------------------------------------------------------------------------
+    TEMSurveyData::~TEMSurveyData () {
+
+    }  // -----  end of method TEMSurveyData::~TEMSurveyData  (destructor)  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  Clone
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMSurveyData> TEMSurveyData::Clone (  ) const {
+        auto copy = TEMSurveyData::NewSP();
+            copy->LineOffsets = LineOffsets;
+            copy->RecordOffsets = RecordOffsets;
+            copy->SeriesOffsets = SeriesOffsets;
+            copy->Data = Data;
+            copy->GateCentres = GateCentres;
+        return copy;
+    }		// -----  end of method TEMSurveyData::Clone  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  Serialize
+    //--------------------------------------------------------------------------------------
+    YAML::Node  TEMSurveyData::Serialize (  ) const {
+        YAML::Node node = LemmaObject::Serialize();
+        node.SetTag( GetName() );
+        node["numberOfLines"] = GetNumberOfLines();
+        node["LineOffsets"] = LineOffsets;
+        node["RecordOffsets"] = RecordOffsets;
+        node["SeriesOffsets"] = SeriesOffsets;
+        node["Data"] = Data;
+        node["GateCentres"] = GateCentres;
+        return node;
+    }		// -----  end of method TEMSurveyData::Serialize  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  DeSerialize
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMSurveyData> TEMSurveyData::DeSerialize ( const YAML::Node& node  ) {
+        if (node.Tag() != "TEMSurveyData") {
+            throw  DeSerializeTypeMismatch( "TEMSurveyData", node.Tag());
+        }
+        return std::make_shared<TEMSurveyData>( node, ctor_key() );
+    }		// -----  end of method TEMSurveyData::DeSerialize  -----
 
-    //SetNumberOfLines( node["numberOfLines"].as<int>( ) );
+    // ====================  OPERATORS     =======================
 
-    for (int ii=0; ii< node["numberOfLines"].as<int>( ); ++ii) {
-        //LineData.push_back( new TEMSurveyLineData("TEMSurveyLineData") );
-        LineData.push_back( TEMSurveyLineData::DeSerialize( node[ std::string("line_")  + to_string(ii)] ) );
-        LineData[ii]->AttachTo(this);
+    std::shared_ptr<TEMSurveyData> TEMSurveyData::operator + (const TEMSurveyData& rhs) const {
+        auto clone = Clone();
+        *clone += rhs;
+        return clone;
     }
 
-
-}  // -----  end of method TEMSurveyData::TEMSurveyData  (constructor)  -----
-#endif
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  New()
-// Description:  public constructor
-//--------------------------------------------------------------------------------------
-TEMSurveyData* TEMSurveyData::New() {
-    TEMSurveyData*  Obj = new TEMSurveyData("TEMSurveyData");
-    Obj->AttachTo(Obj);
-    return Obj;
-}
-
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  Clone
-//--------------------------------------------------------------------------------------
-TEMSurveyData* TEMSurveyData::Clone (  ) {
-    return TEMSurveyData::DeSerialize( this->Serialize() ) ;
-}		// -----  end of method TEMSurveyData::Clone  -----
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  ~TEMSurveyData
-// Description:  destructor (protected)
-//--------------------------------------------------------------------------------------
-TEMSurveyData::~TEMSurveyData () {
-
-}  // -----  end of method TEMSurveyData::~TEMSurveyData  (destructor)  -----
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  Delete
-// Description:  public destructor
-//--------------------------------------------------------------------------------------
-void TEMSurveyData::Delete() {
-    this->DetachFrom(this);
-}
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  Release
-// Description:  destructor (protected)
-//--------------------------------------------------------------------------------------
-void TEMSurveyData::Release() {
-
-    // clean up any old lines
-    for (std::vector<TEMSurveyLineData*>::iterator it = LineData.begin() ; it != LineData.end(); ++it) {
-        (*it)->DetachFrom(this);
-        (*it)->Delete();
+    std::shared_ptr<TEMSurveyData> TEMSurveyData::operator - (const TEMSurveyData& rhs) const {
+        auto clone = Clone();
+        *clone -= rhs;
+        return clone;
     }
 
-    delete this;
-}
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  SetNumberOfLines
-//--------------------------------------------------------------------------------------
-void TEMSurveyData::SetNumberOfLines ( const int& nlines ) {
-
-        // clean up any old lines
-        for (std::vector<TEMSurveyLineData*>::iterator it = LineData.begin() ; it != LineData.end(); ++it) {
-            (*it)->DetachFrom(this);
+    void TEMSurveyData::operator += (const TEMSurveyData& rhs) {
+        if ( SeriesOffsets != rhs.SeriesOffsets || RecordOffsets != rhs.RecordOffsets ) {
+            throw std::runtime_error( "Layout mismatch in TEMSurveyData +=" );
         }
-        LineData.clear();
+        Data += rhs.Data;
+    }
 
-        // Allocate these lines
-        LineData.reserve(nlines);
-        for (int il=0; il<nlines; ++il) {
-            LineData.push_back( TEMSurveyLineData::New() );
-            LineData[il]->AttachTo(this);
+    void TEMSurveyData::operator -= (const TEMSurveyData& rhs) {
+        if ( SeriesOffsets != rhs.SeriesOffsets || RecordOffsets != rhs.RecordOffsets ) {
+            throw std::runtime_error( "Layout mismatch in TEMSurveyData -=" );
         }
-
-    return ;
-}		// -----  end of method TEMSurveyData::SetNumberOfLines  -----
-
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  GetLine
-//--------------------------------------------------------------------------------------
-TEMSurveyLineData* TEMSurveyData::GetLine ( const int& iline) const {
-    return LineData[iline] ;
-}		// -----  end of method TEMSurveyData::GetLine  -----
-
-
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  GetNumberOfLines
-//--------------------------------------------------------------------------------------
-int TEMSurveyData::GetNumberOfLines (  ) const {
-    return  LineData.size() ;
-}		// -----  end of method TEMSurveyData::GetNumberOfLines  -----
-
-
-
-#ifdef HAVE_YAMLCPP
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  Serialize
-//--------------------------------------------------------------------------------------
-YAML::Node  TEMSurveyData::Serialize (  ) const {
-    YAML::Node node = LemmaObject::Serialize();;
-    node.SetTag( this->Name );
-    node["numberOfLines"] = LineData.size();
-
-    for (unsigned int it = 0; it<LineData.size();  ++it) {
-        node[std::string("line_") +  to_string(it)] = LineData[it]->Serialize();
+        Data -= rhs.Data;
     }
 
-    return node;
-}		// -----  end of method TEMSurveyData::Serialize  -----
+    // ====================  OPERATIONS    =======================
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  SetLayout
+    //--------------------------------------------------------------------------------------
+    void TEMSurveyData::SetLayout ( const std::vector<int>& nrec, const std::vector<int>& nseq,
+            const std::vector<VectorXr>& centres ) {
+
+        std::vector<int> lines(1, 0);
+        for (const int& n : nrec) {
+            lines.push_back( lines.back() + n );
+        }
+        std::vector<int> records(1, 0);
+        for (const int& n : nseq) {
+            records.push_back( records.back() + n );
+        }
+        std::vector<int> series(1, 0);
+        for (const VectorXr& c : centres) {
+            series.push_back( series.back() + static_cast<int>(c.size()) );
+        }
+        if ( lines.back() != static_cast<int>(nseq.size()) || records.back() != static_cast<int>(centres.size()) ) {
+            throw std::runtime_error( "TEMSurveyData::SetLayout, inconsistent layout" );
+        }
 
-//--------------------------------------------------------------------------------------
-//       Class:  TEMSurveyData
-//      Method:  DeSerialize
-//--------------------------------------------------------------------------------------
-TEMSurveyData* TEMSurveyData::DeSerialize ( const YAML::Node& node  ) {
-    TEMSurveyData* Object = new TEMSurveyData(node);
-    Object->AttachTo(Object);
-    DESERIALIZECHECK( node, Object )
-    return Object ;
-}		// -----  end of method TEMSurveyData::DeSerialize  -----
-#endif
+        if ( lines != LineOffsets || records != RecordOffsets || series != SeriesOffsets ) {
+            LineOffsets = lines;
+            RecordOffsets = records;
+            SeriesOffsets = series;
+            Data.resize( SeriesOffsets.back() );
+            GateCentres.resize( SeriesOffsets.back() );
+        }
+        for (unsigned int is=0; is<centres.size(); ++is) {
+            GateCentres.segment( SeriesOffsets[is], centres[is].size() ) = centres[is];
+        }
+        Data.setZero();
+
+        return ;
+    }		// -----  end of method TEMSurveyData::SetLayout  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  RecordIndex
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyData::RecordIndex ( const int& iline, const int& irec ) const {
+        if ( iline < 0 || iline >= GetNumberOfLines() || irec < 0 || irec >= GetNumberOfRecords(iline) ) {
+            throw std::runtime_error( "TEMSurveyData::RecordIndex--array bounds error" );
+        }
+        return LineOffsets[iline] + irec;
+    }		// -----  end of method TEMSurveyData::RecordIndex  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  SeriesIndex
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyData::SeriesIndex ( const int& iline, const int& irec, const int& iseq ) const {
+        const int ir = RecordIndex( iline, irec );
+        if ( iseq < 0 || iseq >= RecordOffsets[ir+1] - RecordOffsets[ir] ) {
+            throw std::runtime_error( "TEMSurveyData::SeriesIndex--array bounds error" );
+        }
+        return RecordOffsets[ir] + iseq;
+    }		// -----  end of method TEMSurveyData::SeriesIndex  -----
+
+    // ====================  ACCESS        =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetSeries
+    //--------------------------------------------------------------------------------------
+    VectorXr::SegmentReturnType TEMSurveyData::GetSeries ( const int& iline, const int& irec,
+            const int& iseq ) {
+        const int is = SeriesIndex( iline, irec, iseq );
+        return Data.segment( SeriesOffsets[is], SeriesOffsets[is+1] - SeriesOffsets[is] );
+    }		// -----  end of method TEMSurveyData::GetSeries  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetSeries
+    //--------------------------------------------------------------------------------------
+    VectorXr::ConstSegmentReturnType TEMSurveyData::GetSeries ( const int& iline, const int& irec,
+            const int& iseq ) const {
+        const int is = SeriesIndex( iline, irec, iseq );
+        return Data.segment( SeriesOffsets[is], SeriesOffsets[is+1] - SeriesOffsets[is] );
+    }		// -----  end of method TEMSurveyData::GetSeries  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetSeriesGateCentres
+    //--------------------------------------------------------------------------------------
+    VectorXr::ConstSegmentReturnType TEMSurveyData::GetSeriesGateCentres ( const int& iline,
+            const int& irec, const int& iseq ) const {
+        const int is = SeriesIndex( iline, irec, iseq );
+        return GateCentres.segment( SeriesOffsets[is], SeriesOffsets[is+1] - SeriesOffsets[is] );
+    }		// -----  end of method TEMSurveyData::GetSeriesGateCentres  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetRecord
+    //--------------------------------------------------------------------------------------
+    VectorXr::SegmentReturnType TEMSurveyData::GetRecord ( const int& iline, const int& irec ) {
+        const int ir = RecordIndex( iline, irec );
+        const int d0 = SeriesOffsets[ RecordOffsets[ir] ];
+        return Data.segment( d0, SeriesOffsets[ RecordOffsets[ir+1] ] - d0 );
+    }		// -----  end of method TEMSurveyData::GetRecord  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetRecord
+    //--------------------------------------------------------------------------------------
+    VectorXr::ConstSegmentReturnType TEMSurveyData::GetRecord ( const int& iline, const int& irec ) const {
+        const int ir = RecordIndex( iline, irec );
+        const int d0 = SeriesOffsets[ RecordOffsets[ir] ];
+        return Data.segment( d0, SeriesOffsets[ RecordOffsets[ir+1] ] - d0 );
+    }		// -----  end of method TEMSurveyData::GetRecord  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetRecordGateCentres
+    //--------------------------------------------------------------------------------------
+    VectorXr::ConstSegmentReturnType TEMSurveyData::GetRecordGateCentres ( const int& iline,
+            const int& irec ) const {
+        const int ir = RecordIndex( iline, irec );
+        const int d0 = SeriesOffsets[ RecordOffsets[ir] ];
+        return GateCentres.segment( d0, SeriesOffsets[ RecordOffsets[ir+1] ] - d0 );
+    }		// -----  end of method TEMSurveyData::GetRecordGateCentres  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetData
+    //--------------------------------------------------------------------------------------
+    const VectorXr& TEMSurveyData::GetData (  ) const {
+        return Data;
+    }		// -----  end of method TEMSurveyData::GetData  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetGateCentres
+    //--------------------------------------------------------------------------------------
+    const VectorXr& TEMSurveyData::GetGateCentres (  ) const {
+        return GateCentres;
+    }		// -----  end of method TEMSurveyData::GetGateCentres  -----
+
+    // ====================  INQUIRY       =======================
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetNumberOfLines
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyData::GetNumberOfLines (  ) const {
+        return static_cast<int>(LineOffsets.size()) - 1;
+    }		// -----  end of method TEMSurveyData::GetNumberOfLines  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetNumberOfRecords
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyData::GetNumberOfRecords ( const int& iline ) const {
+        if ( iline < 0 || iline >= GetNumberOfLines() ) {
+            throw std::runtime_error( "TEMSurveyData::GetNumberOfRecords--array bounds error" );
+        }
+        return LineOffsets[iline+1] - LineOffsets[iline];
+    }		// -----  end of method TEMSurveyData::GetNumberOfRecords  -----
+
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyData
+    //      Method:  GetNumberOfSeries
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyData::GetNumberOfSeries ( const int& iline, const int& irec ) const {
+        const int ir = RecordIndex( iline, irec );
+        return RecordOffsets[ir+1] - RecordOffsets[ir];
+    }		// -----  end of method TEMSurveyData::GetNumberOfSeries  -----
 
 }		// -----  end of Lemma  name  -----
-
@@ -22,80 +22,60 @@
 namespace Lemma {
 
     // ====================  FRIEND METHODS  =====================
-#ifdef HAVE_YAMLCPP
+
     std::ostream &operator << (std::ostream &stream, const TEMSurveyLine &ob) {
-        stream << ob.Serialize()  << "\n---\n"; // End of doc --- as a direct stream should encapulste thingy
-        return stream;
-    }
-#else
-    std::ostream &operator<<(std::ostream &stream, const TEMSurveyLine& ob) {
-        stream << *(LemmaObject*)(&ob);
+        stream << ob.Serialize()  << "\n";
         return stream;
     }
-#endif
 
     // ====================  LIFECYCLE     =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
     //      Method:  TEMSurveyLine
-    // Description:  constructor (protected)
+    // Description:  constructor (locked)
     //--------------------------------------------------------------------------------------
-    TEMSurveyLine::TEMSurveyLine (const std::string& name) : LemmaObject(name) {
+    TEMSurveyLine::TEMSurveyLine ( const ctor_key& key ) : LemmaObject(key) {
 
     }  // -----  end of method TEMSurveyLine::TEMSurveyLine  (constructor)  -----
 
-#ifdef HAVE_YAMLCPP
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
     //      Method:  TEMSurveyLine
-    // Description:  DeSerializing constructor (protected)
+    // Description:  DeSerializing constructor (locked)
     //--------------------------------------------------------------------------------------
-    TEMSurveyLine::TEMSurveyLine (const YAML::Node& node) : LemmaObject(node) {
-
+    TEMSurveyLine::TEMSurveyLine ( const YAML::Node& node, const ctor_key& key ) : LemmaObject(node, key) {
+        const int nrec = node["numberOfRecords"].as<int>();
+        Records.reserve(nrec);
+        for (int ir=0; ir<nrec; ++ir) {
+            Records.push_back( TEMSurveyLineRecord::DeSerialize( node[std::string("record_") + to_string(ir)] ) );
+        }
     }  // -----  end of method TEMSurveyLine::TEMSurveyLine  (constructor)  -----
-#endif
-
-    //--------------------------------------------------------------------------------------
-    //       Class:  TEMSurveyLine
-    //      Method:  ~TEMSurveyLine
-    // Description:  destructor (protected)
-    //--------------------------------------------------------------------------------------
-    TEMSurveyLine::~TEMSurveyLine () {
-
-    }  // -----  end of method TEMSurveyLine::~TEMSurveyLine  (destructor)  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
-    //      Method:  Delete
-    // Description:  public destructor
+    //      Method:  NewSP
     //--------------------------------------------------------------------------------------
-    void TEMSurveyLine::Delete() {
-        // THIS is a private member, this class must be used through a TEMSurvey
-        this->DetachFrom(this);
+    std::shared_ptr<TEMSurveyLine> TEMSurveyLine::NewSP() {
+        return std::make_shared<TEMSurveyLine>( ctor_key() );
     }
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
-    //      Method:  Release
-    // Description:  destructor (protected)
+    //      Method:  ~TEMSurveyLine
+    // Description:  destructor
     //--------------------------------------------------------------------------------------
-    void TEMSurveyLine::Release() {
-        for (std::vector<TEMSurveyLineRecord*>::iterator it = Records.begin() ; it != Records.end(); ++it) {
-            (*it)->DetachFrom(this);
-        }
-        delete this;
-    }
+    TEMSurveyLine::~TEMSurveyLine () {
 
+    }  // -----  end of method TEMSurveyLine::~TEMSurveyLine  (destructor)  -----
 
-#ifdef HAVE_YAMLCPP
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
     //      Method:  Serialize
     //--------------------------------------------------------------------------------------
     YAML::Node  TEMSurveyLine::Serialize (  ) const {
-        YAML::Node node;
-        node.SetTag( this->Name );
+        YAML::Node node = LemmaObject::Serialize();
+        node.SetTag( GetName() );
         node["numberOfRecords"] = Records.size();
         for (unsigned int it = 0; it< Records.size();  ++it) {
             node[std::string("record_") +  to_string(it)] = Records[it]->Serialize();
@@ -103,60 +83,51 @@ namespace Lemma {
         return node;
     }		// -----  end of method TEMSurveyLine::Serialize  -----
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
     //      Method:  DeSerialize
     //--------------------------------------------------------------------------------------
-    TEMSurveyLine* TEMSurveyLine::DeSerialize ( const YAML::Node& node  ) {
-        TEMSurveyLine* Object = new TEMSurveyLine(node);
-        Object->AttachTo(Object);
-        DESERIALIZECHECK( node, Object )
-            return Object ;
+    std::shared_ptr<TEMSurveyLine> TEMSurveyLine::DeSerialize ( const YAML::Node& node  ) {
+        if (node.Tag() != "TEMSurveyLine") {
+            throw  DeSerializeTypeMismatch( "TEMSurveyLine", node.Tag());
+        }
+        return std::make_shared<TEMSurveyLine>( node, ctor_key() );
     }		// -----  end of method TEMSurveyLine::DeSerialize  -----
-#endif
 
-    TEMSurveyLineRecord* TEMSurveyLine::GetRecord( const unsigned int& irec )  {
-        return Records[irec];
-    }
+    // ====================  ACCESS        =======================
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyLine
+    //      Method:  GetRecord
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMSurveyLineRecord> TEMSurveyLine::GetRecord( const unsigned int& irec )  {
+        if ( irec >= Records.size() ) {
+            throw std::runtime_error( "TEMSurveyLine::GetRecord(const int& irec)--array bounds error" );
+        }
+        return Records[irec];
+    }		// -----  end of method TEMSurveyLine::GetRecord  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
     //      Method:  SetNumberOfRecords
     //--------------------------------------------------------------------------------------
     void TEMSurveyLine::SetNumberOfRecords ( const int& nrec  ) {
-
-        // clean up any old records
-        for (std::vector<TEMSurveyLineRecord*>::iterator it = Records.begin() ; it != Records.end(); ++it) {
-            (*it)->DetachFrom(this);
-        }
         Records.clear();
-
-        // Allocate these lines
         Records.reserve(nrec);
         for (int ir=0; ir<nrec; ++ir) {
-            Records.push_back( new TEMSurveyLineRecord("TEMSurveyLineRecord") );
-            Records[ir]->AttachTo(this);
+            Records.push_back( TEMSurveyLineRecord::NewSP() );
         }
-
         return ;
     }		// -----  end of method TEMSurveyLine::SetNumberOfRecords  -----
 
+    // ====================  INQUIRY       =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLine
-    //      Method:  ForwardModel
-    //--------------------------------------------------------------------------------------
-    TEMSurveyLineData* TEMSurveyLine::ForwardModel ( LayeredEarthEM* Model, bool additiveNoise ) {
-        TEMSurveyLineData* Data = TEMSurveyLineData::New();
-        for (std::vector<TEMSurveyLineRecord*>::iterator it = Records.begin() ; it != Records.end(); ++it) {
-            TEMSurveyLineRecordData* RecData = (*it)->ForwardModel(Model, additiveNoise) ;
-            RecData->AttachTo(Data);
-            Data->RecordData.push_back( RecData );
-        }
-        return Data;
-    }		// -----  end of method TEMSurveyLine::ForwardModel  -----
-
+    //      Method:  GetNumberOfRecords
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyLine::GetNumberOfRecords (  ) const {
+        return static_cast<int>(Records.size());
+    }		// -----  end of method TEMSurveyLine::GetNumberOfRecords  -----
 
 }		// -----  end of Lemma  name  -----
@@ -18,237 +18,156 @@
  */
 
 #include "TEMSurveyLineRecord.h"
+#include "TEMInductiveReceiver.h"
 
 namespace Lemma {
 
-
     // ====================  FRIEND METHODS  =====================
-#ifdef HAVE_YAMLCPP
+
     std::ostream &operator << (std::ostream &stream, const TEMSurveyLineRecord &ob) {
-        stream << ob.Serialize()  << "\n---\n"; // End of doc --- as a direct stream should encapulste thingy
-        return stream;
-    }
-#else
-    std::ostream &operator<<(std::ostream &stream, const TEMSurveyLineRecord& ob) {
-        stream << *(LemmaObject*)(&ob);
+        stream << ob.Serialize()  << "\n";
         return stream;
     }
-#endif
 
     // ====================  LIFECYCLE     =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
     //      Method:  TEMSurveyLineRecord
-    // Description:  constructor (protected)
+    // Description:  constructor (locked)
     //--------------------------------------------------------------------------------------
-    TEMSurveyLineRecord::TEMSurveyLineRecord (const std::string& name) : LemmaObject(name),
-        numberOfPulseSequences(0)
-    {
+    TEMSurveyLineRecord::TEMSurveyLineRecord ( const ctor_key& key ) : LemmaObject(key),
+        numberOfPulseSequences(0) {
 
     }  // -----  end of method TEMSurveyLineRecord::TEMSurveyLineRecord  (constructor)  -----
 
-#ifdef HAVE_YAMLCPP
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
     //      Method:  TEMSurveyLineRecord
-    // Description:  DeSerializing constructor (protected)
-    //--------------------------------------------------------------------------------------
-    TEMSurveyLineRecord::TEMSurveyLineRecord (const YAML::Node& node) : LemmaObject(node),
-        numberOfPulseSequences(0)
-    {
-
-    }  // -----  end of method TEMSurveyLineRecord::TEMSurveyLineRecord  (constructor)  -----
-#endif
-
-    //--------------------------------------------------------------------------------------
-    //       Class:  TEMSurveyLineRecord
-    //      Method:  ~TEMSurveyLineRecord
-    // Description:  destructor (protected)
-    //--------------------------------------------------------------------------------------
-    TEMSurveyLineRecord::~TEMSurveyLineRecord () {
-
-        for (unsigned int ip=0; ip<Transmitters.size(); ++ip) {
-            if (Transmitters[ip] != NULL) {
-                Transmitters[ip]->DetachFrom(this);
-            }
-        }
-        for (unsigned int ir=0; ir<Receivers.size(); ++ir) {
-            if (Receivers[ir] != NULL) {
-                Receivers[ir]->DetachFrom(this);
+    // Description:  DeSerializing constructor (locked)
+    //--------------------------------------------------------------------------------------
+    TEMSurveyLineRecord::TEMSurveyLineRecord ( const YAML::Node& node, const ctor_key& key ) :
+        LemmaObject(node, key), numberOfPulseSequences(0) {
+
+        SetNumberOfPulseSequences( node["numberOfPulseSequences"].as<int>() );
+        for (int is=0; is<numberOfPulseSequences; ++is) {
+            Transmitters[is] = TEMTransmitter::DeSerialize( node[std::string("pulse_") + to_string(is)] );
+            const YAML::Node rx = node[std::string("receiver_") + to_string(is)];
+            if (rx.Tag() == "TEMInductiveReceiver") {
+                Receivers[is] = TEMInductiveReceiver::DeSerialize( rx );
+            } else {
+                Receivers[is] = TEMReceiver::DeSerialize( rx );
             }
         }
 
-    }  // -----  end of method TEMSurveyLineRecord::~TEMSurveyLineRecord  (destructor)  -----
-
-    //--------------------------------------------------------------------------------------
-    //       Class:  TEMSurveyLineRecord
-    //      Method:  Delete
-    // Description:  public destructor
-    //--------------------------------------------------------------------------------------
-    void TEMSurveyLineRecord::Delete() {
-        this->DetachFrom(this);
-    }
+    }  // -----  end of method TEMSurveyLineRecord::TEMSurveyLineRecord  (constructor)  -----
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
-    //      Method:  Release
-    // Description:  destructor (protected)
+    //      Method:  NewSP
     //--------------------------------------------------------------------------------------
-    void TEMSurveyLineRecord::Release() {
-        delete this;
+    std::shared_ptr<TEMSurveyLineRecord> TEMSurveyLineRecord::NewSP() {
+        return std::make_shared<TEMSurveyLineRecord>( ctor_key() );
     }
 
-
-    //--------------------------------------------------------------------------------------
-    //       Class:  TEMSurveyLineRecord
-    //      Method:  SetPulseSequenceReceiverPair
-    //--------------------------------------------------------------------------------------
-    void TEMSurveyLineRecord::SetTransmitterReceiverPair ( const int& ii, TEMTransmitter* Tx, TEMReceiver* Rx  ) {
-        Receivers[ii] = Rx;
-        Rx->AttachTo(this);
-
-        Transmitters[ii] = Tx;
-        Tx->AttachTo(this);
-        return ;
-    }		// -----  end of method TEMSurveyLineRecord::SetPulseSequenceReceiverPair  -----
-
-
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
-    //      Method:  GetReceiver
+    //      Method:  ~TEMSurveyLineRecord
+    // Description:  destructor
     //--------------------------------------------------------------------------------------
-    TEMReceiver* TEMSurveyLineRecord::GetReceiver ( const int& irec  ) {
-        if ( irec >= (int)(Receivers.size()) ) {
-            throw std::runtime_error( "TEMSurveyLineRecord::GetReceiver(const int& irec)--array bounds error" );
-        }
-        return Receivers[irec] ;
-    }		// -----  end of method TEMSurveyLineRecord::GetReceiver  -----
+    TEMSurveyLineRecord::~TEMSurveyLineRecord () {
 
+    }  // -----  end of method TEMSurveyLineRecord::~TEMSurveyLineRecord  (destructor)  -----
 
-#ifdef HAVE_YAMLCPP
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
     //      Method:  Serialize
     //--------------------------------------------------------------------------------------
     YAML::Node  TEMSurveyLineRecord::Serialize (  ) const {
-        YAML::Node node;
-        node.SetTag( this->Name );
+        YAML::Node node = LemmaObject::Serialize();
+        node.SetTag( GetName() );
         node["numberOfPulseSequences"] = numberOfPulseSequences;
-
-        // FILL IN CLASS SPECIFICS HERE
-
         for( int is=0; is<numberOfPulseSequences; ++is) {
-            node[std::string("pulse_") + to_string(is)]    = Transmitters[is]->Serialize();
-            node[std::string("receiver_") + to_string(is)] = Receivers[is]->Serialize();
+            if (Transmitters[is] != nullptr) {
+                node[std::string("pulse_") + to_string(is)]    = Transmitters[is]->Serialize();
+            }
+            if (Receivers[is] != nullptr) {
+                node[std::string("receiver_") + to_string(is)] = Receivers[is]->Serialize();
+            }
         }
-
-
         return node;
     }		// -----  end of method TEMSurveyLineRecord::Serialize  -----
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
     //      Method:  DeSerialize
     //--------------------------------------------------------------------------------------
-    TEMSurveyLineRecord* TEMSurveyLineRecord::DeSerialize ( const YAML::Node& node  ) {
-        TEMSurveyLineRecord* Object = new TEMSurveyLineRecord(node);
-        Object->AttachTo(Object);
-        DESERIALIZECHECK( node, Object )
-            return Object ;
+    std::shared_ptr<TEMSurveyLineRecord> TEMSurveyLineRecord::DeSerialize ( const YAML::Node& node  ) {
+        if (node.Tag() != "TEMSurveyLineRecord") {
+            throw  DeSerializeTypeMismatch( "TEMSurveyLineRecord", node.Tag());
+        }
+        return std::make_shared<TEMSurveyLineRecord>( node, ctor_key() );
     }		// -----  end of method TEMSurveyLineRecord::DeSerialize  -----
-#endif
 
+    // ====================  OPERATIONS    =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
     //      Method:  SetNumberOfPulseSequences
     //--------------------------------------------------------------------------------------
     void TEMSurveyLineRecord::SetNumberOfPulseSequences ( const int& nseq ) {
-
-        for (unsigned int ip=0; ip<Transmitters.size(); ++ip) {
-            Transmitters[ip]->DetachFrom(this);
-        }
-        for (unsigned int ir=0; ir<Receivers.size(); ++ir) {
-            Receivers[ir]->DetachFrom(this);
-        }
-        Transmitters.clear();
-        Receivers.clear();
-
         numberOfPulseSequences = nseq;
-
-        Receivers.reserve(nseq);
-        Transmitters.reserve(nseq);
-        for (int ir=0; ir<nseq; ++ir) {
-            Transmitters.push_back( NULL );
-            Receivers.push_back( NULL );
-        }
-
+        Transmitters.assign( nseq, nullptr );
+        Receivers.assign( nseq, nullptr );
         return ;
     }		// -----  end of method TEMSurveyLineRecord::SetNumberOfPulseSequences  -----
 
-
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
-    //      Method:  GetNumberOfPulseSequences
+    //      Method:  SetTransmitterReceiverPair
     //--------------------------------------------------------------------------------------
-    int TEMSurveyLineRecord::GetNumberOfPulseSequences (  ) {
-        return numberOfPulseSequences ;
-    }		// -----  end of method TEMSurveyLineRecord::GetNumberOfPulseSequences  -----
+    void TEMSurveyLineRecord::SetTransmitterReceiverPair ( const int& ii, std::shared_ptr<TEMTransmitter> Tx,
+            std::shared_ptr<TEMReceiver> Rx ) {
+        if ( ii < 0 || ii >= numberOfPulseSequences ) {
+            throw std::runtime_error( "TEMSurveyLineRecord::SetTransmitterReceiverPair--array bounds error" );
+        }
+        Transmitters[ii] = Tx;
+        Receivers[ii] = Rx;
+        return ;
+    }		// -----  end of method TEMSurveyLineRecord::SetTransmitterReceiverPair  -----
 
+    // ====================  ACCESS        =======================
 
     //--------------------------------------------------------------------------------------
     //       Class:  TEMSurveyLineRecord
-    //      Method:  ForwardModel
+    //      Method:  GetReceiver
     //--------------------------------------------------------------------------------------
-    TEMSurveyLineRecordData* TEMSurveyLineRecord::ForwardModel ( LayeredEarthEM* model, bool additiveNoise ) {
-
-        TEMSurveyLineRecordData* Data = TEMSurveyLineRecordData::New();
-
-        // DO I want to work with InstrumentTem here? Or just roll it myself at this point?
-        for (unsigned int ip=0; ip<Transmitters.size(); ++ip) {
-
-            InstrumentTem *instrument = InstrumentTem::New();
-
-            // For thread safety...
-            TEMTransmitter*  TC =  Transmitters[ip]->Clone();
-            TEMReceiver* RC = Receivers[ip]->Clone();
-
-            // TODO some of this needs to be moved logic checked or use overriden functions, etc.
-            instrument->EMEarthModel(model);
-	        instrument->SetTransmitLoop( TC );
-            instrument->SetReferenceTime( RC->GetReferenceTime() );
-	        instrument->SetTimeGates( RC->GetWindowCentres(), RC->GetWindowWidths() );
-	        instrument->SetReceiver( RC );   // Clone??
-            instrument->SetReceiverType(INDUCTIVE);
-            instrument->SetPulse( TC->GetWfmAmps(), TC->GetWfmTimes() );
-
-            // TODO pass this
-            //instrument->MakeLaggedCalculation( FHTKEY51 );
-            instrument->MakeLaggedCalculation( ANDERSON801 );
-
-            Data->DataSeries.push_back( MU0*instrument->GetMeasurements().col(1) );
-            Data->GateCentres.push_back( RC->GetWindowCentres() );
-
-            if (additiveNoise) {
-                Data->DataSeries.back() += RC->SampleNoise();
-            }
-
-//                 int nlag = instrument->GetMeasurements().rows();
-//                 std::cout.precision(12);
-//                 std::cout << "// time [s]  dB/dt [T/s] \n";
-//                 for (int ii=0; ii<nlag; ii++) {
-//  		            std::cout<<"  "<<instrument->GetMeasurements()(ii,0)<<"  "<< MU0*instrument->GetMeasurements()(ii,1)<<std::endl;
-//  	            }
+    std::shared_ptr<TEMReceiver> TEMSurveyLineRecord::GetReceiver ( const int& irec  ) {
+        if ( irec < 0 || irec >= static_cast<int>(Receivers.size()) ) {
+            throw std::runtime_error( "TEMSurveyLineRecord::GetReceiver(const int& irec)--array bounds error" );
+        }
+        return Receivers[irec] ;
+    }		// -----  end of method TEMSurveyLineRecord::GetReceiver  -----
 
-            instrument->Delete();
-            TC->Delete();
-            RC->Delete();
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyLineRecord
+    //      Method:  GetTransmitter
+    //--------------------------------------------------------------------------------------
+    std::shared_ptr<TEMTransmitter> TEMSurveyLineRecord::GetTransmitter ( const int& itx  ) {
+        if ( itx < 0 || itx >= static_cast<int>(Transmitters.size()) ) {
+            throw std::runtime_error( "TEMSurveyLineRecord::GetTransmitter(const int& itx)--array bounds error" );
         }
+        return Transmitters[itx] ;
+    }		// -----  end of method TEMSurveyLineRecord::GetTransmitter  -----
 
-        return Data;
-    }		// -----  end of method TEMSurveyLineRecord::ForwardModel  -----
+    // ====================  INQUIRY       =======================
 
+    //--------------------------------------------------------------------------------------
+    //       Class:  TEMSurveyLineRecord
+    //      Method:  GetNumberOfPulseSequences
+    //--------------------------------------------------------------------------------------
+    int TEMSurveyLineRecord::GetNumberOfPulseSequences (  ) const {
+        return numberOfPulseSequences ;
+    }		// -----  end of method TEMSurveyLineRecord::GetNumberOfPulseSequences  -----
 
 }		// -----  end of Lemma  name  -----
@@ -52,7 +52,7 @@ TEMTransmitter::TEMTransmitter (const YAML::Node& node, const ctor_key& key) :
     repFreq =  node["repFreq"].as<Real>();
     repFreqUnits =  string2Enum<FREQUENCYUNITS>( node["repFreqUnits"].as<std::string>() );
     wfmTimes = node["wfmTimes"].as<VectorXr>();
-    wfmTimes = node["wfmAmps"].as<VectorXr>();
+    wfmAmps = node["wfmAmps"].as<VectorXr>();
 
 }  // -----  end of method TEMTransmitter::TEMTransmitter  (constructor)  -----
 
@@ -127,6 +127,46 @@ std::shared_ptr<TEMTransmitter> TEMTransmitter::DeSerialize ( const  YAML::Node&
     return std::make_shared<TEMTransmitter> ( node, ctor_key() );
 }		// -----  end of method TEMTransmitter::DeSerialize  -----
 
+    // ====================  OPERATIONS    =======================
+
+//--------------------------------------------------------------------------------------
+//       Class:  TEMTransmitter
+//      Method:  ConvolveWaveform
+//--------------------------------------------------------------------------------------
+VectorXr TEMTransmitter::ConvolveWaveform ( std::shared_ptr<CubicSplineInterpolator> Spline,
+        const VectorXr& t ) const {
+
+    static const Real T0MIN = 1e-7;
+
+    // response is only defined after the first knot
+    const VectorXr tf = t.array() - Spline->GetKnotAbscissa()(0);
+
+    VectorXr cnv = VectorXr::Zero(t.size());
+    VectorXr tb(t.size());
+    VectorXr tend(t.size());
+    for (int ip=1; ip<wfmTimes.size(); ++ip) {
+        if (wfmTimes(ip) < T0MIN) continue;
+
+        // segments starting after tf are outside of the response, times are ascending so
+        // once no point is active none of the following segments are either
+        const Eigen::Array<bool, Eigen::Dynamic, 1> active = tf.array() >= wfmTimes(ip-1);
+        if (!active.any()) break;
+
+        tb = t.array() - tf.array().min( wfmTimes(ip) );
+        Real dA   = wfmAmps(ip-1) - wfmAmps(ip);
+        Real delt = wfmTimes(ip) - wfmTimes(ip-1);
+        if (delt > T0MIN) {
+            // linear ramp, exact integral of the spline over the segment
+            tend = t.array() - wfmTimes(ip-1);
+            cnv.array() += active.select( (dA/delt) * Spline->Integrate(tb, tend).array(), 0. );
+        } else {
+            // step
+            cnv.array() += active.select( dA * Spline->Interpolate(tb).array(), 0. );
+        }
+    }
+    return cnv;
+}		// -----  end of method TEMTransmitter::ConvolveWaveform  -----
+
     // ====================  INQUIRY       =======================
 
 //--------------------------------------------------------------------------------------
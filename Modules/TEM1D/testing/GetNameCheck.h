@@ -38,5 +38,29 @@ class MyTestSuite : public CxxTest::TestSuite
         TS_ASSERT_EQUALS( Obj->GetName(), std::string("TEMReceiver") );
     }
 
+    void testTEMInductiveReceiver( void )
+    {
+        auto Obj = TEMInductiveReceiver::NewSP();
+        TS_ASSERT_EQUALS( Obj->GetName(), std::string("TEMInductiveReceiver") );
+    }
+
+    void testTEMSurvey( void )
+    {
+        auto Obj = TEMSurvey::NewSP();
+        TS_ASSERT_EQUALS( Obj->GetName(), std::string("TEMSurvey") );
+    }
+
+    void testTEMSurveyData( void )
+    {
+        auto Obj = TEMSurveyData::NewSP();
+        TS_ASSERT_EQUALS( Obj->GetName(), std::string("TEMSurveyData") );
+    }
+
+    void testInstrumentTem( void )
+    {
+        auto Obj = InstrumentTem::NewSP();
+        TS_ASSERT_EQUALS( Obj->GetName(), std::string("InstrumentTem") );
+    }
+
 };
 
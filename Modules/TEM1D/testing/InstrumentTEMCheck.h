@@ -0,0 +1,71 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <TEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    /// Step off dB/dt at the centre of a loop on a halfspace against the analytic
+    /// solution, Ward and Hohmann (1988) eq. 4.98. The loop is a 64 sided polygon,
+    /// whose area is 0.16% smaller than the circle.
+    void testCentralLoopHalfspace(void)
+    {
+        const Real a = 50;
+        const Real sigma = .01;
+        const int np = 64;
+        auto Tx = TEMTransmitter::NewSP();
+            Tx->SetNumberOfPoints(np+1);
+            for (int ip=0; ip<=np; ++ip) {
+                Tx->SetPoint(ip, Vector3r(a*std::cos(2.*PI*ip/np), a*std::sin(2.*PI*ip/np), -1e-2));
+            }
+            VectorXr Times (3);
+            VectorXr Amps  (3);
+            Times << 0, 1, 1;
+            Amps  << 1, 1, 0;
+            Tx->SetWaveform( Times, Amps, MILLISEC );
+
+        VectorXr centres = VectorXr::LinSpaced(8, std::log(3e-5), std::log(5e-3)).array().exp();
+        auto Rx = TEMInductiveReceiver::NewSP();
+            Rx->SetComponent( ZCOMPONENT );
+            Rx->SetRxLocation( Vector3r(0, 0, -1e-2) );
+            Rx->SetWindows( centres, 1e-3*centres, SEC );
+            Rx->SetReferenceTime( 1, MILLISEC );
+
+        auto Earth = LayeredEarthEM::NewSP();
+            Earth->SetNumberOfLayers(2);
+            Earth->SetLayerConductivity( (VectorXcr(2) << Complex(0.,0), Complex(sigma,0) ).finished() );
+
+        auto Instrument = InstrumentTem::NewSP();
+            Instrument->SetTransmitter(Tx);
+            Instrument->SetReceivers( {Rx} );
+            Instrument->SetEarthModel(Earth);
+            Instrument->SetLineIntegralEvaluation(true);
+            Instrument->MakeLaggedCalculation();
+
+        VectorXr dbdt = Instrument->GetMeasurements()[0];
+        for (int ig=0; ig<centres.size(); ++ig) {
+            Real ta = a * std::sqrt( MU0*sigma/(4.*centres(ig)) );
+            Real ref = ( 3.*std::erf(ta) - 2./std::sqrt(PI)*ta*(3.+2.*ta*ta)*std::exp(-ta*ta) ) / (sigma*a*a*a);
+            TS_ASSERT_DELTA( dbdt(ig), ref, 5e-3*ref );
+        }
+    }
+
+};
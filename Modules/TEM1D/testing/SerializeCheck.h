@@ -52,5 +52,42 @@ class MyTestSuite : public CxxTest::TestSuite
         TS_ASSERT_EQUALS( Obj->GetName(), Obj2->GetName() );
     }
 
+    void testTEMInductiveReceiver( void )
+    {
+        auto Obj = TEMInductiveReceiver::NewSP();
+        YAML::Node node = Obj->Serialize();
+        auto Obj2 = TEMInductiveReceiver::DeSerialize(node);
+        TS_ASSERT_EQUALS( Obj->GetName(), Obj2->GetName() );
+    }
+
+    void testTEMSurvey( void )
+    {
+        auto Obj = TEMSurvey::NewSP();
+            Obj->SetNumberOfLines(1);
+            Obj->GetLine(0)->SetNumberOfRecords(2);
+            Obj->GetLine(0)->GetRecord(1)->SetNumberOfPulseSequences(1);
+            Obj->GetLine(0)->GetRecord(1)->SetTransmitterReceiverPair(0, TEMTransmitter::NewSP(),
+                    TEMInductiveReceiver::NewSP());
+        YAML::Node node = Obj->Serialize();
+        auto Obj2 = TEMSurvey::DeSerialize(node);
+        TS_ASSERT_EQUALS( Obj->GetName(), Obj2->GetName() );
+        TS_ASSERT_EQUALS( Obj2->GetLine(0)->GetNumberOfRecords(), 2 );
+        TS_ASSERT_EQUALS( (*Obj2)(0, 1)->GetReceiver(0)->GetName(), std::string("TEMInductiveReceiver") );
+    }
+
+    void testInstrumentTem( void )
+    {
+        auto Obj = InstrumentTem::NewSP();
+            Obj->SetHankelTransformType( FHTKEY101 );
+            Obj->SetTransformTolerance( 1e-9 );
+            Obj->SetLineIntegralEvaluation( true );
+        YAML::Node node = Obj->Serialize();
+        auto Obj2 = InstrumentTem::DeSerialize(node);
+        TS_ASSERT_EQUALS( Obj->GetName(), Obj2->GetName() );
+        TS_ASSERT_EQUALS( node["HankelType"].as<std::string>(),
+                          Obj2->Serialize()["HankelType"].as<std::string>() );
+        TS_ASSERT_EQUALS( Obj2->Serialize()["Tolerance"].as<Real>(), 1e-9 );
+        TS_ASSERT_EQUALS( Obj2->Serialize()["LineIntegral"].as<bool>(), true );
+    }
 
 };
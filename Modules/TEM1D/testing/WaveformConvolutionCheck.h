@@ -0,0 +1,98 @@
+/* This file is part of Lemma, a geophysical modelling and inversion API.
+ * More information is available at http://lemmasoftware.org
+ */
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @file
+ * @date      10/18/2026
+ * @version   $Id$
+ * @copyright Copyright (c) 2026, Lemma Software, LLC
+ */
+
+#include <cxxtest/TestSuite.h>
+#include <TEM1D>
+
+using namespace Lemma;
+
+class MyTestSuite : public CxxTest::TestSuite
+{
+    public:
+
+    /// The closed form gate response matches the former numerical convolution, which
+    /// integrated each ramp with 41200 point Simpson's rule, one gate edge at a time
+    void testClosedFormMatchesSimpson(void)
+    {
+        // trapezoidal pulse, with a step at the end of the ramp off
+        VectorXr Times (6);
+        VectorXr Amps  (6);
+        Times << 0.0, 0.1, 1.5, 2.0, 2.2, 2.2;
+        Amps  << 0.0, 60., 100., 100., 20., 0.;
+        auto Tx = TEMTransmitter::NewSP();
+            Tx->SetWaveform( Times, Amps, MILLISEC );
+
+        VectorXr centres = VectorXr::LinSpaced(12, std::log(1e-4), std::log(2e-2)).array().exp();
+        VectorXr widths  = .4 * centres;
+        auto Rx = TEMReceiver::NewSP();
+            Rx->SetWindows( centres, widths, SEC );
+            Rx->SetReferenceTime( 2.2, MILLISEC );
+
+        // smooth late time decay, sampled like a lagged transform
+        VectorXr t = VectorXr::LinSpaced(120, std::log(1e-7), std::log(1e-1)).array().exp();
+        VectorXr h = t.array().pow(-1.5) * (-t.array()/3e-3).exp();
+        auto Spline = CubicSplineInterpolator::NewSP();
+            Spline->SetKnots(t, h);
+
+        VectorXr gates = Rx->FoldAndConvolve( Spline, Tx );
+
+        const Real refTime = Rx->GetReferenceTime();
+        for (int ig=0; ig<centres.size(); ++ig) {
+            Real early = SimpsonConvolve( Spline, Tx, refTime + centres(ig) - widths(ig)/2. );
+            Real late  = SimpsonConvolve( Spline, Tx, refTime + centres(ig) + widths(ig)/2. );
+            Real ref   = (early - late) / widths(ig);
+            TS_ASSERT_DELTA( gates(ig), ref, 1e-6*std::abs(ref) );
+        }
+    }
+
+    private:
+
+    /// Scalar convolution of the waveform with the spline, as formerly done by InstrumentTem
+    Real SimpsonConvolve( std::shared_ptr<CubicSplineInterpolator> Spline,
+                          std::shared_ptr<TEMTransmitter> Tx, const Real& t )
+    {
+        static const Real T0MIN = 1e-7;
+        VectorXr TxAbs = Tx->GetWfmTimes();
+        VectorXr TxAmp = Tx->GetWfmAmps();
+        Real tf = t - Spline->GetKnotAbscissa()(0);
+        Real cnv(0);
+        for (int ip=1; ip<TxAmp.size(); ++ip) {
+            if (TxAbs(ip) < T0MIN) continue;
+            if (TxAbs(ip-1) > tf)  break;
+            Real tb = t - std::min(tf, TxAbs(ip));
+            Real delt = TxAbs(ip) - TxAbs(ip-1);
+            if (delt > T0MIN) {
+                cnv += (TxAmp(ip-1)-TxAmp(ip))/delt * Simpson(Spline, tb, t - TxAbs(ip-1), 41200);
+            } else {
+                cnv += (TxAmp(ip-1)-TxAmp(ip)) * Spline->Interpolate(tb);
+            }
+        }
+        return cnv;
+    }
+
+    /// Composite Simpson's rule of the spline over n panels
+    Real Simpson( std::shared_ptr<CubicSplineInterpolator> Spline, const Real& x0,
+                  const Real& x1, const int& n )
+    {
+        Real h = (x1 - x0) / n;
+        Real sum = Spline->Interpolate(x0) + Spline->Interpolate(x1);
+        for (int i=1; i<n; ++i) {
+            sum += (i%2 ? 4. : 2.) * Spline->Interpolate(x0 + i*h);
+        }
+        return sum * h / 3.;
+    }
+
+};